@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TemporalCacheMemoryLimit.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Adds time steps to a temporal cache with a memory limit and checks that
+// the number of time steps kept follows the limit, the temporal fields and
+// the temporal window requested by the pipelines, and that the time steps
+// kept hold their data while the older ones are released.
+
+#include "vtkCPDataDescription.h"
+#include "vtkCPInputDataDescription.h"
+#include "vtkCPPipeline.h"
+#include "vtkCPProcessor.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkTemporalDataSetCache.h"
+
+namespace
+{
+// A pipeline that needs array "a" of past time steps from FieldsFrom and two
+// time steps from WindowFrom on. Before that it needs everything.
+class vtkCPTemporalPipeline : public vtkCPPipeline
+{
+public:
+  vtkTypeMacro(vtkCPTemporalPipeline, vtkCPPipeline);
+  static vtkCPTemporalPipeline* New();
+
+  int RequestDataDescription(vtkCPDataDescription* dataDescription) override
+  {
+    vtkCPInputDataDescription* idd = dataDescription->GetInputDescriptionByName("input");
+    idd->AllFieldsOn();
+    idd->GenerateMeshOn();
+    if (dataDescription->GetTimeStep() >= this->FieldsFrom)
+    {
+      idd->AddTemporalField("a", vtkDataObject::POINT);
+    }
+    if (dataDescription->GetTimeStep() >= this->WindowFrom)
+    {
+      idd->RequestTemporalWindow(2);
+    }
+    return 1;
+  }
+
+  int CoProcess(vtkCPDataDescription*) override { return 1; }
+
+  vtkIdType FieldsFrom = 0;
+  vtkIdType WindowFrom = 0;
+
+protected:
+  vtkCPTemporalPipeline() = default;
+  ~vtkCPTemporalPipeline() override = default;
+};
+vtkStandardNewMacro(vtkCPTemporalPipeline);
+
+// A grid with two point arrays of 1 MiB each.
+vtkSmartPointer<vtkImageData> CreateGrid(int timeStep)
+{
+  auto grid = vtkSmartPointer<vtkImageData>::New();
+  grid->SetDimensions(64, 64, 32);
+  const char* names[2] = { "a", "b" };
+  for (const char* name : names)
+  {
+    vtkNew<vtkDoubleArray> array;
+    array->SetName(name);
+    array->SetNumberOfTuples(grid->GetNumberOfPoints());
+    array->FillComponent(0, timeStep);
+    grid->GetPointData()->AddArray(array);
+  }
+  return grid;
+}
+
+// Asks the cache for time step `timeStep`.
+vtkDataSet* GetTimeStep(vtkTemporalDataSetCache* tc, int timeStep)
+{
+  tc->UpdateTimeStep(timeStep * 0.1);
+  return vtkDataSet::SafeDownCast(tc->GetOutputDataObject(0));
+}
+
+// Returns true if `output` has array `name` filled with `timeStep`.
+bool HasArray(vtkDataSet* output, const char* name, int timeStep)
+{
+  vtkDataArray* array = output ? output->GetPointData()->GetArray(name) : nullptr;
+  double range[2] = { -1.0, -1.0 };
+  if (array)
+  {
+    array->GetRange(range, 0);
+  }
+  return range[0] == timeStep && range[1] == timeStep;
+}
+}
+
+int TemporalCacheMemoryLimit(int, char* [])
+{
+  vtkNew<vtkCPProcessor> processor;
+  processor->Initialize();
+  processor->SetTemporalCacheSize(10);
+  processor->SetTemporalCacheMemoryLimit(5);
+  processor->MakeTemporalCache("input");
+  vtkSMSourceProxy* cache = processor->GetTemporalCache("input");
+  vtkTemporalDataSetCache* tc =
+    cache ? vtkTemporalDataSetCache::SafeDownCast(cache->GetClientSideObject()) : nullptr;
+  if (!tc)
+  {
+    vtkGenericWarningMacro("Missing temporal cache.");
+    return 1;
+  }
+
+  // the second pipeline needs all the arrays until it adds temporal fields.
+  vtkNew<vtkCPTemporalPipeline> pipeline1;
+  pipeline1->FieldsFrom = 10;
+  pipeline1->WindowFrom = 25;
+  vtkNew<vtkCPTemporalPipeline> pipeline2;
+  pipeline2->FieldsFrom = 25;
+  pipeline2->WindowFrom = 25;
+  processor->AddPipeline(pipeline1);
+
+  int result = 0;
+  int previousCacheSize = 0;
+  int timeStep = 0;
+  for (; timeStep < 30 && result == 0; timeStep++)
+  {
+    if (timeStep == 20)
+    {
+      processor->AddPipeline(pipeline2);
+    }
+    vtkNew<vtkCPDataDescription> dataDescription;
+    dataDescription->AddInput("input");
+    dataDescription->SetTimeData(timeStep * 0.1, timeStep);
+    processor->RequestDataDescription(dataDescription);
+    auto grid = CreateGrid(timeStep);
+    vtkCPInputDataDescription* idd = dataDescription->GetInputDescriptionByName("input");
+    idd->SetGrid(grid);
+    idd->SetTemporalCache(cache);
+    processor->CoProcess(dataDescription);
+
+    const int cacheSize = tc->GetCacheSize();
+    if (processor->GetTemporalCacheMemoryUsage() > processor->GetTemporalCacheMemoryLimit())
+    {
+      vtkGenericWarningMacro("Memory limit exceeded at time step " << timeStep);
+      result = 1;
+    }
+    else if (timeStep == 9 && cacheSize != 2)
+    {
+      vtkGenericWarningMacro("Expected 2 time steps with all arrays, got " << cacheSize);
+      result = 1;
+    }
+    else if (timeStep == 19 && cacheSize <= previousCacheSize)
+    {
+      vtkGenericWarningMacro("Temporal fields did not allow more time steps: " << cacheSize);
+      result = 1;
+    }
+    else if (timeStep == 24 && cacheSize != 2)
+    {
+      vtkGenericWarningMacro("Expected 2 time steps for all the pipelines, got " << cacheSize);
+      result = 1;
+    }
+    else if (timeStep == 29 && cacheSize != 2)
+    {
+      vtkGenericWarningMacro("Expected the 2 time steps of the window, got " << cacheSize);
+      result = 1;
+    }
+    previousCacheSize = timeStep == 9 ? cacheSize : previousCacheSize;
+
+    // all the arrays are kept until pipeline1 adds temporal fields and while
+    // pipeline2 does not.
+    for (int step = timeStep - cacheSize + 1; step <= timeStep && result == 0; step++)
+    {
+      vtkDataSet* output = GetTimeStep(tc, step);
+      const bool allArrays = step < 10 || (step >= 20 && step < 25);
+      if (!HasArray(output, "a", step) ||
+        (allArrays ? !HasArray(output, "b", step) : output->GetPointData()->HasArray("b") != 0))
+      {
+        vtkGenericWarningMacro("Time step " << step << " not kept intact at " << timeStep);
+        result = 1;
+      }
+    }
+  }
+
+  // the earlier time steps must have been released. Asking for them updates
+  // the cache, so only do it once the time steps kept have been checked.
+  for (int step = 0; step < timeStep - tc->GetCacheSize() && result == 0; step++)
+  {
+    if (HasArray(GetTimeStep(tc, step), "a", step))
+    {
+      vtkGenericWarningMacro("Time step " << step << " was not released.");
+      result = 1;
+    }
+  }
+
+  processor->Finalize();
+  return result;
+}
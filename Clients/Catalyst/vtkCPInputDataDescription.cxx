@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 class vtkCPInputDataDescription::vtkInternals
@@ -32,6 +33,7 @@ class vtkCPInputDataDescription::vtkInternals
 public:
   typedef std::vector<std::string> FieldType;
   std::map<int, FieldType> Fields;
+  std::vector<std::pair<std::string, int> > TemporalFields;
 };
 
 vtkStandardNewMacro(vtkCPInputDataDescription);
@@ -47,6 +49,8 @@ vtkCPInputDataDescription::vtkCPInputDataDescription()
   this->WholeExtent[0] = this->WholeExtent[2] = this->WholeExtent[4] = 0;
   this->WholeExtent[1] = this->WholeExtent[3] = this->WholeExtent[5] = -1;
   this->TemporalCache = nullptr;
+  this->TemporalWindow = 0;
+  this->AllTemporalFields = false;
 }
 
 //----------------------------------------------------------------------------
@@ -65,8 +69,11 @@ vtkCPInputDataDescription::~vtkCPInputDataDescription()
 void vtkCPInputDataDescription::Reset()
 {
   this->Internals->Fields.clear();
+  this->Internals->TemporalFields.clear();
   this->AllFields = false;
   this->GenerateMesh = false;
+  this->TemporalWindow = 0;
+  this->AllTemporalFields = false;
 }
 
 //----------------------------------------------------------------------------
@@ -178,6 +185,63 @@ void vtkCPInputDataDescription::ShallowCopy(vtkCPInputDataDescription* idd)
   memcpy(this->WholeExtent, idd->WholeExtent, 6 * sizeof(int));
   this->Internals->Fields = idd->Internals->Fields;
   this->SetTemporalCache(idd->TemporalCache);
+  this->Internals->TemporalFields = idd->Internals->TemporalFields;
+  this->TemporalWindow = idd->TemporalWindow;
+  this->AllTemporalFields = idd->AllTemporalFields;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPInputDataDescription::AddTemporalField(const char* fieldName, int type)
+{
+  if (!fieldName)
+  {
+    return;
+  }
+  const std::pair<std::string, int> field(fieldName, type);
+  if (std::find(this->Internals->TemporalFields.begin(), this->Internals->TemporalFields.end(),
+        field) == this->Internals->TemporalFields.end())
+  {
+    this->Internals->TemporalFields.push_back(field);
+  }
+  this->TemporalFieldsTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+unsigned int vtkCPInputDataDescription::GetNumberOfTemporalFields()
+{
+  return static_cast<unsigned int>(this->Internals->TemporalFields.size());
+}
+
+//----------------------------------------------------------------------------
+const char* vtkCPInputDataDescription::GetTemporalFieldName(unsigned int fieldIndex)
+{
+  if (fieldIndex >= this->GetNumberOfTemporalFields())
+  {
+    vtkWarningMacro("Bad FieldIndex " << fieldIndex);
+    return nullptr;
+  }
+  return this->Internals->TemporalFields[fieldIndex].first.c_str();
+}
+
+//----------------------------------------------------------------------------
+int vtkCPInputDataDescription::GetTemporalFieldType(unsigned int fieldIndex)
+{
+  if (fieldIndex >= this->GetNumberOfTemporalFields())
+  {
+    vtkWarningMacro("Bad FieldIndex " << fieldIndex);
+    return -1;
+  }
+  return this->Internals->TemporalFields[fieldIndex].second;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPInputDataDescription::RequestTemporalWindow(int numberOfTimeSteps)
+{
+  if (numberOfTimeSteps > this->TemporalWindow)
+  {
+    this->TemporalWindow = numberOfTimeSteps;
+    this->Modified();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -197,4 +261,7 @@ void vtkCPInputDataDescription::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "WholeExtent: " << this->WholeExtent[0] << " " << this->WholeExtent[1] << " "
      << this->WholeExtent[2] << " " << this->WholeExtent[3] << " " << this->WholeExtent[4] << " "
      << this->WholeExtent[5] << "\n";
+  os << indent << "NumberOfTemporalFields: " << this->GetNumberOfTemporalFields() << "\n";
+  os << indent << "TemporalWindow: " << this->TemporalWindow << "\n";
+  os << indent << "AllTemporalFields: " << this->AllTemporalFields << "\n";
 }
@@ -22,6 +22,7 @@ class vtkSMSourceProxy;
 
 #include "vtkObject.h"
 #include "vtkPVCatalystModule.h" // For windows import/export of shared libraries
+#include "vtkTimeStamp.h"        // For TemporalFieldsTime
 
 /// @ingroup CoProcessing
 /// This class provides the data description for each input for the coprocessor
@@ -108,6 +109,40 @@ public:
   // Get the temporal cache.
   vtkGetObjectMacro(TemporalCache, vtkSMSourceProxy);
 
+  // Description:
+  // Add in a name of an array with name *fieldName* of type *type* that
+  // the pipeline needs for past time steps. When temporal fields are
+  // added, the temporal cache only keeps these arrays, unless AllTemporalFields
+  // is on. Note that calling Reset() removes the temporal fields as well.
+  void AddTemporalField(const char* fieldName, int type);
+
+  // Description:
+  // Get the number, names and types of the temporal fields.
+  unsigned int GetNumberOfTemporalFields();
+  const char* GetTemporalFieldName(unsigned int fieldIndex);
+  int GetTemporalFieldType(unsigned int fieldIndex);
+
+  // Description:
+  // Get the time of the last call to AddTemporalField().
+  vtkMTimeType GetTemporalFieldsMTime() { return this->TemporalFieldsTime.GetMTime(); }
+
+  // Description:
+  // On when the temporal cache must keep all the arrays of past time steps,
+  // whatever the temporal fields. vtkCPProcessor::RequestDataDescription()
+  // turns it on when a pipeline does not add temporal fields itself. Note
+  // that calling Reset() resets this flag to Off as well.
+  vtkSetMacro(AllTemporalFields, bool);
+  vtkGetMacro(AllTemporalFields, bool);
+  vtkBooleanMacro(AllTemporalFields, bool);
+
+  // Description:
+  // Request the number of time steps, including the current one, that the
+  // pipelines need from the temporal cache. The largest request is kept
+  // until Reset() is called. 0 (the default) keeps as many time steps as
+  // vtkCPProcessor::GetTemporalCacheSize().
+  void RequestTemporalWindow(int numberOfTimeSteps);
+  vtkGetMacro(TemporalWindow, int);
+
 protected:
   vtkCPInputDataDescription();
   ~vtkCPInputDataDescription() override;
@@ -128,6 +163,18 @@ protected:
   // The temporal cache associated with grid. The cache is not owned by the object.
   vtkSMSourceProxy* TemporalCache;
 
+  // Description:
+  // The number of time steps needed from the temporal cache, 0 if unknown.
+  int TemporalWindow;
+
+  // Description:
+  // On when all arrays must be kept for past time steps.
+  bool AllTemporalFields;
+
+  // Description:
+  // Modified by AddTemporalField().
+  vtkTimeStamp TemporalFieldsTime;
+
 private:
   vtkCPInputDataDescription(const vtkCPInputDataDescription&) = delete;
   void operator=(const vtkCPInputDataDescription&) = delete;
@@ -42,9 +42,12 @@
 #include "vtkStringArray.h"
 #include "vtkTemporalDataSetCache.h"
 
+#include <algorithm>
+#include <deque>
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 struct vtkCPProcessorInternals
@@ -56,6 +59,9 @@ struct vtkCPProcessorInternals
   typedef std::map<std::string, vtkSmartPointer<vtkSMSourceProxy> > CacheList;
   typedef CacheList::iterator CacheListIterator;
   CacheList TemporalCaches;
+
+  // memory, in KiB, of the time steps kept by each temporal cache, oldest first.
+  std::map<std::string, std::deque<unsigned long> > TemporalCacheMemory;
 };
 
 vtkStandardNewMacro(vtkCPProcessor);
@@ -228,12 +234,27 @@ int vtkCPProcessor::RequestDataDescription(vtkCPDataDescription* dataDescription
 
   dataDescription->ResetInputDescriptions();
   int doCoProcessing = 0;
+  std::vector<vtkMTimeType> temporalFieldsTimes(dataDescription->GetNumberOfInputDescriptions());
   for (vtkCPProcessorInternals::PipelineListIterator iter = this->Internal->Pipelines.begin();
        iter != this->Internal->Pipelines.end(); iter++)
   {
+    for (unsigned int i = 0; i < dataDescription->GetNumberOfInputDescriptions(); i++)
+    {
+      temporalFieldsTimes[i] = dataDescription->GetInputDescription(i)->GetTemporalFieldsMTime();
+    }
     if (iter->GetPointer()->RequestDataDescription(dataDescription))
     {
       doCoProcessing = 1;
+      // the temporal fields only restrict the temporal cache when every
+      // pipeline that executes has added the ones it needs.
+      for (unsigned int i = 0; i < dataDescription->GetNumberOfInputDescriptions(); i++)
+      {
+        vtkCPInputDataDescription* idd = dataDescription->GetInputDescription(i);
+        if (idd->GetTemporalFieldsMTime() == temporalFieldsTimes[i])
+        {
+          idd->AllTemporalFieldsOn();
+        }
+      }
     }
   }
   return doCoProcessing;
@@ -273,16 +294,8 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
       input->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), dataDescription->GetTime());
       if (this->GetTemporalCacheSize() > 0)
       {
-        vtkSMSourceProxy* cacheForInput =
-          this->GetTemporalCache(dataDescription->GetInputDescriptionName(i));
-        if (cacheForInput)
-        {
-          vtkTemporalDataSetCache* tc =
-            vtkTemporalDataSetCache::SafeDownCast(cacheForInput->GetClientSideObject());
-          tc->SetInputDataObject(input);
-
-          tc->UpdateTimeStep(dataDescription->GetTime());
-        }
+        this->AddToTemporalCache(dataDescription->GetInputDescriptionName(i),
+          dataDescription->GetInputDescription(i), dataDescription->GetTime());
       }
     }
   }
@@ -384,6 +397,8 @@ void vtkCPProcessor::FinalizeAndRemovePipelines()
 void vtkCPProcessor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "TemporalCacheSize: " << this->TemporalCacheSize << endl;
+  os << indent << "TemporalCacheMemoryLimit: " << this->TemporalCacheMemoryLimit << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -433,6 +448,102 @@ void vtkCPProcessor::MakeTemporalCache(const char* name)
   this->Internal->TemporalCaches[name] = producer;
 }
 
+//----------------------------------------------------------------------------
+void vtkCPProcessor::SetTemporalCacheMemoryLimit(int megabytes)
+{
+  megabytes = std::max(megabytes, 0);
+  if (this->TemporalCacheMemoryLimit == megabytes)
+  {
+    return;
+  }
+  // the time steps beyond the new limit are released when the next one is
+  // added to the caches.
+  this->TemporalCacheMemoryLimit = megabytes;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+double vtkCPProcessor::GetTemporalCacheMemoryUsage()
+{
+  unsigned long kibibytes = 0;
+  for (const auto& cache : this->Internal->TemporalCacheMemory)
+  {
+    for (unsigned long size : cache.second)
+    {
+      kibibytes += size;
+    }
+  }
+  return kibibytes / 1024.0;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPProcessor::AddToTemporalCache(
+  const char* name, vtkCPInputDataDescription* idd, double time)
+{
+  vtkSMSourceProxy* cacheForInput = this->GetTemporalCache(name);
+  vtkTemporalDataSetCache* tc = cacheForInput
+    ? vtkTemporalDataSetCache::SafeDownCast(cacheForInput->GetClientSideObject())
+    : nullptr;
+  if (!tc || !idd->GetGrid())
+  {
+    return;
+  }
+
+  // only keep the arrays the pipelines need from past time steps.
+  vtkSmartPointer<vtkDataObject> grid = idd->GetGrid();
+  if (idd->GetNumberOfTemporalFields() > 0 && !idd->GetAllTemporalFields())
+  {
+    vtkNew<vtkPassArrays> passArrays;
+    passArrays->UseFieldTypesOn();
+    passArrays->AddFieldType(vtkDataObject::POINT);
+    passArrays->AddFieldType(vtkDataObject::CELL);
+    passArrays->SetInputData(grid);
+    for (unsigned int j = 0; j < idd->GetNumberOfTemporalFields(); j++)
+    {
+      passArrays->AddArray(idd->GetTemporalFieldType(j), idd->GetTemporalFieldName(j));
+    }
+    passArrays->Update();
+    grid = passArrays->GetOutputDataObject(0);
+  }
+
+  // keep as many of the last time steps as the window and the memory limit
+  // allow, the new one included. Shrinking the cache releases its oldest
+  // time steps before the new one is added.
+  int cacheSize = this->TemporalCacheSize;
+  if (idd->GetTemporalWindow() > 0)
+  {
+    cacheSize = std::min(cacheSize, idd->GetTemporalWindow());
+  }
+  std::deque<unsigned long>& memory = this->Internal->TemporalCacheMemory[name];
+  memory.push_back(grid->GetActualMemorySize());
+  const unsigned long limit = static_cast<unsigned long>(this->TemporalCacheMemoryLimit) * 1024;
+  unsigned long total = 0;
+  int count = 0;
+  for (auto iter = memory.rbegin(); iter != memory.rend() && count < cacheSize; ++iter, ++count)
+  {
+    if (count > 0 && limit > 0 && total + *iter > limit)
+    {
+      break;
+    }
+    total += *iter;
+  }
+  memory.erase(memory.begin(), memory.end() - count);
+  // the cache releases its earliest time steps when it shrinks, but may release
+  // any of them when it is full and a new one comes in. Make room for the new
+  // one first so that the cache keeps the same time steps as `memory`.
+  if (count > 1 && tc->GetCacheSize() >= count)
+  {
+    tc->SetCacheSize(count - 1);
+  }
+  if (tc->GetCacheSize() != count)
+  {
+    tc->SetCacheSize(count);
+  }
+
+  tc->SetInputDataObject(grid);
+  tc->UpdateTimeStep(time);
+}
+
 //----------------------------------------------------------------------------
 vtkSMSourceProxy* vtkCPProcessor::GetTemporalCache(const char* name)
 {
@@ -20,6 +20,7 @@
 
 struct vtkCPProcessorInternals;
 class vtkCPDataDescription;
+class vtkCPInputDataDescription;
 class vtkCPPipeline;
 class vtkMPICommunicatorOpaqueComm;
 class vtkMultiProcessController;
@@ -85,6 +86,21 @@ public:
   virtual void MakeTemporalCache(const char* name);
   virtual vtkSMSourceProxy* GetTemporalCache(const char* name);
 
+  /// Controls the memory, in MiB, that each temporal cache may use on this
+  /// process. When the time steps kept by a cache exceed it, the oldest ones
+  /// are released; the current time step is always kept. Default is zero,
+  /// which only limits the caches by TemporalCacheSize. The arrays kept and
+  /// the number of time steps can be further reduced by the pipelines with
+  /// vtkCPInputDataDescription::AddTemporalField() and
+  /// vtkCPInputDataDescription::RequestTemporalWindow(). The arrays are only
+  /// reduced when every pipeline that executes adds the temporal fields it needs.
+  virtual void SetTemporalCacheMemoryLimit(int);
+  vtkGetMacro(TemporalCacheMemoryLimit, int);
+
+  /// Returns the memory, in MiB, used by the time steps kept in the temporal
+  /// caches on this process.
+  virtual double GetTemporalCacheMemoryUsage();
+
   /// Initialize the co-processor. Returns 1 if successful and 0
   /// otherwise. If Catalyst is built with MPI then Initialize()
   /// can also be called with a specific MPI communicator if
@@ -147,6 +163,12 @@ protected:
    */
   void FinalizeAndRemovePipelines();
 
+  /**
+   * Adds the grid of *idd* at *time* to the temporal cache *name*, keeping
+   * only the requested arrays and time steps within the memory limit.
+   */
+  void AddToTemporalCache(const char* name, vtkCPInputDataDescription* idd, double time);
+
 private:
   vtkCPProcessor(const vtkCPProcessor&) = delete;
   void operator=(const vtkCPProcessor&) = delete;
@@ -156,6 +178,7 @@ private:
   static vtkMultiProcessController* Controller;
   char* WorkingDirectory;
   int TemporalCacheSize = 0;
+  int TemporalCacheMemoryLimit = 0;
 };
 
 #endif
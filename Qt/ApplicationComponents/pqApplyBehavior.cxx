@@ -57,9 +57,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vtkSMTrace.h"
 #include "vtkSMTransferFunctionManager.h"
 #include "vtkSMViewProxy.h"
+#include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
 
 #include <QList>
+#include <QPointer>
 #include <QSet>
 #include <QtDebug>
 
@@ -154,17 +156,23 @@ void pqApplyBehavior::applied(pqPropertiesPanel*, pqProxy* pqproxy)
     {
       vtkSMSourceProxy* proxy = pqsource->getSourceProxy();
 
-      vtkNew<vtkPVCatalystChannelInformation> information;
+      auto information = vtkSmartPointer<vtkPVCatalystChannelInformation>::New();
       information->Initialize();
 
-      // Ask the server to fill out the rest of the information:
-      proxy->GatherInformation(information);
-
-      std::string name = information->GetChannelName();
-      if (!name.empty())
-      {
-        pqproxy->rename(name.c_str());
-      }
+      // Ask the server to fill out the rest of the information, renaming once
+      // it replies rather than blocking the UI:
+      QPointer<pqProxy> renamed = pqproxy;
+      proxy->GatherInformationAsync(information, [renamed, information](bool status) {
+        if (!status || !renamed || renamed->userModifiedSMName())
+        {
+          return;
+        }
+        std::string name = information->GetChannelName();
+        if (!name.empty())
+        {
+          renamed->rename(name.c_str());
+        }
+      });
     }
   }
 }
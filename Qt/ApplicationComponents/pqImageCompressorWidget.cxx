@@ -42,7 +42,8 @@ static const int NO_COMPRESSION = 0;
 static const int LZ4_COMPRESSION = 1;
 static const int SQUIRT_COMPRESSION = 2;
 static const int ZLIB_COMPRESSION = 3;
-static const int NVPIPE_COMPRESSION = 4;
+static const int DELTA_COMPRESSION = 4;
+static const int NVPIPE_COMPRESSION = 5;
 //-----------------------------------------------------------------------------
 
 class pqImageCompressorWidget::pqInternals
@@ -78,6 +79,8 @@ pqImageCompressorWidget::pqImageCompressorWidget(
   this->connect(ui.zlibColorSpace, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibLevel, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibStripAlpha, SIGNAL(stateChanged(int)), SIGNAL(compressorConfigChanged()));
+  this->connect(
+    ui.deltaKeyFrameInterval, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
 
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
   ui.compressionType->addItem("NvPipe");
@@ -122,6 +125,14 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
                     "\\s+"     // space
                     "([0-9]+)" // num-of-bits.
                     "$");
+  QRegExp deltaRegExp("^vtkDeltaImageCompressor"
+                      "\\s+"     // space
+                      "0"        // 0
+                      "\\s+"     // space
+                      "([0-9]+)" // num-of-bits.
+                      "\\s+"     // space
+                      "([0-9]+)" // key frame interval.
+                      "$");
   QRegExp nvpipeRegExp("^vtkNvPipeCompressor"
                        "\\s+"     // space
                        "0"        // 0
@@ -141,6 +152,14 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
     ui.compressionType->setCurrentIndex(SQUIRT_COMPRESSION);
     ui.squirtColorSpace->setValue(numBits);
   }
+  else if (deltaRegExp.exactMatch(value))
+  {
+    int numBits = deltaRegExp.cap(1).toInt();
+    int interval = deltaRegExp.cap(2).toInt();
+    ui.compressionType->setCurrentIndex(DELTA_COMPRESSION);
+    ui.squirtColorSpace->setValue(numBits);
+    ui.deltaKeyFrameInterval->setValue(interval);
+  }
   else if (zlibRegExp.exactMatch(value))
   {
     int level = zlibRegExp.cap(1).toInt();
@@ -181,6 +200,11 @@ QString pqImageCompressorWidget::compressorConfig() const
         .arg(ui.zlibColorSpace->value())
         .arg(ui.zlibStripAlpha->isChecked() ? 1 : 0);
 
+    case DELTA_COMPRESSION: // inter-frame delta
+      return QString("vtkDeltaImageCompressor 0 %1 %2")
+        .arg(ui.squirtColorSpace->value())
+        .arg(ui.deltaKeyFrameInterval->value());
+
     case NVPIPE_COMPRESSION: // nvpipe
       return QString("vtkNvPipeCompressor 0 %1").arg(ui.nvpLevel->value());
   }
@@ -192,8 +216,13 @@ QString pqImageCompressorWidget::compressorConfig() const
 void pqImageCompressorWidget::currentIndexChanged(int index)
 {
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
-  ui.squirtLabel->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
-  ui.squirtColorSpace->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
+  ui.squirtLabel->setVisible(
+    index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION || index == DELTA_COMPRESSION);
+  ui.squirtColorSpace->setVisible(
+    index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION || index == DELTA_COMPRESSION);
+
+  ui.deltaLabel->setVisible(index == DELTA_COMPRESSION);
+  ui.deltaKeyFrameInterval->setVisible(index == DELTA_COMPRESSION);
 
   ui.zlibLabel1->setVisible(index == ZLIB_COMPRESSION);
   ui.zlibLabel2->setVisible(index == ZLIB_COMPRESSION);
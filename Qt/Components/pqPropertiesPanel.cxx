@@ -42,6 +42,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "pqPipelineSource.h"
 #include "pqProxyWidget.h"
 #include "pqSearchBox.h"
+#include "pqServer.h"
 #include "pqServerManagerModel.h"
 #include "pqSettings.h"
 #include "pqTimer.h"
@@ -54,6 +55,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vtkPVLogger.h"
 #include "vtkSMProperty.h"
 #include "vtkSMProxyClipboard.h"
+#include "vtkSMSession.h"
 #include "vtkSMSourceProxy.h"
 #include "vtkSMViewProxy.h"
 #include "vtkTimerLog.h"
@@ -166,6 +168,7 @@ class pqPropertiesPanel::pqInternals
 {
 public:
   Ui::propertiesPanel Ui;
+  QPointer<pqPropertiesPanel> Panel;
   QPointer<pqView> View;
   QPointer<pqProxy> Source;
   QPointer<pqDataRepresentation> Representation;
@@ -182,7 +185,8 @@ public:
 
   //---------------------------------------------------------------------------
   pqInternals(pqPropertiesPanel* panel)
-    : ReceivedChangeAvailable(false)
+    : Panel(panel)
+    , ReceivedChangeAvailable(false)
   {
     this->Ui.setupUi(panel);
 
@@ -258,6 +262,21 @@ public:
       if (vtkSMSourceProxy* sourceProxy = vtkSMSourceProxy::SafeDownCast(proxy))
       {
         sourceProxy->UpdatePipelineInformation();
+
+        // fetch the data information the widgets depend on without blocking
+        // the UI and refresh the widgets once it arrives.
+        QPointer<pqPropertiesPanel> panel = this->Panel;
+        QPointer<pqProxy> source = this->Source;
+        sourceProxy->UpdateDataInformationAsync([panel, source](bool status) {
+          if (status && panel && source)
+          {
+            pqProxyWidgets* widgets = panel->Internals->SourceWidgets.value(source.data());
+            if (widgets && widgets->Panel)
+            {
+              widgets->Panel->updatePanel();
+            }
+          }
+        });
       }
       else
       {
@@ -847,6 +866,10 @@ void pqPropertiesPanel::apply()
 
   bool onlyApplyCurrentPanel = vtkPVGeneralSettings::GetInstance()->GetAutoApplyActiveOnly();
 
+  // send the modified properties to the server in as few messages as possible.
+  pqServer* server = pqActiveObjects::instance().activeServer();
+  vtkSMSession::vtkScopedBatchPush batch(server ? server->session() : nullptr);
+
   if (onlyApplyCurrentPanel)
   {
     pqProxyWidgets* widgets =
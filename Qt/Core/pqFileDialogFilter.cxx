@@ -48,6 +48,7 @@ pqFileDialogFilter::pqFileDialogFilter(pqFileDialogModel* model, QObject* Parent
   this->Wildcards.setPatternSyntax(QRegExp::RegExp2);
   this->Wildcards.setCaseSensitivity(Qt::CaseSensitive);
   this->setSortCaseSensitivity(Qt::CaseInsensitive);
+  QObject::connect(model, SIGNAL(modelReset()), this, SLOT(fetchAllIfFiltered()));
 }
 
 pqFileDialogFilter::~pqFileDialogFilter()
@@ -122,9 +123,26 @@ void pqFileDialogFilter::setFilter(const QString& filter)
   }
 
   this->Wildcards.setPattern(pattern);
+  this->fetchAllIfFiltered();
   this->invalidateFilter();
 }
 
+void pqFileDialogFilter::fetchAllIfFiltered()
+{
+  // the model fetches large directory listings a page at a time, as the view
+  // scrolls. Only the fetched rows are filtered, so fetch all of them when
+  // the filter may hide some.
+  const QString pattern = this->Wildcards.pattern();
+  if (pattern.isEmpty() || pattern == ".*")
+  {
+    return;
+  }
+  while (this->Model->canFetchMore(QModelIndex()))
+  {
+    this->Model->fetchMore(QModelIndex());
+  }
+}
+
 void pqFileDialogFilter::setShowHidden(const bool& hidden)
 {
   if (this->showHidden != hidden)
@@ -51,6 +51,9 @@ public Q_SLOTS:
   void setShowHidden(const bool& hidden);
   bool getShowHidden() { return showHidden; };
 
+protected Q_SLOTS:
+  void fetchAllIfFiltered();
+
 protected:
   bool filterAcceptsRow(int row_source, const QModelIndex& source_parent) const override;
   bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
@@ -250,6 +250,11 @@ Q_GLOBAL_STATIC(pqFileDialogModelIconProvider, Icons);
 namespace
 {
 
+// Number of entries of a directory listing requested at once. The remaining
+// entries are requested when the view asks for them, see
+// pqFileDialogModel::fetchMore().
+const int DirectoryListingPageSize = 1000;
+
 ///////////////////////////////////////////////////////////////////////
 // CaseInsensitiveSort
 
@@ -314,6 +319,8 @@ class pqFileDialogModel::pqImplementation
 public:
   pqImplementation(pqServer* server)
     : Separator(0)
+    , NumberOfEntries(0)
+    , NumberOfFetchedEntries(0)
     , Server(server)
   {
 
@@ -366,16 +373,20 @@ public:
     return this->GetData(dirListing, this->CurrentPath, path, specialDirs);
   }
 
-  /// query the file system for information
-  vtkPVFileInformation* GetData(
-    bool dirListing, const QString& workingDir, const QString& path, bool specialDirs)
+  /// query the file system for information. Directory listings are paged,
+  /// offset is the index of the first entry of the page to list.
+  vtkPVFileInformation* GetData(bool dirListing, const QString& workingDir, const QString& path,
+    bool specialDirs, int offset = 0)
   {
+    const int pageSize = dirListing ? DirectoryListingPageSize : 0;
     if (this->FileInformationHelperProxy)
     {
       // send data to server
       vtkSMProxy* helper = this->FileInformationHelperProxy;
       pqSMAdaptor::setElementProperty(helper->GetProperty("WorkingDirectory"), workingDir.toUtf8());
       pqSMAdaptor::setElementProperty(helper->GetProperty("DirectoryListing"), dirListing);
+      pqSMAdaptor::setElementProperty(helper->GetProperty("DirectoryListingOffset"), offset);
+      pqSMAdaptor::setElementProperty(helper->GetProperty("DirectoryListingPageSize"), pageSize);
       pqSMAdaptor::setElementProperty(helper->GetProperty("Path"), path.toUtf8());
       pqSMAdaptor::setElementProperty(helper->GetProperty("SpecialDirectories"), specialDirs);
       helper->UpdateVTKObjects();
@@ -388,6 +399,8 @@ public:
     {
       vtkPVFileInformationHelper* helper = this->FileInformationHelper;
       helper->SetDirectoryListing(dirListing);
+      helper->SetDirectoryListingOffset(offset);
+      helper->SetDirectoryListingPageSize(pageSize);
       helper->SetPath(path.toUtf8().data());
       helper->SetSpecialDirectories(specialDirs);
       helper->SetWorkingDirectory(workingDir.toUtf8().data());
@@ -401,7 +414,42 @@ public:
   {
     this->CurrentPath = path;
     this->FileList.clear();
+    // reserve the whole listing, since indices of grouped files point to the
+    // FileList items and must stay valid when more entries are fetched.
+    this->FileList.reserve(dir->GetNumberOfEntries());
+    for (const pqFileDialogModelFileInfo& info : this->GetFileInfos(dir))
+    {
+      this->FileList.push_back(info);
+    }
+    this->NumberOfEntries = dir->GetNumberOfEntries();
+    this->NumberOfFetchedEntries = dir->GetContents()->GetNumberOfItems();
+  }
 
+  /// fetch the next page of the current directory listing. Returns an empty
+  /// list if the directory changed since the first page was fetched: its
+  /// rows may then not fit in the NumberOfEntries rows reserved in FileList.
+  QVector<pqFileDialogModelFileInfo> FetchMore()
+  {
+    const QString& path = this->CurrentPath;
+    vtkPVFileInformation* dir =
+      this->GetData(true, path, path, false, this->NumberOfFetchedEntries);
+    const int numberOfItems = dir->GetContents()->GetNumberOfItems();
+    QVector<pqFileDialogModelFileInfo> rows;
+    if (dir->GetNumberOfEntries() == this->NumberOfEntries && numberOfItems > 0)
+    {
+      rows = this->GetFileInfos(dir);
+    }
+    if (rows.isEmpty() || this->FileList.size() + rows.size() > this->NumberOfEntries)
+    {
+      return QVector<pqFileDialogModelFileInfo>();
+    }
+    this->NumberOfFetchedEntries += numberOfItems;
+    return rows;
+  }
+
+  /// convert the contents of a directory listing, directories first.
+  QVector<pqFileDialogModelFileInfo> GetFileInfos(vtkPVFileInformation* dir)
+  {
     QList<pqFileDialogModelFileInfo> dirs;
     QList<pqFileDialogModelFileInfo> files;
 
@@ -460,14 +508,17 @@ public:
     std::sort(dirs.begin(), dirs.end(), CaseInsensitiveSort);
     std::sort(files.begin(), files.end(), CaseInsensitiveSort);
 
+    QVector<pqFileDialogModelFileInfo> result;
+    result.reserve(dirs.size() + files.size());
     for (int i = 0; i != dirs.size(); ++i)
     {
-      this->FileList.push_back(dirs[i]);
+      result.push_back(dirs[i]);
     }
     for (int i = 0; i != files.size(); ++i)
     {
-      this->FileList.push_back(files[i]);
+      result.push_back(files[i]);
     }
+    return result;
   }
 
   QStringList getFilePaths(const QModelIndex& index)
@@ -529,6 +580,10 @@ public:
   QString CurrentPath;
   /// Caches information about the set of files within the current path.
   QVector<pqFileDialogModelFileInfo> FileList; // adjacent memory occupation for QModelIndex
+  /// Number of entries of the current directory listing, which is also the
+  /// number of rows reserved in FileList, and how many of them were fetched.
+  int NumberOfEntries;
+  int NumberOfFetchedEntries;
 
   const pqFileDialogModelFileInfo* infoForIndex(const QModelIndex& idx) const
   {
@@ -1014,6 +1069,36 @@ int pqFileDialogModel::rowCount(const QModelIndex& idx) const
   return 0;
 }
 
+bool pqFileDialogModel::canFetchMore(const QModelIndex& idx) const
+{
+  return !idx.isValid() &&
+    this->Implementation->NumberOfFetchedEntries < this->Implementation->NumberOfEntries;
+}
+
+void pqFileDialogModel::fetchMore(const QModelIndex& idx)
+{
+  if (!this->canFetchMore(idx))
+  {
+    return;
+  }
+
+  QVector<pqFileDialogModelFileInfo> files = this->Implementation->FetchMore();
+  QVector<pqFileDialogModelFileInfo>& fileList = this->Implementation->FileList;
+  if (files.isEmpty())
+  {
+    // the directory changed: list it again instead, appending would move
+    // the items that indices point to past the entries reserved for them.
+    this->setCurrentPath(this->getCurrentPath());
+    return;
+  }
+  this->beginInsertRows(QModelIndex(), fileList.size(), fileList.size() + files.size() - 1);
+  for (const pqFileDialogModelFileInfo& info : files)
+  {
+    fileList.push_back(info);
+  }
+  this->endInsertRows();
+}
+
 bool pqFileDialogModel::hasChildren(const QModelIndex& idx) const
 {
   if (!idx.isValid())
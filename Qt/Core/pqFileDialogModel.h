@@ -171,6 +171,14 @@ public:
   * return whether a given index has children
   */
   bool hasChildren(const QModelIndex& p) const override;
+  //@{
+  /**
+   * Directory listings are fetched a page at a time, the next page is fetched
+   * when the view asks for more rows.
+   */
+  bool canFetchMore(const QModelIndex& p) const override;
+  void fetchMore(const QModelIndex& p) override;
+  //@}
   /**
   * returns header data
   */
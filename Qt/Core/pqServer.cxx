@@ -118,6 +118,16 @@ pqServer::pqServer(vtkIdType connectionID, vtkPVOptions* options, QObject* _pare
   QObject::connect(
     &this->IdleCollaborationTimer, SIGNAL(timeout()), this, SLOT(processServerNotification()));
 
+  // Poll for replies to asynchronous information requests while some are
+  // pending.
+  this->InformationRepliesTimer.setInterval(5);
+  this->InformationRepliesTimer.setSingleShot(true);
+  QObject::connect(&this->InformationRepliesTimer, SIGNAL(timeout()), this,
+    SLOT(processInformationReplies()));
+  this->Internals->VTKConnect->Connect(this->Session,
+    vtkPVSessionBase::InformationRequestsPendingEvent, &this->InformationRepliesTimer,
+    SLOT(start()));
+
   // Monitor server crash for better error management
   this->Internals->VTKConnect->Connect(this->Session, vtkPVSessionBase::ConnectionLost, this,
     SLOT(onConnectionLost(vtkObject*, ulong, void*, void*)));
@@ -435,6 +445,31 @@ void pqServer::processServerNotification()
   this->IdleCollaborationTimer.start();
 }
 
+//-----------------------------------------------------------------------------
+void pqServer::processInformationReplies()
+{
+  if (!this->Session || this->Session->GetNumberOfPendingInformationRequests() == 0)
+  {
+    return;
+  }
+
+  vtkSMSessionClient* sessionClient = vtkSMSessionClient::SafeDownCast(this->Session);
+  if ((sessionClient == nullptr || sessionClient->IsNotBusy()) && !this->isProgressPending())
+  {
+    // don't wait for the replies, the event loop must keep running.
+    vtkNetworkAccessManager* nam = vtkProcessModule::GetProcessModule()->GetNetworkAccessManager();
+    while (this->Session->GetNumberOfPendingInformationRequests() > 0 &&
+      nam->ProcessEvents(0) == 1)
+    {
+    }
+  }
+
+  if (this->Session->GetNumberOfPendingInformationRequests() > 0)
+  {
+    this->InformationRepliesTimer.start();
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqServer::onCollaborationCommunication(
   vtkObject* vtkNotUsed(src), unsigned long event_, void* vtkNotUsed(method), void* data)
@@ -260,6 +260,12 @@ protected Q_SLOTS:
   */
   void processServerNotification();
 
+  /**
+  * Called while vtkSMSession::GatherInformationAsync() requests are pending
+  * to process the replies from the server.
+  */
+  void processInformationReplies();
+
   /**
   * Called by vtkSMCollaborationManager when associated message happen.
   * This will convert the given parameter into vtkSMMessage and
@@ -286,6 +292,7 @@ private:
   vtkSmartPointer<vtkPVOptions> Options;
 
   pqTimer IdleCollaborationTimer;
+  pqTimer InformationRepliesTimer;
 
   class pqInternals;
   pqInternals* Internals;
@@ -0,0 +1,165 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestFrameEncoder.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests vtkSMFrameEncoder, used by vtkSMSaveAnimationProxy to write frames on
+// background threads: frames named when queued keep their names when they are
+// written out of order, and a failing frame aborts the remaining ones.
+
+#include "vtkSMFrameEncoder.h"
+#include "vtkTestUtilities.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+std::string GetFrameFileName(const std::string& prefix, int frame)
+{
+  char buffer[32];
+  snprintf(buffer, 32, ".%04d.txt", frame);
+  return prefix + buffer;
+}
+
+bool WriteFrame(const std::string& filename, int frame, std::string& error)
+{
+  std::ofstream file(filename.c_str());
+  file << frame;
+  if (!file)
+  {
+    error = "Failed to write '" + filename + "'";
+    return false;
+  }
+  return true;
+}
+
+bool TestOutOfOrder(const std::string& prefix)
+{
+  const int numberOfFrames = 8;
+  vtkSMFrameEncoder encoder(3, 1);
+
+  // frame 0 is only written once frame 1 is, by another thread.
+  std::promise<void> frame1Written;
+  std::shared_future<void> waitForFrame1 = frame1Written.get_future().share();
+  std::mutex mutex;
+  std::vector<int> writtenFrames;
+
+  for (int frame = 0; frame < numberOfFrames; ++frame)
+  {
+    // names are determined when queuing, as SaveAnimation does.
+    const std::string filename = GetFrameFileName(prefix, frame);
+    encoder.Push([&, frame, filename](int, std::string& error) {
+      if (frame == 0 &&
+        waitForFrame1.wait_for(std::chrono::seconds(30)) != std::future_status::ready)
+      {
+        error = "Timed out waiting for frame 1";
+        return false;
+      }
+      const bool status = WriteFrame(filename, frame, error);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        writtenFrames.push_back(frame);
+      }
+      if (frame == 1)
+      {
+        frame1Written.set_value();
+      }
+      return status;
+    });
+  }
+
+  if (!encoder.Finish())
+  {
+    cerr << "ERROR: " << encoder.GetError() << endl;
+    return false;
+  }
+  if (static_cast<int>(writtenFrames.size()) != numberOfFrames || writtenFrames[0] == 0)
+  {
+    cerr << "ERROR: Frames were not written out of order." << endl;
+    return false;
+  }
+
+  for (int frame = 0; frame < numberOfFrames; ++frame)
+  {
+    const std::string filename = GetFrameFileName(prefix, frame);
+    std::ifstream file(filename.c_str());
+    int content = -1;
+    file >> content;
+    if (content != frame)
+    {
+      cerr << "ERROR: '" << filename << "' has frame " << content << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestFailure(const std::string& prefix)
+{
+  vtkSMFrameEncoder encoder(2, 1);
+
+  // frame 2 is written to a missing directory.
+  int frame = 0;
+  for (; frame < 1000; ++frame)
+  {
+    const std::string filename =
+      frame == 2 ? prefix + "-missing/frame.txt" : GetFrameFileName(prefix, frame);
+    const bool queued = encoder.Push([frame, filename](int, std::string& error) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return WriteFrame(filename, frame, error);
+    });
+    if (!queued)
+    {
+      break;
+    }
+  }
+
+  if (frame == 1000)
+  {
+    cerr << "ERROR: Frames still queued after a failure." << endl;
+    return false;
+  }
+  if (encoder.Finish())
+  {
+    cerr << "ERROR: Failure not reported by Finish()." << endl;
+    return false;
+  }
+  if (encoder.GetError().find(prefix + "-missing") == std::string::npos)
+  {
+    cerr << "ERROR: Unexpected error '" << encoder.GetError() << "'" << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestFrameEncoder(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestFrameEncoder";
+  delete[] tempDir;
+
+  bool success = TestOutOfOrder(prefix);
+  success = TestFailure(prefix) && success;
+  return success ? TEST_SUCCESS : TEST_FAILED;
+}
@@ -0,0 +1,155 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkSMFrameEncoder.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkSMFrameEncoder
+ * @brief runs frame writing tasks on background threads
+ *
+ * vtkSMFrameEncoder is used by vtkSMSaveAnimationProxy so that encoding and
+ * writing frames overlaps with rendering the following ones. Tasks are started
+ * in the order they are queued; with a single thread, they also complete in
+ * that order. The queue is bounded: Push() waits while it is full.
+ *
+ * Tasks must not report errors using vtkErrorMacro and the like since they do
+ * not run on the thread that started the animation. Instead, a failing task
+ * returns false and describes the failure in its \c error argument. The
+ * remaining tasks are then discarded and GetError() returns the description
+ * once Finish() returned.
+ */
+
+#ifndef vtkSMFrameEncoder_h
+#define vtkSMFrameEncoder_h
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class vtkSMFrameEncoder
+{
+public:
+  /**
+   * A task writes a frame using the writer of the thread it runs on. It
+   * returns false, and sets \c error, on failure.
+   */
+  using Task = std::function<bool(int thread, std::string& error)>;
+
+  vtkSMFrameEncoder(int numberOfThreads, int queueDepth)
+    : QueueDepth(static_cast<size_t>(std::max(queueDepth, 1)))
+  {
+    for (int cc = 0; cc < numberOfThreads; ++cc)
+    {
+      this->Threads.emplace_back(&vtkSMFrameEncoder::Run, this, cc);
+    }
+  }
+
+  ~vtkSMFrameEncoder() { this->Finish(); }
+
+  /**
+   * Queues a task. Returns false, without queuing it, if a task failed.
+   */
+  bool Push(Task task)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->CanPush.wait(
+      lock, [this]() { return this->Queue.size() < this->QueueDepth || !this->Status; });
+    if (!this->Status)
+    {
+      return false;
+    }
+    this->Queue.push_back(std::move(task));
+    this->CanPop.notify_one();
+    return true;
+  }
+
+  /**
+   * Waits for the queued tasks to complete and stops the threads. Returns
+   * false if any task failed.
+   */
+  bool Finish()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Done = true;
+    }
+    this->CanPop.notify_all();
+    for (auto& thread : this->Threads)
+    {
+      thread.join();
+    }
+    this->Threads.clear();
+    return this->Status;
+  }
+
+  /**
+   * Returns the error of the first task that failed. Only valid once Finish()
+   * returned.
+   */
+  const std::string& GetError() const { return this->Error; }
+
+private:
+  vtkSMFrameEncoder(const vtkSMFrameEncoder&) = delete;
+  void operator=(const vtkSMFrameEncoder&) = delete;
+
+  void Run(int thread)
+  {
+    while (true)
+    {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->CanPop.wait(lock, [this]() { return !this->Queue.empty() || this->Done; });
+        if (this->Queue.empty())
+        {
+          return;
+        }
+        task = std::move(this->Queue.front());
+        this->Queue.pop_front();
+      }
+      this->CanPush.notify_one();
+
+      std::string error;
+      if (!task(thread, error))
+      {
+        // the animation is aborted, skip the remaining frames.
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        if (this->Status)
+        {
+          this->Error = error;
+        }
+        this->Status = false;
+        this->Queue.clear();
+        this->CanPush.notify_all();
+      }
+    }
+  }
+
+  const size_t QueueDepth;
+  std::vector<std::thread> Threads;
+  std::mutex Mutex;
+  std::condition_variable CanPush;
+  std::condition_variable CanPop;
+  std::deque<Task> Queue;
+  bool Done = false;
+  bool Status = true;
+  std::string Error;
+};
+
+#endif
+
+// VTK-HeaderTest-Exclude: vtkSMFrameEncoder.h
@@ -15,6 +15,7 @@
 #include "vtkSMSaveAnimationProxy.h"
 
 #include "vtkCompositeAnimationPlayer.h"
+#include "vtkCommand.h"
 #include "vtkErrorCode.h"
 #include "vtkGenericMovieWriter.h"
 #include "vtkImageData.h"
@@ -29,6 +30,7 @@
 #include "vtkRenderWindow.h"
 #include "vtkSMAnimationScene.h"
 #include "vtkSMAnimationSceneWriter.h"
+#include "vtkSMFrameEncoder.h"
 #include "vtkSMParaViewPipelineController.h"
 #include "vtkSMProperty.h"
 #include "vtkSMPropertyHelper.h"
@@ -39,7 +41,10 @@
 #include "vtkSMViewLayoutProxy.h"
 #include "vtkSMViewProxy.h"
 
+#include <algorithm>
+#include <memory>
 #include <sstream>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 namespace vtkSMSaveAnimationProxyNS
@@ -62,6 +67,56 @@ public:
   }
 };
 
+/**
+ * Collects the errors reported by writers while it exists, instead of
+ * displaying them. Used on encoder threads so that the errors are reported by
+ * the thread saving the animation.
+ */
+class ErrorCollector
+{
+public:
+  ErrorCollector(const std::vector<vtkObject*>& objects)
+  {
+    for (auto object : objects)
+    {
+      if (object)
+      {
+        this->Observers.emplace_back(
+          object, object->AddObserver(vtkCommand::ErrorEvent, this, &ErrorCollector::OnError));
+      }
+    }
+  }
+
+  ~ErrorCollector()
+  {
+    for (const auto& observer : this->Observers)
+    {
+      observer.first->RemoveObserver(observer.second);
+    }
+  }
+
+  /**
+   * Returns `message`, followed by the errors collected, if any.
+   */
+  std::string GetError(const std::string& message) const
+  {
+    return this->Errors.empty() ? message : message + ": " + this->Errors;
+  }
+
+private:
+  ErrorCollector(const ErrorCollector&) = delete;
+  void operator=(const ErrorCollector&) = delete;
+
+  void OnError(vtkObject*, unsigned long, void* calldata)
+  {
+    const char* error = static_cast<const char*>(calldata);
+    this->Errors += error ? error : "";
+  }
+
+  std::vector<std::pair<vtkObject*, unsigned long> > Observers;
+  std::string Errors;
+};
+
 template <class T>
 class SceneImageWriter : public vtkSMAnimationSceneWriter
 {
@@ -74,6 +129,17 @@ public:
    */
   void SetHelper(vtkSMSaveAnimationProxy* helper) { this->Helper = helper; }
 
+  /**
+   * Set the number of threads writing the frames in the background and the
+   * maximum number of frames waiting for them. When \c threads is 0, frames
+   * are written before rendering the next ones.
+   */
+  void SetEncoding(int threads, int queueDepth)
+  {
+    this->NumberOfEncoderThreads = threads;
+    this->EncoderQueueDepth = queueDepth;
+  }
+
 protected:
   SceneImageWriter() {}
   ~SceneImageWriter() {}
@@ -83,6 +149,13 @@ protected:
     // since it's a waste of rendering, the code to save the images will call
     // render anyways.
     this->AnimationScene->SetOverrideStillRender(1);
+
+    const int threads =
+      std::min(this->NumberOfEncoderThreads, this->GetMaximumNumberOfEncoderThreads());
+    if (threads > 0)
+    {
+      this->Encoder.reset(new vtkSMFrameEncoder(threads, this->EncoderQueueDepth));
+    }
     return true;
   }
 
@@ -101,17 +174,56 @@ protected:
       return true;
     }
 
+    if (this->Encoder)
+    {
+      return this->EncodeFrameImage(time, image_pair.first, image_pair.second);
+    }
     return this->WriteFrameImage(time, image_pair.first, image_pair.second);
   }
 
   bool SaveFinalize() override
   {
+    const bool status = this->FinishEncoding();
     this->AnimationScene->SetOverrideStillRender(0);
-    return true;
+    return status;
   }
 
   virtual bool WriteFrameImage(double time, vtkImageData* dataLeft, vtkImageData* dataRight) = 0;
 
+  /**
+   * Queues the images to be written by the encoder threads. Errors reported
+   * by the writers must be collected with an ErrorCollector.
+   */
+  virtual bool EncodeFrameImage(double time, vtkImageData* dataLeft, vtkImageData* dataRight) = 0;
+
+  /**
+   * Returns the maximum number of encoder threads EncodeFrameImage() supports.
+   */
+  virtual int GetMaximumNumberOfEncoderThreads() { return 1; }
+
+  /**
+   * Waits for the queued frames to be written. Returns false, after reporting
+   * the error, if any failed.
+   */
+  bool FinishEncoding()
+  {
+    bool status = true;
+    if (this->Encoder)
+    {
+      status = this->Encoder->Finish();
+      if (!status)
+      {
+        vtkErrorMacro(<< this->Encoder->GetError());
+      }
+      this->Encoder.reset();
+    }
+    return status;
+  }
+
+  std::unique_ptr<vtkSMFrameEncoder> Encoder;
+  int NumberOfEncoderThreads = 0;
+  int EncoderQueueDepth = 1;
+
   std::string GetStereoFileName(const std::string& filename, bool left)
   {
     return Friendship::GetStereoFileName(this->Helper, filename, left);
@@ -181,8 +293,28 @@ protected:
     return status;
   }
 
+  bool EncodeFrameImage(double time, vtkImageData* dataLeft, vtkImageData* dataRight) override
+  {
+    // movies are encoded by a single thread, frames are written in order.
+    vtkSmartPointer<vtkImageData> left = dataLeft;
+    vtkSmartPointer<vtkImageData> right = dataRight;
+    return this->Encoder->Push([this, time, left, right](int, std::string& error) {
+      ErrorCollector errors({ this->Writers[0], this->Writers[1] });
+      const bool status = this->WriteFrameImage(time, left, right);
+      if (!status)
+      {
+        std::ostringstream message;
+        message << "Failed to write frame at time " << time << " to '" << this->FileName << "'";
+        error = errors.GetError(message.str());
+      }
+      return status;
+    });
+  }
+
   bool SaveFinalize() override
   {
+    // all frames must be written before ending the movie.
+    const bool status = this->FinishEncoding();
     if (this->Started)
     {
       for (int cc = 0; cc < 2; ++cc)
@@ -194,7 +326,7 @@ protected:
       }
     }
     this->Started = false;
-    return this->Superclass::SaveFinalize();
+    return this->Superclass::SaveFinalize() && status;
   }
 
 private:
@@ -206,7 +338,8 @@ vtkStandardNewMacro(SceneImageWriterMovie);
 
 class SceneImageWriterImageSeries : public SceneImageWriter<vtkImageWriter>
 {
-  vtkImageWriter* Writer;
+  // One writer for each encoder thread.
+  std::vector<vtkImageWriter*> Writers;
 
 public:
   static SceneImageWriterImageSeries* New();
@@ -221,7 +354,13 @@ public:
   /**
    * Set the writer to use.
    */
-  void SetWriter(vtkImageWriter* writer) { this->Writer = writer; }
+  void SetWriter(vtkImageWriter* writer) { this->Writers.assign(1, writer); }
+
+  /**
+   * Add a writer, configured like the one passed to SetWriter(), used by an
+   * additional encoder thread.
+   */
+  void AddEncoderWriter(vtkImageWriter* writer) { this->Writers.push_back(writer); }
 
 protected:
   SceneImageWriterImageSeries()
@@ -241,43 +380,81 @@ protected:
     return this->Superclass::SaveInitialize(startCount);
   }
 
-  bool WriteFrameImage(
-    double vtkNotUsed(time), vtkImageData* dataLeft, vtkImageData* dataRight) override
+  std::string GetFrameFileName(int counter)
   {
-    bool success = true;
-
-    auto writer = this->Writer;
-    assert(dataLeft);
     assert(this->SuffixFormat);
-    assert(writer);
 
     char buffer[1024];
-    snprintf(buffer, 1024, this->SuffixFormat, this->Counter);
+    snprintf(buffer, 1024, this->SuffixFormat, counter);
 
     std::ostringstream str;
     str << this->Prefix << buffer << this->Extension;
+    return str.str();
+  }
 
-    std::string fname = str.str();
+  // Writes the right image, if any, then the left image.
+  static bool WriteImages(vtkImageWriter* writer, const std::string& leftFileName,
+    vtkImageData* dataLeft, const std::string& rightFileName, vtkImageData* dataRight)
+  {
+    bool success = true;
+    assert(dataLeft);
+    assert(writer);
     if (dataRight)
     {
       writer->SetInputData(dataRight);
-      writer->SetFileName(this->GetStereoFileName(fname, /*left*/ false).c_str());
+      writer->SetFileName(rightFileName.c_str());
       writer->Write();
       success &= (writer->GetErrorCode() == vtkErrorCode::NoError);
-
-      // update fname for left image.
-      fname = this->GetStereoFileName(fname, /*left=*/true);
     }
-    writer->SetFileName(fname.c_str());
+    writer->SetFileName(leftFileName.c_str());
     writer->SetInputData(dataLeft);
     writer->Write();
     writer->SetInputData(nullptr);
 
     success &= writer->GetErrorCode() == vtkErrorCode::NoError;
+    return success;
+  }
+
+  bool WriteFrameImage(
+    double vtkNotUsed(time), vtkImageData* dataLeft, vtkImageData* dataRight) override
+  {
+    std::string fname = this->GetFrameFileName(this->Counter);
+    const bool success = dataRight
+      ? this->WriteImages(this->Writers[0], this->GetStereoFileName(fname, /*left=*/true),
+          dataLeft, this->GetStereoFileName(fname, /*left=*/false), dataRight)
+      : this->WriteImages(this->Writers[0], fname, dataLeft, std::string(), nullptr);
     this->Counter += success ? 1 : 0;
     return success;
   }
 
+  bool EncodeFrameImage(
+    double vtkNotUsed(time), vtkImageData* dataLeft, vtkImageData* dataRight) override
+  {
+    // file names are determined here since frames may be written out of order.
+    std::string leftFileName = this->GetFrameFileName(this->Counter++);
+    std::string rightFileName;
+    if (dataRight)
+    {
+      rightFileName = this->GetStereoFileName(leftFileName, /*left=*/false);
+      leftFileName = this->GetStereoFileName(leftFileName, /*left=*/true);
+    }
+    vtkSmartPointer<vtkImageData> left = dataLeft;
+    vtkSmartPointer<vtkImageData> right = dataRight;
+    return this->Encoder->Push(
+      [this, leftFileName, left, rightFileName, right](int thread, std::string& error) {
+        vtkImageWriter* writer = this->Writers[thread];
+        ErrorCollector errors({ writer });
+        const bool status = this->WriteImages(writer, leftFileName, left, rightFileName, right);
+        if (!status)
+        {
+          error = errors.GetError("Failed to write '" + leftFileName + "'");
+        }
+        return status;
+      });
+  }
+
+  int GetMaximumNumberOfEncoderThreads() override { return static_cast<int>(this->Writers.size()); }
+
 private:
   SceneImageWriterImageSeries(const SceneImageWriterImageSeries&) = delete;
   void operator=(const SceneImageWriterImageSeries&) = delete;
@@ -392,6 +569,12 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
   // check if we're writing 2-stereo video streams at the same time.
   vtkSmartPointer<vtkSMProxy> otherFormatProxy;
 
+  // frames are written by background threads while the next ones are
+  // rendered when NumberOfEncoderThreads > 0.
+  const int encoderThreads = vtkSMPropertyHelper(this, "NumberOfEncoderThreads", true).GetAsInt();
+  const int encoderQueueDepth = vtkSMPropertyHelper(this, "EncoderQueueDepth", true).GetAsInt();
+  std::vector<vtkSmartPointer<vtkSMProxy> > encoderFormatProxies;
+
   // based on the format, we create an appropriate SceneImageWriter.
   auto formatObj = formatProxy->GetClientSideObject();
   if (auto imgWriter = vtkImageWriter::SafeDownCast(formatObj))
@@ -400,6 +583,25 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
     realWriter->SetSuffixFormat(vtkSMPropertyHelper(formatProxy, "SuffixFormat").GetAsString());
     realWriter->SetHelper(this);
     realWriter->SetWriter(imgWriter);
+    realWriter->SetEncoding(encoderThreads, encoderQueueDepth);
+
+    // each encoder thread needs its own writer.
+    auto pxm = this->GetSessionProxyManager();
+    for (int cc = 1; cc < encoderThreads; ++cc)
+    {
+      vtkSmartPointer<vtkSMProxy> encoderFormatProxy;
+      encoderFormatProxy.TakeReference(
+        pxm->NewProxy(formatProxy->GetXMLGroup(), formatProxy->GetXMLName()));
+      encoderFormatProxy->SetLocation(formatProxy->GetLocation());
+      encoderFormatProxy->Copy(formatProxy);
+      encoderFormatProxy->UpdateVTKObjects();
+      if (auto encoderWriter =
+            vtkImageWriter::SafeDownCast(encoderFormatProxy->GetClientSideObject()))
+      {
+        realWriter->AddEncoderWriter(encoderWriter);
+        encoderFormatProxies.push_back(encoderFormatProxy);
+      }
+    }
     writer = realWriter;
   }
   else if (auto movieWriter = vtkGenericMovieWriter::SafeDownCast(formatObj))
@@ -407,6 +609,8 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
     vtkNew<vtkSMSaveAnimationProxyNS::SceneImageWriterMovie> realWriter;
     realWriter->SetHelper(this);
     realWriter->SetWriter(0, movieWriter);
+    // movies are encoded in order by a single thread.
+    realWriter->SetEncoding(encoderThreads, encoderQueueDepth);
 
     // we need two movie writers when writing stereo videos
     if (vtkSMPropertyHelper(this, "StereoMode").GetAsInt() == VTK_STEREO_EMULATE)
@@ -0,0 +1,72 @@
+# Saves an animation with frames written by background encoder threads, as an
+# image series and as a movie, and checks that each image matches the one of
+# the same name saved without encoder threads. Then checks that a frame that
+# cannot be written aborts the save and that the error is reported.
+from __future__ import print_function
+from paraview.simple import *
+from paraview import smtesting
+from paraview.vtk.vtkCommonCore import vtkOutputWindow, vtkStringOutputWindow
+import filecmp
+import os.path
+smtesting.ProcessCommandLineArguments()
+
+tempdir = smtesting.GetUniqueTempDirectory("SaveAnimationEncoderThreads-")
+print("Generating output files in `%s`" % tempdir)
+
+renderView1 = CreateView('RenderView')
+renderView1.ViewSize = [200, 200]
+
+sphere = Sphere(ThetaResolution=32, PhiResolution=32)
+Show(sphere, renderView1)
+ResetCamera(renderView1)
+
+# grow the sphere over the animation so that every frame differs.
+track = GetAnimationTrack('Radius', proxy=sphere)
+track.KeyFrames = [CompositeKeyFrame(KeyTime=0.0, KeyValues=[0.1]),
+                   CompositeKeyFrame(KeyTime=1.0, KeyValues=[0.5])]
+
+numberOfFrames = 10
+scene = GetAnimationScene()
+scene.PlayMode = 'Sequence'
+scene.NumberOfFrames = numberOfFrames
+
+def FrameFileName(prefix, frame):
+    return os.path.join(tempdir, "%s.%04d.png" % (prefix, frame))
+
+if not SaveAnimation(tempdir + "/serial.png", renderView1, ImageResolution=[200, 200]):
+    raise RuntimeError("Failed to save the animation without encoder threads")
+if not SaveAnimation(tempdir + "/threaded.png", renderView1, ImageResolution=[200, 200],
+        NumberOfEncoderThreads=4, EncoderQueueDepth=1):
+    raise RuntimeError("Failed to save the animation with encoder threads")
+
+for frame in range(numberOfFrames):
+    if frame > 0 and filecmp.cmp(FrameFileName("serial", frame - 1),
+            FrameFileName("serial", frame), shallow=False):
+        raise RuntimeError("Frames %d and %d are identical" % (frame - 1, frame))
+    if not filecmp.cmp(FrameFileName("serial", frame), FrameFileName("threaded", frame),
+            shallow=False):
+        raise RuntimeError("Frame %d differs when written by encoder threads" % frame)
+
+definitions = servermanager.ActiveConnection.Session.GetProxyDefinitionManager()
+if definitions.HasDefinition("animation_writers", "OggTheora"):
+    movie = os.path.join(tempdir, "threaded.ogv")
+    if not SaveAnimation(movie, renderView1, ImageResolution=[200, 200],
+            NumberOfEncoderThreads=2, EncoderQueueDepth=1):
+        raise RuntimeError("Failed to save the movie with encoder threads")
+    if not os.path.exists(movie) or os.path.getsize(movie) == 0:
+        raise RuntimeError("Missing movie file")
+
+# frames written to a missing directory fail, the error is reported by the
+# thread saving the animation.
+errors = vtkStringOutputWindow()
+previousOutputWindow = vtkOutputWindow.GetInstance()
+vtkOutputWindow.SetInstance(errors)
+missing = os.path.join(tempdir, "missing")
+status = SaveAnimation(missing + "/threaded.png", renderView1, ImageResolution=[200, 200],
+        NumberOfEncoderThreads=2, EncoderQueueDepth=1)
+vtkOutputWindow.SetInstance(previousOutputWindow)
+
+if status:
+    raise RuntimeError("Saving frames to a missing directory did not fail")
+if missing not in errors.GetOutput():
+    raise RuntimeError("Failure not reported: '%s'" % errors.GetOutput())
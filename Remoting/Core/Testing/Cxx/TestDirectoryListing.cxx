@@ -0,0 +1,228 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestDirectoryListing.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Lists a directory holding a file sequence, checks the grouping of the
+// sequence, that pages of the listing add up to the whole listing, that the
+// index of the directory is reused while the directory is not modified and
+// that the listing follows changes to the directory. Use `--files=<N>` to
+// time the listing of larger sequences.
+
+#include "vtkClientServerStream.h"
+#include "vtkCollection.h"
+#include "vtkNew.h"
+#include "vtkPVFileInformation.h"
+#include "vtkPVFileInformationHelper.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <utime.h>
+#endif
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+void Touch(const std::string& fname)
+{
+  vtksys::ofstream file(fname.c_str());
+  file << "0" << endl;
+}
+
+#if !defined(_WIN32)
+// Sets the modification time of `path` to `modificationTime`.
+bool SetModificationTime(const std::string& path, time_t modificationTime)
+{
+  struct utimbuf times;
+  times.actime = modificationTime;
+  times.modtime = modificationTime;
+  return utime(path.c_str(), &times) == 0;
+}
+#endif
+
+vtkPVFileInformation* GetItem(vtkPVFileInformation* info, int index)
+{
+  return vtkPVFileInformation::SafeDownCast(info->GetContents()->GetItemAsObject(index));
+}
+
+// Lists the directory and passes the result through a stream, as done when
+// the listing is gathered from a server.
+void List(vtkPVFileInformationHelper* helper, vtkPVFileInformation* result, int offset,
+  int pageSize, const char* label = nullptr)
+{
+  helper->SetDirectoryListingOffset(offset);
+  helper->SetDirectoryListingPageSize(pageSize);
+  vtkNew<vtkPVFileInformation> info;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  info->CopyFromObject(helper);
+  timer->StopTimer();
+  if (label)
+  {
+    cout << label << ": " << timer->GetElapsedTime() << " s" << endl;
+  }
+
+  vtkClientServerStream stream;
+  info->CopyToStream(&stream);
+  result->CopyFromStream(&stream);
+}
+}
+
+int TestDirectoryListing(int argc, char* argv[])
+{
+  int files = 1000;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument("--files", argT::EQUAL_ARGUMENT, &files, "Number of files of the sequence.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse() || files < 2)
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string dirname = std::string(tempDir) + "/TestDirectoryListing";
+  delete[] tempDir;
+
+  vtksys::SystemTools::RemoveADirectory(dirname);
+  vtksys::SystemTools::MakeDirectory(dirname + "/subdir");
+  for (int cc = 0; cc < files; ++cc)
+  {
+    char name[64];
+    snprintf(name, sizeof(name), "/data_%06d.vtk", cc);
+    Touch(dirname + name);
+  }
+  Touch(dirname + "/notes_1.txt");
+  Touch(dirname + "/Single.txt");
+
+  vtkNew<vtkPVFileInformationHelper> helper;
+  helper->SetPath(dirname.c_str());
+  helper->SetDirectoryListing(1);
+
+#if !defined(_WIN32)
+  // an index is only reused when built after the second the directory was
+  // last modified, so backdate the directory.
+  const time_t backdated = time(nullptr) - 10;
+  if (!SetModificationTime(dirname, backdated))
+  {
+    cerr << "Cannot set the modification time of " << dirname << endl;
+    return TEST_FAILED;
+  }
+#endif
+
+  // subdir, the data_ sequence, notes_1.txt and Single.txt, in that order.
+  vtkNew<vtkPVFileInformation> all;
+  List(helper, all, 0, 0, "listing");
+  List(helper, all, 0, 0, "listing (indexed)");
+  if (all->GetNumberOfEntries() != 4 || all->GetContents()->GetNumberOfItems() != 4)
+  {
+    cerr << "Expected 4 entries, got " << all->GetNumberOfEntries() << endl;
+    return TEST_FAILED;
+  }
+  const int expectedTypes[4] = { vtkPVFileInformation::DIRECTORY,
+    vtkPVFileInformation::FILE_GROUP, vtkPVFileInformation::SINGLE_FILE,
+    vtkPVFileInformation::SINGLE_FILE };
+  const char* expectedNames[4] = { "subdir", nullptr, "notes_1.txt", "Single.txt" };
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    vtkPVFileInformation* item = GetItem(all, cc);
+    if (item->GetType() != expectedTypes[cc] ||
+      (expectedNames[cc] && std::string(item->GetName()) != expectedNames[cc]))
+    {
+      cerr << "Unexpected entry " << cc << ": " << item->GetName() << endl;
+      return TEST_FAILED;
+    }
+  }
+  vtkPVFileInformation* group = GetItem(all, 1);
+  char lastName[64];
+  snprintf(lastName, sizeof(lastName), "data_%06d.vtk", files - 1);
+  if (group->GetContents()->GetNumberOfItems() != files ||
+    std::string(GetItem(group, files - 1)->GetName()) != lastName)
+  {
+    cerr << "Incorrect sequence " << group->GetName() << endl;
+    return TEST_FAILED;
+  }
+
+  // pages add up to the whole listing.
+  std::vector<std::string> names;
+  for (int offset = 0; offset < 5; offset += 3)
+  {
+    vtkNew<vtkPVFileInformation> page;
+    List(helper, page, offset, 3);
+    if (page->GetNumberOfEntries() != 4)
+    {
+      cerr << "Incorrect number of entries for page " << offset << endl;
+      return TEST_FAILED;
+    }
+    for (int cc = 0; cc < page->GetContents()->GetNumberOfItems(); ++cc)
+    {
+      names.push_back(GetItem(page, cc)->GetName());
+    }
+  }
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    if (names.size() != 4 || names[cc] != GetItem(all, cc)->GetName())
+    {
+      cerr << "Pages do not match the whole listing." << endl;
+      return TEST_FAILED;
+    }
+  }
+
+#if !defined(_WIN32)
+  // a file added behind the back of the index, with the modification time of
+  // the directory restored, is not listed since the index is reused.
+  Touch(dirname + "/unlisted.txt");
+  if (!SetModificationTime(dirname, backdated))
+  {
+    cerr << "Cannot set the modification time of " << dirname << endl;
+    return TEST_FAILED;
+  }
+  List(helper, all, 0, 0);
+  if (all->GetNumberOfEntries() != 4)
+  {
+    cerr << "Index of the unmodified directory not reused." << endl;
+    return TEST_FAILED;
+  }
+  vtksys::SystemTools::RemoveFile(dirname + "/unlisted.txt");
+#endif
+
+  // the indexed listing follows changes to the directory.
+  vtksys::SystemTools::RemoveFile(dirname + "/notes_1.txt");
+  Touch(dirname + "/data_other.vtk");
+  Touch(dirname + "/notes_2.txt");
+  List(helper, all, 0, 0);
+  if (all->GetNumberOfEntries() != 5 ||
+    std::string(GetItem(all, 3)->GetName()) != "notes_2.txt")
+  {
+    cerr << "Listing not updated after changes to the directory." << endl;
+    return TEST_FAILED;
+  }
+
+  vtksys::SystemTools::RemoveADirectory(dirname);
+  return TEST_SUCCESS;
+}
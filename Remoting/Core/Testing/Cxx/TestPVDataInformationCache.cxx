@@ -0,0 +1,112 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVDataInformationCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDoubleArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> GetPolyData(double value)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+
+  vtkSmartPointer<vtkPolyData> pd = sphere->GetOutput();
+  vtkNew<vtkDoubleArray> array;
+  array->SetName("values");
+  array->SetNumberOfTuples(pd->GetNumberOfPoints());
+  array->FillComponent(0, value);
+  pd->GetPointData()->AddArray(array);
+  return pd;
+}
+
+bool CheckRange(vtkDataObject* dobj, double expected)
+{
+  vtkNew<vtkPVDataInformation> info;
+  info->CopyFromObject(dobj);
+  vtkPVArrayInformation* ainfo = info->GetArrayInformation("values", vtkDataObject::POINT);
+  if (ainfo == nullptr)
+  {
+    cerr << "Missing array information." << endl;
+    return false;
+  }
+  double range[2];
+  ainfo->GetComponentRange(0, range);
+  if (range[0] != expected || range[1] != expected)
+  {
+    cerr << "Incorrect range: " << range[0] << ", " << range[1] << " (expected " << expected
+         << ")" << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPVDataInformationCache(int, char* [])
+{
+  vtkPVDataInformation::SetEnableCaching(true);
+
+  auto block0 = GetPolyData(1.0);
+  auto block1 = GetPolyData(2.0);
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetBlock(0, block0);
+  mb->SetBlock(1, block1);
+
+  // populate the cache; a repeated request must produce identical results.
+  if (!CheckRange(block0, 1.0) || !CheckRange(block0, 1.0))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // modifying the array must invalidate the cached information.
+  auto array = vtkDoubleArray::SafeDownCast(block0->GetPointData()->GetArray("values"));
+  array->FillComponent(0, 3.0);
+  array->Modified();
+  if (!CheckRange(block0, 3.0))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // only the modified block changes in a composite dataset.
+  vtkNew<vtkPVDataInformation> info;
+  info->CopyFromObject(mb);
+  double range[2];
+  info->GetArrayInformation("values", vtkDataObject::POINT)->GetComponentRange(0, range);
+  if (range[0] != 2.0 || range[1] != 3.0)
+  {
+    cerr << "Incorrect composite range: " << range[0] << ", " << range[1] << endl;
+    return EXIT_FAILURE;
+  }
+  if (info->GetNumberOfPoints() != block0->GetNumberOfPoints() + block1->GetNumberOfPoints())
+  {
+    cerr << "Incorrect number of points." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkPVDataInformation::ClearCache();
+  vtkPVDataInformation::SetEnableCaching(false);
+  if (!CheckRange(block1, 2.0))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkPVDataInformation::SetEnableCaching(true);
+  return EXIT_SUCCESS;
+}
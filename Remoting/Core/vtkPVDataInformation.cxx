@@ -48,13 +48,16 @@
 #include "vtkPointData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSelection.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkTable.h"
 #include "vtkUniformGrid.h"
+#include "vtkWeakPointer.h"
 
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -63,6 +66,60 @@ vtkStandardNewMacro(vtkPVDataInformation);
 
 std::map<std::string, std::string> helpers;
 
+namespace
+{
+// Cache of information summarized for non-composite data objects. Entries are
+// keyed by the data object and are valid as long as the data object has not
+// been modified or re-generated by the pipeline since.
+struct InformationCache
+{
+  struct Entry
+  {
+    vtkWeakPointer<vtkDataObject> DataObject;
+    int PortNumber = -1;
+    vtkMTimeType MTime = 0;
+    vtkMTimeType UpdateTime = 0;
+    vtkMTimeType PipelineInformationMTime = 0;
+    vtkSmartPointer<vtkPVDataInformation> Information;
+  };
+
+  static bool Enabled;
+  static std::mutex Mutex;
+  static std::map<vtkDataObject*, Entry> Entries;
+
+  // Entries.size() at which expired entries are pruned next. Setting it to
+  // twice the number of live entries after every prune keeps pruning
+  // amortized O(1) per insertion while bounding the expired entries that pile
+  // up in between.
+  static const size_t MinimumPruneSize = 16;
+  static size_t PruneSize;
+
+  // Removes entries for data objects that no longer exist. Caller must hold
+  // the mutex.
+  static void PruneExpired()
+  {
+    for (auto iter = Entries.begin(); iter != Entries.end();)
+    {
+      if (iter->second.DataObject.GetPointer() == nullptr)
+      {
+        iter = Entries.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+    PruneSize = std::max(MinimumPruneSize, 2 * Entries.size());
+  }
+};
+
+bool InformationCache::Enabled = true;
+std::mutex InformationCache::Mutex;
+std::map<vtkDataObject*, InformationCache::Entry> InformationCache::Entries;
+const size_t InformationCache::MinimumPruneSize;
+size_t InformationCache::PruneSize = InformationCache::MinimumPruneSize;
+}
+
 //----------------------------------------------------------------------------
 vtkPVDataInformation::vtkPVDataInformation()
 {
@@ -778,6 +835,15 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
     return;
   }
 
+  if (!this->CopyFromCache(dobj, info))
+  {
+    this->CopyFromDataObject(dobj, info);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::CopyFromDataObject(vtkDataObject* dobj, vtkInformation* info)
+{
   vtkCompositeDataSet* cds = vtkCompositeDataSet::SafeDownCast(dobj);
   if (cds)
   {
@@ -1715,6 +1781,89 @@ void vtkPVDataInformation::CopyFromStream(const vtkClientServerStream* css)
   CSS_ARGUMENT_END();
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVDataInformation::CopyFromCache(vtkDataObject* dobj, vtkInformation* pinfo)
+{
+  // Composite datasets are not cached since their MTime does not reflect
+  // changes to their blocks; the blocks themselves are cached instead.
+  if (!InformationCache::Enabled || vtkCompositeDataSet::SafeDownCast(dobj) != nullptr)
+  {
+    return false;
+  }
+
+  const vtkMTimeType mtime = dobj->GetMTime();
+  const vtkMTimeType updateTime = dobj->GetUpdateTime();
+  const vtkMTimeType pinfoMTime = pinfo ? pinfo->GetMTime() : 0;
+
+  vtkSmartPointer<vtkPVDataInformation> cached;
+  {
+    std::lock_guard<std::mutex> lock(InformationCache::Mutex);
+    auto iter = InformationCache::Entries.find(dobj);
+    if (iter != InformationCache::Entries.end() && iter->second.DataObject.GetPointer() != dobj)
+    {
+      // the data object the entry was created for is gone; `dobj` reuses its
+      // address.
+      InformationCache::Entries.erase(iter);
+    }
+    else if (iter != InformationCache::Entries.end() &&
+      iter->second.PortNumber == this->PortNumber && iter->second.MTime == mtime &&
+      iter->second.UpdateTime == updateTime && iter->second.PipelineInformationMTime == pinfoMTime)
+    {
+      cached = iter->second.Information;
+    }
+  }
+
+  if (!cached)
+  {
+    cached = vtkSmartPointer<vtkPVDataInformation>::New();
+    cached->PortNumber = this->PortNumber;
+    cached->CopyFromDataObject(dobj, pinfo);
+
+    std::lock_guard<std::mutex> lock(InformationCache::Mutex);
+    if (InformationCache::Entries.size() >= InformationCache::PruneSize)
+    {
+      InformationCache::PruneExpired();
+    }
+    InformationCache::Entry& entry = InformationCache::Entries[dobj];
+    entry.DataObject = dobj;
+    entry.PortNumber = this->PortNumber;
+    entry.MTime = mtime;
+    entry.UpdateTime = updateTime;
+    entry.PipelineInformationMTime = pinfoMTime;
+    entry.Information = cached;
+  }
+
+  this->Initialize();
+  this->DeepCopy(cached);
+  this->Time = cached->Time;
+  this->HasTime = cached->HasTime;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::SetEnableCaching(bool val)
+{
+  InformationCache::Enabled = val;
+  if (!val)
+  {
+    vtkPVDataInformation::ClearCache();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataInformation::GetEnableCaching()
+{
+  return InformationCache::Enabled;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::ClearCache()
+{
+  std::lock_guard<std::mutex> lock(InformationCache::Mutex);
+  InformationCache::Entries.clear();
+  InformationCache::PruneSize = InformationCache::MinimumPruneSize;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::RegisterHelper(const char* classname, const char* helper)
 {
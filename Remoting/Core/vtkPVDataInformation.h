@@ -296,6 +296,23 @@ public:
    */
   static void RegisterHelper(const char* classname, const char* helperclassname);
 
+  //@{
+  /**
+   * When enabled (default), information summarized for non-composite data
+   * objects is cached and reused for subsequent requests as long as the data
+   * object has not been modified or re-generated by the pipeline since. For
+   * composite datasets, this means only blocks that have changed are
+   * summarized again. The cache only holds weak references to data objects.
+   */
+  static void SetEnableCaching(bool);
+  static bool GetEnableCaching();
+  //@}
+
+  /**
+   * Discard all cached information.
+   */
+  static void ClearCache();
+
 protected:
   vtkPVDataInformation();
   ~vtkPVDataInformation() override;
@@ -314,6 +331,19 @@ protected:
   void CopyFromSelection(vtkSelection* selection);
   void CopyCommonMetaData(vtkDataObject*, vtkInformation*);
 
+  /**
+   * Summarizes `dobj` into this instance. `pinfo` is the output information
+   * of the port producing `dobj`, if any. Called by CopyFromObject, using
+   * cached information when possible.
+   */
+  void CopyFromDataObject(vtkDataObject* dobj, vtkInformation* pinfo);
+
+  /**
+   * Copies information for a non-composite `dobj` from the cache, updating
+   * the cache if needed. Returns false if `dobj` cannot be cached.
+   */
+  bool CopyFromCache(vtkDataObject* dobj, vtkInformation* pinfo);
+
   static vtkPVDataInformationHelper* FindHelper(const char* classname);
 
   // Data information collected from remote processes.
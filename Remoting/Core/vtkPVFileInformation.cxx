@@ -40,6 +40,7 @@
 #include <errno.h>     // errno
 #include <stdlib.h>    // getenv
 #include <string.h>    // strerror
+#include <strings.h>   // strcasecmp
 #include <sys/types.h> // DIR, struct dirent
 #include <unistd.h>    // access, getcwd
 #define vtkPVServerFileListingGetCWD getcwd
@@ -50,9 +51,12 @@
 #endif
 
 #include <algorithm>
+#include <list>
 #include <set>
 #include <string>
 #include <time.h>
+#include <utility>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 #include <vtksys/SystemTools.hxx>
 
@@ -351,6 +355,40 @@ class vtkPVFileInformationSet : public std::set<vtkSmartPointer<vtkPVFileInforma
 {
 };
 
+//-----------------------------------------------------------------------------
+// Entries of a directory listing. Only names and types are kept so that the
+// index can be cached between listings of the same directory, and the
+// vtkPVFileInformation objects are only created for the requested page.
+class vtkPVFileInformationIndex
+{
+public:
+  struct Entry
+  {
+    std::string Name;
+    int Type;
+    bool Hidden;
+    // Names and types of the files/directories of a group.
+    std::vector<std::pair<std::string, int> > Children;
+  };
+
+  std::vector<Entry> Entries;
+  time_t DirectoryModificationTime;
+  time_t BuildTime;
+};
+
+//-----------------------------------------------------------------------------
+// Indices of the last listed directories, the most recently used first, keyed
+// by FastFileTypeDetection and the directory path.
+typedef std::list<std::pair<std::string, vtkPVFileInformationIndex> >
+  vtkPVFileInformationIndexCache;
+static const size_t vtkPVFileInformationIndexCacheSize = 16;
+
+static vtkPVFileInformationIndexCache& vtkPVFileInformationGetIndexCache()
+{
+  static vtkPVFileInformationIndexCache cache;
+  return cache;
+}
+
 //-----------------------------------------------------------------------------
 vtkPVFileInformation::vtkPVFileInformation()
 {
@@ -370,6 +408,9 @@ vtkPVFileInformation::vtkPVFileInformation()
 #else
   this->ModificationTime = time(NULL);
 #endif
+  this->NumberOfEntries = 0;
+  this->DirectoryListingOffset = 0;
+  this->DirectoryListingPageSize = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -409,11 +450,14 @@ void vtkPVFileInformation::CopyFromObject(vtkObject* object)
   if (helper->GetSpecialDirectories())
   {
     this->GetSpecialDirectories();
+    this->NumberOfEntries = this->Contents->GetNumberOfItems();
     return;
   }
 
   this->FastFileTypeDetection = helper->GetFastFileTypeDetection();
   this->ReadDetailedFileInformation = helper->GetReadDetailedFileInformation();
+  this->DirectoryListingOffset = helper->GetDirectoryListingOffset();
+  this->DirectoryListingPageSize = helper->GetDirectoryListingPageSize();
 
   std::string working_directory = vtksys::SystemTools::GetCurrentWorkingDirectory().c_str();
   if (helper->GetWorkingDirectory() && helper->GetWorkingDirectory()[0])
@@ -470,6 +514,7 @@ void vtkPVFileInformation::CopyFromObject(vtkObject* object)
 // with intelligent pattern matching hee-haa.
 #if defined(_WIN32)
     this->GetWindowsDirectoryListing();
+    this->NumberOfEntries = this->Contents->GetNumberOfItems();
 #else
     this->GetDirectoryListing();
 #endif
@@ -838,6 +883,124 @@ void vtkPVFileInformation::GetDirectoryListing()
   vtkErrorMacro("GetDirectoryListing() cannot be called on Windows systems.");
   return;
 
+#else
+
+  vtksys::SystemTools::Stat_t dirStatus;
+  if (vtksys::SystemTools::Stat(this->FullPath, &dirStatus) == -1)
+  {
+    return;
+  }
+
+  // Reuse the index of the directory if the directory was not modified since
+  // the index was built. An index built during the second the directory was
+  // last modified is not reused, since the modification may have followed the
+  // listing.
+  const std::string key = std::to_string(this->FastFileTypeDetection) + ":" + this->FullPath;
+  vtkPVFileInformationIndexCache& cache = vtkPVFileInformationGetIndexCache();
+  vtkPVFileInformationIndexCache::iterator iter = cache.begin();
+  while (iter != cache.end() && iter->first != key)
+  {
+    ++iter;
+  }
+  if (iter != cache.end() &&
+    (iter->second.DirectoryModificationTime != dirStatus.st_mtime ||
+      iter->second.BuildTime <= iter->second.DirectoryModificationTime))
+  {
+    cache.erase(iter);
+    iter = cache.end();
+  }
+  if (iter == cache.end())
+  {
+    vtkPVFileInformationIndex index;
+    index.DirectoryModificationTime = dirStatus.st_mtime;
+    index.BuildTime = time(NULL);
+    if (!this->BuildDirectoryIndex(index))
+    {
+      return;
+    }
+    cache.push_front(std::make_pair(key, std::move(index)));
+    if (cache.size() > vtkPVFileInformationIndexCacheSize)
+    {
+      cache.pop_back();
+    }
+  }
+  else
+  {
+    cache.splice(cache.begin(), cache, iter);
+  }
+  const vtkPVFileInformationIndex& index = cache.front().second;
+
+  // Only the entries of the requested page are created and, when asked
+  // for, stat'ed for their detailed information.
+  const int numberOfEntries = static_cast<int>(index.Entries.size());
+  const int begin = std::min(std::max(this->DirectoryListingOffset, 0), numberOfEntries);
+  const int end = this->DirectoryListingPageSize > 0
+    ? begin + std::min(this->DirectoryListingPageSize, numberOfEntries - begin)
+    : numberOfEntries;
+  this->NumberOfEntries = numberOfEntries;
+
+  const bool readDetails = this->ReadDetailedFileInformation;
+  auto readDetailedInformation = [readDetails](vtkPVFileInformation* info) {
+    vtksys::SystemTools::Stat_t status;
+    if (!readDetails || vtksys::SystemTools::Stat(info->FullPath, &status) == -1)
+    {
+      return;
+    }
+    if (!S_ISDIR(status.st_mode))
+    {
+      std::string::size_type pos = std::string(info->Name).rfind('.');
+      if (pos != std::string::npos)
+      {
+        info->SetExtension(std::string(info->Name).substr(pos + 1).c_str());
+      }
+    }
+    info->Size = status.st_size;
+    info->ModificationTime = status.st_mtime;
+  };
+
+  std::string prefix = this->FullPath;
+  vtkPVFileInformationAddTerminatingSlash(prefix);
+  for (int cc = begin; cc < end; ++cc)
+  {
+    const vtkPVFileInformationIndex::Entry& entry = index.Entries[cc];
+    vtkNew<vtkPVFileInformation> info;
+    info->SetName(entry.Name.c_str());
+    info->SetFullPath((prefix + entry.Name).c_str());
+    info->Type = entry.Type;
+    info->Hidden = entry.Hidden;
+    info->FastFileTypeDetection = this->FastFileTypeDetection;
+    if (entry.Type == FILE_GROUP || entry.Type == DIRECTORY_GROUP)
+    {
+      for (const auto& child : entry.Children)
+      {
+        vtkNew<vtkPVFileInformation> childInfo;
+        childInfo->SetName(child.first.c_str());
+        childInfo->SetFullPath((prefix + child.first).c_str());
+        childInfo->Type = child.second;
+        childInfo->SetHiddenFlag();
+        childInfo->FastFileTypeDetection = this->FastFileTypeDetection;
+        readDetailedInformation(childInfo);
+        info->Contents->AddItem(childInfo);
+      }
+    }
+    else
+    {
+      readDetailedInformation(info);
+    }
+    this->Contents->AddItem(info);
+  }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVFileInformation::BuildDirectoryIndex(vtkPVFileInformationIndex& index)
+{
+#if defined(_WIN32)
+
+  (void)index;
+  vtkErrorMacro("BuildDirectoryIndex() cannot be called on Windows systems.");
+  return false;
+
 #else
 
   vtkPVFileInformationSet info_set;
@@ -849,7 +1012,7 @@ void vtkPVFileInformation::GetDirectoryListing()
   if (!dir)
   {
     // Could add check of errno here.
-    return;
+    return false;
   }
 
   // Loop through the directory listing.
@@ -866,43 +1029,25 @@ void vtkPVFileInformation::GetDirectoryListing()
     info->Type = INVALID;
     info->SetHiddenFlag();
 
-    vtksys::SystemTools::Stat_t status;
-    int res;
-    if (this->ReadDetailedFileInformation)
-    {
-      // Recover status info
-      res = vtksys::SystemTools::Stat(info->FullPath, &status);
-      if (res != -1)
-      {
-        if (!S_ISDIR(status.st_mode))
-        {
-          std::string::size_type pos = std::string(d->d_name).rfind('.');
-          if (pos != std::string::npos)
-          {
-            std::string ext = std::string(d->d_name).substr(pos + 1);
-            info->SetExtension(ext.c_str());
-          }
-        }
-        info->Size = status.st_size;
-        info->ModificationTime = status.st_mtime;
-      }
-    }
 // fix to bug #09452 such that directories with trailing names can be
 // shown in the file dialog
 #if defined(__SVR4) && defined(__sun)
-    if (!this->ReadDetailedFileInformation)
-    {
-      res = vtksys::SystemTools::Stat(info->FullPath, &status);
-    }
-    if (res != -1 && status.st_mode & S_IFDIR)
+    vtksys::SystemTools::Stat_t status;
+    if (vtksys::SystemTools::Stat(info->FullPath, &status) != -1 && status.st_mode & S_IFDIR)
     {
       info->Type = DIRECTORY;
     }
 #else
-    if (d->d_type & DT_DIR)
+    // The type reported by readdir saves a stat per entry. Links, and entries
+    // of file systems that do not report types, are left to DetectType().
+    if (d->d_type == DT_DIR)
     {
       info->Type = DIRECTORY;
     }
+    else if (d->d_type == DT_REG)
+    {
+      info->Type = SINGLE_FILE;
+    }
 #endif
 
     info->FastFileTypeDetection = this->FastFileTypeDetection;
@@ -915,13 +1060,14 @@ void vtkPVFileInformation::GetDirectoryListing()
 
   // Now we detect the file types for items.
   // We dissolve any groups that contain non-file items.
-
+  std::vector<vtkPVFileInformation*> entries;
+  entries.reserve(info_set.size());
   for (vtkPVFileInformationSet::iterator iter = info_set.begin(); iter != info_set.end(); ++iter)
   {
     vtkPVFileInformation* obj = (*iter);
     if (obj->DetectType())
     {
-      this->Contents->AddItem(obj);
+      entries.push_back(obj);
     }
     else
     {
@@ -932,11 +1078,46 @@ void vtkPVFileInformation::GetDirectoryListing()
           vtkPVFileInformation::SafeDownCast(obj->Contents->GetItemAsObject(cc));
         if (child->DetectType())
         {
-          this->Contents->AddItem(child);
+          entries.push_back(child);
         }
       }
     }
   }
+
+  index.Entries.resize(entries.size());
+  for (size_t cc = 0; cc < entries.size(); ++cc)
+  {
+    vtkPVFileInformation* obj = entries[cc];
+    vtkPVFileInformationIndex::Entry& entry = index.Entries[cc];
+    entry.Name = obj->Name;
+    entry.Type = obj->Type;
+    entry.Hidden = obj->Hidden;
+    if (obj->Type == FILE_GROUP || obj->Type == DIRECTORY_GROUP)
+    {
+      entry.Children.reserve(obj->Contents->GetNumberOfItems());
+      for (int child = 0; child < obj->Contents->GetNumberOfItems(); child++)
+      {
+        vtkPVFileInformation* childObj =
+          vtkPVFileInformation::SafeDownCast(obj->Contents->GetItemAsObject(child));
+        entry.Children.push_back(std::make_pair(childObj->Name, childObj->Type));
+      }
+    }
+  }
+
+  // Sort with the directories first, then by name ignoring the case, so that
+  // pages of the listing are stable.
+  std::sort(index.Entries.begin(), index.Entries.end(),
+    [](const vtkPVFileInformationIndex::Entry& a, const vtkPVFileInformationIndex::Entry& b) {
+      const bool aIsDirectory = IsDirectory(a.Type) || a.Type == DIRECTORY_GROUP;
+      const bool bIsDirectory = IsDirectory(b.Type) || b.Type == DIRECTORY_GROUP;
+      if (aIsDirectory != bIsDirectory)
+      {
+        return aIsDirectory;
+      }
+      const int order = strcasecmp(a.Name.c_str(), b.Name.c_str());
+      return order != 0 ? order < 0 : a.Name < b.Name;
+    });
+  return true;
 #endif
 }
 
@@ -1101,7 +1282,7 @@ void vtkPVFileInformation::CopyToStream(vtkClientServerStream* stream)
 {
   *stream << vtkClientServerStream::Reply << this->Name << this->FullPath << this->Type
           << this->Hidden << this->Contents->GetNumberOfItems() << this->Extension << this->Size
-          << this->ModificationTime;
+          << this->ModificationTime << this->NumberOfEntries;
 
   vtkSmartPointer<vtkCollectionIterator> iter;
   iter.TakeReference(this->Contents->NewIterator());
@@ -1168,11 +1349,16 @@ void vtkPVFileInformation::CopyFromStream(const vtkClientServerStream* css)
     vtkErrorMacro("Error parsing File extension.");
     return;
   }
+  if (!css->GetArgument(0, 8, &this->NumberOfEntries))
+  {
+    vtkErrorMacro("Error parsing Number of entries.");
+    return;
+  }
   for (int cc = 0; cc < num_of_children; cc++)
   {
     vtkPVFileInformation* child = vtkPVFileInformation::New();
     vtkClientServerStream childStream;
-    if (!css->GetArgument(0, 8 + cc, &childStream))
+    if (!css->GetArgument(0, 9 + cc, &childStream))
     {
       vtkErrorMacro("Error parsing child #" << cc);
       return;
@@ -1198,6 +1384,7 @@ void vtkPVFileInformation::Initialize()
 #else
   this->ModificationTime = time(NULL);
 #endif
+  this->NumberOfEntries = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -1264,6 +1451,7 @@ void vtkPVFileInformation::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "Hidden: " << this->Hidden << endl;
   os << indent << "FastFileTypeDetection: " << this->FastFileTypeDetection << endl;
+  os << indent << "NumberOfEntries: " << this->NumberOfEntries << endl;
 
   for (int cc = 0; cc < this->Contents->GetNumberOfItems(); cc++)
   {
@@ -33,6 +33,7 @@
 #include <string> // Needed for std::string
 
 class vtkCollection;
+class vtkPVFileInformationIndex;
 class vtkPVFileInformationSet;
 class vtkFileSequenceParser;
 
@@ -129,6 +130,13 @@ public:
   vtkGetMacro(ModificationTime, time_t);
   //@}
 
+  /**
+   * Get the number of entries of the directory listing. When the listing is
+   * paged with vtkPVFileInformationHelper::SetDirectoryListingPageSize(),
+   * Contents only holds the requested page of these entries.
+   */
+  vtkGetMacro(NumberOfEntries, int);
+
   /**
   * Returns the path to the base data directory path holding various files
   * packaged with ParaView.
@@ -159,6 +167,7 @@ protected:
   char* Extension;         // File extension
   long long Size;          // File size
   time_t ModificationTime; // File modification time
+  int NumberOfEntries;     // Number of entries of the directory listing
 
   vtkSetStringMacro(Extension);
   vtkSetStringMacro(Name);
@@ -167,6 +176,11 @@ protected:
   void GetWindowsDirectoryListing();
   void GetDirectoryListing();
 
+  // Lists the directory and fills the index with its entries, sorted with
+  // directories first and with file sequences grouped. Returns false if the
+  // directory cannot be read.
+  bool BuildDirectoryIndex(vtkPVFileInformationIndex& index);
+
   // Goes thru the collection of vtkPVFileInformation objects
   // are creates file groups, if possible.
   void OrganizeCollection(vtkPVFileInformationSet& vector);
@@ -176,6 +190,8 @@ protected:
   void SetHiddenFlag();
   int FastFileTypeDetection;
   bool ReadDetailedFileInformation;
+  int DirectoryListingOffset;
+  int DirectoryListingPageSize;
 
 private:
   vtkPVFileInformation(const vtkPVFileInformation&) = delete;
@@ -28,6 +28,8 @@ vtkStandardNewMacro(vtkPVFileInformationHelper);
 vtkPVFileInformationHelper::vtkPVFileInformationHelper()
 {
   this->DirectoryListing = 0;
+  this->DirectoryListingOffset = 0;
+  this->DirectoryListingPageSize = 0;
   this->Path = 0;
   this->WorkingDirectory = 0;
   this->SpecialDirectories = 0;
@@ -71,6 +73,8 @@ void vtkPVFileInformationHelper::PrintSelf(ostream& os, vtkIndent indent)
      << "WorkingDirectory: " << (this->WorkingDirectory ? this->WorkingDirectory : "(null)")
      << endl;
   os << indent << "DirectoryListing: " << this->DirectoryListing << endl;
+  os << indent << "DirectoryListingOffset: " << this->DirectoryListingOffset << endl;
+  os << indent << "DirectoryListingPageSize: " << this->DirectoryListingPageSize << endl;
   os << indent << "SpecialDirectories: " << this->SpecialDirectories << endl;
   os << indent << "PathSeparator: " << (this->PathSeparator ? this->PathSeparator : "(null)")
      << endl;
@@ -74,6 +74,21 @@ public:
   vtkBooleanMacro(DirectoryListing, int);
   //@}
 
+  //@{
+  /**
+   * Get/Set the range of entries to return when listing a directory: at most
+   * DirectoryListingPageSize entries, starting with the entry at
+   * DirectoryListingOffset. The whole listing is returned when
+   * DirectoryListingPageSize is 0, which is the default.
+   * vtkPVFileInformation::GetNumberOfEntries() gives the size of the whole
+   * listing. Listings of Windows directories are not paged.
+   */
+  vtkGetMacro(DirectoryListingOffset, int);
+  vtkSetMacro(DirectoryListingOffset, int);
+  vtkGetMacro(DirectoryListingPageSize, int);
+  vtkSetMacro(DirectoryListingPageSize, int);
+  //@}
+
   //@{
   /**
    * Get/Set if the query is for special directories.
@@ -146,6 +161,8 @@ protected:
   char* Path;
   char* WorkingDirectory;
   int DirectoryListing;
+  int DirectoryListingOffset;
+  int DirectoryListingPageSize;
   int SpecialDirectories;
   int FastFileTypeDetection;
 
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestBatchPushClientServer.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Interleaves property pushes and streams executed on the server within
+// batch push blocks and checks that the server processes them in the order
+// they were issued. Run through smTestDriver, which starts pvserver and
+// passes its `-url=cs://<host>:<port>` to the client.
+
+#include "vtkClientServerStream.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVOptions.h"
+#include "vtkProcessModule.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSessionClient.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+
+namespace
+{
+void SetRadiusOnServer(vtkSMSourceProxy* sphere, double radius)
+{
+  vtkClientServerStream stream;
+  stream << vtkClientServerStream::Invoke << VTKOBJECT(sphere) << "SetRadius" << radius
+         << vtkClientServerStream::End;
+  sphere->GetSession()->ExecuteStream(sphere->GetLocation(), stream);
+}
+
+void SetRadius(vtkSMSourceProxy* sphere, double radius)
+{
+  vtkSMPropertyHelper(sphere, "Radius").Set(radius);
+  sphere->UpdateVTKObjects();
+}
+
+double GetRadius(vtkSMSourceProxy* sphere)
+{
+  sphere->MarkModified(nullptr);
+  sphere->UpdatePipeline();
+  vtkNew<vtkPVDataInformation> info;
+  sphere->GatherInformation(info);
+  return info->GetBounds()[5];
+}
+}
+
+int main(int argc, char* argv[])
+{
+  vtkNew<vtkPVOptions> options;
+  vtkInitializationHelper::Initialize(argc, argv, vtkProcessModule::PROCESS_CLIENT, options);
+
+  int exitCode = EXIT_SUCCESS;
+  {
+    vtkNew<vtkSMSessionClient> session;
+    if (options->GetServerURL() == nullptr || !session->Connect(options->GetServerURL()))
+    {
+      cerr << "ERROR: Failed to connect to the server!!!" << endl;
+      vtkInitializationHelper::Finalize();
+      return EXIT_FAILURE;
+    }
+    vtkProcessModule::GetProcessModule()->RegisterSession(session);
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+    vtkSmartPointer<vtkSMSourceProxy> sphere;
+    sphere.TakeReference(
+      vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+    sphere->UpdateVTKObjects();
+
+    try
+    {
+      {
+        vtkSMSession::vtkScopedBatchPush batch(session);
+        SetRadius(sphere, 2.0);
+        SetRadiusOnServer(sphere, 3.0);
+      }
+      if (std::abs(GetRadius(sphere) - 3.0) > 1e-6)
+      {
+        throw "ERROR: Stream executed before the state pushed ahead of it!!!";
+      }
+
+      {
+        vtkSMSession::vtkScopedBatchPush batch(session);
+        SetRadiusOnServer(sphere, 4.0);
+        SetRadius(sphere, 5.0);
+      }
+      if (std::abs(GetRadius(sphere) - 5.0) > 1e-6)
+      {
+        throw "ERROR: State pushed before the stream executed ahead of it!!!";
+      }
+
+      // nested blocks only send their messages when the outermost one ends.
+      {
+        vtkSMSession::vtkScopedBatchPush batch(session);
+        SetRadius(sphere, 6.0);
+        {
+          vtkSMSession::vtkScopedBatchPush nested(session);
+          SetRadiusOnServer(sphere, 7.0);
+        }
+        SetRadius(sphere, 8.0);
+        SetRadiusOnServer(sphere, 9.0);
+      }
+      if (std::abs(GetRadius(sphere) - 9.0) > 1e-6)
+      {
+        throw "ERROR: Nested batch messages processed out of order!!!";
+      }
+    }
+    catch (const char* msg)
+    {
+      cerr << msg << endl;
+      exitCode = EXIT_FAILURE;
+    }
+    sphere = nullptr;
+    vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  }
+  vtkInitializationHelper::Finalize();
+  return exitCode;
+}
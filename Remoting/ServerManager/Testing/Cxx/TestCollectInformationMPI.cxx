@@ -0,0 +1,245 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCollectInformationMPI.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reduces vtkPVDataInformation over all the ranks with
+// vtkPVSessionCore::CollectInformation (a binomial tree) and compares the
+// result against a linear gather to the root merged in rank order, for a
+// data set and a multiblock. Meant to run on a number of ranks that is not a
+// power of two so that some rounds of the tree have ranks without a child.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkClientServerStream.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMPIController.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVCompositeDataInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVDataSetAttributesInformation.h"
+#include "vtkPVSessionCore.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+// Exposes the protected CollectInformation for testing.
+class vtkTestSessionCore : public vtkPVSessionCore
+{
+public:
+  static vtkTestSessionCore* New();
+  vtkTypeMacro(vtkTestSessionCore, vtkPVSessionCore);
+
+  bool Collect(vtkPVInformation* info) { return this->CollectInformation(info); }
+
+protected:
+  vtkTestSessionCore()
+  {
+    // satellites never process RMIs in this test, so don't let the root
+    // trigger a break on destruction.
+    this->SymmetricMPIMode = true;
+  }
+};
+vtkStandardNewMacro(vtkTestSessionCore);
+
+// Points with a rank dependent count and scalar range, one vertex per point.
+vtkSmartPointer<vtkPolyData> MakePolyData(int rank)
+{
+  const vtkIdType numPoints = 100 + 37 * rank;
+  vtkMath::RandomSeed(1234 + rank);
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfComponents(2);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  for (vtkIdType cc = 0; cc < numPoints; ++cc)
+  {
+    points->InsertNextPoint(vtkMath::Random(-rank, 1.0), vtkMath::Random(0.0, 2.0 + rank),
+      vtkMath::Random(-1.0, 1.0));
+    verts->InsertNextCell(1, &cc);
+    scalars->InsertNextTuple2(vtkMath::Random(rank, 2.0 * rank + 1), -rank * cc);
+    ids->InsertNextValue(1000 * rank + cc);
+  }
+
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points);
+  pd->SetVerts(verts);
+  pd->GetPointData()->SetScalars(scalars);
+  pd->GetCellData()->AddArray(ids);
+  return pd;
+}
+
+// The reduction vtkPVSessionCore::CollectInformation used to do: gather every
+// rank's serialized information to the root and merge it in rank order.
+void LinearGather(vtkMultiProcessController* controller, vtkPVInformation* info)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int nranks = controller->GetNumberOfProcesses();
+
+  vtkClientServerStream stream;
+  info->CopyToStream(&stream);
+  const unsigned char* data = nullptr;
+  size_t length = 0;
+  stream.GetData(&data, &length);
+  vtkIdType localLength = static_cast<vtkIdType>(length);
+
+  std::vector<vtkIdType> lengths(nranks);
+  std::vector<vtkIdType> offsets(nranks);
+  controller->Gather(&localLength, &lengths[0], 1, 0);
+  vtkIdType total = 0;
+  for (int pid = 0; rank == 0 && pid < nranks; ++pid)
+  {
+    offsets[pid] = total;
+    total += lengths[pid];
+  }
+  std::vector<unsigned char> buffer(rank == 0 ? total : 1);
+  controller->GatherV(data, &buffer[0], localLength, &lengths[0], &offsets[0], 0);
+
+  for (int pid = 1; rank == 0 && pid < nranks; ++pid)
+  {
+    vtkClientServerStream rcvStream;
+    rcvStream.SetData(&buffer[offsets[pid]], lengths[pid]);
+    vtkSmartPointer<vtkPVInformation> tempInfo;
+    tempInfo.TakeReference(info->NewInstance());
+    tempInfo->CopyFromStream(&rcvStream);
+    info->AddInformation(tempInfo);
+  }
+}
+
+bool CompareAttributes(
+  vtkPVDataSetAttributesInformation* a, vtkPVDataSetAttributesInformation* b, const char* label)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    cerr << label << ": mismatched number of arrays." << endl;
+    return false;
+  }
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    vtkPVArrayInformation* arrayA = a->GetArrayInformation(cc);
+    vtkPVArrayInformation* arrayB = b->GetArrayInformation(arrayA->GetName());
+    if (arrayB == nullptr || arrayA->GetNumberOfComponents() != arrayB->GetNumberOfComponents() ||
+      arrayA->GetNumberOfTuples() != arrayB->GetNumberOfTuples())
+    {
+      cerr << label << ": mismatched array " << arrayA->GetName() << endl;
+      return false;
+    }
+    for (int comp = -1; comp < arrayA->GetNumberOfComponents(); ++comp)
+    {
+      double rangeA[2], rangeB[2];
+      arrayA->GetComponentRange(comp, rangeA);
+      arrayB->GetComponentRange(comp, rangeB);
+      if (rangeA[0] != rangeB[0] || rangeA[1] != rangeB[1])
+      {
+        cerr << label << ": mismatched range for " << arrayA->GetName() << "(" << comp
+             << "): [" << rangeA[0] << ", " << rangeA[1] << "] vs. [" << rangeB[0] << ", "
+             << rangeB[1] << "]" << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CompareInformation(vtkPVDataInformation* a, vtkPVDataInformation* b, const char* label)
+{
+  if (a->GetDataSetType() != b->GetDataSetType() ||
+    a->GetCompositeDataSetType() != b->GetCompositeDataSetType() ||
+    a->GetNumberOfDataSets() != b->GetNumberOfDataSets() ||
+    a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells() || a->GetMemorySize() != b->GetMemorySize())
+  {
+    cerr << label << ": mismatched types or counts." << endl;
+    return false;
+  }
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    if (a->GetBounds()[cc] != b->GetBounds()[cc])
+    {
+      cerr << label << ": mismatched bounds." << endl;
+      return false;
+    }
+  }
+  if (a->GetCompositeDataInformation()->GetNumberOfChildren() !=
+    b->GetCompositeDataInformation()->GetNumberOfChildren())
+  {
+    cerr << label << ": mismatched number of blocks." << endl;
+    return false;
+  }
+  return CompareAttributes(a->GetPointDataInformation(), b->GetPointDataInformation(), label) &&
+    CompareAttributes(a->GetCellDataInformation(), b->GetCellDataInformation(), label);
+}
+
+bool DoTest(vtkMultiProcessController* controller, vtkTestSessionCore* core,
+  vtkDataObject* data, const char* label)
+{
+  vtkNew<vtkPVDataInformation> reduced;
+  reduced->CopyFromObject(data);
+  core->Collect(reduced);
+
+  vtkNew<vtkPVDataInformation> gathered;
+  gathered->CopyFromObject(data);
+  LinearGather(controller, gathered);
+
+  // only the root has the reduced information.
+  int success = 1;
+  if (controller->GetLocalProcessId() == 0)
+  {
+    success = CompareInformation(reduced, gathered, label) ? 1 : 0;
+  }
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::MIN_OP);
+  return allSuccess == 1;
+}
+}
+
+int TestCollectInformationMPI(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const int rank = controller->GetLocalProcessId();
+  const int nranks = controller->GetNumberOfProcesses();
+
+  bool success = true;
+  {
+    vtkNew<vtkTestSessionCore> core;
+    vtkSmartPointer<vtkPolyData> pd = MakePolyData(rank);
+    success = DoTest(controller, core, pd, "vtkPolyData");
+
+    // each rank fills its own block, so blocks must be merged in rank order.
+    vtkNew<vtkMultiBlockDataSet> mb;
+    mb->SetNumberOfBlocks(nranks);
+    mb->SetBlock(rank, pd);
+    success = DoTest(controller, core, mb, "vtkMultiBlockDataSet") && success;
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return success ? TEST_SUCCESS : TEST_FAILED;
+}
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestGatherInformationAsync.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkProcessModule.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+int TestGatherInformationAsync(int argc, char* argv[])
+{
+  (void)argc;
+
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  int exitCode = EXIT_SUCCESS;
+  {
+    vtkNew<vtkSMSession> session;
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+    vtkSmartPointer<vtkSMSourceProxy> sphereSource;
+    sphereSource.TakeReference(
+      vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+    vtkSMPropertyHelper(sphereSource, "ThetaResolution").Set(16);
+    sphereSource->UpdateVTKObjects();
+    sphereSource->UpdatePipeline();
+
+    vtkSmartPointer<vtkSMSourceProxy> coneSource;
+    coneSource.TakeReference(
+      vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "ConeSource")));
+    coneSource->UpdateVTKObjects();
+    coneSource->UpdatePipeline();
+
+    // batch requests for several proxies.
+    std::vector<vtkSMSession::InformationRequest> requests;
+    for (vtkSMSourceProxy* proxy : { sphereSource.GetPointer(), coneSource.GetPointer() })
+    {
+      vtkSMSession::InformationRequest request;
+      request.Location = proxy->GetLocation();
+      request.Information = vtkSmartPointer<vtkPVDataInformation>::New();
+      request.GlobalID = proxy->GetGlobalID();
+      requests.push_back(request);
+    }
+
+    int callbacks = 0;
+    bool result = false;
+    session->GatherInformationAsync(requests, [&](bool status) {
+      ++callbacks;
+      result = status;
+    });
+    session->WaitForInformationRequests();
+
+    try
+    {
+      if (callbacks != 1 || !result || session->GetNumberOfPendingInformationRequests() != 0)
+      {
+        throw "ERROR: Callback not invoked exactly once with success!!!";
+      }
+      for (size_t cc = 0; cc < requests.size(); ++cc)
+      {
+        vtkNew<vtkPVDataInformation> expected;
+        (cc == 0 ? sphereSource : coneSource)->GatherInformation(expected);
+        auto info = vtkPVDataInformation::SafeDownCast(requests[cc].Information);
+        if (info->GetNumberOfPoints() == 0 ||
+          info->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+          info->GetNumberOfCells() != expected->GetNumberOfCells())
+        {
+          throw "ERROR: Information does not match GatherInformation()!!!";
+        }
+      }
+
+      // single request through the proxy API.
+      vtkNew<vtkPVDataInformation> info;
+      callbacks = 0;
+      sphereSource->GatherInformationAsync(info, [&](bool status) {
+        ++callbacks;
+        result = status;
+      });
+      session->WaitForInformationRequests();
+      if (callbacks != 1 || !result || info->GetNumberOfPoints() == 0)
+      {
+        throw "ERROR: vtkSMProxy::GatherInformationAsync failed!!!";
+      }
+
+      // data information of the output ports, refreshed after an update.
+      vtkSMPropertyHelper(sphereSource, "ThetaResolution").Set(32);
+      sphereSource->UpdateVTKObjects();
+      sphereSource->UpdatePipeline();
+      vtkNew<vtkPVDataInformation> expected;
+      sphereSource->GatherInformation(expected);
+      callbacks = 0;
+      vtkIdType numberOfPoints = 0;
+      sphereSource->UpdateDataInformationAsync([&](bool status) {
+        ++callbacks;
+        result = status;
+        numberOfPoints = sphereSource->GetDataInformation()->GetNumberOfPoints();
+      });
+      session->WaitForInformationRequests();
+      if (callbacks != 1 || !result || numberOfPoints != expected->GetNumberOfPoints())
+      {
+        throw "ERROR: vtkSMSourceProxy::UpdateDataInformationAsync failed!!!";
+      }
+    }
+    catch (const char* msg)
+    {
+      cerr << msg << endl;
+      exitCode = EXIT_FAILURE;
+    }
+  }
+  vtkInitializationHelper::Finalize();
+  return exitCode;
+}
@@ -0,0 +1,161 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestGatherInformationAsyncClientServer.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Issues several asynchronous information requests over a client-server
+// connection and waits for their replies. Run through smTestDriver, which
+// starts pvserver and passes its `-url=cs://<host>:<port>` to the client.
+
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVOptions.h"
+#include "vtkProcessModule.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSessionClient.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+  vtkNew<vtkPVOptions> options;
+  vtkInitializationHelper::Initialize(argc, argv, vtkProcessModule::PROCESS_CLIENT, options);
+
+  int exitCode = EXIT_SUCCESS;
+  {
+    vtkNew<vtkSMSessionClient> session;
+    if (options->GetServerURL() == nullptr || !session->Connect(options->GetServerURL()))
+    {
+      cerr << "ERROR: Failed to connect to the server!!!" << endl;
+      vtkInitializationHelper::Finalize();
+      return EXIT_FAILURE;
+    }
+    vtkProcessModule::GetProcessModule()->RegisterSession(session);
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+    const char* names[] = { "SphereSource", "ConeSource", "CylinderSource", "PlaneSource" };
+    std::vector<vtkSmartPointer<vtkSMSourceProxy> > sources;
+    for (const char* name : names)
+    {
+      vtkSmartPointer<vtkSMSourceProxy> source;
+      source.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", name)));
+      source->UpdateVTKObjects();
+      source->UpdatePipeline();
+      sources.push_back(source);
+    }
+
+    // two batches in flight at once, the second one sent right after an
+    // update that changes the information it asks for.
+    std::vector<vtkSMSession::InformationRequest> requests[2];
+    for (size_t cc = 0; cc < sources.size(); ++cc)
+    {
+      vtkSMSession::InformationRequest request;
+      request.Location = sources[cc]->GetLocation();
+      request.Information = vtkSmartPointer<vtkPVDataInformation>::New();
+      request.GlobalID = sources[cc]->GetGlobalID();
+      requests[cc % 2].push_back(request);
+    }
+
+    int callbacks = 0;
+    bool result = true;
+    auto callback = [&](bool status) {
+      ++callbacks;
+      result = result && status;
+    };
+    session->GatherInformationAsync(requests[0], callback);
+    vtkSMPropertyHelper(sources[1], "Resolution").Set(32);
+    sources[1]->UpdateVTKObjects();
+    sources[1]->UpdatePipeline();
+    session->GatherInformationAsync(requests[1], callback);
+    session->WaitForInformationRequests();
+
+    try
+    {
+      if (callbacks != 2 || !result || session->GetNumberOfPendingInformationRequests() != 0)
+      {
+        throw "ERROR: Callbacks not invoked exactly once each with success!!!";
+      }
+      for (size_t cc = 0; cc < sources.size(); ++cc)
+      {
+        vtkNew<vtkPVDataInformation> expected;
+        sources[cc]->GatherInformation(expected);
+        auto info = vtkPVDataInformation::SafeDownCast(requests[cc % 2][cc / 2].Information);
+        if (info->GetNumberOfPoints() == 0 ||
+          info->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+          info->GetNumberOfCells() != expected->GetNumberOfCells())
+        {
+          throw "ERROR: Information does not match GatherInformation()!!!";
+        }
+      }
+
+      // single request through the proxy API.
+      vtkNew<vtkPVDataInformation> info;
+      callbacks = 0;
+      sources[0]->GatherInformationAsync(info, callback);
+      session->WaitForInformationRequests();
+      if (callbacks != 1 || !result || info->GetNumberOfPoints() == 0)
+      {
+        throw "ERROR: vtkSMProxy::GatherInformationAsync failed!!!";
+      }
+
+      // data information of the output ports, available when the callback runs.
+      vtkSMPropertyHelper(sources[3], "XResolution").Set(8);
+      sources[3]->UpdateVTKObjects();
+      sources[3]->UpdatePipeline();
+      vtkNew<vtkPVDataInformation> expected;
+      sources[3]->GatherInformation(expected);
+      callbacks = 0;
+      vtkIdType numberOfPoints = 0;
+      sources[3]->UpdateDataInformationAsync([&](bool status) {
+        callback(status);
+        numberOfPoints = sources[3]->GetDataInformation()->GetNumberOfPoints();
+      });
+      session->WaitForInformationRequests();
+      if (callbacks != 1 || !result || numberOfPoints != expected->GetNumberOfPoints())
+      {
+        throw "ERROR: vtkSMSourceProxy::UpdateDataInformationAsync failed!!!";
+      }
+
+      // a reply for data information invalidated by an update while the
+      // request is in flight must not replace the information of the update.
+      vtkSMPropertyHelper(sources[2], "Resolution").Set(24);
+      sources[2]->UpdateVTKObjects();
+      sources[2]->UpdatePipeline();
+      callbacks = 0;
+      sources[2]->UpdateDataInformationAsync(callback);
+      vtkSMPropertyHelper(sources[2], "Resolution").Set(48);
+      sources[2]->UpdateVTKObjects();
+      sources[2]->UpdatePipeline();
+      session->WaitForInformationRequests();
+      vtkNew<vtkPVDataInformation> updated;
+      sources[2]->GatherInformation(updated);
+      if (callbacks != 1 || !result ||
+        sources[2]->GetDataInformation()->GetNumberOfPoints() != updated->GetNumberOfPoints())
+      {
+        throw "ERROR: Stale data information reply was not dropped!!!";
+      }
+    }
+    catch (const char* msg)
+    {
+      cerr << msg << endl;
+      exitCode = EXIT_FAILURE;
+    }
+    sources.clear();
+    vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  }
+  vtkInitializationHelper::Finalize();
+  return exitCode;
+}
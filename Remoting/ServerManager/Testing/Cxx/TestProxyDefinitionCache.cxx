@@ -0,0 +1,128 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestProxyDefinitionCache.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Times the creation of vtkSIProxyDefinitionManager, which loads the core
+// proxy definitions, without the binary definition cache, when saving the
+// cache and when loading from it, then checks that the definitions loaded
+// from the cache match the parsed ones. Use `--repeat=<N>` to average the
+// times over more runs.
+
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVProxyDefinitionIterator.h"
+#include "vtkPVXMLElement.h"
+#include "vtkProcessModule.h"
+#include "vtkSIProxyDefinitionManager.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+#include <vtksys/Directory.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+vtkSmartPointer<vtkSIProxyDefinitionManager> CreateManager(int repeat, const char* label)
+{
+  vtkSmartPointer<vtkSIProxyDefinitionManager> manager;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (int cc = 0; cc < repeat; ++cc)
+  {
+    manager = vtkSmartPointer<vtkSIProxyDefinitionManager>::New();
+  }
+  timer->StopTimer();
+  cout << label << ": " << timer->GetElapsedTime() / repeat << " s" << endl;
+  return manager;
+}
+}
+
+int TestProxyDefinitionCache(int argc, char* argv[])
+{
+  int repeat = 1;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument(
+    "--repeat", argT::EQUAL_ARGUMENT, &repeat, "Number of times each manager is created.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse() || repeat < 1)
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string cacheDir = std::string(tempDir) + "/TestProxyDefinitionCache";
+  delete[] tempDir;
+  vtksys::SystemTools::RemoveADirectory(cacheDir);
+  vtksys::SystemTools::MakeDirectory(cacheDir);
+
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtksys::SystemTools::PutEnv("PV_PROXY_DEFINITION_CACHE_DIR=");
+  auto parsed = CreateManager(repeat, "parsing XML");
+  vtksys::SystemTools::PutEnv("PV_PROXY_DEFINITION_CACHE_DIR=" + cacheDir);
+  CreateManager(1, "parsing XML and saving the cache");
+  auto cached = CreateManager(repeat, "loading the cache");
+
+  vtksys::Directory directory;
+  directory.Load(cacheDir);
+  int result = TEST_SUCCESS;
+  if (directory.GetNumberOfFiles() != 3)
+  {
+    cerr << "Expected a single cache file in " << cacheDir << endl;
+    result = TEST_FAILED;
+  }
+
+  int count = 0;
+  vtkPVProxyDefinitionIterator* iter =
+    parsed->NewIterator(vtkSIProxyDefinitionManager::CORE_DEFINITIONS);
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal() && result == TEST_SUCCESS;
+       iter->GoToNextItem(), ++count)
+  {
+    const char* group = iter->GetGroupName();
+    const char* name = iter->GetProxyName();
+    vtkPVXMLElement* collapsed = parsed->GetCollapsedProxyDefinition(group, name, nullptr, false);
+    if (collapsed == nullptr)
+    {
+      cerr << "Missing collapsed definition (" << group << ", " << name << ")" << endl;
+      result = TEST_FAILED;
+      break;
+    }
+    if (!iter->GetProxyDefinition()->Equals(cached->GetProxyDefinition(group, name, false)) ||
+      !collapsed->Equals(cached->GetCollapsedProxyDefinition(group, name, nullptr, false)))
+    {
+      cerr << "Mismatched definition (" << group << ", " << name << ")" << endl;
+      result = TEST_FAILED;
+    }
+  }
+  iter->Delete();
+  cout << count << " definitions compared" << endl;
+
+  parsed = nullptr;
+  cached = nullptr;
+  vtksys::SystemTools::PutEnv("PV_PROXY_DEFINITION_CACHE_DIR=");
+  vtksys::SystemTools::RemoveADirectory(cacheDir);
+  vtkInitializationHelper::Finalize();
+  return result;
+}
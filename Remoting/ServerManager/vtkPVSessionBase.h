@@ -47,7 +47,8 @@ public:
     RegisterRemoteObjectEvent = 1234,
     UnRegisterRemoteObjectEvent = 4321,
     ProcessingRemoteEnd = 2143,
-    ConnectionLost = 6789
+    ConnectionLost = 6789,
+    InformationRequestsPendingEvent = 6790
   };
 
   //---------------------------------------------------------------------------
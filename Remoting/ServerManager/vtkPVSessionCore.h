@@ -211,7 +211,10 @@ protected:
   bool GatherInformationInternal(vtkPVInformation* information, vtkTypeUInt32 globalid);
 
   /**
-   * Gather information across MPI satellites.
+   * Gather information across MPI satellites. Information is reduced to the
+   * root using a binomial tree, so intermediate ranks merge partial
+   * information objects. The time spent is recorded in vtkTimerLog (and hence
+   * reported by vtkPVTimerInformation).
    */
   bool CollectInformation(vtkPVInformation*);
 
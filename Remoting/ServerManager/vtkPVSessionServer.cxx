@@ -539,20 +539,13 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
       stream >> string;
       vtkSMMessage msg;
       msg.ParseFromString(string);
+      this->PushStateInternal(&msg);
+    }
+    break;
 
-      //      cout << "=================================" << endl;
-      //      msg.PrintDebugString();
-      //      cout << "=================================" << endl;
-
-      // Do we skip the processing ?
-      if (!this->Internal->StoreShareOnly(&msg))
-      {
-        this->PushState(&msg);
-      }
-
-      // Notify when ProxyManager state has changed
-      // or any other state change
-      this->NotifyOtherClients(&msg);
+    case vtkPVSessionServer::PUSH_BATCH:
+    {
+      this->ProcessBatchPushInternal(stream);
     }
     break;
 
@@ -622,6 +615,74 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
       this->GatherInformationInternal(location, classname.c_str(), globalid, stream);
     }
     break;
+
+    case vtkPVSessionServer::GATHER_INFORMATION_ASYNC:
+    {
+      this->GatherInformationAsyncInternal(stream);
+    }
+    break;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::PushStateInternal(vtkSMMessage* msg)
+{
+  //      cout << "=================================" << endl;
+  //      msg->PrintDebugString();
+  //      cout << "=================================" << endl;
+
+  // Do we skip the processing ?
+  if (!this->Internal->StoreShareOnly(msg))
+  {
+    this->PushState(msg);
+  }
+
+  // Notify when ProxyManager state has changed
+  // or any other state change
+  this->NotifyOtherClients(msg);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::ProcessBatchPushInternal(vtkMultiProcessStream& stream)
+{
+  int size;
+  stream >> size;
+  std::vector<unsigned char> raw_data(size);
+  this->Internal->GetActiveController()->Receive(
+    raw_data.data(), size, 1, vtkPVSessionServer::PUSH_BATCH_TAG);
+  vtkClientServerStream batch;
+  batch.SetData(raw_data.data(), size);
+
+  // Each message holds the type followed by the message's arguments: the
+  // serialized state for PUSH, the ignore_errors flag and the stream to
+  // execute for EXECUTE_STREAM.
+  std::vector<char> state;
+  for (int cc = 0, max = batch.GetNumberOfMessages(); cc < max; ++cc)
+  {
+    int type = 0;
+    batch.GetArgument(cc, 0, &type);
+    if (type == vtkPVSessionServer::PUSH)
+    {
+      vtkTypeUInt32 length = 0;
+      batch.GetArgumentLength(cc, 1, &length);
+      state.resize(length);
+      batch.GetArgument(cc, 1, state.data(), length);
+      vtkSMMessage msg;
+      msg.ParseFromArray(state.data(), static_cast<int>(length));
+      this->PushStateInternal(&msg);
+    }
+    else if (type == vtkPVSessionServer::EXECUTE_STREAM)
+    {
+      int ignore_errors = 0;
+      vtkClientServerStream cssStream;
+      batch.GetArgument(cc, 1, &ignore_errors);
+      batch.GetArgument(cc, 2, &cssStream);
+      this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
+    }
+    else
+    {
+      vtkErrorMacro("Unexpected message in batch: " << type);
+    }
   }
 }
 
@@ -679,6 +740,50 @@ void vtkPVSessionServer::GatherInformationInternal(vtkTypeUInt32 location, const
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::GatherInformationAsyncInternal(vtkMultiProcessStream& stream)
+{
+  vtkTypeUInt32 requestid;
+  int count;
+  stream >> requestid >> count;
+
+  // The first message identifies the request, followed by one message with
+  // the index and the information stream of each request that succeeded.
+  vtkClientServerStream reply;
+  reply << vtkClientServerStream::Reply << requestid << vtkClientServerStream::End;
+  for (int cc = 0; cc < count; ++cc)
+  {
+    std::string classname;
+    vtkTypeUInt32 location, globalid;
+    stream >> location >> classname >> globalid;
+
+    vtkSmartPointer<vtkObjectBase> o;
+    o.TakeReference(vtkClientServerStreamInstantiator::CreateInstance(classname.c_str()));
+    vtkPVInformation* info = vtkPVInformation::SafeDownCast(o);
+    if (!info)
+    {
+      // the parameters of the remaining requests cannot be read without the
+      // information object; they are reported as failed to the client.
+      vtkErrorMacro("Could not create information object: `" << classname << "`.");
+      break;
+    }
+    info->CopyParametersFromStream(stream);
+    this->GatherInformation(location, info, globalid);
+
+    vtkClientServerStream css;
+    info->CopyToStream(&css);
+    reply << vtkClientServerStream::Reply << cc << css << vtkClientServerStream::End;
+  }
+
+  const unsigned char* data;
+  size_t length;
+  reply.GetData(&data, &length);
+  // reply to the requesting client only.
+  vtkMultiProcessController* client = this->Internal->GetActiveController()->GetActiveController();
+  client->TriggerRMI(1, const_cast<unsigned char*>(data), static_cast<int>(length),
+    vtkPVSessionServer::REPLY_GATHER_INFORMATION_ASYNC_RMI);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::OnCloseSessionRMI()
 {
@@ -83,13 +83,17 @@ public:
     REGISTER_SI = 16,
     UNREGISTER_SI = 17,
     LAST_RESULT = 18,
+    GATHER_INFORMATION_ASYNC = 19,
+    PUSH_BATCH = 20,
     SERVER_NOTIFICATION_MESSAGE_RMI = 55624,
     CLIENT_SERVER_MESSAGE_RMI = 55625,
     CLOSE_SESSION = 55626,
     REPLY_GATHER_INFORMATION_TAG = 55627,
     REPLY_PULL = 55628,
     REPLY_LAST_RESULT = 55629,
-    EXECUTE_STREAM_TAG = 55630
+    EXECUTE_STREAM_TAG = 55630,
+    REPLY_GATHER_INFORMATION_ASYNC_RMI = 55631,
+    PUSH_BATCH_TAG = 55632
   };
 
   //@{
@@ -146,6 +150,25 @@ protected:
   void GatherInformationInternal(
     vtkTypeUInt32 location, const char* classname, vtkTypeUInt32 globalid, vtkMultiProcessStream&);
 
+  /**
+   * Called when client triggers GatherInformationAsync(). Gathers all the
+   * requests in the \c stream and sends the results back to the client in a
+   * single REPLY_GATHER_INFORMATION_ASYNC_RMI.
+   */
+  void GatherInformationAsyncInternal(vtkMultiProcessStream& stream);
+
+  /**
+   * Called when client triggers PushState() with the state message.
+   */
+  void PushStateInternal(vtkSMMessage* msg);
+
+  /**
+   * Called when client flushes a batch of PushState() and ExecuteStream()
+   * messages (see vtkSMSession::BeginBatchPush()). Receives the batch and
+   * processes its messages in order.
+   */
+  void ProcessBatchPushInternal(vtkMultiProcessStream& stream);
+
   /**
    * Sends the last result to client.
    */
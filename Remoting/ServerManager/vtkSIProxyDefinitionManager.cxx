@@ -35,13 +35,27 @@
 #include "vtkTimerLog.h"
 
 #include <cassert>
+#include <cstddef>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <vtksys/FStream.hxx>
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#if defined(_WIN32)
+#include <process.h> // _getpid
+#else
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close, getpid
+#endif
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -50,6 +64,75 @@ typedef vtkSmartPointer<vtkPVXMLElement> XMLElement;
 typedef std::map<std::string, XMLElement> StrToXmlMap;
 typedef std::map<std::string, StrToXmlMap> StrToStrToXmlMap;
 
+// Read-only content of a binary definition cache file. The file is mapped in
+// memory where supported, so that the processes of a node share its pages.
+class vtkSIProxyDefinitionCacheFile
+{
+public:
+  vtkSIProxyDefinitionCacheFile()
+    : Begin(nullptr)
+    , End(nullptr)
+    , Mapping(nullptr)
+  {
+  }
+  ~vtkSIProxyDefinitionCacheFile()
+  {
+#if !defined(_WIN32)
+    if (this->Mapping)
+    {
+      munmap(this->Mapping, this->End - this->Begin);
+    }
+#endif
+  }
+
+  bool Open(const std::string& fname)
+  {
+#if defined(_WIN32)
+    vtksys::ifstream file(fname.c_str(), ios::in | ios::binary);
+    if (!file)
+    {
+      return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    this->Buffer = contents.str();
+    this->Begin = this->Buffer.data();
+    this->End = this->Begin + this->Buffer.size();
+#else
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    struct stat status;
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &status) == 0 && status.st_size > 0)
+    {
+      mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+      return false;
+    }
+    this->Mapping = mapping;
+    this->Begin = static_cast<const char*>(mapping);
+    this->End = this->Begin + status.st_size;
+#endif
+    return true;
+  }
+
+  const char* Begin;
+  const char* End;
+
+private:
+  void* Mapping;
+  std::string Buffer;
+
+  vtkSIProxyDefinitionCacheFile(const vtkSIProxyDefinitionCacheFile&) = delete;
+  void operator=(const vtkSIProxyDefinitionCacheFile&) = delete;
+};
+
 class vtkSIProxyDefinitionManager::vtkInternals
 {
 public:
@@ -59,6 +142,16 @@ public:
   StrToStrToXmlMap CoreDefinitions;
   // Keep track of custom definition
   StrToStrToXmlMap CustomsDefinitions;
+  // Core definitions of the binary cache, moved to CoreDefinitions when first
+  // requested.
+  struct CachedDefinition
+  {
+    const char* Begin;
+    const char* End;
+  };
+  typedef std::map<std::string, CachedDefinition> StrToCachedMap;
+  std::map<std::string, StrToCachedMap> CachedDefinitions;
+  std::shared_ptr<vtkSIProxyDefinitionCacheFile> CacheFile;
   //-------------------------------------------------------------------------
   vtkInternals()
     : EnableXMLProxyDefinitionUpdate(true)
@@ -69,11 +162,81 @@ public:
   {
     this->CoreDefinitions.clear();
     this->CustomsDefinitions.clear();
+    this->CachedDefinitions.clear();
+    this->CacheFile.reset();
   }
   //-------------------------------------------------------------------------
   bool HasCoreDefinition(const char* groupName, const char* proxyName)
   {
-    return this->GetProxyElement(this->CoreDefinitions, groupName, proxyName) != NULL;
+    return this->GetProxyElement(this->CoreDefinitions, groupName, proxyName) != NULL ||
+      this->FindCachedDefinition(groupName, proxyName) != NULL;
+  }
+  //-------------------------------------------------------------------------
+  CachedDefinition* FindCachedDefinition(const char* groupName, const char* proxyName)
+  {
+    if (groupName && proxyName)
+    {
+      auto it = this->CachedDefinitions.find(groupName);
+      if (it != this->CachedDefinitions.end())
+      {
+        auto it2 = it->second.find(proxyName);
+        if (it2 != it->second.end())
+        {
+          return &it2->second;
+        }
+      }
+    }
+    return NULL;
+  }
+  //-------------------------------------------------------------------------
+  static XMLElement LoadCachedDefinition(const CachedDefinition& definition)
+  {
+    const char* data = definition.Begin;
+    XMLElement element;
+    element.TakeReference(vtkPVXMLElement::NewFromBinary(&data, definition.End));
+    return element;
+  }
+  //-------------------------------------------------------------------------
+  // Returns the core definition, building it from the binary cache if needed.
+  vtkPVXMLElement* GetCoreElement(const char* groupName, const char* proxyName)
+  {
+    vtkPVXMLElement* element = this->GetProxyElement(this->CoreDefinitions, groupName, proxyName);
+    if (!element)
+    {
+      if (CachedDefinition* definition = this->FindCachedDefinition(groupName, proxyName))
+      {
+        XMLElement loaded = LoadCachedDefinition(*definition);
+        this->CachedDefinitions[groupName].erase(proxyName);
+        if (loaded)
+        {
+          this->CoreDefinitions[groupName][proxyName] = loaded;
+          element = loaded;
+        }
+      }
+    }
+    return element;
+  }
+  //-------------------------------------------------------------------------
+  // Builds all the remaining definitions of the binary cache, for code that
+  // walks CoreDefinitions directly.
+  void LoadCachedDefinitions()
+  {
+    for (const auto& group : this->CachedDefinitions)
+    {
+      for (const auto& proxy : group.second)
+      {
+        StrToXmlMap& definitions = this->CoreDefinitions[group.first];
+        if (definitions.find(proxy.first) == definitions.end())
+        {
+          XMLElement loaded = LoadCachedDefinition(proxy.second);
+          if (loaded)
+          {
+            definitions[proxy.first] = loaded;
+          }
+        }
+      }
+    }
+    this->CachedDefinitions.clear();
   }
   //-------------------------------------------------------------------------
   bool HasCustomDefinition(const char* groupName, const char* proxyName)
@@ -88,6 +251,11 @@ public:
     {
       nbProxy += static_cast<unsigned int>(this->CoreDefinitions[groupName].size());
       nbProxy += static_cast<unsigned int>(this->CustomsDefinitions[groupName].size());
+      auto it = this->CachedDefinitions.find(groupName);
+      if (it != this->CachedDefinitions.end())
+      {
+        nbProxy += static_cast<unsigned int>(it->second.size());
+      }
     }
     return nbProxy;
   }
@@ -97,7 +265,7 @@ public:
     vtkPVXMLElement* elementToReturn = NULL;
 
     // Search in ServerManager definitions
-    elementToReturn = this->GetProxyElement(this->CoreDefinitions, groupName, proxyName);
+    elementToReturn = this->GetCoreElement(groupName, proxyName);
 
     // If not found yet, search in customs ones...
     if (elementToReturn == NULL)
@@ -191,6 +359,81 @@ public:
     }
   }
 };
+//****************************************************************************/
+// Binary definition cache: a header (magic, key of the XML contents, number of
+// definitions and size of the table), a table with the group, name and
+// location of each definition and of its collapsed version, then the
+// definitions saved with vtkPVXMLElement::SaveBinary(). Locations are relative
+// to the end of the table.
+static const char vtkSIProxyDefinitionCacheMagic[8] = { 'P', 'V', 'P', 'D', 'E', 'F', '0', '1' };
+
+template <typename T>
+static void vtkSIProxyDefinitionCacheAppend(std::string& buffer, const T& value)
+{
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void vtkSIProxyDefinitionCacheAppend(std::string& buffer, const std::string& value)
+{
+  vtkSIProxyDefinitionCacheAppend(buffer, static_cast<vtkTypeUInt32>(value.size()));
+  buffer.append(value);
+}
+
+template <typename T>
+static bool vtkSIProxyDefinitionCacheRead(const char*& data, const char* end, T& value)
+{
+  if (end - data < static_cast<std::ptrdiff_t>(sizeof(T)))
+  {
+    return false;
+  }
+  memcpy(&value, data, sizeof(T));
+  data += sizeof(T);
+  return true;
+}
+
+static bool vtkSIProxyDefinitionCacheRead(const char*& data, const char* end, std::string& value)
+{
+  vtkTypeUInt32 size;
+  if (!vtkSIProxyDefinitionCacheRead(data, end, size) ||
+    static_cast<vtkTypeUInt64>(end - data) < size)
+  {
+    return false;
+  }
+  value.assign(data, size);
+  data += size;
+  return true;
+}
+
+// Returns the name of the cache file for the given XML contents, or an empty
+// string if PV_PROXY_DEFINITION_CACHE_DIR is not set.
+static std::string vtkSIProxyDefinitionCacheFileName(
+  const std::vector<std::string>& xmls, vtkTypeUInt64& key)
+{
+  const char* directory = vtksys::SystemTools::GetEnv("PV_PROXY_DEFINITION_CACHE_DIR");
+  if (!directory || !*directory)
+  {
+    return std::string();
+  }
+
+  // FNV-1a hash of the version and of the XML contents.
+  key = 14695981039346656037ull;
+  auto hash = [&key](const char* data, size_t length) {
+    for (size_t cc = 0; cc < length; ++cc)
+    {
+      key = (key ^ static_cast<unsigned char>(data[cc])) * 1099511628211ull;
+    }
+  };
+  hash(PARAVIEW_VERSION_FULL, sizeof(PARAVIEW_VERSION_FULL));
+  for (const std::string& xml : xmls)
+  {
+    hash(xml.c_str(), xml.size() + 1);
+  }
+
+  std::ostringstream fname;
+  fname << directory << "/ProxyDefinitions-" << std::hex << key << ".bin";
+  return fname.str();
+}
+
 //****************************************************************************/
 class vtkInternalDefinitionIterator : public vtkPVProxyDefinitionIterator
 {
@@ -478,8 +721,7 @@ void vtkSIProxyDefinitionManager::AddElement(
   if (element->GetName() && strcmp(element->GetName(), "Extension") == 0)
   {
     // This is an extension for an existing definition.
-    vtkPVXMLElement* coreElem =
-      this->Internals->GetProxyElement(this->Internals->CoreDefinitions, groupName, proxyName);
+    vtkPVXMLElement* coreElem = this->Internals->GetCoreElement(groupName, proxyName);
     if (coreElem)
     {
       // We found it, so we can extend it
@@ -499,6 +741,10 @@ void vtkSIProxyDefinitionManager::AddElement(
   {
     // Just referenced it
     this->Internals->CoreDefinitions[groupName][proxyName] = element;
+    if (this->Internals->FindCachedDefinition(groupName, proxyName))
+    {
+      this->Internals->CachedDefinitions[groupName].erase(proxyName);
+    }
     updated = true;
   }
 
@@ -841,6 +1087,10 @@ vtkPVProxyDefinitionIterator* vtkSIProxyDefinitionManager::NewSingleGroupIterato
 // vtkSIProxyDefinitionManager::CUSTOM_DEFINITIONS = 2
 vtkPVProxyDefinitionIterator* vtkSIProxyDefinitionManager::NewIterator(int scope)
 {
+  if (scope != vtkSIProxyDefinitionManager::CUSTOM_DEFINITIONS)
+  {
+    this->Internals->LoadCachedDefinitions();
+  }
   vtkInternalDefinitionIterator* iterator = vtkInternalDefinitionIterator::New();
   switch (scope)
   {
@@ -861,6 +1111,7 @@ vtkPVProxyDefinitionIterator* vtkSIProxyDefinitionManager::NewIterator(int scope
 void vtkSIProxyDefinitionManager::InvalidateCollapsedDefinition()
 {
   this->InternalsFlatten->CoreDefinitions.clear();
+  this->InternalsFlatten->CachedDefinitions.clear();
 }
 //---------------------------------------------------------------------------
 vtkPVXMLElement* vtkSIProxyDefinitionManager::ExtractSubProxy(
@@ -1119,6 +1370,7 @@ void vtkSIProxyDefinitionManager::Push(vtkSMMessage* msg)
   // proxy definitions on the client side when a server's definitions are
   // loaded. Ideally, we save all proxies that are "client" only. We will do
   // that when we convert this class to use pugixml.
+  this->Internals->LoadCachedDefinitions();
   const auto animationWriters = this->Internals->CoreDefinitions["animation_writers"];
   const auto screenshotWriters = this->Internals->CoreDefinitions["screenshot_writers"];
 
@@ -1191,16 +1443,26 @@ void vtkSIProxyDefinitionManager::HandlePlugin(vtkPVPlugin* plugin)
     // Make sure only the SERVER is processing the XML proxy definition
     if (this->Internals->EnableXMLProxyDefinitionUpdate)
     {
+      // if GetPluginName() == vtkPVInitializerPlugin, it implies that it's
+      // the ParaView core and should not be treated as plugin.
+      const bool isCore = strcmp(plugin->GetPluginName(), "vtkPVInitializerPlugin") == 0;
+      if (isCore && this->LoadDefinitionCache(xmls))
+      {
+        return;
+      }
+
       for (size_t cc = 0; cc < xmls.size(); cc++)
       {
-        this->LoadConfigurationXMLFromString(xmls[cc].c_str(),
-          // if GetPluginName() == vtkPVInitializerPlugin, it implies that it's
-          // the ParaView core and should not be treated as plugin.
-          strcmp(plugin->GetPluginName(), "vtkPVInitializerPlugin") != 0);
+        this->LoadConfigurationXMLFromString(xmls[cc].c_str(), !isCore);
       }
 
       // Make sure we invalidate any cached flatten version of our proxy definition
       this->InternalsFlatten->Clear();
+
+      if (isCore)
+      {
+        this->SaveDefinitionCache(xmls);
+      }
     }
   }
 }
@@ -1287,3 +1549,156 @@ void vtkSIProxyDefinitionManager::EnableXMLProxyDefnitionUpdate(bool enable)
 {
   this->Internals->EnableXMLProxyDefinitionUpdate = enable;
 }
+//----------------------------------------------------------------------------
+bool vtkSIProxyDefinitionManager::LoadDefinitionCache(const std::vector<std::string>& xmls)
+{
+  vtkTypeUInt64 key = 0;
+  const std::string fname = vtkSIProxyDefinitionCacheFileName(xmls, key);
+  auto file = std::make_shared<vtkSIProxyDefinitionCacheFile>();
+  if (fname.empty() || !file->Open(fname))
+  {
+    return false;
+  }
+
+  vtkTimerLog::MarkStartEvent("vtkSIProxyDefinitionManager Load Definition Cache");
+  const char* data = file->Begin;
+  const char* end = file->End;
+  char magic[sizeof(vtkSIProxyDefinitionCacheMagic)];
+  vtkTypeUInt64 fileKey;
+  vtkTypeUInt32 count;
+  vtkTypeUInt64 tableSize;
+  if (!vtkSIProxyDefinitionCacheRead(data, end, magic) ||
+    memcmp(magic, vtkSIProxyDefinitionCacheMagic, sizeof(magic)) != 0 ||
+    !vtkSIProxyDefinitionCacheRead(data, end, fileKey) || fileKey != key ||
+    !vtkSIProxyDefinitionCacheRead(data, end, count) ||
+    !vtkSIProxyDefinitionCacheRead(data, end, tableSize) ||
+    static_cast<vtkTypeUInt64>(end - data) < tableSize)
+  {
+    vtkTimerLog::MarkEndEvent("vtkSIProxyDefinitionManager Load Definition Cache");
+    return false;
+  }
+
+  // Only the table is read now, definitions are built when requested.
+  const char* definitions = data + tableSize;
+  const vtkTypeUInt64 definitionsSize = static_cast<vtkTypeUInt64>(end - definitions);
+  std::map<std::string, vtkInternals::StrToCachedMap> cached;
+  std::map<std::string, vtkInternals::StrToCachedMap> collapsed;
+  for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+  {
+    std::string groupName, proxyName;
+    vtkTypeUInt64 location[4];
+    if (!vtkSIProxyDefinitionCacheRead(data, definitions, groupName) ||
+      !vtkSIProxyDefinitionCacheRead(data, definitions, proxyName) ||
+      !vtkSIProxyDefinitionCacheRead(data, definitions, location) ||
+      location[0] > definitionsSize || location[1] > definitionsSize - location[0] ||
+      location[2] > definitionsSize || location[3] > definitionsSize - location[2])
+    {
+      vtkWarningMacro("Ignoring invalid proxy definition cache " << fname);
+      vtkTimerLog::MarkEndEvent("vtkSIProxyDefinitionManager Load Definition Cache");
+      return false;
+    }
+    vtkInternals::CachedDefinition& definition = cached[groupName][proxyName];
+    definition.Begin = definitions + location[0];
+    definition.End = definition.Begin + location[1];
+    if (location[3] > 0)
+    {
+      vtkInternals::CachedDefinition& collapsedDefinition = collapsed[groupName][proxyName];
+      collapsedDefinition.Begin = definitions + location[2];
+      collapsedDefinition.End = collapsedDefinition.Begin + location[3];
+    }
+  }
+
+  this->Internals->CachedDefinitions.swap(cached);
+  this->Internals->CacheFile = file;
+  this->InternalsFlatten->Clear();
+  this->InternalsFlatten->CachedDefinitions.swap(collapsed);
+  this->InternalsFlatten->CacheFile = file;
+  vtkTimerLog::MarkEndEvent("vtkSIProxyDefinitionManager Load Definition Cache");
+
+  this->InvokeEvent(vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::SaveDefinitionCache(const std::vector<std::string>& xmls)
+{
+  // All processes load the same definitions, a single one saves them.
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkTypeUInt64 key = 0;
+  const std::string fname = vtkSIProxyDefinitionCacheFileName(xmls, key);
+  if (fname.empty() || (pm && pm->GetPartitionId() > 0))
+  {
+    return;
+  }
+
+  vtkTimerLog::MarkStartEvent("vtkSIProxyDefinitionManager Save Definition Cache");
+  std::string table;
+  std::string definitions;
+  vtkTypeUInt32 count = 0;
+  for (const auto& group : this->Internals->CoreDefinitions)
+  {
+    for (const auto& proxy : group.second)
+    {
+      vtkPVXMLElement* definition = proxy.second;
+      if (!definition)
+      {
+        continue;
+      }
+      vtkTypeUInt64 location[4] = { definitions.size(), 0, 0, 0 };
+      definition->SaveBinary(definitions);
+      location[1] = definitions.size() - location[0];
+
+      // Save the collapsed definition as well when the proxy inherits from
+      // another one, unless a base definition is missing since
+      // GetCollapsedProxyDefinition() aborts on that.
+      bool complete = true;
+      for (vtkPVXMLElement* base = definition; base && complete;)
+      {
+        const char* baseGroup = base->GetAttribute("base_proxygroup");
+        const char* baseName = base->GetAttribute("base_proxyname");
+        base = baseGroup && baseName ? this->GetProxyDefinition(baseGroup, baseName, false) : NULL;
+        complete = base != NULL || !baseGroup || !baseName;
+      }
+      vtkPVXMLElement* collapsedDefinition = complete
+        ? this->GetCollapsedProxyDefinition(group.first.c_str(), proxy.first.c_str(), NULL, false)
+        : NULL;
+      if (collapsedDefinition && collapsedDefinition != definition)
+      {
+        location[2] = definitions.size();
+        collapsedDefinition->SaveBinary(definitions);
+        location[3] = definitions.size() - location[2];
+      }
+
+      vtkSIProxyDefinitionCacheAppend(table, group.first);
+      vtkSIProxyDefinitionCacheAppend(table, proxy.first);
+      vtkSIProxyDefinitionCacheAppend(table, location);
+      ++count;
+    }
+  }
+
+  std::string header(vtkSIProxyDefinitionCacheMagic, sizeof(vtkSIProxyDefinitionCacheMagic));
+  vtkSIProxyDefinitionCacheAppend(header, key);
+  vtkSIProxyDefinitionCacheAppend(header, count);
+  vtkSIProxyDefinitionCacheAppend(header, static_cast<vtkTypeUInt64>(table.size()));
+
+  // Write a temporary file then rename it, so that other processes never
+  // read a partial cache.
+  std::ostringstream tmpname;
+#if defined(_WIN32)
+  tmpname << fname << "." << _getpid();
+#else
+  tmpname << fname << "." << getpid();
+#endif
+  bool success;
+  {
+    vtksys::ofstream file(tmpname.str().c_str(), ios::out | ios::binary);
+    success = static_cast<bool>(file) && file.write(header.data(), header.size()) &&
+      file.write(table.data(), table.size()) && file.write(definitions.data(), definitions.size());
+  }
+  if (!success || !vtksys::SystemTools::RenameFile(tmpname.str(), fname))
+  {
+    vtksys::SystemTools::RemoveFile(tmpname.str());
+    vtkWarningMacro("Failed to save the proxy definition cache " << fname);
+  }
+  vtkTimerLog::MarkEndEvent("vtkSIProxyDefinitionManager Save Definition Cache");
+}
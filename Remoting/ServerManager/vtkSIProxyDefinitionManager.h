@@ -37,6 +37,13 @@
  * \li \c vtkCommand::UnRegisterEvent - Fired when a proxy definition is
  * removed. Since this class only support removing custom proxies, this event is
  * fired only when a custom proxy is removed.
+ *
+ * When the PV_PROXY_DEFINITION_CACHE_DIR environment variable names a
+ * directory, the core definitions, along with their collapsed version, are
+ * saved there in a binary cache the first time they are loaded. Later
+ * processes map that file instead of parsing the XML, so that processes
+ * running on the same node share it, and only build the vtkPVXMLElement of a
+ * definition when it is first requested.
 */
 
 #ifndef vtkSIProxyDefinitionManager_h
@@ -45,6 +52,9 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSIObject.h"
 
+#include <string> // for std::string
+#include <vector> // for std::vector
+
 class vtkPVPlugin;
 class vtkPVProxyDefinitionIterator;
 class vtkPVXMLElement;
@@ -321,6 +331,16 @@ protected:
    */
   void InvokeCustomDefitionsUpdated();
 
+  //@{
+  /**
+   * Load the core definitions from the binary cache matching the given XML
+   * contents, or save them into it. LoadDefinitionCache() returns false when
+   * there is no usable cache. See PV_PROXY_DEFINITION_CACHE_DIR.
+   */
+  bool LoadDefinitionCache(const std::vector<std::string>& xmls);
+  void SaveDefinitionCache(const std::vector<std::string>& xmls);
+  //@}
+
 private:
   vtkSIProxyDefinitionManager(const vtkSIProxyDefinitionManager&) = delete;
   void operator=(const vtkSIProxyDefinitionManager&) = delete;
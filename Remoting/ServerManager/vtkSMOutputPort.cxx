@@ -118,6 +118,7 @@ void vtkSMOutputPort::InvalidateDataInformation()
   this->DataInformationValid = false;
   this->ClassNameInformationValid = false;
   this->TemporalDataInformationValid = false;
+  this->DataInformationInvalidationTime.Modified();
 }
 
 //----------------------------------------------------------------------------
@@ -152,6 +152,10 @@ protected:
   vtkPVDataAssemblyInformation* DataAssemblyInformation;
   bool DataInformationValid;
 
+  // Modified by InvalidateDataInformation() so that replies to asynchronous
+  // requests sent before the data information was invalidated are dropped.
+  vtkTimeStamp DataInformationInvalidationTime;
+
   vtkPVTemporalDataInformation* TemporalDataInformation;
   bool TemporalDataInformationValid;
 
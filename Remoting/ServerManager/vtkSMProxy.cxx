@@ -864,6 +864,33 @@ bool vtkSMProxy::GatherInformation(vtkPVInformation* information)
   return false;
 }
 
+//---------------------------------------------------------------------------
+void vtkSMProxy::GatherInformationAsync(
+  vtkPVInformation* information, std::function<void(bool status)> callback)
+{
+  assert(information);
+
+  vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "%s: gather information %s (async)",
+    this->GetLogNameOrDefault(), information->GetClassName());
+
+  if (this->GetSession() && this->Location != 0)
+  {
+    // ensure that the proxy is created.
+    this->CreateVTKObjects();
+
+    vtkSMSession::InformationRequest request;
+    request.Location = this->Location;
+    request.Information = information;
+    request.GlobalID = this->GetGlobalID();
+    this->GetSession()->GatherInformationAsync(
+      std::vector<vtkSMSession::InformationRequest>(1, request), callback);
+  }
+  else if (callback)
+  {
+    callback(false);
+  }
+}
+
 //---------------------------------------------------------------------------
 bool vtkSMProxy::GatherInformation(vtkPVInformation* information, vtkTypeUInt32 location)
 {
@@ -134,6 +134,8 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMRemoteObject.h"
 
+#include <functional> // needed for std::function
+
 struct vtkSMProxyInternals;
 
 class vtkClientServerStream;
@@ -488,6 +490,14 @@ public:
   bool GatherInformation(vtkPVInformation* information, vtkTypeUInt32 location);
   //@}
 
+  /**
+   * Same as GatherInformation() but does not wait for the server to reply;
+   * \c callback is invoked with the status once \c information has been
+   * filled in. See vtkSMSession::GatherInformationAsync().
+   */
+  void GatherInformationAsync(
+    vtkPVInformation* information, std::function<void(bool status)> callback);
+
   /**
    * Saves the state of the proxy. This state can be reloaded
    * to create a new proxy that is identical the present state of this proxy.
@@ -14,12 +14,15 @@
 =========================================================================*/
 #include "vtkSMSILDomain.h"
 
+#include "vtkClientServerStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVSILInformation.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSMIdTypeVectorProperty.h"
 #include "vtkSMProperty.h"
 #include "vtkSMProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkWeakPointer.h"
 
 vtkStandardNewMacro(vtkSMSILDomain);
 //----------------------------------------------------------------------------
@@ -27,6 +30,7 @@ vtkSMSILDomain::vtkSMSILDomain()
 {
   this->SubTree = 0;
   this->SILTimeStamp = 0;
+  this->PendingSILTimeStamp = 0;
   this->SIL = vtkPVSILInformation::New();
 }
 
@@ -80,6 +84,41 @@ vtkGraph* vtkSMSILDomain::GetSIL()
   return this->SIL->GetSIL();
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSILDomain::Update(vtkSMProperty* requestingProperty)
+{
+  this->Superclass::Update(requestingProperty);
+
+  vtkSMIdTypeVectorProperty* timestamp =
+    vtkSMIdTypeVectorProperty::SafeDownCast(this->GetRequiredProperty("TimeStamp"));
+  if (timestamp == nullptr || timestamp->GetNumberOfElements() == 0)
+  {
+    return;
+  }
+
+  const vtkIdType silTimeStamp = timestamp->GetElement(0);
+  if (silTimeStamp <= this->SILTimeStamp || silTimeStamp <= this->PendingSILTimeStamp)
+  {
+    return;
+  }
+
+  this->PendingSILTimeStamp = silTimeStamp;
+  auto sil = vtkSmartPointer<vtkPVSILInformation>::New();
+  vtkWeakPointer<vtkSMSILDomain> self(this);
+  timestamp->GetParent()->GatherInformationAsync(sil, [self, sil, silTimeStamp](bool status) {
+    // GetSIL() may have fetched the same or a newer SIL in the meantime.
+    if (!status || !self || silTimeStamp <= self->SILTimeStamp)
+    {
+      return;
+    }
+    vtkClientServerStream stream;
+    sil->CopyToStream(&stream);
+    self->SIL->CopyFromStream(&stream);
+    self->SILTimeStamp = silTimeStamp;
+    self->DomainModified();
+  });
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSILDomain::PrintSelf(ostream& os, vtkIndent indent)
 {
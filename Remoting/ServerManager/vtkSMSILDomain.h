@@ -73,6 +73,13 @@ public:
    */
   int SetDefaultValues(vtkSMProperty*, bool) override { return 1; }
 
+  /**
+   * Overridden to fetch the SIL without blocking when the TimeStamp required
+   * property reports a newer SIL than the one fetched. DomainModifiedEvent is
+   * fired once the SIL arrives.
+   */
+  void Update(vtkSMProperty* requestingProperty) override;
+
 protected:
   /**
    * Set the appropriate ivars from the xml element. Should
@@ -89,6 +96,7 @@ protected:
   char* SubTree;
   vtkPVSILInformation* SIL;
   vtkIdType SILTimeStamp;
+  vtkIdType PendingSILTimeStamp;
 
 private:
   vtkSMSILDomain(const vtkSMSILDomain&) = delete;
@@ -17,6 +17,7 @@
 #include "vtkCommand.h"
 #include "vtkDebugLeaks.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVInformation.h"
 #include "vtkPVCatalystSessionCore.h"
 #include "vtkPVServerInformation.h"
 #include "vtkPVSessionCore.h"
@@ -72,6 +73,7 @@ vtkSMSession::vtkSMSession(
   this->SessionProxyManager = NULL;
   this->StateLocator = vtkSMStateLocator::New();
   this->IsAutoMPI = false;
+  this->BatchPushDepth = 0;
 
   // Create and setup deserializer for the local ProxyLocator
   vtkNew<vtkSMDeserializerProtobuf> deserializer;
@@ -216,10 +218,67 @@ bool vtkSMSession::IsMPIInitialized(vtkTypeUInt32)
   return vtkProcessModule::GetProcessModule()->IsMPIInitialized();
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSession::GatherInformationAsync(
+  const std::vector<InformationRequest>& requests, InformationCallback callback)
+{
+  // everything is local, gather right away.
+  bool status = true;
+  for (const InformationRequest& request : requests)
+  {
+    status = this->GatherInformation(request.Location, request.Information, request.GlobalID) &&
+      status;
+  }
+  if (callback)
+  {
+    callback(status);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSession::BeginBatchPush()
+{
+  this->BatchPushDepth++;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSession::EndBatchPush()
+{
+  if (this->BatchPushDepth <= 0)
+  {
+    vtkErrorMacro("EndBatchPush() called without matching BeginBatchPush().");
+    return;
+  }
+  if (--this->BatchPushDepth == 0)
+  {
+    this->FlushBatchPush();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSMSession::vtkScopedBatchPush::vtkScopedBatchPush(vtkSMSession* session)
+  : Session(session)
+{
+  if (this->Session)
+  {
+    this->Session->BeginBatchPush();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSMSession::vtkScopedBatchPush::~vtkScopedBatchPush()
+{
+  if (this->Session)
+  {
+    this->Session->EndBatchPush();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSession::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "InBatchPush: " << this->GetInBatchPush() << endl;
 }
 
 //----------------------------------------------------------------------------
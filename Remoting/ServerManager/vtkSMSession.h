@@ -26,6 +26,9 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSmartPointer.h"                // needed for vtkSmartPointer.
 
+#include <functional> // needed for std::function
+#include <vector>     // needed for std::vector
+
 class vtkProcessModuleAutoMPI;
 class vtkSMCollaborationManager;
 class vtkSMProxyLocator;
@@ -85,6 +88,97 @@ public:
    */
   virtual bool IsMPIInitialized(vtkTypeUInt32 servers);
 
+  //---------------------------------------------------------------------------
+  // API for asynchronous information gathering
+  //---------------------------------------------------------------------------
+
+  /**
+   * A request for GatherInformationAsync(): gather \c Information about the
+   * object identified by \c GlobalID from the processes in \c Location.
+   */
+  struct InformationRequest
+  {
+    vtkTypeUInt32 Location;
+    vtkSmartPointer<vtkPVInformation> Information;
+    vtkTypeUInt32 GlobalID;
+  };
+
+  /**
+   * Callback invoked once all requests passed to GatherInformationAsync() have
+   * been filled in. \c status is false if any of them failed.
+   */
+  using InformationCallback = std::function<void(bool status)>;
+
+  /**
+   * Gathers several information objects without waiting for the server to
+   * reply. All requests sent to the same server are batched into a single
+   * message. For remote sessions, \c callback is invoked when the replies are
+   * processed, either by the application's network event processing (see
+   * vtkNetworkAccessManager::ProcessEvents) or by
+   * WaitForInformationRequests(). InformationRequestsPendingEvent is fired
+   * when requests are left waiting for replies. The implementation provided
+   * gathers the information immediately and invokes \c callback before
+   * returning.
+   */
+  virtual void GatherInformationAsync(
+    const std::vector<InformationRequest>& requests, InformationCallback callback);
+
+  /**
+   * Returns the number of GatherInformationAsync() calls whose callback has
+   * not been invoked yet.
+   */
+  virtual int GetNumberOfPendingInformationRequests() { return 0; }
+
+  /**
+   * Blocks until the callbacks of all pending GatherInformationAsync() calls
+   * have been invoked.
+   */
+  virtual void WaitForInformationRequests() {}
+
+  //---------------------------------------------------------------------------
+  // API for batching state updates
+  //---------------------------------------------------------------------------
+
+  //@{
+  /**
+   * Within a BeginBatchPush()/EndBatchPush() block, the messages sent to the
+   * server(s) by PushState() and ExecuteStream() are accumulated and sent as a
+   * single message when the outermost block ends, saving a network round trip
+   * per message. Blocks can be nested. Calls needing a reply from the server,
+   * such as PullState() or GatherInformation(), send the accumulated messages
+   * first so the server processes all messages in the order they were issued.
+   * Builtin sessions have nothing to batch.
+   */
+  void BeginBatchPush();
+  void EndBatchPush();
+  bool GetInBatchPush() const { return this->BatchPushDepth > 0; }
+  //@}
+
+  /**
+   * Sends the messages accumulated in the current batch right away. The
+   * implementation provided does nothing.
+   */
+  virtual void FlushBatchPush() {}
+
+  /**
+   * Helper class to call BeginBatchPush() in constructor and EndBatchPush() in
+   * destructor.
+   * @code
+   * {
+   *    vtkSMSession::vtkScopedBatchPush batch(session);
+   *    ...
+   * }
+   * @endcode
+   */
+  class VTKREMOTINGSERVERMANAGER_EXPORT vtkScopedBatchPush
+  {
+    vtkSmartPointer<vtkSMSession> Session;
+
+  public:
+    vtkScopedBatchPush(vtkSMSession* session);
+    ~vtkScopedBatchPush();
+  };
+
   //---------------------------------------------------------------------------
   // API for Proxy Finder/ReNew
   //---------------------------------------------------------------------------
@@ -287,6 +381,8 @@ protected:
 
   bool IsAutoMPI;
 
+  int BatchPushDepth;
+
 private:
   vtkSMSession(const vtkSMSession&) = delete;
   void operator=(const vtkSMSession&) = delete;
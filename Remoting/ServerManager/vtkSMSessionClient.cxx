@@ -23,6 +23,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVConfig.h"
+#include "vtkPVInformation.h"
 #include "vtkPVMultiClientsInformation.h"
 #include "vtkPVOptions.h"
 #include "vtkPVProgressHandler.h"
@@ -46,8 +47,12 @@
 #include <string>
 #include <vtksys/RegularExpression.hxx>
 
+#include <algorithm>
 #include <assert.h>
+#include <map>
 #include <set>
+#include <utility>
+#include <vector>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -60,6 +65,46 @@ void RMICallback(
   vtkSMSessionClient* self = reinterpret_cast<vtkSMSessionClient*>(localArg);
   self->OnServerNotificationMessageRMI(remoteArg, remoteArgLength);
 }
+
+void GatherInformationAsyncReplyCallback(
+  void* localArg, void* remoteArg, int remoteArgLength, int vtkNotUsed(remoteProcessId))
+{
+  vtkSMSessionClient* self = reinterpret_cast<vtkSMSessionClient*>(localArg);
+  self->OnGatherInformationAsyncReplyRMI(remoteArg, remoteArgLength);
+}
+
+// Batched messages are flushed once they exceed this size so that a large
+// state does not have to be buffered entirely.
+const size_t MaximumBatchPushSize = 16 * 1024 * 1024;
+};
+
+//****************************************************************************/
+// Keeps track of the GatherInformationAsync() calls waiting for replies. Each
+// call is a batch which sends one message to each server it targets.
+class vtkSMSessionClient::vtkInformationRequests
+{
+public:
+  struct Batch
+  {
+    std::vector<vtkSMSession::InformationRequest> Requests;
+    // Requests also gathered on the client, the server results are added to.
+    std::vector<bool> AddLocalInformation;
+    vtkSMSession::InformationCallback Callback;
+    int PendingMessages = 0;
+    bool Status = true;
+  };
+
+  struct Message
+  {
+    vtkTypeUInt32 BatchId;
+    vtkMultiProcessController* Controller;
+    // Index of the requests in the batch, in the order sent to the server.
+    std::vector<size_t> Indices;
+  };
+
+  std::map<vtkTypeUInt32, Batch> Batches;
+  std::map<vtkTypeUInt32, Message> Messages;
+  vtkTypeUInt32 NextId = 1;
 };
 //****************************************************************************/
 vtkStandardNewMacro(vtkSMSessionClient);
@@ -92,6 +137,9 @@ vtkSMSessionClient::vtkSMSessionClient()
   // Default value
   this->NoMoreDelete = false;
   this->NotBusy = 0;
+  this->InformationRequests = new vtkInformationRequests();
+  this->DataServerBatchPush = new vtkClientServerStream();
+  this->RenderServerBatchPush = new vtkClientServerStream();
 }
 
 //----------------------------------------------------------------------------
@@ -101,6 +149,13 @@ vtkSMSessionClient::~vtkSMSessionClient()
   {
     this->DataServerController->RemoveAllRMICallbacks(
       vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI);
+    this->DataServerController->RemoveAllRMICallbacks(
+      vtkPVSessionServer::REPLY_GATHER_INFORMATION_ASYNC_RMI);
+  }
+  if (this->RenderServerController)
+  {
+    this->RenderServerController->RemoveAllRMICallbacks(
+      vtkPVSessionServer::REPLY_GATHER_INFORMATION_ASYNC_RMI);
   }
   if (this->GetIsAlive())
   {
@@ -120,6 +175,12 @@ vtkSMSessionClient::~vtkSMSessionClient()
 
   delete this->ServerLastInvokeResult;
   this->ServerLastInvokeResult = NULL;
+  delete this->InformationRequests;
+  this->InformationRequests = NULL;
+  delete this->DataServerBatchPush;
+  this->DataServerBatchPush = NULL;
+  delete this->RenderServerBatchPush;
+  this->RenderServerBatchPush = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -272,6 +333,8 @@ bool vtkSMSessionClient::Connect(const char* url, int timeout)
       vtkCommand::ErrorEvent, this, &vtkSMSessionClient::OnConnectionLost);
     dcontroller->AddRMICallback(
       &RMICallback, this, vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI);
+    dcontroller->AddRMICallback(&GatherInformationAsyncReplyCallback, this,
+      vtkPVSessionServer::REPLY_GATHER_INFORMATION_ASYNC_RMI);
     dcontroller->Delete();
   }
   if (rcontroller)
@@ -281,6 +344,8 @@ bool vtkSMSessionClient::Connect(const char* url, int timeout)
       vtkCommand::WrongTagEvent, this, &vtkSMSessionClient::OnWrongTagEvent);
     rcontroller->GetCommunicator()->AddObserver(
       vtkCommand::ErrorEvent, this, &vtkSMSessionClient::OnConnectionLost);
+    rcontroller->AddRMICallback(&GatherInformationAsyncReplyCallback, this,
+      vtkPVSessionServer::REPLY_GATHER_INFORMATION_ASYNC_RMI);
     rcontroller->Delete();
   }
 
@@ -447,6 +512,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->FlushBatchPush();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -465,6 +531,7 @@ void vtkSMSessionClient::CloseSession()
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PreDisconnection()
 {
+  this->FlushBatchPush();
   this->NoMoreDelete = true;
 }
 
@@ -510,7 +577,28 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   {
     controllers[num_controllers++] = this->RenderServerController;
   }
-  if (num_controllers > 0)
+  if (num_controllers > 0 && this->GetInBatchPush())
+  {
+    const std::string state = message->SerializeAsString();
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->GetBatchPush(controllers[cc])
+        << vtkClientServerStream::Reply << static_cast<int>(vtkPVSessionServer::PUSH)
+        << vtkClientServerStream::InsertArray(state.data(), static_cast<int>(state.size()))
+        << vtkClientServerStream::End;
+    }
+    // as in ExecuteStream(), the server(s) must have received the state
+    // before it is pushed on the client.
+    if ((location & vtkPVSession::CLIENT) != 0)
+    {
+      this->FlushBatchPush();
+    }
+    else
+    {
+      this->FlushBatchPushIfFull();
+    }
+  }
+  else if (num_controllers > 0)
   {
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::PUSH);
@@ -552,13 +640,26 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
         msg.set_share_only(true);
         msg.set_client_id(this->ServerInformation->GetClientId());
 
-        vtkMultiProcessStream stream;
-        stream << static_cast<int>(vtkPVSessionServer::PUSH);
-        stream << msg.SerializeAsString();
-        std::vector<unsigned char> raw_message;
-        stream.GetRawData(raw_message);
-        this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        // keep the shared state in order with the batched messages.
+        if (this->GetInBatchPush())
+        {
+          const std::string state = msg.SerializeAsString();
+          this->GetBatchPush(this->DataServerController)
+            << vtkClientServerStream::Reply << static_cast<int>(vtkPVSessionServer::PUSH)
+            << vtkClientServerStream::InsertArray(state.data(), static_cast<int>(state.size()))
+            << vtkClientServerStream::End;
+          this->FlushBatchPushIfFull();
+        }
+        else
+        {
+          vtkMultiProcessStream stream;
+          stream << static_cast<int>(vtkPVSessionServer::PUSH);
+          stream << msg.SerializeAsString();
+          std::vector<unsigned char> raw_message;
+          stream.GetRawData(raw_message);
+          this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
+            static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        }
       }
       else if (!remoteObject)
       {
@@ -583,6 +684,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PullState(vtkSMMessage* message)
 {
+  this->FlushBatchPush();
   this->StartBusyWork();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
@@ -652,7 +754,27 @@ void vtkSMSessionClient::ExecuteStream(
     controllers[num_controllers++] = this->RenderServerController;
   }
 
-  if (num_controllers > 0)
+  if (num_controllers > 0 && this->GetInBatchPush())
+  {
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->GetBatchPush(controllers[cc])
+        << vtkClientServerStream::Reply << static_cast<int>(vtkPVSessionServer::EXECUTE_STREAM)
+        << static_cast<int>(ignore_errors) << cssstream << vtkClientServerStream::End;
+    }
+    // the stream may invoke methods which communicate with the server(s)
+    // when executed on the client e.g. rendering, so the server(s) must have
+    // received it first.
+    if ((location & vtkPVSession::CLIENT) != 0)
+    {
+      this->FlushBatchPush();
+    }
+    else
+    {
+      this->FlushBatchPushIfFull();
+    }
+  }
+  else if (num_controllers > 0)
   {
     const unsigned char* data;
     size_t size;
@@ -679,9 +801,60 @@ void vtkSMSessionClient::ExecuteStream(
   }
 }
 
+//----------------------------------------------------------------------------
+vtkClientServerStream& vtkSMSessionClient::GetBatchPush(vtkMultiProcessController* controller)
+{
+  return controller == this->DataServerController ? *this->DataServerBatchPush
+                                                  : *this->RenderServerBatchPush;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushBatchPushIfFull()
+{
+  const unsigned char* data;
+  size_t dataServerSize, renderServerSize;
+  this->DataServerBatchPush->GetData(&data, &dataServerSize);
+  this->RenderServerBatchPush->GetData(&data, &renderServerSize);
+  if (dataServerSize > MaximumBatchPushSize || renderServerSize > MaximumBatchPushSize)
+  {
+    this->FlushBatchPush();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushBatchPush()
+{
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  vtkClientServerStream* batches[2] = { this->DataServerBatchPush, this->RenderServerBatchPush };
+  for (int cc = 0; cc < 2; cc++)
+  {
+    if (batches[cc]->GetNumberOfMessages() == 0)
+    {
+      continue;
+    }
+    if (controllers[cc])
+    {
+      const unsigned char* data;
+      size_t size;
+      batches[cc]->GetData(&data, &size);
+
+      vtkMultiProcessStream stream;
+      stream << static_cast<int>(vtkPVSessionServer::PUSH_BATCH) << static_cast<int>(size);
+      std::vector<unsigned char> raw_message;
+      stream.GetRawData(raw_message);
+      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
+        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      controllers[cc]->Send(data, static_cast<int>(size), 1, vtkPVSessionServer::PUSH_BATCH_TAG);
+    }
+    batches[cc]->Reset();
+  }
+}
+
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 location)
 {
+  this->FlushBatchPush();
   this->StartBusyWork();
   location = this->GetRealLocation(location);
 
@@ -730,6 +903,7 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 bool vtkSMSessionClient::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  this->FlushBatchPush();
   this->StartBusyWork();
   if (this->RenderServerController == NULL)
   {
@@ -821,6 +995,202 @@ bool vtkSMSessionClient::GatherInformation(
   return false;
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::GatherInformationAsync(
+  const std::vector<InformationRequest>& requests, InformationCallback callback)
+{
+  this->FlushBatchPush();
+
+  vtkInformationRequests::Batch batch;
+  batch.Requests = requests;
+  batch.Callback = callback;
+  batch.AddLocalInformation.resize(requests.size(), false);
+
+  // Split the requests between the data-server and the render-server.
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  std::vector<size_t> indices[2];
+  std::vector<vtkTypeUInt32> locations(requests.size());
+  for (size_t cc = 0; cc < requests.size(); ++cc)
+  {
+    const InformationRequest& request = requests[cc];
+    const vtkTypeUInt32 location = this->GetRealLocation(request.Location);
+    if ((location & vtkPVSession::CLIENT) != 0)
+    {
+      this->Superclass::GatherInformation(location, request.Information, request.GlobalID);
+      if (request.Information->GetRootOnly())
+      {
+        continue;
+      }
+      batch.AddLocalInformation[cc] = true;
+    }
+
+    locations[cc] = location;
+    if ((location & (vtkPVSession::DATA_SERVER | vtkPVSession::DATA_SERVER_ROOT)) != 0)
+    {
+      indices[0].push_back(cc);
+    }
+    else if ((location & (vtkPVSession::RENDER_SERVER | vtkPVSession::RENDER_SERVER_ROOT)) != 0)
+    {
+      indices[1].push_back(cc);
+    }
+  }
+
+  const vtkTypeUInt32 batchid = this->InformationRequests->NextId++;
+  for (int server = 0; server < 2; ++server)
+  {
+    if (indices[server].empty())
+    {
+      continue;
+    }
+    if (controllers[server] == NULL)
+    {
+      batch.Status = false;
+      continue;
+    }
+
+    const vtkTypeUInt32 requestid = this->InformationRequests->NextId++;
+    vtkMultiProcessStream stream;
+    stream << static_cast<int>(vtkPVSessionServer::GATHER_INFORMATION_ASYNC) << requestid
+           << static_cast<int>(indices[server].size());
+    for (size_t index : indices[server])
+    {
+      vtkPVInformation* information = requests[index].Information;
+      stream << locations[index] << information->GetClassName() << requests[index].GlobalID;
+      information->CopyParametersToStream(stream);
+    }
+    std::vector<unsigned char> raw_message;
+    stream.GetRawData(raw_message);
+    controllers[server]->TriggerRMIOnAllChildren(&raw_message[0],
+      static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+
+    vtkInformationRequests::Message& message = this->InformationRequests->Messages[requestid];
+    message.BatchId = batchid;
+    message.Controller = controllers[server];
+    message.Indices = indices[server];
+    ++batch.PendingMessages;
+  }
+
+  if (batch.PendingMessages == 0)
+  {
+    // nothing to wait for.
+    if (callback)
+    {
+      callback(batch.Status);
+    }
+    return;
+  }
+
+  this->InformationRequests->Batches[batchid] = std::move(batch);
+  this->InvokeEvent(vtkPVSessionBase::InformationRequestsPendingEvent);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::OnGatherInformationAsyncReplyRMI(void* message, int message_length)
+{
+  vtkClientServerStream reply;
+  reply.SetData(reinterpret_cast<const unsigned char*>(message), message_length);
+
+  auto& messages = this->InformationRequests->Messages;
+  vtkTypeUInt32 requestid = 0;
+  auto miter = (reply.GetNumberOfMessages() > 0 && reply.GetArgument(0, 0, &requestid))
+    ? messages.find(requestid)
+    : messages.end();
+  if (miter == messages.end())
+  {
+    vtkErrorMacro("Received reply for an unknown information request.");
+    return;
+  }
+  const std::vector<size_t> indices = miter->second.Indices;
+  auto biter = this->InformationRequests->Batches.find(miter->second.BatchId);
+  messages.erase(miter);
+  assert(biter != this->InformationRequests->Batches.end());
+  vtkInformationRequests::Batch& batch = biter->second;
+
+  // Each message after the first holds the index of a request and its
+  // information stream. Requests the server failed to gather are missing.
+  std::vector<bool> received(indices.size(), false);
+  for (int cc = 1; cc < reply.GetNumberOfMessages(); ++cc)
+  {
+    int index = -1;
+    vtkClientServerStream css;
+    if (!reply.GetArgument(cc, 0, &index) || index < 0 ||
+      index >= static_cast<int>(indices.size()) || !reply.GetArgument(cc, 1, &css))
+    {
+      continue;
+    }
+    const size_t request = indices[index];
+    vtkPVInformation* information = batch.Requests[request].Information;
+    if (batch.AddLocalInformation[request])
+    {
+      vtkPVInformation* tempInfo = information->NewInstance();
+      tempInfo->CopyFromStream(&css);
+      information->AddInformation(tempInfo);
+      tempInfo->Delete();
+    }
+    else
+    {
+      information->CopyFromStream(&css);
+    }
+    received[index] = true;
+  }
+  if (std::find(received.begin(), received.end(), false) != received.end())
+  {
+    vtkErrorMacro("Server failed to gather information.");
+    batch.Status = false;
+  }
+
+  if (--batch.PendingMessages == 0)
+  {
+    // the callback may issue new requests, so forget about this one first.
+    InformationCallback callback = std::move(batch.Callback);
+    const bool status = batch.Status;
+    this->InformationRequests->Batches.erase(biter);
+    if (callback)
+    {
+      callback(status);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkSMSessionClient::GetNumberOfPendingInformationRequests()
+{
+  return static_cast<int>(this->InformationRequests->Batches.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::WaitForInformationRequests()
+{
+  while (!this->InformationRequests->Messages.empty())
+  {
+    // Process RMIs until the replies arrive. Other RMIs, such as server
+    // notifications, are handled along the way.
+    vtkSmartPointer<vtkMultiProcessController> controller =
+      this->InformationRequests->Messages.begin()->second.Controller;
+    if (controller->ProcessRMIs(1, 1) != vtkMultiProcessController::RMI_NO_ERROR)
+    {
+      this->AbortInformationRequests();
+      return;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::AbortInformationRequests()
+{
+  std::map<vtkTypeUInt32, vtkInformationRequests::Batch> batches;
+  std::swap(batches, this->InformationRequests->Batches);
+  this->InformationRequests->Messages.clear();
+  for (auto& item : batches)
+  {
+    if (item.second.Callback)
+    {
+      item.second.Callback(false);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
 {
@@ -829,6 +1199,9 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  // keep the order with the batched messages.
+  this->FlushBatchPush();
+
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
@@ -870,6 +1243,9 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  // keep the order with the batched messages.
+  this->FlushBatchPush();
+
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
@@ -961,18 +1337,19 @@ void vtkSMSessionClient::OnServerNotificationMessageRMI(void* message, int messa
 }
 //-----------------------------------------------------------------------------
 bool vtkSMSessionClient::OnWrongTagEvent(
-  vtkObject* vtkNotUsed(obj), unsigned long vtkNotUsed(event), void* calldata)
+  vtkObject* obj, unsigned long vtkNotUsed(event), void* calldata)
 {
   int tag = -1;
   const char* data = reinterpret_cast<const char*>(calldata);
   const char* ptr = data;
   memcpy(&tag, ptr, sizeof(tag));
 
-  // Just buffer RMI_TAG's
+  // Just buffer RMI_TAG's. Both the data-server and the render-server may
+  // send RMIs (e.g. GatherInformationAsync() replies) so buffer them on the
+  // communicator that received them.
   if (tag == vtkMultiProcessController::RMI_TAG || tag == vtkMultiProcessController::RMI_ARG_TAG)
   {
-    vtkSocketCommunicator::SafeDownCast(this->DataServerController->GetCommunicator())
-      ->BufferCurrentMessage();
+    vtkSocketCommunicator::SafeDownCast(obj)->BufferCurrentMessage();
   }
   else
   {
@@ -988,6 +1365,9 @@ bool vtkSMSessionClient::OnWrongTagEvent(
 void vtkSMSessionClient::OnConnectionLost(
   vtkObject* vtkNotUsed(src), unsigned long vtkNotUsed(event), void* vtkNotUsed(calldata))
 {
+  this->AbortInformationRequests();
+  this->DataServerBatchPush->Reset();
+  this->RenderServerBatchPush->Reset();
   this->InvokeEvent(vtkPVSessionBase::ConnectionLost,
     (void*)"The server had died, please look at the server side for more details.");
 }
@@ -108,6 +108,12 @@ public:
   const vtkClientServerStream& GetLastResult(vtkTypeUInt32 location) override;
   //@}
 
+  /**
+   * Sends the PushState() and ExecuteStream() messages accumulated since
+   * BeginBatchPush() to the server(s), one message per server.
+   */
+  void FlushBatchPush() override;
+
   //@{
   /**
    * When Connect() is waiting for a server to connect back to the client (in
@@ -132,6 +138,20 @@ public:
   bool GatherInformation(
     vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid) override;
 
+  //@{
+  /**
+   * Overridden to send the requests to the server(s) without waiting for the
+   * replies. Requests for the same server are sent in a single message and
+   * the server replies with a single message. The replies are processed when
+   * the application processes network events, see pqServer, or in
+   * WaitForInformationRequests().
+   */
+  void GatherInformationAsync(
+    const std::vector<InformationRequest>& requests, InformationCallback callback) override;
+  int GetNumberOfPendingInformationRequests() override;
+  void WaitForInformationRequests() override;
+  //@}
+
   /**
    * Returns the number of processes on the given server/s. If more than 1
    * server is identified, than it returns the maximum number of processes e.g.
@@ -213,6 +233,7 @@ public:
   vtkTypeUInt32 GetNextChunkGlobalUniqueIdentifier(vtkTypeUInt32 chunkSize) override;
 
   void OnServerNotificationMessageRMI(void* message, int message_length);
+  void OnGatherInformationAsyncReplyRMI(void* message, int message_length);
 
 protected:
   vtkSMSessionClient();
@@ -280,6 +301,28 @@ private:
   int NotBusy;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
+
+  /**
+   * Invokes the callbacks of the pending GatherInformationAsync() calls with
+   * a failure status. Used when the connection is lost.
+   */
+  void AbortInformationRequests();
+
+  class vtkInformationRequests;
+  vtkInformationRequests* InformationRequests;
+
+  //@{
+  /**
+   * Returns the stream accumulating the messages batched for the server of \c
+   * controller, see BeginBatchPush(). FlushBatchPushIfFull() flushes the
+   * batches once they grow too large.
+   */
+  vtkClientServerStream& GetBatchPush(vtkMultiProcessController* controller);
+  void FlushBatchPushIfFull();
+  //@}
+
+  vtkClientServerStream* DataServerBatchPush;
+  vtkClientServerStream* RenderServerBatchPush;
 };
 
 #endif
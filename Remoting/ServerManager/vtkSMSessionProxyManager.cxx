@@ -914,6 +914,7 @@ void vtkSMSessionProxyManager::RegisterProxy(
 void vtkSMSessionProxyManager::UpdateRegisteredProxies(
   const char* groupname, int modified_only /*=1*/)
 {
+  vtkSMSession::vtkScopedBatchPush batch(this->GetSession());
   vtkSMSessionProxyManagerInternals::ProxyGroupType::iterator it =
     this->Internals->RegisteredProxyMap.find(groupname);
   if (it != this->Internals->RegisteredProxyMap.end())
@@ -942,6 +943,7 @@ void vtkSMSessionProxyManager::UpdateRegisteredProxies(int modified_only /*=1*/)
 {
   vtksys::RegularExpression prototypesRe("_prototypes$");
 
+  vtkSMSession::vtkScopedBatchPush batch(this->GetSession());
   vtkSMSessionProxyManagerInternals::ProxyGroupType::iterator it =
     this->Internals->RegisteredProxyMap.begin();
   for (; it != this->Internals->RegisteredProxyMap.end(); it++)
@@ -1242,7 +1244,13 @@ void vtkSMSessionProxyManager::LoadXMLState(
   {
     spLoader = loader;
   }
-  if (spLoader->LoadState(rootElement, keepOriginalIds))
+  bool loaded;
+  {
+    // send the state of the loaded proxies in as few messages as possible.
+    vtkSMSession::vtkScopedBatchPush batch(this->GetSession());
+    loaded = spLoader->LoadState(rootElement, keepOriginalIds);
+  }
+  if (loaded)
   {
     vtkSMProxyManager::LoadStateInformation info;
     info.RootElement = rootElement;
@@ -21,6 +21,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVAlgorithmPortsInformation.h"
 #include "vtkPVArrayInformation.h"
+#include "vtkPVDataAssemblyInformation.h"
 #include "vtkPVDataInformation.h"
 #include "vtkPVDataSetAttributesInformation.h"
 #include "vtkPVXMLElement.h"
@@ -37,6 +38,7 @@
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMStringVectorProperty.h"
 #include "vtkSmartPointer.h"
+#include "vtkWeakPointer.h"
 
 #include <assert.h>
 #include <sstream>
@@ -547,6 +549,88 @@ vtkPVDataInformation* vtkSMSourceProxy::GetDataInformation(unsigned int idx)
   return this->GetOutputPort(idx)->GetDataInformation();
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSourceProxy::UpdateDataInformationAsync(std::function<void(bool status)> callback)
+{
+  this->CreateOutputPorts();
+
+  struct PortRequest
+  {
+    vtkWeakPointer<vtkSMOutputPort> Port;
+    vtkMTimeType InvalidationTime;
+    vtkSmartPointer<vtkPVDataInformation> DataInformation;
+    vtkSmartPointer<vtkPVDataAssemblyInformation> DataAssemblyInformation;
+  };
+  std::vector<PortRequest> portRequests;
+  std::vector<vtkSMSession::InformationRequest> requests;
+  for (auto& item : this->PInternals->OutputPorts)
+  {
+    vtkSMOutputPort* port = item.Port;
+    // ports of a compound proxy are gathered from the sub-proxy producing them.
+    vtkSMSourceProxy* source = port->SourceProxy;
+    if (port->DataInformationValid || source == nullptr)
+    {
+      continue;
+    }
+
+    PortRequest portRequest;
+    portRequest.Port = port;
+    portRequest.InvalidationTime = port->DataInformationInvalidationTime.GetMTime();
+    portRequest.DataInformation = vtkSmartPointer<vtkPVDataInformation>::New();
+    portRequest.DataInformation->Initialize();
+    portRequest.DataInformation->SetPortNumber(port->PortIndex);
+    portRequest.DataAssemblyInformation = vtkSmartPointer<vtkPVDataAssemblyInformation>::New();
+    portRequest.DataAssemblyInformation->Initialize();
+    portRequest.DataAssemblyInformation->SetPortNumber(port->PortIndex);
+    portRequests.push_back(portRequest);
+
+    source->CreateVTKObjects();
+    vtkSMSession::InformationRequest request;
+    request.Location = source->GetLocation();
+    request.GlobalID = source->GetGlobalID();
+    request.Information = portRequest.DataInformation;
+    requests.push_back(request);
+    request.Information = portRequest.DataAssemblyInformation;
+    requests.push_back(request);
+  }
+
+  if (requests.empty() || !this->GetSession())
+  {
+    if (callback)
+    {
+      callback(requests.empty());
+    }
+    return;
+  }
+
+  this->GetSession()->GatherInformationAsync(requests, [portRequests, callback](bool status) {
+    for (const auto& portRequest : portRequests)
+    {
+      vtkSMOutputPort* port = portRequest.Port;
+      if (status && port &&
+        port->DataInformationInvalidationTime.GetMTime() == portRequest.InvalidationTime)
+      {
+        // copy the same way the session fills in the information it gathers.
+        vtkClientServerStream stream;
+        portRequest.DataInformation->CopyToStream(&stream);
+        port->DataInformation->Initialize();
+        port->DataInformation->SetPortNumber(port->PortIndex);
+        port->DataInformation->CopyFromStream(&stream);
+        stream.Reset();
+        portRequest.DataAssemblyInformation->CopyToStream(&stream);
+        port->DataAssemblyInformation->Initialize();
+        port->DataAssemblyInformation->SetPortNumber(port->PortIndex);
+        port->DataAssemblyInformation->CopyFromStream(&stream);
+        port->DataInformationValid = true;
+      }
+    }
+    if (callback)
+    {
+      callback(status);
+    }
+  });
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSourceProxy::InvalidateDataInformation()
 {
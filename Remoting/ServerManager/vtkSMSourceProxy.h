@@ -142,6 +142,16 @@ public:
   vtkPVDataInformation* GetDataInformation(unsigned int outputIdx);
   //@}
 
+  /**
+   * Gathers the data information of all output ports whose data information
+   * is not valid without waiting for the server to reply. All ports are
+   * gathered in a single batch, see vtkSMSession::GatherInformationAsync().
+   * Once the replies are processed, GetDataInformation() returns the gathered
+   * information and \c callback, if any, is invoked. Replies for ports
+   * invalidated in the meantime are dropped.
+   */
+  void UpdateDataInformationAsync(std::function<void(bool status)> callback = nullptr);
+
   /**
    * Creates extract selection proxies for each output port if not already
    * created.
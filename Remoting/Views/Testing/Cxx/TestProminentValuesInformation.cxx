@@ -0,0 +1,183 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestProminentValuesInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Collects the prominent values of arrays split in pieces, with and without
+// UseSketch, merges them through streams as done when gathering information
+// from several ranks and compares the results. Use `--values=<N>` to time
+// larger arrays.
+
+#include "vtkAbstractArray.h"
+#include "vtkClientServerStream.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPVProminentValuesInformation.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <cmath>
+#include <set>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+const int NumberOfPieces = 4;
+
+// Gathers the information of each piece into its own object, then merges
+// the serialized objects into the returned one.
+vtkSmartPointer<vtkPVProminentValuesInformation> Gather(
+  const std::vector<vtkSmartPointer<vtkDataArray> >& pieces, bool useSketch, bool force)
+{
+  auto result = vtkSmartPointer<vtkPVProminentValuesInformation>::New();
+  result->SetFieldName(pieces[0]->GetName());
+  result->SetFieldAssociation("Points");
+  result->SetNumberOfComponents(pieces[0]->GetNumberOfComponents());
+  result->SetFraction(1e-3);
+  result->SetUncertainty(0.);
+  result->SetForce(force);
+  result->SetUseSketch(useSketch);
+  result->SetSketchSize(256);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (const auto& piece : pieces)
+  {
+    vtkNew<vtkPVProminentValuesInformation> info;
+    info->DeepCopy(result);
+    info->CopyDistinctValuesFromObject(piece);
+
+    vtkClientServerStream stream;
+    info->CopyToStream(&stream);
+    vtkNew<vtkPVProminentValuesInformation> received;
+    received->CopyFromStream(&stream);
+    result->AddInformation(received);
+  }
+  timer->StopTimer();
+  cout << pieces[0]->GetName() << (useSketch ? " (sketch): " : " (exact): ")
+       << timer->GetElapsedTime() << " s" << endl;
+  return result;
+}
+
+std::set<double> GetValues(vtkPVProminentValuesInformation* info, int component)
+{
+  std::set<double> values;
+  vtkSmartPointer<vtkAbstractArray> array;
+  array.TakeReference(info->GetProminentComponentValues(component));
+  for (vtkIdType cc = 0; array && cc < array->GetNumberOfValues(); ++cc)
+  {
+    values.insert(array->GetVariantValue(cc).ToDouble());
+  }
+  return values;
+}
+}
+
+int TestProminentValuesInformation(int argc, char* argv[])
+{
+  int numberOfValues = 100000;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument(
+    "--values", argT::EQUAL_ARGUMENT, &numberOfValues, "Number of values of each array.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse() || numberOfValues < 1000)
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  // categories: 10 integer values. mixed: 10 values composing 90% of the
+  // array plus a large number of rare values. continuous: random doubles.
+  std::vector<vtkSmartPointer<vtkDataArray> > categories;
+  std::vector<vtkSmartPointer<vtkDataArray> > mixed;
+  std::vector<vtkSmartPointer<vtkDataArray> > continuous;
+  vtkMath::RandomSeed(1234);
+  for (int piece = 0; piece < NumberOfPieces; ++piece)
+  {
+    auto categoriesPiece = vtkSmartPointer<vtkIntArray>::New();
+    categoriesPiece->SetName("categories");
+    auto mixedPiece = vtkSmartPointer<vtkIntArray>::New();
+    mixedPiece->SetName("mixed");
+    auto continuousPiece = vtkSmartPointer<vtkDoubleArray>::New();
+    continuousPiece->SetName("continuous");
+    for (vtkIdType cc = 0; cc < numberOfValues / NumberOfPieces; ++cc)
+    {
+      categoriesPiece->InsertNextValue(static_cast<int>(vtkMath::Random(0.0, 10.0)));
+      mixedPiece->InsertNextValue(vtkMath::Random() < 0.9
+          ? static_cast<int>(vtkMath::Random(0.0, 10.0))
+          : static_cast<int>(vtkMath::Random(100.0, 100.0 + numberOfValues)));
+      continuousPiece->InsertNextValue(vtkMath::Random());
+    }
+    categories.push_back(categoriesPiece);
+    mixed.push_back(mixedPiece);
+    continuous.push_back(continuousPiece);
+  }
+
+  // with few distinct values, the sketch is exact.
+  auto exact = Gather(categories, false, false);
+  auto sketch = Gather(categories, true, false);
+  if (!exact->GetValid() || !sketch->GetValid() || GetValues(exact, 0).size() != 10 ||
+    GetValues(exact, 0) != GetValues(sketch, 0) ||
+    sketch->GetEstimatedNumberOfDistinctValues(0) != 10)
+  {
+    cerr << "Mismatched categorical values." << endl;
+    return TEST_FAILED;
+  }
+
+  // with many distinct values, the frequent values are still found and the
+  // number of distinct values is estimated.
+  sketch = Gather(mixed, true, true);
+  const std::set<double> prominents = GetValues(sketch, 0);
+  for (int value = 0; value < 10; ++value)
+  {
+    if (prominents.count(value) == 0)
+    {
+      cerr << "Missing prominent value " << value << endl;
+      return TEST_FAILED;
+    }
+  }
+  std::set<double> distincts;
+  for (const auto& piece : mixed)
+  {
+    for (vtkIdType cc = 0; cc < piece->GetNumberOfTuples(); ++cc)
+    {
+      distincts.insert(piece->GetComponent(cc, 0));
+    }
+  }
+  const double expected = static_cast<double>(distincts.size());
+  const double estimate = static_cast<double>(sketch->GetEstimatedNumberOfDistinctValues(0));
+  cout << "mixed: " << expected << " distinct values, " << estimate << " estimated" << endl;
+  if (std::abs(estimate - expected) > 0.1 * expected || sketch->GetValid())
+  {
+    cerr << "Incorrect estimate of the number of distinct values." << endl;
+    return TEST_FAILED;
+  }
+
+  // continuous arrays are not discrete.
+  exact = Gather(continuous, false, false);
+  sketch = Gather(continuous, true, false);
+  if (exact->GetValid() || sketch->GetValid() || !GetValues(sketch, 0).empty())
+  {
+    cerr << "Continuous array considered discrete." << endl;
+    return TEST_FAILED;
+  }
+  return TEST_SUCCESS;
+}
@@ -1243,6 +1243,19 @@ void vtkGeometryRepresentation::SetNonlinearSubdivisionLevel(int val)
   this->MarkModified();
 }
 
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::SetCacheStaticMeshSurfaces(bool val)
+{
+  if (vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter))
+  {
+    vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter)->SetCacheStaticMeshSurfaces(val);
+  }
+
+  // since geometry filter needs to execute, we need to mark the representation
+  // modified.
+  this->MarkModified();
+}
+
 //----------------------------------------------------------------------------
 void vtkGeometryRepresentation::SetGenerateFeatureEdges(bool val)
 {
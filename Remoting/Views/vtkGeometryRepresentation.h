@@ -176,6 +176,7 @@ public:
   void SetTriangulate(int);
   void SetNonlinearSubdivisionLevel(int);
   virtual void SetGenerateFeatureEdges(bool);
+  void SetCacheStaticMeshSurfaces(bool);
 
   //***************************************************************************
   // Forwarded to vtkProperty.
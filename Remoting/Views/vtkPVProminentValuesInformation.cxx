@@ -16,11 +16,13 @@
 
 #include "vtkAbstractArray.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkClientServerStream.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkExecutive.h"
@@ -39,9 +41,14 @@
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
 #include <map>
 #include <set>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 #define VTK_MAX_CATEGORICAL_VALS (32)
@@ -49,11 +56,250 @@
 namespace
 {
 typedef std::map<int, std::set<std::vector<vtkVariant> > > vtkInternalDistinctValuesBase;
+
+// HyperLogLog registers are indexed by the first bits of the value hashes:
+// 4096 registers estimate the number of distinct values within about 1.6%.
+const int VTK_PROMINENT_HLL_PRECISION = 12;
+const int VTK_PROMINENT_HLL_SIZE = 1 << VTK_PROMINENT_HLL_PRECISION;
+
+// splitmix64 finalizer.
+vtkTypeUInt64 vtkProminentValuesMix(vtkTypeUInt64 h)
+{
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+// Values are hashed through their double representation so that ranks
+// holding the same values in arrays of different types agree on the hashes.
+template <typename ValueT>
+vtkTypeUInt64 vtkProminentValuesHash(const std::vector<ValueT>& tuple)
+{
+  vtkTypeUInt64 h = 0;
+  for (const ValueT& value : tuple)
+  {
+    double d = static_cast<double>(value);
+    d = d == 0 ? 0.0 : d; // -0 and 0 are the same value.
+    vtkTypeUInt64 bits;
+    memcpy(&bits, &d, sizeof(bits));
+    h = vtkProminentValuesMix(h * 0x9e3779b97f4a7c15ULL + bits);
+  }
+  return h;
+}
+
+template <typename ValueT>
+struct vtkProminentValuesTupleHash
+{
+  size_t operator()(const std::vector<ValueT>& tuple) const
+  {
+    return static_cast<size_t>(vtkProminentValuesHash(tuple));
+  }
+};
+
+// Mergeable summary of the values taken by an array component (or by its
+// tuples). Counts is a Misra-Gries summary: it holds at most SketchSize
+// values and each count underestimates the real count by at most ErrorBound.
+// When ErrorBound is 0, Counts is exact.
+struct vtkProminentValuesSketch
+{
+  std::map<std::vector<vtkVariant>, vtkIdType> Counts;
+  vtkIdType NumberOfValues = 0;
+  vtkIdType ErrorBound = 0;
+  std::vector<unsigned char> Registers;
+
+  vtkProminentValuesSketch()
+    : Registers(VTK_PROMINENT_HLL_SIZE, 0)
+  {
+  }
+
+  void AddHash(vtkTypeUInt64 hash)
+  {
+    const size_t index = static_cast<size_t>(hash >> (64 - VTK_PROMINENT_HLL_PRECISION));
+    hash <<= VTK_PROMINENT_HLL_PRECISION;
+    unsigned char rank = 1;
+    while (rank <= 64 - VTK_PROMINENT_HLL_PRECISION && (hash >> 63) == 0)
+    {
+      hash <<= 1;
+      ++rank;
+    }
+    this->Registers[index] = std::max(this->Registers[index], rank);
+  }
+
+  // Keeps the `capacity` largest counts by subtracting the next largest one
+  // from all counts, which keeps the summary mergeable (Agarwal et al.,
+  // "Mergeable summaries").
+  void Trim(size_t capacity)
+  {
+    if (this->Counts.size() <= capacity)
+    {
+      return;
+    }
+    std::vector<vtkIdType> counts;
+    counts.reserve(this->Counts.size());
+    for (const auto& count : this->Counts)
+    {
+      counts.push_back(count.second);
+    }
+    std::nth_element(counts.begin(), counts.begin() + capacity, counts.end(),
+      std::greater<vtkIdType>());
+    const vtkIdType decrement = counts[capacity];
+    for (auto iter = this->Counts.begin(); iter != this->Counts.end();)
+    {
+      if ((iter->second -= decrement) <= 0)
+      {
+        iter = this->Counts.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+    this->ErrorBound += decrement;
+  }
+
+  void Merge(const vtkProminentValuesSketch& other, size_t capacity)
+  {
+    for (const auto& count : other.Counts)
+    {
+      this->Counts[count.first] += count.second;
+    }
+    this->NumberOfValues += other.NumberOfValues;
+    this->ErrorBound += other.ErrorBound;
+    for (size_t cc = 0; cc < this->Registers.size() && cc < other.Registers.size(); ++cc)
+    {
+      this->Registers[cc] = std::max(this->Registers[cc], other.Registers[cc]);
+    }
+    this->Trim(capacity);
+  }
+
+  double GetNumberOfDistinctValues() const
+  {
+    if (this->ErrorBound == 0)
+    {
+      return static_cast<double>(this->Counts.size());
+    }
+    const double m = VTK_PROMINENT_HLL_SIZE;
+    double sum = 0.0;
+    int zeros = 0;
+    for (unsigned char rank : this->Registers)
+    {
+      sum += std::ldexp(1.0, -rank);
+      zeros += rank == 0 ? 1 : 0;
+    }
+    double estimate = 0.7213 / (1.0 + 1.079 / m) * m * m / sum;
+    if (estimate <= 2.5 * m && zeros > 0)
+    {
+      estimate = m * std::log(m / zeros);
+    }
+    // the summary overflowed: there are more values than it holds.
+    return std::max(estimate, static_cast<double>(this->Counts.size() + 1));
+  }
+};
+
+typedef std::map<int, vtkProminentValuesSketch> vtkProminentValuesSketches;
+
+bool vtkProminentValuesSketchesAreValid(const vtkProminentValuesSketches& sketches, double limit)
+{
+  for (const auto& sketch : sketches)
+  {
+    if (sketch.second.GetNumberOfDistinctValues() > limit)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Counts the values of a component (or the tuples when Component is -1)
+// with typed accessors into a Misra-Gries summary of Capacity values.
+struct vtkProminentValuesSketchWorker
+{
+  int Component;
+  size_t Capacity;
+  vtkProminentValuesSketch* Sketch;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array) const
+  {
+    using ValueT = typename vtkDataArrayAccessor<ArrayT>::APIType;
+    using CountsT =
+      std::unordered_map<std::vector<ValueT>, vtkIdType, vtkProminentValuesTupleHash<ValueT> >;
+
+    vtkDataArrayAccessor<ArrayT> accessor(array);
+    const int first = this->Component < 0 ? 0 : this->Component;
+    const int size = this->Component < 0 ? array->GetNumberOfComponents() : 1;
+    vtkProminentValuesSketch& sketch = *this->Sketch;
+
+    CountsT counts(2 * this->Capacity);
+    std::vector<ValueT> tuple(size);
+    vtkIdType numberOfValues = 0;
+    vtkIdType errorBound = 0;
+    for (vtkIdType t = 0, nt = array->GetNumberOfTuples(); t < nt; ++t)
+    {
+      bool isNaN = false;
+      for (int c = 0; c < size; ++c)
+      {
+        tuple[c] = accessor.Get(t, first + c);
+        isNaN = isNaN || tuple[c] != tuple[c];
+      }
+      if (isNaN)
+      {
+        continue;
+      }
+      ++numberOfValues;
+      sketch.AddHash(vtkProminentValuesHash(tuple));
+
+      auto iter = counts.find(tuple);
+      if (iter != counts.end())
+      {
+        ++iter->second;
+      }
+      else if (counts.size() < this->Capacity)
+      {
+        counts.emplace(tuple, 1);
+      }
+      else
+      {
+        // the summary is full: decrement all counts, dropping the values
+        // that reach zero. Each decrement pays for an earlier increment.
+        ++errorBound;
+        for (auto cit = counts.begin(); cit != counts.end();)
+        {
+          if (--cit->second == 0)
+          {
+            cit = counts.erase(cit);
+          }
+          else
+          {
+            ++cit;
+          }
+        }
+      }
+    }
+
+    std::vector<vtkVariant> key(size);
+    for (const auto& count : counts)
+    {
+      for (int c = 0; c < size; ++c)
+      {
+        key[c] = vtkVariant(count.first[c]);
+      }
+      sketch.Counts[key] += count.second;
+    }
+    sketch.NumberOfValues += numberOfValues;
+    sketch.ErrorBound += errorBound;
+    sketch.Trim(this->Capacity);
+  }
+};
 }
 
 class vtkPVProminentValuesInformation::vtkInternalDistinctValues
   : public vtkInternalDistinctValuesBase
 {
+public:
+  vtkProminentValuesSketches Sketches;
 };
 
 vtkStandardNewMacro(vtkPVProminentValuesInformation);
@@ -69,6 +315,8 @@ vtkPVProminentValuesInformation::vtkPVProminentValuesInformation()
   this->Initialize();
   this->Force = false;
   this->Valid = true;
+  this->UseSketch = false;
+  this->SketchSize = 1024;
 }
 
 //----------------------------------------------------------------------------
@@ -139,8 +387,20 @@ void vtkPVProminentValuesInformation::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << i2 << "None" << endl;
   }
+  if (this->DistinctValues)
+  {
+    for (const auto& sketch : this->DistinctValues->Sketches)
+    {
+      os << i2 << "Sketch " << sketch.first << " (" << sketch.second.Counts.size()
+         << " values counted, error bound " << sketch.second.ErrorBound << ", about "
+         << this->GetEstimatedNumberOfDistinctValues(sketch.first) << " distinct values)"
+         << endl;
+    }
+  }
   os << "Fraction: " << this->Fraction << endl;
   os << "Uncertainty: " << this->Uncertainty << endl;
+  os << "UseSketch: " << this->UseSketch << endl;
+  os << "SketchSize: " << this->SketchSize << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -154,6 +414,7 @@ void vtkPVProminentValuesInformation::SetNumberOfComponents(int numComps)
   if (this->DistinctValues)
   {
     this->DistinctValues->clear();
+    this->DistinctValues->Sketches.clear();
   }
   if (numComps <= 0)
   {
@@ -250,6 +511,8 @@ void vtkPVProminentValuesInformation::DeepCopyParameters(vtkPVProminentValuesInf
   this->Uncertainty = other->Uncertainty;
   this->Force = other->Force;
   this->Valid = other->Valid;
+  this->UseSketch = other->UseSketch;
+  this->SketchSize = other->SketchSize;
 }
 
 //----------------------------------------------------------------------------
@@ -325,12 +588,29 @@ void vtkPVProminentValuesInformation::CopyDistinctValuesFromObject(vtkAbstractAr
   if (this->DistinctValues)
   {
     this->DistinctValues->clear();
+    this->DistinctValues->Sketches.clear();
   }
   else
   {
     this->DistinctValues = new vtkInternalDistinctValues;
   }
   int nc = this->GetNumberOfComponents();
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  if (this->UseSketch && dataArray)
+  {
+    for (int c = (nc > 1 ? -1 : 0); c < nc && c < dataArray->GetNumberOfComponents(); ++c)
+    {
+      vtkProminentValuesSketchWorker worker = { c, static_cast<size_t>(this->SketchSize),
+        &this->DistinctValues->Sketches[c] };
+      if (!vtkArrayDispatch::Dispatch::Execute(dataArray, worker))
+      {
+        worker(dataArray);
+      }
+    }
+    this->Valid = vtkProminentValuesSketchesAreValid(this->DistinctValues->Sketches,
+      this->Force ? this->SketchSize : vtkAbstractArray::MAX_DISCRETE_VALUES);
+    return;
+  }
   vtkNew<vtkVariantArray> cvalues;
   std::vector<vtkVariant> tuple;
   // bool tooManyValues;
@@ -414,7 +694,7 @@ void vtkPVProminentValuesInformation::CopyToStream(vtkClientServerStream* css)
   // Copy parameter values to stream.
   *css << this->PortNumber << std::string(this->FieldAssociation) << std::string(this->FieldName)
        << this->NumberOfComponents << this->Fraction << this->Uncertainty << this->Force
-       << this->Valid;
+       << this->Valid << this->UseSketch << this->SketchSize;
 
   // Now copy results to stream.
   int numberOfDistinctValueComponents =
@@ -440,6 +720,31 @@ void vtkPVProminentValuesInformation::CopyToStream(vtkClientServerStream* css)
     }
   }
 
+  // Sketches are sent as their counted values followed by the HyperLogLog
+  // registers, so their size does not depend on the number of values.
+  int numberOfSketches =
+    static_cast<int>(this->DistinctValues ? this->DistinctValues->Sketches.size() : 0);
+  *css << numberOfSketches;
+  if (numberOfSketches)
+  {
+    for (const auto& sketch : this->DistinctValues->Sketches)
+    {
+      *css << sketch.first << static_cast<vtkTypeInt64>(sketch.second.NumberOfValues)
+           << static_cast<vtkTypeInt64>(sketch.second.ErrorBound)
+           << static_cast<unsigned>(sketch.second.Counts.size());
+      for (const auto& count : sketch.second.Counts)
+      {
+        for (const vtkVariant& value : count.first)
+        {
+          *css << value;
+        }
+        *css << static_cast<vtkTypeInt64>(count.second);
+      }
+      *css << vtkClientServerStream::InsertArray(
+        sketch.second.Registers.data(), static_cast<int>(sketch.second.Registers.size()));
+    }
+  }
+
   *css << vtkClientServerStream::End;
 }
 
@@ -499,6 +804,18 @@ void vtkPVProminentValuesInformation::CopyFromStream(const vtkClientServerStream
     return;
   }
 
+  if (!css->GetArgument(0, pos++, &this->UseSketch))
+  {
+    vtkErrorMacro("Error parsing sketch flag from message.");
+    return;
+  }
+
+  if (!css->GetArgument(0, pos++, &this->SketchSize))
+  {
+    vtkErrorMacro("Error parsing sketch size from message.");
+    return;
+  }
+
   int numberOfDistinctValueComponents;
   if (!css->GetArgument(0, pos++, &numberOfDistinctValueComponents))
   {
@@ -540,7 +857,7 @@ void vtkPVProminentValuesInformation::CopyFromStream(const vtkClientServerStream
       {
         for (int k = 0; k < tupleSize; ++k)
         {
-          if (!css->GetArgument(0, pos, &tuple[k]))
+          if (!css->GetArgument(0, pos++, &tuple[k]))
           {
             vtkErrorMacro("Error decoding the " << k << "-th entry of the " << j
                                                 << "-th unique tuple for component " << i);
@@ -551,6 +868,63 @@ void vtkPVProminentValuesInformation::CopyFromStream(const vtkClientServerStream
       }
     }
   }
+
+  int numberOfSketches;
+  if (!css->GetArgument(0, pos++, &numberOfSketches))
+  {
+    vtkErrorMacro("Error parsing number of sketches from message.");
+    return;
+  }
+  if (this->DistinctValues)
+  {
+    this->DistinctValues->Sketches.clear();
+  }
+  else if (numberOfSketches)
+  {
+    this->DistinctValues = new vtkInternalDistinctValues;
+  }
+  for (int i = 0; i < numberOfSketches; ++i)
+  {
+    int component;
+    vtkTypeInt64 numberOfValues;
+    vtkTypeInt64 errorBound;
+    unsigned numberOfCounts;
+    if (!css->GetArgument(0, pos++, &component) || !css->GetArgument(0, pos++, &numberOfValues) ||
+      !css->GetArgument(0, pos++, &errorBound) || !css->GetArgument(0, pos++, &numberOfCounts))
+    {
+      vtkErrorMacro("Error decoding the header of the " << i << "-th sketch.");
+      return;
+    }
+    vtkProminentValuesSketch& sketch = this->DistinctValues->Sketches[component];
+    sketch.NumberOfValues = static_cast<vtkIdType>(numberOfValues);
+    sketch.ErrorBound = static_cast<vtkIdType>(errorBound);
+    std::vector<vtkVariant> tuple(component < 0 ? this->NumberOfComponents : 1);
+    for (unsigned j = 0; j < numberOfCounts; ++j)
+    {
+      for (size_t k = 0; k < tuple.size(); ++k)
+      {
+        if (!css->GetArgument(0, pos++, &tuple[k]))
+        {
+          vtkErrorMacro("Error decoding the " << j << "-th value of the " << i << "-th sketch.");
+          return;
+        }
+      }
+      vtkTypeInt64 count;
+      if (!css->GetArgument(0, pos++, &count))
+      {
+        vtkErrorMacro("Error decoding the " << j << "-th count of the " << i << "-th sketch.");
+        return;
+      }
+      sketch.Counts[tuple] = static_cast<vtkIdType>(count);
+    }
+    vtkTypeUInt32 length;
+    if (!css->GetArgumentLength(0, pos, &length) || length != sketch.Registers.size() ||
+      !css->GetArgument(0, pos++, sketch.Registers.data(), length))
+    {
+      vtkErrorMacro("Error decoding the registers of the " << i << "-th sketch.");
+      return;
+    }
+  }
 }
 
 #define VTK_PROMINENT_MAGIC_NUMBER 573167
@@ -561,7 +935,7 @@ void vtkPVProminentValuesInformation::CopyParametersToStream(vtkMultiProcessStre
   vtkTypeUInt32 magic_number = VTK_PROMINENT_MAGIC_NUMBER;
   mps << magic_number << this->PortNumber << std::string(this->FieldAssociation)
       << std::string(this->FieldName) << this->NumberOfComponents << this->Fraction
-      << this->Uncertainty << this->Force << this->Valid;
+      << this->Uncertainty << this->Force << this->Valid << this->UseSketch << this->SketchSize;
 }
 
 //-----------------------------------------------------------------------------
@@ -572,7 +946,8 @@ void vtkPVProminentValuesInformation::CopyParametersFromStream(vtkMultiProcessSt
   std::string fieldAssoc;
   std::string fieldName;
   mps >> magic_number >> this->PortNumber >> fieldAssoc >> fieldName >> this->NumberOfComponents >>
-    this->Fraction >> this->Uncertainty >> this->Force >> this->Valid;
+    this->Fraction >> this->Uncertainty >> this->Force >> this->Valid >> this->UseSketch >>
+    this->SketchSize;
   if (magic_number != VTK_PROMINENT_MAGIC_NUMBER)
   {
     vtkErrorMacro("Magic number mismatch.");
@@ -616,6 +991,18 @@ void vtkPVProminentValuesInformation::AddDistinctValues(vtkPVProminentValuesInfo
       this->Valid = false;
     }
   }
+
+  if (!info->DistinctValues->Sketches.empty())
+  {
+    for (const auto& sketch : info->DistinctValues->Sketches)
+    {
+      this->DistinctValues->Sketches[sketch.first].Merge(
+        sketch.second, static_cast<size_t>(this->SketchSize));
+    }
+    this->Valid = this->Valid &&
+      vtkProminentValuesSketchesAreValid(this->DistinctValues->Sketches,
+        this->Force ? this->SketchSize : vtkAbstractArray::MAX_DISCRETE_VALUES);
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -628,6 +1015,44 @@ vtkAbstractArray* vtkPVProminentValuesInformation::GetProminentComponentValues(i
   {
     component = 0;
   }
+  vtkProminentValuesSketches::const_iterator sketchEntry;
+  if (this->DistinctValues &&
+    (sketchEntry = this->DistinctValues->Sketches.find(component)) !=
+      this->DistinctValues->Sketches.end())
+  {
+    // An exact sketch holds all the values; otherwise, keep the values that
+    // may compose at least Fraction of the array.
+    const vtkProminentValuesSketch& sketch = sketchEntry->second;
+    const double threshold =
+      sketch.ErrorBound > 0 ? std::max(this->Fraction, 0.) * sketch.NumberOfValues : 0.;
+    const int nc = (component < 0 ? this->NumberOfComponents : 1);
+    std::vector<const std::vector<vtkVariant>*> prominents;
+    for (const auto& count : sketch.Counts)
+    {
+      if (count.first.size() == static_cast<size_t>(nc) &&
+        count.second + sketch.ErrorBound >= threshold)
+      {
+        prominents.push_back(&count.first);
+      }
+    }
+    if (prominents.empty() ||
+      (!this->Force &&
+        prominents.size() > static_cast<size_t>(vtkAbstractArray::MAX_DISCRETE_VALUES)))
+    {
+      return va;
+    }
+    va = vtkVariantArray::New();
+    va->SetNumberOfComponents(nc);
+    va->Allocate(static_cast<vtkIdType>(prominents.size()) * nc);
+    for (const auto* tuple : prominents)
+    {
+      for (int i = 0; i < nc; ++i)
+      {
+        va->InsertNextValue((*tuple)[i]);
+      }
+    }
+    return va;
+  }
   if (!this->DistinctValues ||
     (compEntry = this->DistinctValues->find(component)) == this->DistinctValues->end() ||
     (nt = static_cast<vtkIdType>(compEntry->second.size())) == 0)
@@ -649,3 +1074,27 @@ vtkAbstractArray* vtkPVProminentValuesInformation::GetProminentComponentValues(i
   }
   return va;
 }
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkPVProminentValuesInformation::GetEstimatedNumberOfDistinctValues(int component)
+{
+  if (component < 0 && this->NumberOfComponents == 1)
+  {
+    component = 0;
+  }
+  if (!this->DistinctValues)
+  {
+    return -1;
+  }
+  auto sketchEntry = this->DistinctValues->Sketches.find(component);
+  if (sketchEntry != this->DistinctValues->Sketches.end())
+  {
+    return static_cast<vtkIdType>(sketchEntry->second.GetNumberOfDistinctValues() + 0.5);
+  }
+  auto compEntry = this->DistinctValues->find(component);
+  if (compEntry != this->DistinctValues->end())
+  {
+    return static_cast<vtkIdType>(compEntry->second.size());
+  }
+  return -1;
+}
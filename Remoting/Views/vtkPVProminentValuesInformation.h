@@ -27,6 +27,13 @@
  * the prominent values are also made available.
  *
  * This class uses vtkAbstractArray::GetProminentComponentValues().
+ *
+ * When UseSketch is on, numeric arrays are instead summarized with a fixed
+ * size sketch: the most frequent values are counted with a heavy hitters
+ * summary of SketchSize entries and the number of distinct values is
+ * estimated with HyperLogLog. Sketches are merged across blocks and ranks
+ * without growing, so the memory and the amount of data sent to the client
+ * do not depend on the number of distinct values in the array.
 */
 
 #ifndef vtkPVProminentValuesInformation_h
@@ -114,6 +121,30 @@ public:
   vtkSetMacro(Force, bool);
   vtkGetMacro(Force, bool);
 
+  //@{
+  /**
+   * Set/get whether numeric arrays are summarized with a fixed size sketch
+   * instead of collecting all their distinct values. Off by default.
+   * Prominent values found by the sketch are the values that may compose
+   * at least Fraction of the array; a value composing more than
+   * 1 / (SketchSize + 1) of the array is always found. With Force on, the
+   * information stays valid as long as the array takes on at most
+   * SketchSize distinct values.
+   */
+  vtkSetMacro(UseSketch, bool);
+  vtkGetMacro(UseSketch, bool);
+  vtkBooleanMacro(UseSketch, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/get the maximum number of values counted by the sketch of each
+   * component. Default is 1024.
+   */
+  vtkSetClampMacro(SketchSize, int, 64, VTK_INT_MAX);
+  vtkGetMacro(SketchSize, int);
+  //@}
+
   //@{
   /**
    * Get the validity of the information. The flag has a meaning after trying to recover
@@ -195,6 +226,13 @@ public:
    */
   vtkAbstractArray* GetProminentComponentValues(int component);
 
+  /**
+   * Returns the number of distinct values of an array component (or of its
+   * tuples when component is -1), estimated when the sketch overflowed, or
+   * -1 when no information is available for the component.
+   */
+  vtkIdType GetEstimatedNumberOfDistinctValues(int component);
+
 protected:
   vtkPVProminentValuesInformation();
   ~vtkPVProminentValuesInformation() override;
@@ -213,6 +251,8 @@ protected:
   double Uncertainty;
   bool Force;
   bool Valid;
+  bool UseSketch;
+  int SketchSize;
   //@}
 
   /// Information results
@@ -14,8 +14,10 @@
 =========================================================================*/
 #include "vtkPVRenderViewSettings.h"
 
+#include "vtkMPIMoveData.h"
 #include "vtkMapper.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVGeometryFilter.h"
 
 #include <cassert>
 
@@ -112,6 +114,70 @@ void vtkPVRenderViewSettings::SetZShift(double val)
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderViewSettings::SetDeliveryMarshallingMode(int mode)
+{
+  if (vtkMPIMoveData::GetMarshallingMode() != mode)
+  {
+    vtkMPIMoveData::SetMarshallingMode(mode);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVRenderViewSettings::GetDeliveryMarshallingMode()
+{
+  return vtkMPIMoveData::GetMarshallingMode();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderViewSettings::SetDeliveryCompressionCodec(int codec)
+{
+  if (vtkMPIMoveData::GetCompressionCodec() != codec)
+  {
+    vtkMPIMoveData::SetCompressionCodec(codec);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVRenderViewSettings::GetDeliveryCompressionCodec()
+{
+  return vtkMPIMoveData::GetCompressionCodec();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderViewSettings::SetDeliveryCompressionLevel(int level)
+{
+  if (vtkMPIMoveData::GetCompressionLevel() != level)
+  {
+    vtkMPIMoveData::SetCompressionLevel(level);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVRenderViewSettings::GetDeliveryCompressionLevel()
+{
+  return vtkMPIMoveData::GetCompressionLevel();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderViewSettings::SetGeometryExtractionConcurrency(int value)
+{
+  if (vtkPVGeometryFilter::GetBlockExecutionConcurrency() != value)
+  {
+    vtkPVGeometryFilter::SetBlockExecutionConcurrency(value);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVRenderViewSettings::GetGeometryExtractionConcurrency()
+{
+  return vtkPVGeometryFilter::GetBlockExecutionConcurrency();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderViewSettings::PrintSelf(ostream& os, vtkIndent indent)
 {
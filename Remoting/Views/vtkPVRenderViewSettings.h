@@ -113,6 +113,39 @@ public:
   vtkGetMacro(EnableFastPreselection, bool);
   //@}
 
+  //@{
+  /**
+   * Choose how geometry is serialized when it is delivered between processes.
+   * Accepted values are vtkMPIMoveData::MarshallingModes. Since this setting
+   * is applied on all processes in the session, it affects data sent from the
+   * data server as well as the client.
+   */
+  void SetDeliveryMarshallingMode(int mode);
+  int GetDeliveryMarshallingMode();
+  //@}
+
+  //@{
+  /**
+   * Choose the codec and level used to compress geometry when it is delivered
+   * between processes. Accepted codecs are vtkMPIMoveData::CompressionCodecs.
+   */
+  void SetDeliveryCompressionCodec(int codec);
+  int GetDeliveryCompressionCodec();
+  void SetDeliveryCompressionLevel(int level);
+  int GetDeliveryCompressionLevel();
+  //@}
+
+  //@{
+  /**
+   * Set the maximum number of blocks of a composite dataset from which
+   * surfaces are extracted concurrently on each process. 1 extracts surfaces
+   * one block at a time, 0 uses all available threads.
+   * See vtkPVGeometryFilter::SetBlockExecutionConcurrency.
+   */
+  void SetGeometryExtractionConcurrency(int value);
+  int GetGeometryExtractionConcurrency();
+  //@}
+
 protected:
   vtkPVRenderViewSettings();
   ~vtkPVRenderViewSettings() override;
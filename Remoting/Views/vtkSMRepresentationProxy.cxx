@@ -33,6 +33,11 @@
 #include <cassert>
 #include <sstream>
 
+namespace
+{
+vtkIdType ProminentValuesSketchThreshold = 10000000;
+}
+
 #define MAX_NUMBER_OF_INTERNAL_REPRESENTATIONS 10
 
 vtkStandardNewMacro(vtkSMRepresentationProxy);
@@ -378,8 +383,16 @@ vtkPVProminentValuesInformation* vtkSMRepresentationProxy::GetProminentValuesInf
     vtkSMPropertyHelper inputHelper(this, "Input");
     vtkSMSourceProxy* input = vtkSMSourceProxy::SafeDownCast(inputHelper.GetAsProxy());
     const unsigned int port = inputHelper.GetOutputPort();
-    if (input &&
-      input->GetDataInformation(port)->GetArrayInformation(name.c_str(), fieldAssoc) != nullptr)
+    const bool onInput = input &&
+      input->GetDataInformation(port)->GetArrayInformation(name.c_str(), fieldAssoc) != nullptr;
+
+    // Large arrays are summarized with a sketch of fixed size.
+    vtkPVDataInformation* dataInfo =
+      onInput ? input->GetDataInformation(port) : this->GetRepresentedDataInformation();
+    this->ProminentValuesInformation->SetUseSketch(ProminentValuesSketchThreshold >= 0 &&
+      dataInfo->GetNumberOfElements(fieldAssoc) > ProminentValuesSketchThreshold);
+
+    if (onInput)
     {
       this->ProminentValuesInformation->SetPortNumber(port);
       input->GatherInformation(this->ProminentValuesInformation);
@@ -398,6 +411,18 @@ vtkPVProminentValuesInformation* vtkSMRepresentationProxy::GetProminentValuesInf
   return this->ProminentValuesInformation;
 }
 
+//----------------------------------------------------------------------------
+void vtkSMRepresentationProxy::SetProminentValuesSketchThreshold(vtkIdType threshold)
+{
+  ProminentValuesSketchThreshold = threshold;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSMRepresentationProxy::GetProminentValuesSketchThreshold()
+{
+  return ProminentValuesSketchThreshold;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMRepresentationProxy::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -117,6 +117,17 @@ public:
     int fieldAssoc, int numComponents, double uncertaintyAllowed = 1e-6, double fraction = 1e-3,
     bool force = false);
 
+  //@{
+  /**
+   * Set/get the number of elements above which GetProminentValuesInformation()
+   * summarizes numeric arrays with a fixed size sketch instead of collecting
+   * all their distinct values (see vtkPVProminentValuesInformation::SetUseSketch).
+   * A negative value always collects the distinct values. Default is 10000000.
+   */
+  static void SetProminentValuesSketchThreshold(vtkIdType threshold);
+  static vtkIdType GetProminentValuesSketchThreshold();
+  //@}
+
   /**
    * Calls Update() on all sources. It also creates output ports if
    * they are not already created.
@@ -81,5 +81,22 @@ int TestCGNSReaderMeshCaching(int argc, char* argv[])
   // vtk_assert(hot_timing < cold_timing);
   cout << "Expected timings: " << hot_timing << " < " << cold_timing << endl;
 
+  // the second update must have been served from the caches.
+  vtk_assert(reader->GetCacheHits() > 0);
+  vtk_assert(reader->GetCacheMemoryUsage() > 0.0);
+  vtk_assert(reader->GetCacheEvictions() == 0);
+
+  // a memory limit evicts least recently used objects, but the output
+  // must not change.
+  reader->SetCacheMemoryLimit(1);
+  reader->ResetCacheStatistics();
+  reader->EnableAllCellArrays();
+  reader->Update();
+  mb = reader->GetOutput();
+  ds = vtkPointSet::SafeDownCast(vtkMultiBlockDataSet::SafeDownCast(mb->GetBlock(0))->GetBlock(0));
+  vtk_assert(ds != nullptr);
+  vtk_assert(ds->GetCellData()->GetArray("Pressure") != nullptr);
+  vtk_assert(reader->GetCacheMemoryUsage() <= 1.0);
+
   return EXIT_SUCCESS;
 }
@@ -18,6 +18,11 @@
  *
  *     store an object in a container with its CGNS path key
  *
+ * The cache evicts the least recently used objects when the memory used by
+ * the cached objects, as reported by their GetActualMemorySize(), exceeds
+ * the memory limit. Each entry records the vtkTimeStamp of its last access
+ * so that the least recently used entries of several caches sharing a
+ * memory budget can be compared (see GetLeastRecentAccessTime()).
  *
  * @par Thanks:
  * Thanks to Mickael Philit
@@ -27,61 +32,120 @@
 #define vtkCGNSCache_h
 
 #include "vtkSmartPointer.h"
+#include "vtkTimeStamp.h"
 
+#include <cstddef>
 #include <iterator>
+#include <list>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 
 namespace CGNSRead
 {
-// No priority and no size limit right now
-
 template <typename CacheDataType>
 class vtkCGNSCache
 {
 public:
   vtkCGNSCache();
 
+  /**
+   * Returns the object cached with the given key, or nullptr. A found object
+   * becomes the most recently used one.
+   */
   vtkSmartPointer<CacheDataType> Find(const std::string& query);
 
+  /**
+   * Adds or replaces the object with the given key, then evicts the least
+   * recently used objects if the memory limit is exceeded.
+   */
   void Insert(const std::string& key, const vtkSmartPointer<CacheDataType>& data);
 
   void ClearCache();
 
-  void SetCacheSizeLimit(int size);
-  int GetCacheSizeLimit();
+  //@{
+  /**
+   * Get/Set the maximum memory, in kibibytes, used by the cached objects. 0
+   * means no limit (default).
+   */
+  void SetMemoryLimit(size_t kibibytes);
+  size_t GetMemoryLimit() const { return this->MemoryLimit; }
+  //@}
+
+  /**
+   * Returns the memory, in kibibytes, used by the cached objects.
+   */
+  size_t GetMemorySize() const { return this->MemorySize; }
+
+  size_t GetNumberOfEntries() const { return this->Entries.size(); }
+
+  /**
+   * Returns the time of the last access to the least recently used object, or
+   * VTK_MTIME_MAX if the cache is empty.
+   */
+  vtkMTimeType GetLeastRecentAccessTime() const;
+
+  /**
+   * Evicts the least recently used object. Returns false if the cache is
+   * empty.
+   */
+  bool EvictLeastRecent();
+
+  //@{
+  /**
+   * Statistics on the use of the cache since its creation or the last call
+   * to ResetStatistics(). ClearCache() does not count as evictions.
+   */
+  vtkTypeInt64 GetNumberOfHits() const { return this->NumberOfHits; }
+  vtkTypeInt64 GetNumberOfMisses() const { return this->NumberOfMisses; }
+  vtkTypeInt64 GetNumberOfEvictions() const { return this->NumberOfEvictions; }
+  void ResetStatistics();
+  //@}
 
 private:
   vtkCGNSCache(const vtkCGNSCache&) = delete;
   void operator=(const vtkCGNSCache&) = delete;
 
-  typedef std::unordered_map<std::string, vtkSmartPointer<CacheDataType> > CacheMapper;
+  struct CacheEntry
+  {
+    std::string Key;
+    vtkSmartPointer<CacheDataType> Data;
+    size_t MemorySize;
+    vtkTimeStamp LastAccess;
+  };
+
+  // Entries, most recently used first.
+  typedef std::list<CacheEntry> CacheList;
+  CacheList Entries;
+
+  typedef std::unordered_map<std::string, typename CacheList::iterator> CacheMapper;
   CacheMapper CacheData;
 
-  typename CacheMapper::iterator LastCacheAccess;
+  size_t MemoryLimit;
+  size_t MemorySize;
 
-  int cacheSizeLimit;
+  vtkTypeInt64 NumberOfHits;
+  vtkTypeInt64 NumberOfMisses;
+  vtkTypeInt64 NumberOfEvictions;
 };
 
 template <typename CacheDataType>
 vtkCGNSCache<CacheDataType>::vtkCGNSCache()
   : CacheData()
 {
-  this->cacheSizeLimit = -1;
-  this->LastCacheAccess = CacheData.end();
-}
-
-template <typename CacheDataType>
-void vtkCGNSCache<CacheDataType>::SetCacheSizeLimit(int size)
-{
-  this->cacheSizeLimit = size;
+  this->MemoryLimit = 0;
+  this->MemorySize = 0;
+  this->ResetStatistics();
 }
 
 template <typename CacheDataType>
-int vtkCGNSCache<CacheDataType>::GetCacheSizeLimit()
+void vtkCGNSCache<CacheDataType>::SetMemoryLimit(size_t kibibytes)
 {
-  return this->cacheSizeLimit;
+  this->MemoryLimit = kibibytes;
+  while (this->MemoryLimit > 0 && this->MemorySize > this->MemoryLimit)
+  {
+    this->EvictLeastRecent();
+  }
 }
 
 template <typename CacheDataType>
@@ -90,30 +154,85 @@ vtkSmartPointer<CacheDataType> vtkCGNSCache<CacheDataType>::Find(const std::stri
   typename CacheMapper::iterator iter;
   iter = this->CacheData.find(query);
   if (iter == this->CacheData.end())
+  {
+    ++this->NumberOfMisses;
     return vtkSmartPointer<CacheDataType>(nullptr);
-  this->LastCacheAccess = iter;
-  return iter->second;
+  }
+  ++this->NumberOfHits;
+  this->Entries.splice(this->Entries.begin(), this->Entries, iter->second);
+  iter->second->LastAccess.Modified();
+  return iter->second->Data;
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::Insert(
   const std::string& key, const vtkSmartPointer<CacheDataType>& data)
 {
+  typename CacheMapper::iterator iter = this->CacheData.find(key);
+  if (iter != this->CacheData.end())
+  {
+    this->MemorySize -= iter->second->MemorySize;
+    this->Entries.erase(iter->second);
+    this->CacheData.erase(iter);
+  }
+  if (data == nullptr)
+  {
+    return;
+  }
+
+  CacheEntry entry;
+  entry.Key = key;
+  entry.Data = data;
+  entry.MemorySize = static_cast<size_t>(data->GetActualMemorySize());
+  entry.LastAccess.Modified();
+  this->Entries.push_front(entry);
+  this->CacheData[key] = this->Entries.begin();
+  this->MemorySize += entry.MemorySize;
+
+  // Make some room by removing the least recently used items, but always
+  // keep the new one.
+  while (this->MemoryLimit > 0 && this->MemorySize > this->MemoryLimit &&
+    this->Entries.size() > 1)
+  {
+    this->EvictLeastRecent();
+  }
+}
+
+template <typename CacheDataType>
+vtkMTimeType vtkCGNSCache<CacheDataType>::GetLeastRecentAccessTime() const
+{
+  return this->Entries.empty() ? VTK_MTIME_MAX : this->Entries.back().LastAccess.GetMTime();
+}
 
-  if (this->cacheSizeLimit > 0 &&
-    this->CacheData.size() >= static_cast<size_t>(this->cacheSizeLimit))
+template <typename CacheDataType>
+bool vtkCGNSCache<CacheDataType>::EvictLeastRecent()
+{
+  if (this->Entries.empty())
   {
-    // Make some room by removing last accessed/inserted item
-    this->CacheData.erase(this->LastCacheAccess);
+    return false;
   }
-  this->CacheData[key] = data;
-  this->LastCacheAccess = this->CacheData.find(key);
+  const CacheEntry& entry = this->Entries.back();
+  this->MemorySize -= entry.MemorySize;
+  this->CacheData.erase(entry.Key);
+  this->Entries.pop_back();
+  ++this->NumberOfEvictions;
+  return true;
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::ClearCache()
 {
   this->CacheData.clear();
+  this->Entries.clear();
+  this->MemorySize = 0;
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
 }
 }
 #endif // vtkCGNSCache_h
@@ -591,6 +591,7 @@ vtkCGNSReader::vtkCGNSReader()
   this->DistributeBlocks = true;
   this->CacheMesh = false;
   this->CacheConnectivity = false;
+  this->CacheMemoryLimit = 0;
 
   this->SetNumberOfInputPorts(0);
   this->SetNumberOfOutputPorts(1);
@@ -1916,6 +1917,7 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
     if (caching)
     {
       self->MeshPointsCache.Insert(keyMesh, points);
+      self->TrimCaches();
     }
   }
 
@@ -2196,6 +2198,7 @@ int vtkCGNSReader::GetUnstructuredZone(
     if (caching)
     {
       this->MeshPointsCache.Insert(keyMesh, points);
+      this->TrimCaches();
     }
   }
 
@@ -2993,6 +2996,7 @@ int vtkCGNSReader::GetUnstructuredZone(
     if (caching)
     {
       this->ConnectivitiesCache.Insert(keyConnect, ugrid);
+      this->TrimCaches();
     }
   }
   //
@@ -4672,6 +4676,9 @@ void vtkCGNSReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "CreateEachSolutionAsBlock: " << this->CreateEachSolutionAsBlock << endl;
   os << indent << "IgnoreFlowSolutionPointers: " << this->IgnoreFlowSolutionPointers << endl;
   os << indent << "DistributeBlocks: " << this->DistributeBlocks << endl;
+  os << indent << "CacheMesh: " << this->CacheMesh << endl;
+  os << indent << "CacheConnectivity: " << this->CacheConnectivity << endl;
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -5005,6 +5012,75 @@ void vtkCGNSReader::SetCacheConnectivity(bool enable)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkCGNSReader::SetCacheMemoryLimit(int mebibytes)
+{
+  mebibytes = std::max(mebibytes, 0);
+  if (this->CacheMemoryLimit != mebibytes)
+  {
+    this->CacheMemoryLimit = mebibytes;
+    this->TrimCaches();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkCGNSReader::TrimCaches()
+{
+  if (this->CacheMemoryLimit <= 0)
+  {
+    return;
+  }
+  const size_t limit = static_cast<size_t>(this->CacheMemoryLimit) * 1024;
+  while (this->MeshPointsCache.GetMemorySize() + this->ConnectivitiesCache.GetMemorySize() > limit)
+  {
+    // evict from the cache holding the least recently used object.
+    if (this->MeshPointsCache.GetLeastRecentAccessTime() <
+      this->ConnectivitiesCache.GetLeastRecentAccessTime())
+    {
+      this->MeshPointsCache.EvictLeastRecent();
+    }
+    else if (!this->ConnectivitiesCache.EvictLeastRecent())
+    {
+      break;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCGNSReader::GetCacheHits() const
+{
+  return static_cast<vtkIdType>(
+    this->MeshPointsCache.GetNumberOfHits() + this->ConnectivitiesCache.GetNumberOfHits());
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCGNSReader::GetCacheMisses() const
+{
+  return static_cast<vtkIdType>(
+    this->MeshPointsCache.GetNumberOfMisses() + this->ConnectivitiesCache.GetNumberOfMisses());
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCGNSReader::GetCacheEvictions() const
+{
+  return static_cast<vtkIdType>(this->MeshPointsCache.GetNumberOfEvictions() +
+    this->ConnectivitiesCache.GetNumberOfEvictions());
+}
+
+//----------------------------------------------------------------------------
+double vtkCGNSReader::GetCacheMemoryUsage() const
+{
+  return (this->MeshPointsCache.GetMemorySize() + this->ConnectivitiesCache.GetMemorySize()) /
+    1024.0;
+}
+
+//----------------------------------------------------------------------------
+void vtkCGNSReader::ResetCacheStatistics()
+{
+  this->MeshPointsCache.ResetStatistics();
+  this->ConnectivitiesCache.ResetStatistics();
+}
+
 //==============================================================================
 #ifdef _WINDOWS
 #pragma warning(pop)
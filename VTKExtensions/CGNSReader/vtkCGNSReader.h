@@ -228,6 +228,30 @@ public:
   vtkGetMacro(CacheConnectivity, bool);
   vtkBooleanMacro(CacheConnectivity, bool);
 
+  //@{
+  /**
+   * Set the maximum memory, in mebibytes, used by the cached mesh points and
+   * connectivities. When exceeded, the least recently used ones are evicted.
+   * The caches are kept when the file name changes, so they are shared by
+   * the time steps of a temporal file series. 0 means no limit (default).
+   */
+  void SetCacheMemoryLimit(int mebibytes);
+  vtkGetMacro(CacheMemoryLimit, int);
+  //@}
+
+  //@{
+  /**
+   * Statistics on the mesh points and connectivities caches: number of
+   * lookups found in the caches, not found, objects evicted to respect
+   * CacheMemoryLimit, and memory used by the cached objects in mebibytes.
+   */
+  vtkIdType GetCacheHits() const;
+  vtkIdType GetCacheMisses() const;
+  vtkIdType GetCacheEvictions() const;
+  double GetCacheMemoryUsage() const;
+  void ResetCacheStatistics();
+  //@}
+
   //@{
   /**
    * Set/get the communication object used to relay a list of files
@@ -281,6 +305,10 @@ private:
   CGNSRead::vtkCGNSCache<vtkUnstructuredGrid>
     ConnectivitiesCache; // Cache for the mesh connectivities
 
+  // Evicts the least recently used objects of both caches until they fit in
+  // CacheMemoryLimit.
+  void TrimCaches();
+
   char* FileName;                // cgns file name
   bool LoadBndPatch;             // option to set section loading for unstructured grid
   bool LoadMesh;                 // option to enable/disable mesh loading
@@ -291,6 +319,7 @@ private:
   bool DistributeBlocks;
   bool CacheMesh;
   bool CacheConnectivity;
+  int CacheMemoryLimit;
 
   // For internal cgio calls (low level IO)
   int cgioNum;      // cgio file reference
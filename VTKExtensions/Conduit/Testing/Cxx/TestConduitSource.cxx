@@ -13,8 +13,11 @@
 
 =========================================================================*/
 
+#include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkConduitSource.h"
+#include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkLogger.h"
 #include "vtkNew.h"
@@ -28,6 +31,8 @@
 
 #include <conduit_blueprint.hpp>
 
+#include <vector>
+
 #define VERIFY(x, ...)                                                                             \
   if ((x) == false)                                                                                \
   {                                                                                                \
@@ -80,6 +85,7 @@ bool ValidateMeshTypeRectilinear()
   VERIFY(vtkVector3i(rg->GetDimensions()) == vtkVector3i(3, 3, 3),
     "incorrect dimensions, expected=3x3x3, got=%dx%dx%d", rg->GetDimensions()[0],
     rg->GetDimensions()[1], rg->GetDimensions()[2]);
+  VERIFY(rg->GetYCoordinates() != rg->GetXCoordinates(), "incorrect y coordinates");
 
   return true;
 }
@@ -125,12 +131,112 @@ bool ValidateMeshTypeUnstructured()
   VERIFY(ug->GetCellData()->GetArray("field") != nullptr, "missing 'field' cell-data array");
   return true;
 }
+
+void SetExplicitCoordinates(conduit::Node& mesh, const std::vector<double>& x,
+  const std::vector<double>& y, const std::vector<double>& z)
+{
+  mesh["coordsets/coords/type"] = "explicit";
+  mesh["coordsets/coords/values/x"].set(x);
+  mesh["coordsets/coords/values/y"].set(y);
+  mesh["coordsets/coords/values/z"].set(z);
+  mesh["topologies/mesh/type"] = "unstructured";
+  mesh["topologies/mesh/coordset"] = "coords";
+}
+
+bool ValidateMeshTypeMixed()
+{
+  // a quad, a triangle and a pentagon, with 32-bit connectivity.
+  conduit::Node mesh;
+  SetExplicitCoordinates(mesh, { 0, 1, 2, 0, 1, 2, 3, 3 }, { 0, 0, 0, 1, 1, 1, 0, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 0 });
+  std::vector<conduit::int32> connectivity = { 0, 1, 4, 3, 1, 2, 4, 2, 6, 7, 5, 4 };
+  mesh["topologies/mesh/elements/shape"] = "mixed";
+  mesh["topologies/mesh/elements/shape_map/quad"] = 9;
+  mesh["topologies/mesh/elements/shape_map/tri"] = 5;
+  mesh["topologies/mesh/elements/shape_map/polygonal"] = 7;
+  mesh["topologies/mesh/elements/shapes"].set(std::vector<conduit::int32>{ 9, 5, 7 });
+  mesh["topologies/mesh/elements/sizes"].set(std::vector<conduit::int32>{ 4, 3, 5 });
+  mesh["topologies/mesh/elements/offsets"].set(std::vector<conduit::int32>{ 0, 4, 7 });
+  mesh["topologies/mesh/elements/connectivity"].set_external(connectivity);
+
+  // a 2-component field strided over 3 values per tuple.
+  std::vector<double> values = { 0, 10, -1, 1, 11, -1, 2, 12, -1 };
+  mesh["fields/field/association"] = "element";
+  mesh["fields/field/topology"] = "mesh";
+  mesh["fields/field/values/u"].set_external(
+    conduit::DataType::float64(3, 0, 3 * sizeof(double)), values.data());
+  mesh["fields/field/values/v"].set_external(
+    conduit::DataType::float64(3, sizeof(double), 3 * sizeof(double)), values.data());
+
+  auto pds = vtkPartitionedDataSet::SafeDownCast(Convert(mesh));
+  auto ug = pds ? vtkUnstructuredGrid::SafeDownCast(pds->GetPartition(0)) : nullptr;
+  VERIFY(ug != nullptr, "missing partition 0");
+  VERIFY(ug->GetNumberOfCells() == 3, "incorrect number of cells, expected 3, got %lld",
+    ug->GetNumberOfCells());
+  VERIFY(ug->GetCellType(0) == VTK_QUAD && ug->GetCellType(1) == VTK_TRIANGLE &&
+      ug->GetCellType(2) == VTK_POLYGON,
+    "incorrect cell types");
+  VERIFY(ug->GetCell(2)->GetNumberOfPoints() == 5,
+    "incorrect number of points in cell 2, expected 5, got %lld",
+    ug->GetCell(2)->GetNumberOfPoints());
+  VERIFY(ug->GetCells()->GetConnectivityArray()->GetVoidPointer(0) == connectivity.data(),
+    "connectivity was copied");
+
+  auto array = ug->GetCellData()->GetArray("field");
+  VERIFY(array != nullptr && array->GetNumberOfComponents() == 2, "missing 'field' array");
+  VERIFY(array->GetComponent(2, 0) == 2 && array->GetComponent(2, 1) == 12,
+    "incorrect strided values, expected (2, 12), got (%g, %g)", array->GetComponent(2, 0),
+    array->GetComponent(2, 1));
+  return true;
+}
+
+bool ValidateMeshTypePolyhedral()
+{
+  // a hexahedron described by its faces.
+  conduit::Node mesh;
+  SetExplicitCoordinates(mesh, { 0, 1, 1, 0, 0, 1, 1, 0 }, { 0, 0, 1, 1, 0, 0, 1, 1 },
+    { 0, 0, 0, 0, 1, 1, 1, 1 });
+  mesh["topologies/mesh/elements/shape"] = "polyhedral";
+  mesh["topologies/mesh/elements/connectivity"].set(
+    std::vector<conduit::int64>{ 0, 1, 2, 3, 4, 5 });
+  mesh["topologies/mesh/elements/sizes"].set(std::vector<conduit::int64>{ 6 });
+  mesh["topologies/mesh/elements/offsets"].set(std::vector<conduit::int64>{ 0 });
+  mesh["topologies/mesh/subelements/shape"] = "polygonal";
+  mesh["topologies/mesh/subelements/connectivity"].set(std::vector<conduit::int64>{
+    0, 3, 2, 1, 4, 5, 6, 7, 0, 1, 5, 4, 1, 2, 6, 5, 2, 3, 7, 6, 3, 0, 4, 7 });
+  mesh["topologies/mesh/subelements/sizes"].set(std::vector<conduit::int64>{ 4, 4, 4, 4, 4, 4 });
+  mesh["topologies/mesh/subelements/offsets"].set(
+    std::vector<conduit::int64>{ 0, 4, 8, 12, 16, 20 });
+
+  vtkNew<vtkConduitSource> source;
+  source->SetNode(&mesh);
+  source->CacheUnchangedTopologiesOn();
+  source->Update();
+  auto pds = vtkPartitionedDataSet::SafeDownCast(source->GetOutputDataObject(0));
+  auto ug = pds ? vtkUnstructuredGrid::SafeDownCast(pds->GetPartition(0)) : nullptr;
+  VERIFY(ug != nullptr, "missing partition 0");
+  VERIFY(ug->GetNumberOfCells() == 1 && ug->GetCellType(0) == VTK_POLYHEDRON,
+    "expected a single polyhedron");
+  VERIFY(ug->GetCell(0)->GetNumberOfPoints() == 8 && ug->GetCell(0)->GetNumberOfFaces() == 6,
+    "incorrect polyhedron, expected 8 points and 6 faces, got %lld and %d",
+    ug->GetCell(0)->GetNumberOfPoints(), ug->GetCell(0)->GetNumberOfFaces());
+
+  // the unchanged topology is not converted again.
+  vtkSmartPointer<vtkCellArray> cells = ug->GetCells();
+  source->Modified();
+  source->Update();
+  pds = vtkPartitionedDataSet::SafeDownCast(source->GetOutputDataObject(0));
+  ug = vtkUnstructuredGrid::SafeDownCast(pds->GetPartition(0));
+  VERIFY(ug->GetCells() == cells && ug->GetFaces() != nullptr, "topology was not reused");
+  return true;
+}
 }
 
 int TestConduitSource(int, char* [])
 {
   return ValidateMeshTypeUniform() && ValidateMeshTypeRectilinear() &&
-      ValidateMeshTypeStructured() && ValidateMeshTypeUnstructured()
+      ValidateMeshTypeStructured() && ValidateMeshTypeUnstructured() &&
+      ValidateMeshTypeMixed() && ValidateMeshTypePolyhedral()
     ? EXIT_SUCCESS
     : EXIT_FAILURE;
 }
@@ -34,6 +34,8 @@
 #include <conduit_blueprint_mcarray.hpp>
 #include <conduit_cpp_to_c.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 namespace internals
@@ -53,16 +55,33 @@ using SOAArrays = vtkTypeList::Unique<
     vtkSOADataArrayTemplate<vtkTypeUInt32>, vtkSOADataArrayTemplate<vtkTypeUInt64>,
     vtkSOADataArrayTemplate<vtkTypeFloat32>, vtkSOADataArrayTemplate<vtkTypeFloat64> > >::Result;
 
-bool is_contiguous(const conduit::Node& node)
+// Returns true if the components are interleaved in a single buffer, as
+// expected by vtkAOSDataArrayTemplate.
+bool is_interleaved(const conduit::Node& mcarray)
 {
-  if (node.is_contiguous())
+  const auto num_components = mcarray.number_of_children();
+  const auto element_bytes = mcarray.child(0).dtype().element_bytes();
+  const char* base = static_cast<const char*>(mcarray.child(0).element_ptr(0));
+  for (conduit::index_t cc = 0; cc < num_components; ++cc)
   {
-    return true;
+    const auto& child = mcarray.child(cc);
+    if (child.dtype().stride() != num_components * element_bytes ||
+      static_cast<const char*>(child.element_ptr(0)) != base + cc * element_bytes)
+    {
+      return false;
+    }
   }
-  auto iter = node.children();
+  return true;
+}
+
+// Returns true if each component is compact in its own buffer, as expected
+// by vtkSOADataArrayTemplate.
+bool is_contiguous(const conduit::Node& mcarray)
+{
+  auto iter = mcarray.children();
   while (iter.has_next())
   {
-    if (!iter.next().is_contiguous())
+    if (!iter.next().dtype().is_compact())
     {
       return false;
     }
@@ -95,6 +114,79 @@ vtkSmartPointer<vtkSOADataArrayTemplate<ValueT> > CreateSOArray(
   return array;
 }
 
+// Copies components of any stride to an interleaved array.
+template <typename ArrayT>
+vtkSmartPointer<ArrayT> CreateStridedCopy(const conduit::Node& mcarray)
+{
+  using ValueType = typename ArrayT::ValueType;
+  const int num_components = static_cast<int>(mcarray.number_of_children());
+  const vtkIdType num_tuples =
+    static_cast<vtkIdType>(mcarray.child(0).dtype().number_of_elements());
+
+  auto array = vtkSmartPointer<ArrayT>::New();
+  array->SetNumberOfComponents(num_components);
+  array->SetNumberOfTuples(num_tuples);
+  ValueType* output = array->GetPointer(0);
+  for (int cc = 0; cc < num_components; ++cc)
+  {
+    const auto& child = mcarray.child(cc);
+    const char* input = static_cast<const char*>(child.element_ptr(0));
+    const auto stride = child.dtype().stride();
+    for (vtkIdType tt = 0; tt < num_tuples; ++tt)
+    {
+      memcpy(output + tt * num_components + cc, input + tt * stride, sizeof(ValueType));
+    }
+  }
+  return array;
+}
+
+// Returns the array as one of the types vtkCellArray uses without copy,
+// converting it to a 64-bit array otherwise.
+vtkSmartPointer<vtkDataArray> AsCellArrayStorage(vtkDataArray* array)
+{
+  if (vtkArrayDownCast<vtkTypeInt32Array>(array) || vtkArrayDownCast<vtkTypeInt64Array>(array))
+  {
+    return array;
+  }
+  auto result = vtkSmartPointer<vtkTypeInt64Array>::New();
+  result->DeepCopy(array);
+  return result;
+}
+
+// Returns the array as a vtkIdType array, converting it if needed.
+vtkSmartPointer<vtkAOSDataArrayTemplate<vtkIdType> > AsIdTypeArray(vtkDataArray* array)
+{
+  if (auto ids = vtkArrayDownCast<vtkAOSDataArrayTemplate<vtkIdType> >(array))
+  {
+    return ids;
+  }
+  auto result = vtkSmartPointer<vtkAOSDataArrayTemplate<vtkIdType> >::New();
+  result->DeepCopy(array);
+  return result;
+}
+
+// Fills the `num_cells + 1` offsets expected by vtkCellArray from the
+// Blueprint offsets or, if `from_sizes` is true, from the Blueprint sizes.
+template <typename ValueT>
+void FillOffsets(ValueT* result, const vtkIdType* values, vtkIdType num_cells, bool from_sizes,
+  vtkIdType connectivity_size)
+{
+  if (from_sizes)
+  {
+    result[0] = 0;
+    for (vtkIdType cc = 0; cc < num_cells; ++cc)
+    {
+      result[cc + 1] = result[cc] + static_cast<ValueT>(values[cc]);
+    }
+  }
+  else
+  {
+    std::transform(values, values + num_cells, result,
+      [](vtkIdType value) { return static_cast<ValueT>(value); });
+    result[num_cells] = static_cast<ValueT>(connectivity_size);
+  }
+}
+
 //----------------------------------------------------------------------------
 // internal: change components helper.
 struct ChangeComponentsAOSImpl
@@ -277,9 +369,14 @@ vtkSmartPointer<vtkDataArray> vtkConduitArrayUtilities::MCArrayToVTKArrayImpl(
         dtype0.name().c_str(), cc, dtypeCC.name().c_str());
       return nullptr;
     }
+    if (dtype0.number_of_elements() != dtypeCC.number_of_elements())
+    {
+      vtkLogF(ERROR, "mismatched number of elements for component 0 and %ld.", cc);
+      return nullptr;
+    }
   }
 
-  if (conduit::blueprint::mcarray::is_interleaved(mcarray))
+  if (internals::is_interleaved(mcarray))
   {
     return vtkConduitArrayUtilities::MCArrayToVTKAOSArray(conduit::c_node(&mcarray), force_signed);
   }
@@ -289,9 +386,8 @@ vtkSmartPointer<vtkDataArray> vtkConduitArrayUtilities::MCArrayToVTKArrayImpl(
   }
   else
   {
-    // TODO: we can do a deep-copy in this case, so we can still handle it quite easily when needed.
-    vtkLogF(ERROR, "unsupported array layout.");
-    return nullptr;
+    return vtkConduitArrayUtilities::MCArrayToVTKStridedArray(
+      conduit::c_node(&mcarray), force_signed);
   }
 }
 
@@ -407,6 +503,51 @@ vtkSmartPointer<vtkDataArray> vtkConduitArrayUtilities::MCArrayToVTKSOAArray(
   }
 }
 
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> vtkConduitArrayUtilities::MCArrayToVTKStridedArray(
+  const conduit_node* c_mcarray, bool force_signed)
+{
+  const conduit::Node& mcarray = (*conduit::cpp_node(c_mcarray));
+  auto& dtype0 = mcarray.child(0).dtype();
+
+  switch (internals::GetTypeId(dtype0.id(), force_signed))
+  {
+    case conduit::DataType::INT8_ID:
+      return internals::CreateStridedCopy<vtkTypeInt8Array>(mcarray);
+
+    case conduit::DataType::INT16_ID:
+      return internals::CreateStridedCopy<vtkTypeInt16Array>(mcarray);
+
+    case conduit::DataType::INT32_ID:
+      return internals::CreateStridedCopy<vtkTypeInt32Array>(mcarray);
+
+    case conduit::DataType::INT64_ID:
+      return internals::CreateStridedCopy<vtkTypeInt64Array>(mcarray);
+
+    case conduit::DataType::UINT8_ID:
+      return internals::CreateStridedCopy<vtkTypeUInt8Array>(mcarray);
+
+    case conduit::DataType::UINT16_ID:
+      return internals::CreateStridedCopy<vtkTypeUInt16Array>(mcarray);
+
+    case conduit::DataType::UINT32_ID:
+      return internals::CreateStridedCopy<vtkTypeUInt32Array>(mcarray);
+
+    case conduit::DataType::UINT64_ID:
+      return internals::CreateStridedCopy<vtkTypeUInt64Array>(mcarray);
+
+    case conduit::DataType::FLOAT32_ID:
+      return internals::CreateStridedCopy<vtkTypeFloat32Array>(mcarray);
+
+    case conduit::DataType::FLOAT64_ID:
+      return internals::CreateStridedCopy<vtkTypeFloat64Array>(mcarray);
+
+    default:
+      vtkLogF(ERROR, "unsupported data type '%s' ", dtype0.name().c_str());
+      return nullptr;
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkSmartPointer<vtkDataArray> vtkConduitArrayUtilities::SetNumberOfComponents(
   vtkDataArray* array, int num_components)
@@ -446,7 +587,52 @@ vtkSmartPointer<vtkCellArray> vtkConduitArrayUtilities::MCArrayToVTKCellArray(
 
   // now the array matches the type accepted by vtkCellArray (in most cases).
   vtkNew<vtkCellArray> cellArray;
-  cellArray->SetData(cellSize, array);
+  cellArray->SetData(cellSize, internals::AsCellArrayStorage(array));
+  return cellArray;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkCellArray> vtkConduitArrayUtilities::MCArrayToVTKCellArray(
+  const conduit_node* connectivity, const conduit_node* offsets, const conduit_node* sizes)
+{
+  if (offsets == nullptr && sizes == nullptr)
+  {
+    vtkLogF(ERROR, "cells need offsets or sizes.");
+    return nullptr;
+  }
+
+  auto conn = vtkConduitArrayUtilities::MCArrayToVTKArrayImpl(connectivity, /*force_signed*/ true);
+  auto counts = vtkConduitArrayUtilities::MCArrayToVTKArrayImpl(
+    offsets ? offsets : sizes, /*force_signed*/ true);
+  if (!conn || !counts)
+  {
+    return nullptr;
+  }
+  conn = internals::AsCellArrayStorage(conn);
+  auto values = internals::AsIdTypeArray(counts);
+
+  // offsets use the type of the connectivity, as required by vtkCellArray.
+  const vtkIdType num_cells = values->GetNumberOfTuples();
+  vtkSmartPointer<vtkDataArray> cellOffsets;
+  cellOffsets.TakeReference(conn->NewInstance());
+  cellOffsets->SetNumberOfTuples(num_cells + 1);
+  if (auto offsets32 = vtkArrayDownCast<vtkTypeInt32Array>(cellOffsets))
+  {
+    internals::FillOffsets(offsets32->GetPointer(0), values->GetPointer(0), num_cells,
+      offsets == nullptr, conn->GetNumberOfTuples());
+  }
+  else
+  {
+    internals::FillOffsets(vtkArrayDownCast<vtkTypeInt64Array>(cellOffsets)->GetPointer(0),
+      values->GetPointer(0), num_cells, offsets == nullptr, conn->GetNumberOfTuples());
+  }
+
+  vtkNew<vtkCellArray> cellArray;
+  if (!cellArray->SetData(cellOffsets, conn))
+  {
+    vtkLogF(ERROR, "failed to create cells from connectivity and offsets.");
+    return nullptr;
+  }
   return cellArray;
 }
 
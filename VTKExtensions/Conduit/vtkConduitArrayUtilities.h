@@ -19,8 +19,8 @@
  *
  * vtkConduitArrayUtilities is intended to convert Conduit nodes satisfying the
  * `mcarray` protocol to VTK arrays. It uses zero-copy, as much as possible.
- * Currently implementation fails if zero-copy is not possible. In future, that
- * may be changed to do a deep-copy (with appropriate warnings) if necessary.
+ * Interleaved and contiguous per-component layouts are used without copy;
+ * other strided layouts are copied to an interleaved array in a single pass.
  *
  * This is primarily designed for use by vtkConduitSource.
  */
@@ -65,6 +65,18 @@ public:
   static vtkSmartPointer<vtkCellArray> MCArrayToVTKCellArray(
     vtkIdType cellSize, const conduit_node* mcarray);
 
+  /**
+   * Converts the connectivity of cells with varying number of points, with
+   * either their offsets or their sizes (the other may be nullptr), to
+   * vtkCellArray.
+   *
+   * The connectivity is used without copy when its type is accepted by
+   * vtkCellArray. The offsets are always built, in a single pass, since
+   * vtkCellArray needs one more offset than there are cells.
+   */
+  static vtkSmartPointer<vtkCellArray> MCArrayToVTKCellArray(
+    const conduit_node* connectivity, const conduit_node* offsets, const conduit_node* sizes);
+
   /**
    * If the number of components in the array does not match the target, a new
    * array is created.
@@ -82,6 +94,8 @@ protected:
     const conduit_node* mcarray, bool force_signed);
   static vtkSmartPointer<vtkDataArray> MCArrayToVTKSOAArray(
     const conduit_node* mcarray, bool force_signed);
+  static vtkSmartPointer<vtkDataArray> MCArrayToVTKStridedArray(
+    const conduit_node* mcarray, bool force_signed);
 
 private:
   vtkConduitArrayUtilities(const vtkConduitArrayUtilities&) = delete;
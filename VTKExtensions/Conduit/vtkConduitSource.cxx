@@ -15,9 +15,11 @@
 #include "vtkConduitSource.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkConduitArrayUtilities.h"
 #include "vtkDataArray.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -29,6 +31,7 @@
 #include "vtkRectilinearGrid.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <conduit.hpp>
@@ -36,9 +39,23 @@
 #include <conduit_cpp_to_c.hpp>
 
 #include <algorithm>
+#include <map>
+#include <sstream>
+#include <vector>
 namespace internals
 {
 
+// Cells converted for an unstructured topology, reused when the topology
+// arrays did not change since the previous update.
+struct TopologyCache
+{
+  std::string Key;
+  vtkSmartPointer<vtkUnsignedCharArray> Types;
+  vtkSmartPointer<vtkCellArray> Cells;
+  vtkSmartPointer<vtkIdTypeArray> FaceLocations;
+  vtkSmartPointer<vtkIdTypeArray> Faces;
+};
+
 //----------------------------------------------------------------------------
 int GetAssociation(const std::string& assoc)
 {
@@ -81,6 +98,18 @@ int GetCellType(const std::string& shape)
   {
     return VTK_HEXAHEDRON;
   }
+  else if (shape == "wedge")
+  {
+    return VTK_WEDGE;
+  }
+  else if (shape == "pyramid")
+  {
+    return VTK_PYRAMID;
+  }
+  else if (shape == "polygonal")
+  {
+    return VTK_POLYGON;
+  }
   else
   {
     throw std::runtime_error("unsupported shape " + shape);
@@ -102,6 +131,10 @@ static vtkIdType GetNumberOfPointsInCellType(int vtk_cell_type)
     case VTK_QUAD:
     case VTK_TETRA:
       return 4;
+    case VTK_PYRAMID:
+      return 5;
+    case VTK_WEDGE:
+      return 6;
     case VTK_HEXAHEDRON:
       return 8;
     default:
@@ -136,9 +169,204 @@ vtkSmartPointer<vtkPoints> CreatePoints(const conduit::Node& coords)
   return pts;
 }
 
+//----------------------------------------------------------------------------
+// internal: describes the arrays of a node by their address, size and type,
+// to recognize a topology passed again without change.
+void AppendKey(const conduit::Node& node, std::ostringstream& key)
+{
+  if (node.number_of_children() == 0)
+  {
+    if (node.dtype().is_string())
+    {
+      key << node.as_string() << ";";
+    }
+    else
+    {
+      key << node.data_ptr() << ":" << node.dtype().number_of_elements() << ":"
+          << node.dtype().id() << ";";
+    }
+    return;
+  }
+
+  auto iter = node.children();
+  while (iter.has_next())
+  {
+    auto& child = iter.next();
+    key << iter.name() << "/";
+    AppendKey(child, key);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkCellArray> CreateCellArray(const conduit::Node& elements)
+{
+  auto cellArray = vtkConduitArrayUtilities::MCArrayToVTKCellArray(&elements["connectivity"],
+    elements.has_child("offsets") ? &elements["offsets"] : nullptr,
+    elements.has_child("sizes") ? &elements["sizes"] : nullptr);
+  if (cellArray == nullptr)
+  {
+    throw std::runtime_error("failed to convert cells!");
+  }
+  return cellArray;
+}
+
+//----------------------------------------------------------------------------
+// internal: "mixed" shapes have the Blueprint shape of each cell in "shapes",
+// mapped to shape names by "shape_map".
+void SetMixedCells(vtkUnstructuredGrid* ug, const conduit::Node& elements)
+{
+  std::vector<unsigned char> lookup;
+  auto iter = elements["shape_map"].children();
+  while (iter.has_next())
+  {
+    const auto id = iter.next().to_int32();
+    if (id < 0)
+    {
+      throw std::runtime_error("invalid shape_map!");
+    }
+    lookup.resize(std::max(lookup.size(), static_cast<size_t>(id) + 1), VTK_EMPTY_CELL);
+    lookup[id] = static_cast<unsigned char>(GetCellType(iter.name()));
+  }
+
+  auto shapes = vtkConduitArrayUtilities::MCArrayToVTKArray(&elements["shapes"]);
+  if (shapes == nullptr)
+  {
+    throw std::runtime_error("failed to convert shapes!");
+  }
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfTuples(shapes->GetNumberOfTuples());
+  for (vtkIdType cc = 0, max = shapes->GetNumberOfTuples(); cc < max; ++cc)
+  {
+    const auto id = static_cast<size_t>(shapes->GetComponent(cc, 0));
+    if (id >= lookup.size() || lookup[id] == VTK_EMPTY_CELL)
+    {
+      throw std::runtime_error("shape missing from shape_map!");
+    }
+    types->SetValue(cc, lookup[id]);
+  }
+
+  auto cellArray = CreateCellArray(elements);
+  if (cellArray->GetNumberOfCells() != types->GetNumberOfTuples())
+  {
+    throw std::runtime_error("mismatched number of shapes and cells!");
+  }
+  ug->SetCells(types, cellArray);
+}
+
+//----------------------------------------------------------------------------
+// internal: "polyhedral" cells reference polygonal faces in "subelements".
+// They are converted, in a single pass, to the points of each cell and to the
+// face stream of vtkUnstructuredGrid.
+void SetPolyhedralCells(
+  vtkUnstructuredGrid* ug, const conduit::Node& elements, const conduit::Node& subelements)
+{
+  auto cellFaces = CreateCellArray(elements);
+  auto faces = CreateCellArray(subelements);
+  const vtkIdType numCells = cellFaces->GetNumberOfCells();
+
+  vtkNew<vtkCellArray> cellPoints;
+  cellPoints->AllocateEstimate(numCells, 8);
+  vtkNew<vtkIdTypeArray> faceLocations;
+  faceLocations->SetNumberOfTuples(numCells);
+  vtkNew<vtkIdTypeArray> faceStream;
+  faceStream->Allocate(numCells + cellFaces->GetNumberOfConnectivityIds() +
+    2 * faces->GetNumberOfConnectivityIds());
+
+  std::vector<vtkIdType> points;
+  auto cellIter = vtk::TakeSmartPointer(cellFaces->NewIterator());
+  auto faceIter = vtk::TakeSmartPointer(faces->NewIterator());
+  for (cellIter->GoToFirstCell(); !cellIter->IsDoneWithTraversal(); cellIter->GoToNextCell())
+  {
+    vtkIdType numFaces;
+    const vtkIdType* faceIds;
+    cellIter->GetCurrentCell(numFaces, faceIds);
+    faceLocations->SetValue(cellIter->GetCurrentCellId(), faceStream->GetNumberOfTuples());
+    faceStream->InsertNextValue(numFaces);
+
+    points.clear();
+    for (vtkIdType ff = 0; ff < numFaces; ++ff)
+    {
+      if (faceIds[ff] < 0 || faceIds[ff] >= faces->GetNumberOfCells())
+      {
+        throw std::runtime_error("invalid face id!");
+      }
+      vtkIdType numPoints;
+      const vtkIdType* pointIds;
+      faceIter->GetCellAtId(faceIds[ff], numPoints, pointIds);
+      faceStream->InsertNextValue(numPoints);
+      for (vtkIdType pp = 0; pp < numPoints; ++pp)
+      {
+        faceStream->InsertNextValue(pointIds[pp]);
+      }
+      points.insert(points.end(), pointIds, pointIds + numPoints);
+    }
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    cellPoints->InsertNextCell(static_cast<vtkIdType>(points.size()), points.data());
+  }
+
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfTuples(numCells);
+  types->FillValue(VTK_POLYHEDRON);
+  ug->SetCells(types, cellPoints, faceLocations, faceStream);
+}
+
+//----------------------------------------------------------------------------
+void SetCells(vtkUnstructuredGrid* ug, const conduit::Node& topologyNode, TopologyCache* cache)
+{
+  std::string key;
+  if (cache)
+  {
+    std::ostringstream stream;
+    AppendKey(topologyNode, stream);
+    key = stream.str();
+    if (cache->Cells != nullptr && cache->Key == key)
+    {
+      ug->SetCells(cache->Types, cache->Cells, cache->FaceLocations, cache->Faces);
+      return;
+    }
+  }
+
+  auto& elements = topologyNode["elements"];
+  const auto shape = elements["shape"].as_string();
+  if (shape == "mixed")
+  {
+    SetMixedCells(ug, elements);
+  }
+  else if (shape == "polyhedral")
+  {
+    SetPolyhedralCells(ug, elements, topologyNode["subelements"]);
+  }
+  else if (shape == "polygonal")
+  {
+    ug->SetCells(VTK_POLYGON, CreateCellArray(elements));
+  }
+  else
+  {
+    const auto vtk_cell_type = GetCellType(shape);
+    const auto cell_size = GetNumberOfPointsInCellType(vtk_cell_type);
+    auto cellArray =
+      vtkConduitArrayUtilities::MCArrayToVTKCellArray(cell_size, &elements["connectivity"]);
+    if (cellArray == nullptr)
+    {
+      throw std::runtime_error("failed to convert cells!");
+    }
+    ug->SetCells(vtk_cell_type, cellArray);
+  }
+
+  if (cache)
+  {
+    cache->Key = key;
+    cache->Types = ug->GetCellTypesArray();
+    cache->Cells = ug->GetCells();
+    cache->FaceLocations = ug->GetFaceLocations();
+    cache->Faces = ug->GetFaces();
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkSmartPointer<vtkDataSet> GetMesh(
-  const conduit::Node& topologyNode, const conduit::Node& coordsets)
+  const conduit::Node& topologyNode, const conduit::Node& coordsets, TopologyCache* cache)
 {
   // get the coordset for this topology element.
   auto& coords = coordsets[topologyNode["coordset"].as_string()];
@@ -181,8 +409,8 @@ vtkSmartPointer<vtkDataSet> GetMesh(
     rg->SetDimensions(
       xArray->GetNumberOfTuples(), yArray->GetNumberOfTuples(), zArray->GetNumberOfTuples());
     rg->SetXCoordinates(xArray);
-    rg->SetYCoordinates(xArray);
-    rg->SetZCoordinates(xArray);
+    rg->SetYCoordinates(yArray);
+    rg->SetZCoordinates(zArray);
     return rg;
   }
   else if (topologyNode["type"].as_string() == "structured" &&
@@ -202,11 +430,7 @@ vtkSmartPointer<vtkDataSet> GetMesh(
   {
     vtkNew<vtkUnstructuredGrid> ug;
     ug->SetPoints(CreatePoints(coords));
-    const auto vtk_cell_type = GetCellType(topologyNode["elements/shape"].as_string());
-    const auto cell_size = GetNumberOfPointsInCellType(vtk_cell_type);
-    auto cellArray = vtkConduitArrayUtilities::MCArrayToVTKCellArray(
-      cell_size, &topologyNode["elements/connectivity"]);
-    ug->SetCells(vtk_cell_type, cellArray);
+    SetCells(ug, topologyNode, cache);
     return ug;
   }
   else
@@ -221,12 +445,14 @@ class vtkConduitSource::vtkInternals
 {
 public:
   const conduit::Node* Node = nullptr;
+  std::map<std::string, internals::TopologyCache> Topologies;
 };
 
 vtkStandardNewMacro(vtkConduitSource);
 //----------------------------------------------------------------------------
 vtkConduitSource::vtkConduitSource()
-  : Internals(new vtkConduitSource::vtkInternals())
+  : CacheUnchangedTopologies(false)
+  , Internals(new vtkConduitSource::vtkInternals())
 {
   this->SetNumberOfInputPorts(0);
   this->SetNumberOfOutputPorts(1);
@@ -278,6 +504,10 @@ int vtkConduitSource::RequestData(
   }
 
   std::map<std::string, vtkSmartPointer<vtkDataSet> > datasets;
+  if (!this->CacheUnchangedTopologies)
+  {
+    internals.Topologies.clear();
+  }
 
   // process "topologies".
   auto& topologies = node["topologies"];
@@ -287,7 +517,8 @@ int vtkConduitSource::RequestData(
     iter.next();
     try
     {
-      if (auto ds = internals::GetMesh(iter.node(), node["coordsets"]))
+      auto cache = this->CacheUnchangedTopologies ? &internals.Topologies[iter.name()] : nullptr;
+      if (auto ds = internals::GetMesh(iter.node(), node["coordsets"], cache))
       {
         auto idx = output->GetNumberOfPartitions();
         output->SetPartition(idx, ds);
@@ -355,4 +586,5 @@ int vtkConduitSource::RequestInformation(
 void vtkConduitSource::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheUnchangedTopologies: " << this->CacheUnchangedTopologies << endl;
 }
@@ -52,6 +52,18 @@ public:
   void SetNode(const conduit_node* node);
   //@}
 
+  //@{
+  /**
+   * When set, the cells converted for an unstructured topology are reused by
+   * the following updates as long as the topology arrays keep the same
+   * address, size and type. Only enable this when the simulation does not
+   * modify its topology arrays in place. Defaults to false.
+   */
+  vtkSetMacro(CacheUnchangedTopologies, bool);
+  vtkGetMacro(CacheUnchangedTopologies, bool);
+  vtkBooleanMacro(CacheUnchangedTopologies, bool);
+  //@}
+
 protected:
   vtkConduitSource();
   ~vtkConduitSource();
@@ -61,6 +73,8 @@ protected:
   int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  bool CacheUnchangedTopologies;
+
 private:
   vtkConduitSource(const vtkConduitSource&) = delete;
   void operator=(const vtkConduitSource&) = delete;
@@ -14,7 +14,8 @@
 #include <vtkFileSequenceParser.h>
 #include <vtkNew.h>
 
-bool check_group(vtkFileSequenceParser* parser, const char* fname, const char* seqname)
+bool check_group(vtkFileSequenceParser* parser, const char* fname, const char* seqname,
+  const char* index = nullptr)
 {
   if (!parser->ParseFileSequence(fname))
   {
@@ -28,6 +29,13 @@ bool check_group(vtkFileSequenceParser* parser, const char* fname, const char* s
          << "      got  : '" << parser->GetSequenceName() << "'" << endl;
     return false;
   }
+  if (index && parser->GetSequenceIndexString() != index)
+  {
+    cout << "ERROR: sequence index mismatch for '" << fname << "' " << endl
+         << "  expected : '" << index << "'" << endl
+         << "      got  : '" << parser->GetSequenceIndexString() << "'" << endl;
+    return false;
+  }
   return true;
 }
 
@@ -46,20 +54,36 @@ int TestFileSequenceParser(int, char* argv[])
   (void)argv;
   vtkNew<vtkFileSequenceParser> seqParser;
 
-  check_group(seqParser.Get(), "foo.1.csv", "foo...csv");
-  check_group(seqParser.Get(), "foo1.csv", "foo..csv");
-  check_group(seqParser.Get(), "alpha99beta88gamma0001.csv", "alpha99beta88gamma..csv");
-  check_group(seqParser.Get(), "foo.csv.1", "foo.csv");
-  check_group(seqParser.Get(), "foo.csv.10.0", "foo.csv.10");
-  check_group(seqParser.Get(), "spcta.10", "spcta");
-  check_group(seqParser.Get(), "spcta1.10", "spcta1");
-  check_group(seqParser.Get(), "Project_01_solution.cgns", "Project_.._solution.cgns");
-  check_group(seqParser.Get(), "prefix-021-suffix.ext", "prefix-..-suffix.ext");
-  check_group(seqParser.Get(), "prefix021suffix.ext", "prefix..suffix.ext");
-  check_group(seqParser.Get(), "plt0001000", "plt..");
+  bool success = true;
+  success &= check_group(seqParser.Get(), "foo.1.csv", "foo...csv");
+  success &= check_group(seqParser.Get(), "foo1.csv", "foo..csv");
+  success &=
+    check_group(seqParser.Get(), "alpha99beta88gamma0001.csv", "alpha99beta88gamma..csv");
+  success &= check_group(seqParser.Get(), "foo.csv.1", "foo.csv");
+  success &= check_group(seqParser.Get(), "foo.csv.10.0", "foo.csv.10");
+  success &= check_group(seqParser.Get(), "spcta.10", "spcta");
+  success &= check_group(seqParser.Get(), "spcta1.10", "spcta1");
+  success &=
+    check_group(seqParser.Get(), "Project_01_solution.cgns", "Project_.._solution.cgns");
+  success &= check_group(seqParser.Get(), "prefix-021-suffix.ext", "prefix-..-suffix.ext");
+  success &= check_group(seqParser.Get(), "prefix021suffix.ext", "prefix..suffix.ext");
+  success &= check_group(seqParser.Get(), "plt0001000", "plt..");
 
-  check_no_group(seqParser.Get(), "foo.3dm");
-  check_no_group(seqParser.Get(), "foo.2dm");
+  success &= check_no_group(seqParser.Get(), "foo.3dm");
+  success &= check_no_group(seqParser.Get(), "foo.2dm");
+
+  // one name for each of the patterns, in the order they are tried.
+  success &= check_group(seqParser.Get(), "a.10", "a", "10");
+  success &= check_group(seqParser.Get(), "x_001.vtk", "x_..vtk", "001");
+  success &= check_group(seqParser.Get(), "a1.vtk", "a..vtk", "1");
+  success &= check_group(seqParser.Get(), "001_x.vtk", ".._x.vtk", "001");
+  success &= check_group(seqParser.Get(), "001a.vtk", "..a.vtk", "001");
+  success &= check_group(seqParser.Get(), "a12b.vtk", "a..b.vtk", "12");
+  if (success && seqParser->GetSequenceIndex() != 12)
+  {
+    cout << "ERROR: sequence index mismatch for 'a12b.vtk'" << endl;
+    success = false;
+  }
 
-  return EXIT_SUCCESS;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -16,11 +16,145 @@
 
 #include "vtkObjectFactory.h"
 
-#include <set>
+#include <cstdlib>
 #include <string>
 #include <vtksys/RegularExpression.hxx>
 #include <vtksys/SystemTools.hxx>
 
+namespace
+{
+// The patterns below used to be matched with regular expressions. They are
+// matched by hand, following the same greedy rules, since this is called for
+// every file of the directories listed in the file dialog.
+
+inline bool IsDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+inline bool IsIndexCharacter(char c)
+{
+  return IsDigit(c) || c == '.';
+}
+
+inline bool IsSeparator(char c)
+{
+  return c == '.' || c == '_' || c == '-';
+}
+
+inline bool IsLetter(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// "^(.*)\.([0-9.]+)$": sequence ending with numbers.
+bool MatchTrailingIndex(const std::string& file, std::string& name, std::string& index)
+{
+  const size_t size = file.size();
+  if (size < 2)
+  {
+    return false;
+  }
+  size_t start = size;
+  while (start > 0 && IsIndexCharacter(file[start - 1]))
+  {
+    --start;
+  }
+  // the index starts after the last '.' of the trailing numbers.
+  for (size_t pos = size - 1; pos > start; --pos)
+  {
+    if (file[pos - 1] == '.')
+    {
+      name = file.substr(0, pos - 1);
+      index = file.substr(pos);
+      return true;
+    }
+  }
+  return false;
+}
+
+// "^(.*)(X)([0-9.]+)\.(.*)$": sequence ending with extension, where X is a
+// separator or a letter.
+bool MatchIndexBeforeExtension(
+  const std::string& file, bool (*isSeparator)(char), std::string& name, std::string& index)
+{
+  const size_t size = file.size();
+  for (size_t pos = size; pos-- > 0;)
+  {
+    if (!isSeparator(file[pos]))
+    {
+      continue;
+    }
+    size_t end = pos + 1;
+    while (end < size && IsIndexCharacter(file[end]))
+    {
+      ++end;
+    }
+    // the index ends at the last '.' of the numbers following the separator.
+    for (size_t dot = end; dot-- > pos + 2;)
+    {
+      if (file[dot] == '.')
+      {
+        name = file.substr(0, pos + 1) + ".." + file.substr(dot + 1);
+        index = file.substr(pos + 1, dot - pos - 1);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// "^([0-9.]+)(X)(.*)\.(.*)$": sequence ending with extension and starting
+// with the index, where X is a separator or a letter.
+bool MatchLeadingIndex(
+  const std::string& file, bool (*isSeparator)(char), std::string& name, std::string& index)
+{
+  const size_t size = file.size();
+  const size_t dot = file.rfind('.');
+  size_t end = 0;
+  while (end < size && IsIndexCharacter(file[end]))
+  {
+    ++end;
+  }
+  for (size_t length = end; length > 0; --length)
+  {
+    if (length < size && isSeparator(file[length]) && dot != std::string::npos &&
+      dot > length)
+    {
+      name = ".." + file.substr(length, dot - length) + "." + file.substr(dot + 1);
+      index = file.substr(0, length);
+      return true;
+    }
+  }
+  return false;
+}
+
+// "^(.*[^0-9])([0-9]+)([^0-9]*)$" on the file name without extension: any
+// sequence with a number in the middle, taking the last number.
+bool MatchLastNumber(const std::string& file, std::string& name, std::string& index)
+{
+  const std::string base = vtksys::SystemTools::GetFilenameWithoutExtension(file);
+  size_t end = base.size();
+  while (end > 0 && !IsDigit(base[end - 1]))
+  {
+    --end;
+  }
+  size_t start = end;
+  while (start > 0 && IsDigit(base[start - 1]))
+  {
+    --start;
+  }
+  if (start == 0)
+  {
+    return false;
+  }
+  name = base.substr(0, start) + ".." + base.substr(end) +
+    vtksys::SystemTools::GetFilenameExtension(file);
+  index = base.substr(start, end - start);
+  return true;
+}
+}
+
 vtkStandardNewMacro(vtkFileSequenceParser);
 //-----------------------------------------------------------------------------
 vtkFileSequenceParser::vtkFileSequenceParser()
@@ -67,59 +201,17 @@ vtkFileSequenceParser::~vtkFileSequenceParser()
 //-----------------------------------------------------------------------------
 bool vtkFileSequenceParser::ParseFileSequence(const char* file)
 {
-  bool match = false;
-  if (this->reg_ex->find(file))
-  {
-    this->SetSequenceName(this->reg_ex->match(1).c_str());
-    this->SequenceIndexString = this->reg_ex->match(2);
-    match = true;
-  }
-  else if (this->reg_ex2->find(file))
-  {
-    this->SetSequenceName(std::string(this->reg_ex2->match(1) + this->reg_ex2->match(2) + ".." +
-                            this->reg_ex2->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex2->match(3);
-    match = true;
-  }
-  else if (this->reg_ex3->find(file))
-  {
-    this->SetSequenceName(std::string(this->reg_ex3->match(1) + this->reg_ex3->match(2) + ".." +
-                            this->reg_ex3->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex3->match(3);
-    match = true;
-  }
-  else if (this->reg_ex4->find(file))
-  {
-    this->SetSequenceName(std::string(".." + this->reg_ex4->match(2) + this->reg_ex4->match(3) +
-                            "." + this->reg_ex4->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex4->match(1);
-    match = true;
-  }
-  else if (this->reg_ex5->find(file))
-  {
-    this->SetSequenceName(std::string(".." + this->reg_ex5->match(2) + this->reg_ex5->match(3) +
-                            "." + this->reg_ex5->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex5->match(1);
-    match = true;
-  }
-  else
-  {
-    std::string fname_wo_ext = vtksys::SystemTools::GetFilenameWithoutExtension(file);
-    std::string ext = vtksys::SystemTools::GetFilenameExtension(file);
-    if (this->reg_ex_last->find(fname_wo_ext))
-    {
-      this->SetSequenceName(
-        (this->reg_ex_last->match(1) + ".." + this->reg_ex_last->match(3) + ext).c_str());
-      this->SequenceIndexString = this->reg_ex_last->match(2);
-      match = true;
-    }
-  }
+  const std::string fname(file);
+  std::string name;
+  bool match = MatchTrailingIndex(fname, name, this->SequenceIndexString) ||
+    MatchIndexBeforeExtension(fname, IsSeparator, name, this->SequenceIndexString) ||
+    MatchIndexBeforeExtension(fname, IsLetter, name, this->SequenceIndexString) ||
+    MatchLeadingIndex(fname, IsSeparator, name, this->SequenceIndexString) ||
+    MatchLeadingIndex(fname, IsLetter, name, this->SequenceIndexString) ||
+    MatchLastNumber(fname, name, this->SequenceIndexString);
   if (match)
   {
+    this->SetSequenceName(name.c_str());
     this->SequenceIndex = atoi(this->SequenceIndexString.c_str());
   }
   return match;
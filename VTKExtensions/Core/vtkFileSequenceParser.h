@@ -74,6 +74,11 @@ protected:
   vtkFileSequenceParser();
   ~vtkFileSequenceParser() override;
 
+  /**
+   * @deprecated ParaView 5.9. ParseFileSequence() no longer uses these
+   * regular expressions. They are still created with the same patterns for
+   * subclasses that use them.
+   */
   vtksys::RegularExpression* reg_ex;
   vtksys::RegularExpression* reg_ex2;
   vtksys::RegularExpression* reg_ex3;
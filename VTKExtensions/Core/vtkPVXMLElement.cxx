@@ -20,6 +20,9 @@
 
 vtkStandardNewMacro(vtkPVXMLElement);
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <ctype.h>
 #include <sstream>
 #include <string>
@@ -749,6 +752,143 @@ void vtkPVXMLElement::CopyAttributesTo(vtkPVXMLElement* other)
     this->Internal->CharacterData.c_str(), static_cast<int>(this->Internal->CharacterData.size()));
 }
 
+//----------------------------------------------------------------------------
+// Strings of the binary form are a 32-bit length followed by the characters,
+// the length of a null string being ~0.
+static void vtkPVXMLElementSaveString(std::string& buffer, const char* str, size_t length)
+{
+  const vtkTypeUInt32 size = str ? static_cast<vtkTypeUInt32>(length) : ~vtkTypeUInt32(0);
+  buffer.append(reinterpret_cast<const char*>(&size), sizeof(size));
+  if (str)
+  {
+    buffer.append(str, length);
+  }
+}
+
+static void vtkPVXMLElementSaveString(std::string& buffer, const char* str)
+{
+  vtkPVXMLElementSaveString(buffer, str, str ? strlen(str) : 0);
+}
+
+static bool vtkPVXMLElementLoadSize(const char** data, const char* end, vtkTypeUInt32& size)
+{
+  if (end - *data < static_cast<std::ptrdiff_t>(sizeof(size)))
+  {
+    return false;
+  }
+  memcpy(&size, *data, sizeof(size));
+  *data += sizeof(size);
+  return true;
+}
+
+static bool vtkPVXMLElementLoadString(
+  const char** data, const char* end, const char*& str, vtkTypeUInt32& length)
+{
+  if (!vtkPVXMLElementLoadSize(data, end, length))
+  {
+    return false;
+  }
+  if (length == ~vtkTypeUInt32(0))
+  {
+    str = nullptr;
+    length = 0;
+    return true;
+  }
+  if (static_cast<vtkTypeUInt64>(end - *data) < length)
+  {
+    return false;
+  }
+  str = *data;
+  *data += length;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElement::SaveBinary(std::string& buffer)
+{
+  vtkPVXMLElementSaveString(buffer, this->Name);
+  vtkPVXMLElementSaveString(buffer, this->Id);
+  const vtkTypeUInt32 numAttributes =
+    static_cast<vtkTypeUInt32>(this->Internal->AttributeNames.size());
+  buffer.append(reinterpret_cast<const char*>(&numAttributes), sizeof(numAttributes));
+  for (vtkTypeUInt32 i = 0; i < numAttributes; ++i)
+  {
+    const std::string& attrName = this->Internal->AttributeNames[i];
+    const std::string& attrValue = this->Internal->AttributeValues[i];
+    vtkPVXMLElementSaveString(buffer, attrName.c_str(), attrName.size());
+    vtkPVXMLElementSaveString(buffer, attrValue.c_str(), attrValue.size());
+  }
+  vtkPVXMLElementSaveString(
+    buffer, this->Internal->CharacterData.c_str(), this->Internal->CharacterData.size());
+  const vtkTypeUInt32 numNested =
+    static_cast<vtkTypeUInt32>(this->Internal->NestedElements.size());
+  buffer.append(reinterpret_cast<const char*>(&numNested), sizeof(numNested));
+  for (vtkTypeUInt32 i = 0; i < numNested; ++i)
+  {
+    this->Internal->NestedElements[i]->SaveBinary(buffer);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLElement* vtkPVXMLElement::NewFromBinary(const char** data, const char* end)
+{
+  const char* str;
+  vtkTypeUInt32 length;
+  vtkSmartPointer<vtkPVXMLElement> element = vtkSmartPointer<vtkPVXMLElement>::New();
+  if (!vtkPVXMLElementLoadString(data, end, str, length))
+  {
+    return nullptr;
+  }
+  element->SetName(str ? std::string(str, length).c_str() : nullptr);
+  if (!vtkPVXMLElementLoadString(data, end, str, length))
+  {
+    return nullptr;
+  }
+  element->SetId(str ? std::string(str, length).c_str() : nullptr);
+
+  vtkTypeUInt32 numAttributes;
+  if (!vtkPVXMLElementLoadSize(data, end, numAttributes))
+  {
+    return nullptr;
+  }
+  for (vtkTypeUInt32 i = 0; i < numAttributes; ++i)
+  {
+    const char* value;
+    vtkTypeUInt32 valueLength;
+    if (!vtkPVXMLElementLoadString(data, end, str, length) ||
+      !vtkPVXMLElementLoadString(data, end, value, valueLength))
+    {
+      return nullptr;
+    }
+    element->Internal->AttributeNames.push_back(std::string(str ? str : "", length));
+    element->Internal->AttributeValues.push_back(std::string(value ? value : "", valueLength));
+  }
+  if (!vtkPVXMLElementLoadString(data, end, str, length))
+  {
+    return nullptr;
+  }
+  element->Internal->CharacterData.assign(str ? str : "", length);
+
+  vtkTypeUInt32 numNested;
+  if (!vtkPVXMLElementLoadSize(data, end, numNested))
+  {
+    return nullptr;
+  }
+  element->Internal->NestedElements.reserve(std::min<vtkTypeUInt64>(numNested, end - *data));
+  for (vtkTypeUInt32 i = 0; i < numNested; ++i)
+  {
+    vtkSmartPointer<vtkPVXMLElement> nested;
+    nested.TakeReference(vtkPVXMLElement::NewFromBinary(data, end));
+    if (!nested)
+    {
+      return nullptr;
+    }
+    element->AddNestedElement(nested);
+  }
+  element->Register(nullptr);
+  return element;
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVXMLElement::Equals(vtkPVXMLElement* other)
 {
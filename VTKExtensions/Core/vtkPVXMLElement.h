@@ -263,6 +263,22 @@ public:
    */
   void CopyAttributesTo(vtkPVXMLElement* other);
 
+#ifndef __VTK_WRAP__
+  //@{
+  /**
+   * Append the element, with its attributes, character data and nested
+   * elements, to `buffer` in a compact binary form. NewFromBinary() restores
+   * an element from that form much faster than vtkPVXMLParser parses XML: it
+   * reads from `*data`, never past `end`, and advances `*data` past the
+   * element. It returns nullptr if the data is truncated or invalid. The form
+   * depends on the byte order of the host.
+   */
+  void SaveBinary(std::string& buffer);
+  VTK_NEWINSTANCE
+  static vtkPVXMLElement* NewFromBinary(const char** data, const char* end);
+  //@}
+#endif
+
 protected:
   vtkPVXMLElement();
   ~vtkPVXMLElement() override;
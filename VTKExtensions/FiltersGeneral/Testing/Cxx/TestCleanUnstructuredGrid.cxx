@@ -0,0 +1,262 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCleanUnstructuredGrid.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Merges the points of a grid of hexahedra and polyhedra that do not share
+// their points, with and without UseParallelMerge, compares the outputs and
+// reports the time taken for an increasing number of threads. Also checks
+// that the parallel merge leaves the input untouched and keeps the points
+// with NaN coordinates apart. Use `--cells=<N>` to time larger grids.
+
+#include "vtkCleanUnstructuredGrid.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <cmath>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+vtkSmartPointer<vtkUnstructuredGrid> CreateGrid(int cellsPerSide)
+{
+  static const int faces[6][4] = { { 0, 3, 2, 1 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 },
+    { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 0, 4, 7 } };
+
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> distance;
+  distance->SetName("distance");
+  grid->Allocate(cellsPerSide * cellsPerSide * cellsPerSide);
+  vtkNew<vtkIdList> stream;
+  vtkIdType cellId = 0;
+  for (int k = 0; k < cellsPerSide; ++k)
+  {
+    for (int j = 0; j < cellsPerSide; ++j)
+    {
+      for (int i = 0; i < cellsPerSide; ++i, ++cellId)
+      {
+        vtkIdType ids[8];
+        for (int corner = 0; corner < 8; ++corner)
+        {
+          const int x = i + ((corner + 1) / 2) % 2;
+          const int y = j + (corner / 2) % 2;
+          const int z = k + corner / 4;
+          ids[corner] = points->InsertNextPoint(x, y, z);
+          distance->InsertNextValue(x * x + y * y + z * z);
+        }
+        if (cellId % 10 == 0)
+        {
+          stream->Reset();
+          for (int face = 0; face < 6; ++face)
+          {
+            stream->InsertNextId(4);
+            for (int corner = 0; corner < 4; ++corner)
+            {
+              stream->InsertNextId(ids[faces[face][corner]]);
+            }
+          }
+          grid->InsertNextCell(VTK_POLYHEDRON, 8, ids, 6, stream->GetPointer(0));
+        }
+        else
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+        }
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(distance);
+  return grid;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> Clean(vtkUnstructuredGrid* input, bool parallel)
+{
+  vtkNew<vtkCleanUnstructuredGrid> clean;
+  clean->SetInputData(input);
+  clean->SetUseParallelMerge(parallel);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  clean->Update();
+  timer->StopTimer();
+  cout << (parallel ? "parallel" : "serial") << " ("
+       << (parallel ? vtkSMPTools::GetEstimatedNumberOfThreads() : 1)
+       << " threads): " << timer->GetElapsedTime() << " s" << endl;
+  return clean->GetOutput();
+}
+
+bool Compare(vtkUnstructuredGrid* expected, vtkUnstructuredGrid* output)
+{
+  if (expected->GetNumberOfPoints() != output->GetNumberOfPoints() ||
+    expected->GetNumberOfCells() != output->GetNumberOfCells())
+  {
+    cerr << "Mismatched number of points or cells." << endl;
+    return false;
+  }
+  vtkDataArray* expectedDistance = expected->GetPointData()->GetArray("distance");
+  vtkDataArray* distance = output->GetPointData()->GetArray("distance");
+  if (distance == nullptr)
+  {
+    cerr << "Missing point data." << endl;
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfPoints(); ++cc)
+  {
+    double x[3], y[3];
+    expected->GetPoint(cc, x);
+    output->GetPoint(cc, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+      expectedDistance->GetComponent(cc, 0) != distance->GetComponent(cc, 0))
+    {
+      cerr << "Mismatched point " << cc << endl;
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> expectedIds;
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfCells(); ++cc)
+  {
+    if (expected->GetCellType(cc) != output->GetCellType(cc))
+    {
+      cerr << "Mismatched type of cell " << cc << endl;
+      return false;
+    }
+    if (expected->GetCellType(cc) == VTK_POLYHEDRON)
+    {
+      expected->GetFaceStream(cc, expectedIds);
+      output->GetFaceStream(cc, ids);
+    }
+    else
+    {
+      expected->GetCellPoints(cc, expectedIds);
+      output->GetCellPoints(cc, ids);
+    }
+    bool same = expectedIds->GetNumberOfIds() == ids->GetNumberOfIds();
+    for (vtkIdType id = 0; same && id < ids->GetNumberOfIds(); ++id)
+    {
+      same = expectedIds->GetId(id) == ids->GetId(id);
+    }
+    if (!same)
+    {
+      cerr << "Mismatched points of cell " << cc << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Adds vertices at points with NaN coordinates to a grid, twice each, and
+// checks that the parallel merge keeps every one of them apart.
+bool CheckNaNPoints()
+{
+  auto grid = CreateGrid(2);
+  const vtkIdType numberOfPoints = 27;
+  const double nan = vtkMath::Nan();
+  const double coordinates[4][3] = { { nan, 0, 0 }, { 0, nan, 1 }, { 1, 1, nan },
+    { nan, nan, nan } };
+  for (int copy = 0; copy < 2; ++copy)
+  {
+    for (const auto& x : coordinates)
+    {
+      const vtkIdType id = grid->GetPoints()->InsertNextPoint(x);
+      grid->GetPointData()->GetArray("distance")->InsertNextTuple1(-1);
+      grid->InsertNextCell(VTK_VERTEX, 1, &id);
+    }
+  }
+
+  vtkSMPTools::Initialize();
+  auto output = Clean(grid, true);
+  if (output->GetNumberOfPoints() != numberOfPoints + 8)
+  {
+    cerr << "Incorrect number of points with NaNs: " << output->GetNumberOfPoints() << endl;
+    return false;
+  }
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType cc = output->GetNumberOfCells() - 8; cc < output->GetNumberOfCells(); ++cc)
+  {
+    double x[3];
+    output->GetCellPoints(cc, ids);
+    output->GetPoint(ids->GetId(0), x);
+    if (!std::isnan(x[0]) && !std::isnan(x[1]) && !std::isnan(x[2]))
+    {
+      cerr << "Vertex " << cc << " lost its NaN point." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestCleanUnstructuredGrid(int argc, char* argv[])
+{
+  int cells = 50000;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument("--cells", argT::EQUAL_ARGUMENT, &cells, "Approximate number of cells.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse() || cells < 1)
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  int cellsPerSide = 1;
+  while ((cellsPerSide + 1) * (cellsPerSide + 1) * (cellsPerSide + 1) <= cells)
+  {
+    ++cellsPerSide;
+  }
+  auto grid = CreateGrid(cellsPerSide);
+  cout << grid->GetNumberOfCells() << " cells, " << grid->GetNumberOfPoints() << " points"
+       << endl;
+
+  auto expected = Clean(grid, false);
+  const vtkIdType sideLength = cellsPerSide + 1;
+  if (expected->GetNumberOfPoints() != sideLength * sideLength * sideLength)
+  {
+    cerr << "Incorrect number of merged points: " << expected->GetNumberOfPoints() << endl;
+    return TEST_FAILED;
+  }
+
+  // the output shares the cell types with the input, which must keep its size.
+  const vtkIdType cellTypesSize = grid->GetCellTypesArray()->GetSize();
+  vtkSMPTools::Initialize();
+  const int maxThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  for (int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    vtkSMPTools::Initialize(threads);
+    if (!Compare(expected, Clean(grid, true)))
+    {
+      return TEST_FAILED;
+    }
+  }
+  if (grid->GetCellTypesArray()->GetSize() != cellTypesSize)
+  {
+    cerr << "The input cell types were modified." << endl;
+    return TEST_FAILED;
+  }
+  return CheckNaNPoints() ? TEST_SUCCESS : TEST_FAILED;
+}
@@ -0,0 +1,200 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestIsoVolume.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Extracts a band of a linear field on an image and on an unstructured grid
+// of hexahedra with vtkIsoVolume, checks the volume and the scalars of the
+// output and compares the time taken against clipping twice with
+// vtkPVClipDataSet. Use `--dimension=<N>` to time larger grids.
+
+#include "vtkCellData.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkIsoVolume.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVClipDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTetra.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <cmath>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+const double Lower = 2.3;
+const double Upper = 5.6;
+
+// Sums the volume of the voxels, hexahedra and tetrahedra of `grid`, which
+// are axis aligned boxes or tetrahedra here.
+double ComputeVolume(vtkUnstructuredGrid* grid)
+{
+  double volume = 0.0;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cc = 0; cc < grid->GetNumberOfCells(); ++cc)
+  {
+    grid->GetCellPoints(cc, ptIds);
+    if (grid->GetCellType(cc) == VTK_TETRA)
+    {
+      double x[4][3];
+      for (int i = 0; i < 4; ++i)
+      {
+        grid->GetPoint(ptIds->GetId(i), x[i]);
+      }
+      volume += std::abs(vtkTetra::ComputeVolume(x[0], x[1], x[2], x[3]));
+    }
+    else
+    {
+      double bounds[6];
+      grid->GetCellBounds(cc, bounds);
+      volume += (bounds[1] - bounds[0]) * (bounds[3] - bounds[2]) * (bounds[5] - bounds[4]);
+    }
+  }
+  return volume;
+}
+
+bool Check(vtkUnstructuredGrid* output, int dimension, const char* name)
+{
+  const double expected = (Upper - Lower) * (dimension - 1) * (dimension - 1);
+  const double volume = ComputeVolume(output);
+  if (std::abs(volume - expected) > 1e-6 * expected)
+  {
+    cerr << name << ": incorrect volume " << volume << " (expected " << expected << ")" << endl;
+    return false;
+  }
+  vtkDataArray* scalars = output->GetPointData()->GetArray("x");
+  vtkDataArray* ids = output->GetCellData()->GetArray("ids");
+  if (scalars == nullptr || ids == nullptr)
+  {
+    cerr << name << ": missing arrays." << endl;
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < output->GetNumberOfPoints(); ++cc)
+  {
+    const double s = scalars->GetComponent(cc, 0);
+    if (std::abs(s - output->GetPoint(cc)[0]) > 1e-6)
+    {
+      cerr << name << ": incorrect scalar at point " << cc << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> IsoVolume(vtkDataObject* input, const char* name)
+{
+  vtkNew<vtkIsoVolume> isoVolume;
+  isoVolume->SetInputData(input);
+  isoVolume->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "x");
+  isoVolume->ThresholdBetween(Lower, Upper);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  isoVolume->Update();
+  timer->StopTimer();
+  cout << name << ": " << timer->GetElapsedTime() << " s" << endl;
+  vtkDataObject* output = isoVolume->GetOutputDataObject(0);
+  if (vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(output))
+  {
+    return vtkUnstructuredGrid::SafeDownCast(mb->GetBlock(0));
+  }
+  return vtkUnstructuredGrid::SafeDownCast(output);
+}
+
+void ClipTwice(vtkDataObject* input, const char* name)
+{
+  vtkNew<vtkPVClipDataSet> lower;
+  lower->SetInputData(input);
+  lower->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "x");
+  lower->SetValue(Lower);
+  vtkNew<vtkPVClipDataSet> upper;
+  upper->SetInputConnection(lower->GetOutputPort());
+  upper->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "x");
+  upper->SetValue(Upper);
+  upper->InsideOutOn();
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  upper->Update();
+  timer->StopTimer();
+  cout << name << " (clipping twice): " << timer->GetElapsedTime() << " s" << endl;
+}
+}
+
+int TestIsoVolume(int argc, char* argv[])
+{
+  int dimension = 40;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument(
+    "--dimension", argT::EQUAL_ARGUMENT, &dimension, "Number of points along each axis.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse() || dimension < 8)
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(dimension, dimension, dimension);
+  vtkNew<vtkDoubleArray> x;
+  x->SetName("x");
+  x->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    x->SetValue(cc, image->GetPoint(cc)[0]);
+  }
+  image->GetPointData()->AddArray(x);
+  vtkNew<vtkDoubleArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfTuples(image->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfCells(); ++cc)
+  {
+    ids->SetValue(cc, cc);
+  }
+  image->GetCellData()->AddArray(ids);
+
+  // the same grid made of tetrahedra.
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputData(image);
+  tetrahedralize->Update();
+  vtkUnstructuredGrid* tetras = tetrahedralize->GetOutput();
+
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetBlock(0, tetras);
+
+  auto imageBand = IsoVolume(image, "image");
+  ClipTwice(image, "image");
+  auto tetrasBand = IsoVolume(tetras, "tetrahedra");
+  ClipTwice(tetras, "tetrahedra");
+  auto blocksBand = IsoVolume(blocks, "multiblock");
+  if (imageBand == nullptr || tetrasBand == nullptr || blocksBand == nullptr)
+  {
+    cerr << "Missing output." << endl;
+    return TEST_FAILED;
+  }
+  return Check(imageBand, dimension, "image") && Check(tetrasBand, dimension, "tetrahedra") &&
+      Check(blocksBand, dimension, "multiblock")
+    ? TEST_SUCCESS
+    : TEST_FAILED;
+}
@@ -0,0 +1,322 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVGlyphFilter.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Glyphs point clouds of increasing sizes with vtkPVGlyphFilter, checks the
+// placement, the scale and the point data of the glyphs and that the output
+// does not depend on the number of threads, and reports the time taken for
+// each number of threads. Also checks that an IsPointVisible() overridden by
+// a subclass is called serially. Use `--points=<N>` to time larger point
+// clouds.
+
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVGlyphFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <cmath>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+const double ScaleFactor = 0.5;
+
+// Hides every 5th point, with an IsPointVisible() that is not thread safe
+// and records whether it was called with increasing point ids.
+class vtkSerialVisibilityGlyphFilter : public vtkPVGlyphFilter
+{
+public:
+  vtkTypeMacro(vtkSerialVisibilityGlyphFilter, vtkPVGlyphFilter);
+  static vtkSerialVisibilityGlyphFilter* New();
+
+  bool Ordered = true;
+
+protected:
+  vtkSerialVisibilityGlyphFilter() = default;
+  ~vtkSerialVisibilityGlyphFilter() override = default;
+
+  int IsPointVisible(unsigned int index, vtkDataSet* ds, vtkIdType ptId, bool cellCenters) override
+  {
+    this->Ordered = this->Ordered && ptId > this->LastPointId;
+    this->LastPointId = ptId;
+    return ptId % 5 != 0 && this->Superclass::IsPointVisible(index, ds, ptId, cellCenters);
+  }
+
+  vtkIdType LastPointId = -1;
+};
+vtkStandardNewMacro(vtkSerialVisibilityGlyphFilter);
+
+// Random points with a scale, a vector and an id array. Every 7th point is a
+// duplicate ghost point, which must not be glyphed.
+vtkSmartPointer<vtkPolyData> CreatePoints(vtkIdType numberOfPoints)
+{
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numberOfPoints);
+  vtkNew<vtkDoubleArray> scale;
+  scale->SetName("scale");
+  scale->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkDoubleArray> vector;
+  vector->SetName("vector");
+  vector->SetNumberOfComponents(3);
+  vector->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(numberOfPoints);
+  vtkMath::RandomSeed(1234);
+  for (vtkIdType cc = 0; cc < numberOfPoints; ++cc)
+  {
+    points->SetPoint(
+      cc, vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0));
+    scale->SetValue(cc, vtkMath::Random(0.1, 1.0));
+    vector->SetTuple3(
+      cc, vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0));
+    ids->SetValue(cc, cc);
+    ghosts->SetValue(cc, cc % 7 == 0 ? vtkDataSetAttributes::DUPLICATEPOINT : 0);
+  }
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(scale);
+  input->GetPointData()->AddArray(vector);
+  input->GetPointData()->AddArray(ids);
+  input->GetPointData()->AddArray(ghosts);
+  return input;
+}
+
+// A glyph made of a vertex at the origin, a line and a triangle, with normals.
+vtkSmartPointer<vtkPolyData> CreateSource()
+{
+  auto source = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 0.0, 0.0);
+  points->InsertNextPoint(0.0, 0.2, 0.0);
+  points->InsertNextPoint(0.0, 0.0, 0.2);
+  vtkNew<vtkFloatArray> normals;
+  normals->SetNumberOfComponents(3);
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    normals->InsertNextTuple3(1.0, 0.0, 0.0);
+  }
+  source->SetPoints(points);
+  source->GetPointData()->SetNormals(normals);
+  source->Allocate();
+  const vtkIdType vertex[1] = { 0 };
+  const vtkIdType line[2] = { 0, 1 };
+  const vtkIdType triangle[3] = { 1, 2, 3 };
+  source->InsertNextCell(VTK_VERTEX, 1, vertex);
+  source->InsertNextCell(VTK_LINE, 2, line);
+  source->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  return source;
+}
+
+vtkSmartPointer<vtkPolyData> Glyph(vtkPolyData* input, vtkPolyData* source, int glyphMode)
+{
+  vtkNew<vtkPVGlyphFilter> glyph;
+  glyph->SetController(nullptr);
+  glyph->SetInputData(input);
+  glyph->SetInputData(1, source);
+  glyph->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "scale");
+  glyph->SetInputArrayToProcess(1, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "vector");
+  glyph->SetScaleFactor(ScaleFactor);
+  glyph->SetGlyphMode(glyphMode);
+  glyph->SetStride(3);
+  glyph->SetMaximumNumberOfSamplePoints(1000);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  glyph->Update();
+  timer->StopTimer();
+  cout << "  " << vtkSMPTools::GetEstimatedNumberOfThreads()
+       << " threads: " << timer->GetElapsedTime() << " s" << endl;
+  return vtkPolyData::SafeDownCast(glyph->GetOutputDataObject(0));
+}
+
+// Checks that each glyph is placed at its input point and scaled by the
+// scale array, and that it carries the point data of its input point.
+bool Check(vtkPolyData* input, vtkPolyData* output, int glyphMode)
+{
+  vtkIdType expected = 0;
+  for (vtkIdType cc = 0; cc < input->GetNumberOfPoints(); ++cc)
+  {
+    expected += cc % 7 != 0 && (glyphMode == vtkPVGlyphFilter::ALL_POINTS || cc % 3 == 0) ? 1 : 0;
+  }
+  vtkDataArray* ids = output->GetPointData()->GetArray("ids");
+  vtkDataArray* scale = input->GetPointData()->GetArray("scale");
+  if (glyphMode != vtkPVGlyphFilter::SPATIALLY_UNIFORM_DISTRIBUTION &&
+    output->GetNumberOfPoints() != 4 * expected)
+  {
+    cerr << "Expected " << expected << " glyphs, got " << output->GetNumberOfPoints() / 4 << endl;
+    return false;
+  }
+  if (ids == nullptr || output->GetPointData()->GetNormals() == nullptr ||
+    output->GetNumberOfVerts() != output->GetNumberOfPoints() / 4 ||
+    output->GetNumberOfLines() != output->GetNumberOfPoints() / 4 ||
+    output->GetNumberOfPolys() != output->GetNumberOfPoints() / 4)
+  {
+    cerr << "Missing point data or cells." << endl;
+    return false;
+  }
+  for (vtkIdType glyph = 0; glyph < output->GetNumberOfPoints() / 4; ++glyph)
+  {
+    const vtkIdType ptId = static_cast<vtkIdType>(ids->GetComponent(4 * glyph, 0));
+    double x[3], origin[3], tip[3];
+    input->GetPoint(ptId, x);
+    output->GetPoint(4 * glyph, origin);
+    output->GetPoint(4 * glyph + 1, tip);
+    const double length = std::sqrt(vtkMath::Distance2BetweenPoints(origin, tip));
+    if (ptId % 7 == 0 || vtkMath::Distance2BetweenPoints(x, origin) > 1e-10 ||
+      std::abs(length - ScaleFactor * scale->GetComponent(ptId, 0)) > 1e-5 ||
+      ids->GetComponent(4 * glyph + 3, 0) != ptId)
+    {
+      cerr << "Incorrect glyph " << glyph << " for point " << ptId << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Compare(vtkPolyData* expected, vtkPolyData* output)
+{
+  if (expected->GetNumberOfPoints() != output->GetNumberOfPoints() ||
+    expected->GetNumberOfCells() != output->GetNumberOfCells())
+  {
+    cerr << "Mismatched number of points or cells." << endl;
+    return false;
+  }
+  vtkDataArray* expectedIds = expected->GetPointData()->GetArray("ids");
+  vtkDataArray* ids = output->GetPointData()->GetArray("ids");
+  vtkDataArray* expectedNormals = expected->GetPointData()->GetNormals();
+  vtkDataArray* normals = output->GetPointData()->GetNormals();
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfPoints(); ++cc)
+  {
+    double x[3], y[3], n[3], m[3];
+    expected->GetPoint(cc, x);
+    output->GetPoint(cc, y);
+    expectedNormals->GetTuple(cc, n);
+    normals->GetTuple(cc, m);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] || n[0] != m[0] || n[1] != m[1] ||
+      n[2] != m[2] || expectedIds->GetComponent(cc, 0) != ids->GetComponent(cc, 0))
+    {
+      cerr << "Mismatched point " << cc << endl;
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> expectedPts;
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfCells(); ++cc)
+  {
+    expected->GetCellPoints(cc, expectedPts);
+    output->GetCellPoints(cc, pts);
+    bool same = expected->GetCellType(cc) == output->GetCellType(cc) &&
+      expectedPts->GetNumberOfIds() == pts->GetNumberOfIds();
+    for (vtkIdType id = 0; same && id < pts->GetNumberOfIds(); ++id)
+    {
+      same = expectedPts->GetId(id) == pts->GetId(id);
+    }
+    if (!same)
+    {
+      cerr << "Mismatched cell " << cc << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckSerialVisibility(vtkPolyData* input, vtkPolyData* source)
+{
+  vtkIdType expected = 0;
+  for (vtkIdType cc = 0; cc < input->GetNumberOfPoints(); ++cc)
+  {
+    expected += cc % 7 != 0 && cc % 5 != 0 ? 1 : 0;
+  }
+  vtkSMPTools::Initialize();
+  vtkNew<vtkSerialVisibilityGlyphFilter> glyph;
+  glyph->SetController(nullptr);
+  glyph->SetInputData(input);
+  glyph->SetInputData(1, source);
+  glyph->SetGlyphMode(vtkPVGlyphFilter::ALL_POINTS);
+  glyph->Update();
+  if (!glyph->Ordered || glyph->GetOutput()->GetNumberOfPoints() != 4 * expected)
+  {
+    cerr << "Overridden IsPointVisible() not called serially." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPVGlyphFilter(int argc, char* argv[])
+{
+  int numberOfPoints = 200000;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument(
+    "--points", argT::EQUAL_ARGUMENT, &numberOfPoints, "Number of points of the largest cloud.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse() || numberOfPoints < 100)
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  auto source = CreateSource();
+  vtkSMPTools::Initialize();
+  const int maxThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  const int glyphModes[3] = { vtkPVGlyphFilter::ALL_POINTS, vtkPVGlyphFilter::EVERY_NTH_POINT,
+    vtkPVGlyphFilter::SPATIALLY_UNIFORM_DISTRIBUTION };
+  for (vtkIdType size = numberOfPoints / 100; size <= numberOfPoints; size *= 10)
+  {
+    auto input = CreatePoints(size);
+    for (int glyphMode : glyphModes)
+    {
+      cout << size << " points, glyph mode " << glyphMode << endl;
+      vtkSMPTools::Initialize(1);
+      auto expected = Glyph(input, source, glyphMode);
+      if (!Check(input, expected, glyphMode))
+      {
+        return TEST_FAILED;
+      }
+      for (int threads = 2; threads <= maxThreads; threads *= 2)
+      {
+        vtkSMPTools::Initialize(threads);
+        if (!Compare(expected, Glyph(input, source, glyphMode)))
+        {
+          return TEST_FAILED;
+        }
+      }
+    }
+  }
+  return CheckSerialVisibility(CreatePoints(numberOfPoints / 10), source) ? TEST_SUCCESS
+                                                                          : TEST_FAILED;
+}
@@ -14,10 +14,15 @@ PURPOSE.  See the above copyright notice for more information.
 =========================================================================*/
 #include "vtkCleanUnstructuredGrid.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCollection.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -28,8 +33,247 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Orders point ids by their coordinates, compared in the precision of the
+// output points, then by id. NaN coordinates come after all the others and
+// are equivalent to each other, but points with NaNs are never equal.
+template <typename ArrayT, typename ValueT>
+struct CoordinatesLess
+{
+  ArrayT* Points;
+
+  bool operator()(vtkIdType a, vtkIdType b) const
+  {
+    vtkDataArrayAccessor<ArrayT> points(this->Points);
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      const ValueT va = static_cast<ValueT>(points.Get(a, comp));
+      const ValueT vb = static_cast<ValueT>(points.Get(b, comp));
+      const bool nanA = std::isnan(va);
+      const bool nanB = std::isnan(vb);
+      if (nanA || nanB)
+      {
+        if (nanA != nanB)
+        {
+          return nanB;
+        }
+      }
+      else if (va != vb)
+      {
+        return va < vb;
+      }
+    }
+    return a < b;
+  }
+
+  bool Equal(vtkIdType a, vtkIdType b) const
+  {
+    vtkDataArrayAccessor<ArrayT> points(this->Points);
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      if (static_cast<ValueT>(points.Get(a, comp)) != static_cast<ValueT>(points.Get(b, comp)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Maps each point to the smallest id of the points with the same coordinates.
+// The point ids are sorted by coordinates, then each run of equal coordinates
+// is mapped to its first id.
+struct MapDuplicatePointsWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* points, bool doublePrecision, std::vector<vtkIdType>& firstIds)
+  {
+    if (doublePrecision)
+    {
+      this->Execute(CoordinatesLess<ArrayT, double>{ points }, firstIds);
+    }
+    else
+    {
+      this->Execute(CoordinatesLess<ArrayT, float>{ points }, firstIds);
+    }
+  }
+
+  template <typename LessT>
+  void Execute(const LessT& less, std::vector<vtkIdType>& firstIds)
+  {
+    const vtkIdType numPts = less.Points->GetNumberOfTuples();
+    std::vector<vtkIdType> order(numPts);
+    std::iota(order.begin(), order.end(), 0);
+    vtkSMPTools::Sort(order.begin(), order.end(), less);
+
+    firstIds.resize(numPts);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      // process the runs that start in [begin, end).
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        if (cc > 0 && less.Equal(order[cc - 1], order[cc]))
+        {
+          continue;
+        }
+        const vtkIdType first = order[cc];
+        vtkIdType next = cc;
+        do
+        {
+          firstIds[order[next]] = first;
+          ++next;
+        } while (next < numPts && less.Equal(first, order[next]));
+      }
+    });
+  }
+};
+
+//----------------------------------------------------------------------------
+void MapDuplicatePoints(vtkDataSet* input, bool doublePrecision, std::vector<vtkIdType>& firstIds)
+{
+  vtkSmartPointer<vtkDataArray> points;
+  vtkPointSet* ps = vtkPointSet::SafeDownCast(input);
+  if (ps && ps->GetPoints())
+  {
+    points = ps->GetPoints()->GetData();
+  }
+  else
+  {
+    points = vtkSmartPointer<vtkDoubleArray>::New();
+    points->SetNumberOfComponents(3);
+    points->SetNumberOfTuples(input->GetNumberOfPoints());
+    for (vtkIdType cc = 0; cc < input->GetNumberOfPoints(); ++cc)
+    {
+      points->SetTuple(cc, input->GetPoint(cc));
+    }
+  }
+
+  MapDuplicatePointsWorker worker;
+  using Dispatcher = vtkArrayDispatch::DispatchByValueType<vtkArrayDispatch::Reals>;
+  if (!Dispatcher::Execute(points, worker, doublePrecision, firstIds))
+  {
+    // the generic vtkDataArray API is not thread-safe, use a copy.
+    vtkNew<vtkDoubleArray> copy;
+    copy->DeepCopy(points);
+    worker(copy.GetPointer(), doublePrecision, firstIds);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Numbers the first point of each group of duplicates in id order, as the
+// locator does, and maps all the points to the number of their group.
+void NumberUniquePoints(
+  const std::vector<vtkIdType>& firstIds, std::vector<vtkIdType>& pointMap, vtkIdList* sourceIds)
+{
+  const vtkIdType numPts = static_cast<vtkIdType>(firstIds.size());
+  const vtkIdType chunkSize = 65536;
+  const vtkIdType numChunks = (numPts + chunkSize - 1) / chunkSize;
+  std::vector<vtkIdType> offsets(numChunks + 1, 0);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+    {
+      vtkIdType count = 0;
+      for (vtkIdType id = chunk * chunkSize; id < std::min(numPts, (chunk + 1) * chunkSize); ++id)
+      {
+        count += firstIds[id] == id ? 1 : 0;
+      }
+      offsets[chunk + 1] = count;
+    }
+  });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  sourceIds->SetNumberOfIds(offsets[numChunks]);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+    {
+      vtkIdType next = offsets[chunk];
+      for (vtkIdType id = chunk * chunkSize; id < std::min(numPts, (chunk + 1) * chunkSize); ++id)
+      {
+        if (firstIds[id] == id)
+        {
+          pointMap[id] = next;
+          sourceIds->SetId(next, id);
+          ++next;
+        }
+      }
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType id = begin; id < end; ++id)
+    {
+      if (firstIds[id] != id)
+      {
+        pointMap[id] = pointMap[firstIds[id]];
+      }
+    }
+  });
+}
+
+//----------------------------------------------------------------------------
+template <typename ArrayT>
+void RemapIds(ArrayT* ids, const vtkIdType* pointMap)
+{
+  using ValueType = typename ArrayT::ValueType;
+  ValueType* values = ids->GetPointer(0);
+  vtkSMPTools::For(0, ids->GetNumberOfValues(), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      values[cc] = static_cast<ValueType>(pointMap[values[cc]]);
+    }
+  });
+}
+
+//----------------------------------------------------------------------------
+// Copies the cells of `input` to `output` with their point ids mapped by
+// `pointMap`, in parallel. The cell types and face locations are shared.
+void RemapCells(vtkUnstructuredGrid* input, vtkUnstructuredGrid* output, vtkIdType* pointMap)
+{
+  vtkNew<vtkCellArray> cells;
+  cells->DeepCopy(input->GetCells());
+  if (cells->IsStorage64Bit())
+  {
+    RemapIds(cells->GetConnectivityArray64(), pointMap);
+  }
+  else
+  {
+    RemapIds(cells->GetConnectivityArray32(), pointMap);
+  }
+
+  vtkIdTypeArray* faceLocations = input->GetFaceLocations();
+  if (input->GetFaces() == nullptr || faceLocations == nullptr)
+  {
+    output->SetCells(input->GetCellTypesArray(), cells);
+    return;
+  }
+
+  vtkNew<vtkIdTypeArray> faces;
+  faces->DeepCopy(input->GetFaces());
+  vtkIdType* stream = faces->GetPointer(0);
+  const vtkIdType* locations = faceLocations->GetPointer(0);
+  vtkSMPTools::For(0, faceLocations->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (locations[cellId] >= 0)
+      {
+        vtkIdType* cellFaces = stream + locations[cellId];
+        vtkUnstructuredGrid::ConvertFaceStreamPointIds(cellFaces[0], cellFaces + 1, pointMap);
+      }
+    }
+  });
+  output->SetCells(input->GetCellTypesArray(), cells, faceLocations, faces);
+}
+}
+
 vtkStandardNewMacro(vtkCleanUnstructuredGrid);
 vtkCxxSetObjectMacro(vtkCleanUnstructuredGrid, Locator, vtkIncrementalPointLocator);
 
@@ -43,6 +287,7 @@ vtkCleanUnstructuredGrid::~vtkCleanUnstructuredGrid()
 void vtkCleanUnstructuredGrid::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseParallelMerge: " << this->UseParallelMerge << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -103,43 +348,102 @@ int vtkCleanUnstructuredGrid::RequestData(vtkInformation* vtkNotUsed(request),
   vtkIdType num = input->GetNumberOfPoints();
   vtkIdType id;
   vtkIdType newId;
-  vtkIdType* ptMap = new vtkIdType[num];
+  std::vector<vtkIdType> ptMap(num);
   double pt[3];
 
-  this->CreateDefaultLocator(input);
-  if (this->ToleranceIsAbsolute)
-  {
-    this->Locator->SetTolerance(this->AbsoluteTolerance);
-  }
-  else
-  {
-    this->Locator->SetTolerance(this->Tolerance * input->GetLength());
-  }
+  const double tolerance =
+    this->ToleranceIsAbsolute ? this->AbsoluteTolerance : this->Tolerance * input->GetLength();
   double bounds[6];
   input->GetBounds(bounds);
-  this->Locator->InitPointInsertion(newPts, bounds);
 
   vtkIdType progressStep = num / 100;
   if (progressStep == 0)
   {
     progressStep = 1;
   }
-  for (id = 0; id < num; ++id)
+  if (this->UseParallelMerge)
   {
-    if (id % progressStep == 0)
+    // find exact duplicates in parallel, then number the unique points,
+    // in parallel too when there is no tolerance.
+    std::vector<vtkIdType> firstIds;
+    MapDuplicatePoints(input, newPts->GetDataType() == VTK_DOUBLE, firstIds);
+    this->UpdateProgress(0.4);
+
+    vtkNew<vtkIdList> sourceIds;
+    if (tolerance == 0.0)
     {
-      this->UpdateProgress(0.8 * ((float)id / num));
+      NumberUniquePoints(firstIds, ptMap, sourceIds);
+      newPts->SetNumberOfPoints(sourceIds->GetNumberOfIds());
+      vtkSMPTools::For(0, sourceIds->GetNumberOfIds(), [&](vtkIdType begin, vtkIdType end) {
+        double x[3];
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          input->GetPoint(sourceIds->GetId(cc), x);
+          newPts->SetPoint(cc, x);
+        }
+      });
     }
-    input->GetPoint(id, pt);
-    if (this->Locator->InsertUniquePoint(pt, newId))
+    else
     {
-      output->GetPointData()->CopyData(input->GetPointData(), id, newId);
+      this->CreateDefaultLocator(input);
+      this->Locator->SetTolerance(tolerance);
+      this->Locator->InitPointInsertion(newPts, bounds);
+      for (id = 0; id < num; ++id)
+      {
+        if (firstIds[id] != id)
+        {
+          ptMap[id] = ptMap[firstIds[id]];
+          continue;
+        }
+        input->GetPoint(id, pt);
+        if (this->Locator->InsertUniquePoint(pt, newId))
+        {
+          sourceIds->InsertNextId(id);
+        }
+        ptMap[id] = newId;
+      }
+    }
+
+    vtkNew<vtkIdList> destIds;
+    destIds->SetNumberOfIds(sourceIds->GetNumberOfIds());
+    std::iota(destIds->GetPointer(0), destIds->GetPointer(0) + destIds->GetNumberOfIds(), 0);
+    output->GetPointData()->CopyAllocate(input->GetPointData(), sourceIds->GetNumberOfIds());
+    output->GetPointData()->CopyData(input->GetPointData(), sourceIds, destIds);
+    this->UpdateProgress(0.8);
+  }
+  else
+  {
+    this->CreateDefaultLocator(input);
+    this->Locator->SetTolerance(tolerance);
+    this->Locator->InitPointInsertion(newPts, bounds);
+
+    for (id = 0; id < num; ++id)
+    {
+      if (id % progressStep == 0)
+      {
+        this->UpdateProgress(0.8 * ((float)id / num));
+      }
+      input->GetPoint(id, pt);
+      if (this->Locator->InsertUniquePoint(pt, newId))
+      {
+        output->GetPointData()->CopyData(input->GetPointData(), id, newId);
+      }
+      ptMap[id] = newId;
     }
-    ptMap[id] = newId;
   }
   output->SetPoints(newPts);
   newPts->Delete();
 
+  vtkUnstructuredGrid* inputGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (this->UseParallelMerge && inputGrid)
+  {
+    RemapCells(inputGrid, output, ptMap.data());
+    // the cells are already allocated to size and the cell types, face
+    // locations and cell data are shared with the input: only squeeze the points.
+    output->GetPoints()->Squeeze();
+    return 1;
+  }
+
   // Now copy the cells.
   vtkIdList* cellPoints = vtkIdList::New();
   num = input->GetNumberOfCells();
@@ -151,10 +455,10 @@ int vtkCleanUnstructuredGrid::RequestData(vtkInformation* vtkNotUsed(request),
       this->UpdateProgress(0.8 + 0.2 * ((float)id / num));
     }
     // special handling for polyhedron cells
-    if (vtkUnstructuredGrid::SafeDownCast(input) && input->GetCellType(id) == VTK_POLYHEDRON)
+    if (inputGrid && input->GetCellType(id) == VTK_POLYHEDRON)
     {
-      vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(id, cellPoints);
-      vtkUnstructuredGrid::ConvertFaceStreamPointIds(cellPoints, ptMap);
+      inputGrid->GetFaceStream(id, cellPoints);
+      vtkUnstructuredGrid::ConvertFaceStreamPointIds(cellPoints, ptMap.data());
     }
     else
     {
@@ -169,7 +473,6 @@ int vtkCleanUnstructuredGrid::RequestData(vtkInformation* vtkNotUsed(request),
     output->InsertNextCell(input->GetCellType(id), cellPoints);
   }
 
-  delete[] ptMap;
   cellPoints->Delete();
   output->Squeeze();
 
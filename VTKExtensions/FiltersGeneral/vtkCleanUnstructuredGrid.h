@@ -21,7 +21,8 @@
  * vtkCleanUnstructuredGrid is a filter that takes unstructured grid data as
  * input and generates unstructured grid data as output. vtkCleanUnstructuredGrid can
  * merge duplicate points (with coincident coordinates) using the vtkMergePoints object
- * to merge points.
+ * to merge points. With UseParallelMerge, duplicate points are instead found by
+ * sorting the points in parallel.
  *
  * @sa
  * vtkCleanPolyData
@@ -69,6 +70,22 @@ public:
   vtkGetObjectMacro(Locator, vtkIncrementalPointLocator);
   //@}
 
+  //@{
+  /**
+   * When set, exact duplicate points are found by sorting the points by their
+   * coordinates, in parallel with vtkSMPTools, instead of inserting them one
+   * at a time in the locator, and the connectivity of unstructured grid inputs
+   * is remapped in parallel. With a zero tolerance, the locator is not used and
+   * the output is the same as without this option. With a non-zero tolerance,
+   * only the first point of each group of exact duplicates is inserted in the
+   * locator, so a point may be merged with another point within tolerance than
+   * without this option. Default is false.
+   */
+  vtkSetMacro(UseParallelMerge, bool);
+  vtkGetMacro(UseParallelMerge, bool);
+  vtkBooleanMacro(UseParallelMerge, bool);
+  //@}
+
   // Create default locator. Used to create one when none is specified.
   void CreateDefaultLocator(vtkDataSet* input = nullptr);
 
@@ -97,6 +114,7 @@ protected:
   double AbsoluteTolerance = 1.0;
   vtkIncrementalPointLocator* Locator = nullptr;
   int OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  bool UseParallelMerge = false;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int port, vtkInformation* info) override;
@@ -14,10 +14,15 @@
 =========================================================================*/
 #include "vtkIsoVolume.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCellTypes.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
+#include "vtkDataArrayAccessor.h"
+#include "vtkGenericCell.h"
 #include "vtkGenericClip.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
@@ -26,13 +31,301 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkObjectFactory.h"
+#include "vtkOrderedTriangulator.h"
 #include "vtkPVClipDataSet.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <assert.h>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+// Point types given to vtkOrderedTriangulator, as in vtkCell3D::Clip: OUTSIDE
+// points are not inserted in the triangulation.
+enum
+{
+  INSIDE = 0,
+  BOUNDARY = 2,
+  OUTSIDE = 4
+};
+
+// Edge intersections closer than this fraction of the edge length to one of
+// its end points are replaced by that point, as in vtkCell3D::Clip.
+const double MergeTolerance = 0.01;
+
+//----------------------------------------------------------------------------
+bool IsLinear3DCell(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_TETRA:
+    case VTK_VOXEL:
+    case VTK_HEXAHEDRON:
+    case VTK_WEDGE:
+    case VTK_PYRAMID:
+    case VTK_PENTAGONAL_PRISM:
+    case VTK_HEXAGONAL_PRISM:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//----------------------------------------------------------------------------
+// An intersection of an edge with one of the thresholds. The end points are
+// ordered by increasing scalar so that neighboring cells compute the same
+// point.
+struct EdgeIntersection
+{
+  vtkIdType Start;
+  vtkIdType End;
+  int Threshold;
+
+  bool operator==(const EdgeIntersection& other) const
+  {
+    return this->Start == other.Start && this->End == other.End &&
+      this->Threshold == other.Threshold;
+  }
+};
+
+// Combines the ordered end points and the threshold so that the two
+// intersections of an edge, and edges sharing an end point, hash apart.
+struct EdgeIntersectionHash
+{
+  size_t operator()(const EdgeIntersection& edge) const
+  {
+    const vtkTypeUInt64 start = static_cast<vtkTypeUInt64>(edge.Start);
+    const vtkTypeUInt64 end = static_cast<vtkTypeUInt64>(edge.End);
+    vtkTypeUInt64 hash = start * 0x9E3779B97F4A7C15ull ^ (end + (start << 6) + (start >> 2));
+    hash = hash * 0xFF51AFD7ED558CCDull ^ static_cast<vtkTypeUInt64>(edge.Threshold);
+    return static_cast<size_t>(hash ^ (hash >> 32));
+  }
+};
+
+//----------------------------------------------------------------------------
+// Extracts the parts of the cells whose point scalars are between the lower
+// and upper thresholds in a single pass. Cells entirely between the
+// thresholds are copied. The others are triangulated with their points
+// between the thresholds and the intersections of their edges with both
+// thresholds, as vtkCell3D::Clip does for one threshold.
+class BandClipWorker
+{
+public:
+  BandClipWorker(vtkDataSet* input, const double thresholds[2], vtkUnstructuredGrid* output)
+    : Input(input)
+    , Output(output)
+    , PointMap(input->GetNumberOfPoints(), -1)
+  {
+    this->Thresholds[0] = thresholds[0];
+    this->Thresholds[1] = thresholds[1];
+  }
+
+  template <typename ArrayT>
+  void operator()(ArrayT* scalarArray)
+  {
+    vtkDataArrayAccessor<ArrayT> scalars(scalarArray);
+    vtkDataSet* input = this->Input;
+    const vtkIdType numPts = input->GetNumberOfPoints();
+    const vtkIdType numCells = input->GetNumberOfCells();
+
+    vtkPointSet* ps = vtkPointSet::SafeDownCast(input);
+    vtkNew<vtkPoints> points;
+    points->SetDataType(ps && ps->GetPoints() ? ps->GetPoints()->GetDataType() : VTK_FLOAT);
+    this->Points = points;
+    this->Output->GetPointData()->InterpolateAllocate(input->GetPointData());
+    this->Output->GetCellData()->CopyAllocate(input->GetCellData());
+
+    vtkNew<vtkCellArray> cells;
+    vtkNew<vtkUnsignedCharArray> types;
+    vtkNew<vtkIdList> ptIds;
+    vtkNew<vtkGenericCell> cell;
+    vtkNew<vtkOrderedTriangulator> triangulator;
+    triangulator->PreSortedOff();
+    std::vector<vtkIdType> newIds;
+    std::vector<double> cellScalars;
+    std::vector<int> pointTypes;
+    std::vector<EdgeIntersection> intersections;
+    std::vector<double> intersectionT;
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      input->GetCellPoints(cellId, ptIds);
+      const vtkIdType npts = ptIds->GetNumberOfIds();
+      cellScalars.resize(npts);
+      pointTypes.resize(npts);
+      int numBelow = 0;
+      int numAbove = 0;
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        const double s = static_cast<double>(scalars.Get(ptIds->GetId(i), 0));
+        cellScalars[i] = s;
+        numBelow += s < this->Thresholds[0] ? 1 : 0;
+        numAbove += s > this->Thresholds[1] ? 1 : 0;
+        pointTypes[i] = s < this->Thresholds[0] || s > this->Thresholds[1] ? OUTSIDE : INSIDE;
+      }
+      if (numBelow == npts || numAbove == npts)
+      {
+        continue;
+      }
+
+      if (numBelow == 0 && numAbove == 0)
+      {
+        newIds.resize(npts);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          newIds[i] = this->GetPointId(ptIds->GetId(i));
+        }
+        const vtkIdType newCellId = cells->InsertNextCell(npts, newIds.data());
+        types->InsertNextValue(static_cast<unsigned char>(input->GetCellType(cellId)));
+        this->Output->GetCellData()->CopyData(input->GetCellData(), cellId, newCellId);
+        continue;
+      }
+
+      // find the edge intersections, or the points replacing them.
+      input->GetCell(cellId, cell);
+      intersections.clear();
+      intersectionT.clear();
+      for (int edgeId = 0; edgeId < cell->GetNumberOfEdges(); ++edgeId)
+      {
+        vtkCell* edge = cell->GetEdge(edgeId);
+        const vtkIdType v[2] = { ptIds->IsId(edge->GetPointId(0)),
+          ptIds->IsId(edge->GetPointId(1)) };
+        for (int threshold = 0; threshold < 2; ++threshold)
+        {
+          const double value = this->Thresholds[threshold];
+          const bool crosses = threshold == 0
+            ? (cellScalars[v[0]] < value) != (cellScalars[v[1]] < value)
+            : (cellScalars[v[0]] > value) != (cellScalars[v[1]] > value);
+          if (!crosses)
+          {
+            continue;
+          }
+          const int start = cellScalars[v[0]] < cellScalars[v[1]] ? 0 : 1;
+          const vtkIdType v1 = v[start];
+          const vtkIdType v2 = v[1 - start];
+          const double t = (value - cellScalars[v1]) / (cellScalars[v2] - cellScalars[v1]);
+          if (t < MergeTolerance)
+          {
+            pointTypes[v1] = BOUNDARY;
+          }
+          else if (t > 1.0 - MergeTolerance)
+          {
+            pointTypes[v2] = BOUNDARY;
+          }
+          else
+          {
+            intersections.push_back(EdgeIntersection{ v1, v2, threshold });
+            intersectionT.push_back(t);
+          }
+        }
+      }
+
+      // triangulate the points between the thresholds. Points are sorted by
+      // input id, then by output id for the intersections, so that the faces
+      // shared by neighboring cells are triangulated the same way.
+      double bounds[6];
+      cell->GetBounds(bounds);
+      triangulator->InitTriangulation(bounds, static_cast<int>(npts + intersections.size()));
+      double x[3];
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        const vtkIdType ptId = ptIds->GetId(i);
+        const vtkIdType newId = pointTypes[i] == OUTSIDE ? -1 : this->GetPointId(ptId);
+        cell->GetPoints()->GetPoint(i, x);
+        triangulator->InsertPoint(newId, ptId, x, x, pointTypes[i]);
+      }
+      for (size_t cc = 0; cc < intersections.size(); ++cc)
+      {
+        EdgeIntersection& intersection = intersections[cc];
+        const double t = intersectionT[cc];
+        double x1[3], x2[3];
+        cell->GetPoints()->GetPoint(intersection.Start, x1);
+        cell->GetPoints()->GetPoint(intersection.End, x2);
+        for (int i = 0; i < 3; ++i)
+        {
+          x[i] = x1[i] + t * (x2[i] - x1[i]);
+        }
+        intersection.Start = ptIds->GetId(intersection.Start);
+        intersection.End = ptIds->GetId(intersection.End);
+        const vtkIdType newId = this->GetIntersectionPointId(intersection, t, x);
+        triangulator->InsertPoint(newId, numPts + newId, x, x, BOUNDARY);
+      }
+      triangulator->Triangulate();
+
+      const vtkIdType firstCellId = cells->GetNumberOfCells();
+      const vtkIdType numTetras = triangulator->AddTetras(0, cells);
+      for (vtkIdType cc = 0; cc < numTetras; ++cc)
+      {
+        types->InsertNextValue(VTK_TETRA);
+        this->Output->GetCellData()->CopyData(input->GetCellData(), cellId, firstCellId + cc);
+      }
+    }
+
+    this->Output->SetPoints(points);
+    this->Output->SetCells(types, cells);
+    this->Output->Squeeze();
+  }
+
+private:
+  vtkIdType GetPointId(vtkIdType ptId)
+  {
+    vtkIdType& newId = this->PointMap[ptId];
+    if (newId < 0)
+    {
+      double x[3];
+      this->Input->GetPoint(ptId, x);
+      newId = this->Points->InsertNextPoint(x);
+      this->Output->GetPointData()->CopyData(this->Input->GetPointData(), ptId, newId);
+    }
+    return newId;
+  }
+
+  vtkIdType GetIntersectionPointId(const EdgeIntersection& intersection, double t, double x[3])
+  {
+    auto inserted = this->Intersections.insert(std::make_pair(intersection, vtkIdType(-1)));
+    if (inserted.second)
+    {
+      inserted.first->second = this->Points->InsertNextPoint(x);
+      this->Output->GetPointData()->InterpolateEdge(this->Input->GetPointData(),
+        inserted.first->second, intersection.Start, intersection.End, t);
+    }
+    return inserted.first->second;
+  }
+
+  vtkDataSet* Input;
+  vtkUnstructuredGrid* Output;
+  double Thresholds[2];
+  vtkPoints* Points = nullptr;
+  std::vector<vtkIdType> PointMap;
+  std::unordered_map<EdgeIntersection, vtkIdType, EdgeIntersectionHash> Intersections;
+};
+
+//----------------------------------------------------------------------------
+// Returns true when the band can be extracted in a single pass.
+bool CanClipInSinglePass(vtkDataSet* input, vtkDataArray* scalars, int fieldAssociation)
+{
+  if (fieldAssociation != vtkDataObject::FIELD_ASSOCIATION_POINTS || scalars == nullptr)
+  {
+    return false;
+  }
+  vtkNew<vtkCellTypes> types;
+  input->GetCellTypes(types);
+  for (vtkIdType cc = 0; cc < types->GetNumberOfTypes(); ++cc)
+  {
+    if (!IsLinear3DCell(types->GetCellType(cc)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
 
 vtkStandardNewMacro(vtkIsoVolume);
 
@@ -103,16 +396,41 @@ int vtkIsoVolume::RequestData(vtkInformation* vtkNotUsed(request),
   }
   arrayName = std::string(inArrayInfo->Get(vtkDataObject::FIELD_NAME()));
 
-  // FIXME: Currently, both clips are always run. As a performance improvement
-  // we can avoid running one of the clips if not needed.
-  vtkDataObject* inputClone = inObj->NewInstance();
-  inputClone->ShallowCopy(inObj);
-  outObj1.TakeReference(
-    this->Clip(inputClone, this->LowerThreshold, arrayName.c_str(), fieldAssociation, false));
-  inputClone->Delete();
+  vtkMultiBlockDataSet* inputMB = vtkMultiBlockDataSet::SafeDownCast(inObj);
+  if (vtkDataSet* inputDS = vtkDataSet::SafeDownCast(inObj))
+  {
+    outObj1.TakeReference(this->ClipBetween(inputDS, arrayName.c_str(), fieldAssociation));
+  }
+  else if (inputMB)
+  {
+    vtkMultiBlockDataSet* outputMB = vtkMultiBlockDataSet::New();
+    outputMB->CopyStructure(inputMB);
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(inputMB->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkDataSet* block = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+      if (block)
+      {
+        vtkSmartPointer<vtkDataObject> clipped;
+        clipped.TakeReference(this->ClipBetween(block, arrayName.c_str(), fieldAssociation));
+        outputMB->SetDataSet(iter, clipped);
+      }
+    }
+    outObj1.TakeReference(outputMB);
+  }
+  else
+  {
+    // other composite datasets, such as AMR, are clipped twice.
+    vtkDataObject* inputClone = inObj->NewInstance();
+    inputClone->ShallowCopy(inObj);
+    outObj1.TakeReference(
+      this->Clip(inputClone, this->LowerThreshold, arrayName.c_str(), fieldAssociation, false));
+    inputClone->Delete();
 
-  outObj1.TakeReference(
-    this->Clip(outObj1, this->UpperThreshold, arrayName.c_str(), fieldAssociation, true));
+    outObj1.TakeReference(
+      this->Clip(outObj1, this->UpperThreshold, arrayName.c_str(), fieldAssociation, true));
+  }
 
   assert(outObj1->IsA(outObj->GetClassName()));
   outObj->ShallowCopy(outObj1);
@@ -144,6 +462,32 @@ vtkDataObject* vtkIsoVolume::Clip(
   return output;
 }
 
+//----------------------------------------------------------------------------
+vtkDataObject* vtkIsoVolume::ClipBetween(
+  vtkDataSet* input, const char* array_name, int fieldAssociation)
+{
+  vtkDataArray* scalars = input->GetPointData()->GetArray(array_name);
+  if (!CanClipInSinglePass(input, scalars, fieldAssociation))
+  {
+    vtkDataObject* inputClone = input->NewInstance();
+    inputClone->ShallowCopy(input);
+    vtkSmartPointer<vtkDataObject> lowerClip;
+    lowerClip.TakeReference(
+      this->Clip(inputClone, this->LowerThreshold, array_name, fieldAssociation, false));
+    inputClone->Delete();
+    return this->Clip(lowerClip, this->UpperThreshold, array_name, fieldAssociation, true);
+  }
+
+  const double thresholds[2] = { this->LowerThreshold, this->UpperThreshold };
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::New();
+  BandClipWorker worker(input, thresholds, output);
+  if (!vtkArrayDispatch::Dispatch::Execute(scalars, worker))
+  {
+    worker(scalars);
+  }
+  return output;
+}
+
 //----------------------------------------------------------------------------
 void vtkIsoVolume::PrintSelf(ostream& os, vtkIndent indent)
 {
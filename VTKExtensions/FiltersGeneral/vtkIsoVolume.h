@@ -17,7 +17,11 @@
  * @brief   This filter extract cells using lower / upper
  * threshold set and vtkPVClipDataSet filter.
  *
- *
+ * Datasets made of linear 3D cells with point scalars are clipped against both
+ * thresholds in a single pass: cells between the thresholds are copied and the
+ * cells crossing a threshold are triangulated into tetrahedra. Other datasets,
+ * and composite datasets other than vtkMultiBlockDataSet, are clipped by the
+ * lower then by the upper threshold with vtkPVClipDataSet.
  *
  * @sa
  * vtkThreshold vtkPVClipDataSet
@@ -30,6 +34,7 @@
 #include "vtkPVVTKExtensionsFiltersGeneralModule.h" //needed for exports
 
 // Forware declarations.
+class vtkDataSet;
 class vtkPVClipDataSet;
 
 class VTKPVVTKEXTENSIONSFILTERSGENERAL_EXPORT vtkIsoVolume : public vtkDataObjectAlgorithm
@@ -70,6 +75,12 @@ protected:
   vtkDataObject* Clip(
     vtkDataObject* input, double value, const char* array_name, int fieldAssociation, bool invert);
 
+  /**
+   * Returns the part of `input` between the lower and upper thresholds. The
+   * caller owns the returned reference.
+   */
+  vtkDataObject* ClipBetween(vtkDataSet* input, const char* array_name, int fieldAssociation);
+
   double LowerThreshold;
   double UpperThreshold;
 
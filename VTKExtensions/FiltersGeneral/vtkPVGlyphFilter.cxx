@@ -15,17 +15,22 @@
 #include "vtkPVGlyphFilter.h"
 
 // VTK includes
+#include "vtkArrayDispatch.h"
 #include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
 #include "vtkCellCenters.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetSurfaceFilter.h"
 #include "vtkDataSetTriangleFilter.h"
 #include "vtkFloatArray.h"
 #include "vtkIdFilter.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMatrix4x4.h"
 #include "vtkMinimalStandardRandomSequence.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
@@ -34,6 +39,7 @@
 #include "vtkOctreePointLocator.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTetra.h"
@@ -52,9 +58,111 @@
 #include <numeric>
 #include <random>
 #include <set>
+#include <typeinfo>
 #include <vector>
 
 static const std::string IDS_ARRAY_NAME = "vtkPVGlyphFilter_Ids";
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Returns a copy of `cells` for each glyph, the point ids of the copy for the
+// i-th glyph being offset by i * numSourcePts.
+vtkSmartPointer<vtkCellArray> ReplicateCells(
+  vtkCellArray* cells, vtkIdType numGlyphs, vtkIdType numSourcePts)
+{
+  std::vector<vtkIdType> sourceOffsets(1, 0);
+  std::vector<vtkIdType> sourceConnectivity;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (cells->InitTraversal(); cells->GetNextCell(npts, pts);)
+  {
+    sourceConnectivity.insert(sourceConnectivity.end(), pts, pts + npts);
+    sourceOffsets.push_back(static_cast<vtkIdType>(sourceConnectivity.size()));
+  }
+  const vtkIdType numCells = static_cast<vtkIdType>(sourceOffsets.size()) - 1;
+  const vtkIdType connectivitySize = static_cast<vtkIdType>(sourceConnectivity.size());
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numGlyphs * numCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numGlyphs * connectivitySize);
+  vtkIdType* offsetValues = offsets->GetPointer(0);
+  vtkIdType* connectivityValues = connectivity->GetPointer(0);
+  vtkSMPTools::For(0, numGlyphs, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType glyph = begin; glyph < end; ++glyph)
+    {
+      for (vtkIdType cc = 0; cc < numCells; ++cc)
+      {
+        offsetValues[glyph * numCells + cc] = glyph * connectivitySize + sourceOffsets[cc];
+      }
+      for (vtkIdType cc = 0; cc < connectivitySize; ++cc)
+      {
+        connectivityValues[glyph * connectivitySize + cc] =
+          glyph * numSourcePts + sourceConnectivity[cc];
+      }
+    }
+  });
+  offsetValues[numGlyphs * numCells] = numGlyphs * connectivitySize;
+
+  auto result = vtkSmartPointer<vtkCellArray>::New();
+  result->SetData(offsets, connectivity);
+  return result;
+}
+
+//----------------------------------------------------------------------------
+// Copies the tuple of each glyphed point to all the points of its glyph.
+struct CopyGlyphTuplesWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT* inArray, OutArrayT* outArray,
+    const std::vector<vtkIdType>& glyphPoints, vtkIdType numSourcePts)
+  {
+    vtkDataArrayAccessor<InArrayT> in(inArray);
+    vtkDataArrayAccessor<OutArrayT> out(outArray);
+    const int numComps = inArray->GetNumberOfComponents();
+    const vtkIdType numGlyphs = static_cast<vtkIdType>(glyphPoints.size());
+    vtkSMPTools::For(0, numGlyphs, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType glyph = begin; glyph < end; ++glyph)
+      {
+        for (vtkIdType id = glyph * numSourcePts; id < (glyph + 1) * numSourcePts; ++id)
+        {
+          for (int comp = 0; comp < numComps; ++comp)
+          {
+            out.Set(id, comp, in.Get(glyphPoints[glyph], comp));
+          }
+        }
+      }
+    });
+  }
+};
+
+//----------------------------------------------------------------------------
+void CopyGlyphTuples(vtkAbstractArray* inArray, vtkAbstractArray* outArray,
+  const std::vector<vtkIdType>& glyphPoints, vtkIdType numSourcePts)
+{
+  const vtkIdType numGlyphs = static_cast<vtkIdType>(glyphPoints.size());
+  outArray->SetNumberOfTuples(numGlyphs * numSourcePts);
+
+  vtkDataArray* inDA = vtkArrayDownCast<vtkDataArray>(inArray);
+  vtkDataArray* outDA = vtkArrayDownCast<vtkDataArray>(outArray);
+  CopyGlyphTuplesWorker worker;
+  using Dispatcher = vtkArrayDispatch::Dispatch2SameValueType;
+  if (!inDA || !outDA || !Dispatcher::Execute(inDA, outDA, worker, glyphPoints, numSourcePts))
+  {
+    // string arrays and arrays not supported by the dispatcher are copied
+    // serially, the generic array API not being thread-safe.
+    for (vtkIdType glyph = 0; glyph < numGlyphs; ++glyph)
+    {
+      for (vtkIdType id = glyph * numSourcePts; id < (glyph + 1) * numSourcePts; ++id)
+      {
+        outArray->SetTuple(id, glyphPoints[glyph], inArray);
+      }
+    }
+  }
+}
+}
+
 class vtkPVGlyphFilter::vtkInternals
 {
   vtkDataSet* LastDataSet = nullptr;
@@ -737,6 +845,12 @@ int vtkPVGlyphFilter::IsPointVisible(
   return this->Internals->IsPointVisible(index, ds, ptId, cellCenters, this);
 }
 
+//-----------------------------------------------------------------------------
+bool vtkPVGlyphFilter::IsPointVisibleThreadSafe()
+{
+  return typeid(*this) == typeid(vtkPVGlyphFilter);
+}
+
 //-----------------------------------------------------------------------------
 bool vtkPVGlyphFilter::IsInputArrayToProcessValid(vtkDataSet* input)
 {
@@ -824,9 +938,6 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  auto pts = vtkSmartPointer<vtkIdList>::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   unsigned char* inGhostLevels = nullptr;
   vtkDataArray* temp = nullptr;
   auto pd = input->GetPointData();
@@ -869,25 +980,83 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
 
   auto sourcePts = source->GetPoints();
   vtkIdType numSourcePts = sourcePts->GetNumberOfPoints();
-  vtkIdType numSourceCells = source->GetNumberOfCells();
 
   vtkDataArray* sourceNormals = source->GetPointData()->GetNormals();
 
-  // Allocate storage for output point data
-  vtkPointData* outputPD = output->GetPointData();
-  outputPD->CopyNormalsOff();
+  // Find the points to glyph. If we are processing a piece, we do not want to
+  // duplicate glyphs on the borders, and blanking specified on uniform grids
+  // is respected. IsPointVisible() only supports concurrent calls in the
+  // modes that do not sample the points, and if it is not overridden by a
+  // subclass that does not support them.
+  const bool concurrentVisibility =
+    (this->GlyphMode == ALL_POINTS || this->GlyphMode == EVERY_NTH_POINT) &&
+    this->IsPointVisibleThreadSafe();
+  vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
+  if (inputUG)
+  {
+    // vtkUniformGrid::IsPointVisible() caches the ghost array on first use.
+    inputUG->GetPointGhostArray();
+  }
+  std::vector<unsigned char> visible(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType inPtId = begin; inPtId < end; ++inPtId)
+    {
+      const bool ghost =
+        inGhostLevels && (inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT);
+      const bool blanked = inputUG && !inputUG->IsPointVisible(inPtId);
+      visible[inPtId] = !ghost && !blanked &&
+          (!concurrentVisibility || this->IsPointVisible(index, input, inPtId, cellCenters))
+        ? 1
+        : 0;
+    }
+  });
+  if (!concurrentVisibility)
+  {
+    for (vtkIdType inPtId = 0; inPtId < numPts; inPtId++)
+    {
+      if (visible[inPtId])
+      {
+        visible[inPtId] = this->IsPointVisible(index, input, inPtId, cellCenters) ? 1 : 0;
+      }
+    }
+  }
 
-  outputPD->CopyAllocate(pd, numPts * numSourcePts);
+  // Number the glyphs in point id order.
+  const vtkIdType chunkSize = 65536;
+  const vtkIdType numChunks = (numPts + chunkSize - 1) / chunkSize;
+  std::vector<vtkIdType> chunkOffsets(numChunks + 1, 0);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+    {
+      const auto first = visible.begin() + chunk * chunkSize;
+      const auto last = visible.begin() + std::min(numPts, (chunk + 1) * chunkSize);
+      chunkOffsets[chunk + 1] = std::count(first, last, 1);
+    }
+  });
+  std::partial_sum(chunkOffsets.begin(), chunkOffsets.end(), chunkOffsets.begin());
 
-  vtkNew<vtkIdList> srcPointIdList;
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  vtkNew<vtkIdList> dstPointIdList;
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  vtkNew<vtkIdList> srcCellIdList;
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  vtkNew<vtkIdList> dstCellIdList;
-  dstCellIdList->SetNumberOfIds(numSourceCells);
+  const vtkIdType numGlyphs = chunkOffsets[numChunks];
+  std::vector<vtkIdType> glyphPoints(numGlyphs);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+    {
+      vtkIdType next = chunkOffsets[chunk];
+      for (vtkIdType id = chunk * chunkSize; id < std::min(numPts, (chunk + 1) * chunkSize); ++id)
+      {
+        if (visible[id])
+        {
+          glyphPoints[next++] = id;
+        }
+      }
+    }
+  });
+  this->UpdateProgress(0.2);
+  if (this->GetAbortExecute())
+  {
+    return true;
+  }
 
+  const vtkIdType numNewPts = numGlyphs * numSourcePts;
   auto newPts = vtkSmartPointer<vtkPoints>::New();
 
   // Set the desired precision for the points in the output.
@@ -903,203 +1072,204 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
   {
     newPts->SetDataType(VTK_DOUBLE);
   }
-
-  newPts->Allocate(numPts * numSourcePts);
+  newPts->SetNumberOfPoints(numNewPts);
 
   vtkSmartPointer<vtkFloatArray> newNormals;
   if (sourceNormals)
   {
     newNormals.TakeReference(vtkFloatArray::New());
     newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(numNewPts);
     newNormals->SetName("Normals");
   }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->Allocate(source, 3 * numPts * numSourceCells, numPts * numSourceCells);
-
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
-
-  // Traverse all Input points, transforming Source points and copying
-  // point attributes.
-  auto trans = vtkSmartPointer<vtkTransform>::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdType ptIncr = 0;
-  vtkIdType cellIncr = 0;
-  for (vtkIdType inPtId = 0; inPtId < numPts; inPtId++)
+  // The source transform is the same for all the glyphs, apply it once.
+  std::vector<double> sourceCoords(3 * numSourcePts);
+  vtkSmartPointer<vtkPoints> transformedSourcePts = sourcePts;
+  if (this->SourceTransform)
   {
-    double scalex(1.0), scaley(1.0), scalez(1.0);
-    if (!(inPtId % 10000))
+    transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
+    transformedSourcePts->SetDataTypeToDouble();
+    transformedSourcePts->Allocate(numSourcePts);
+    this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
+  }
+  std::vector<double> sourceNormalCoords(sourceNormals ? 3 * numSourcePts : 0);
+  for (vtkIdType i = 0; i < numSourcePts; ++i)
+  {
+    transformedSourcePts->GetPoint(i, &sourceCoords[3 * i]);
+    if (sourceNormals)
     {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->GetAbortExecute())
-      {
-        break;
-      }
+      sourceNormals->GetTuple(i, &sourceNormalCoords[3 * i]);
     }
+  }
 
-    // Get the scalar and vector data
-    if (scaleArray)
+  // Transform the source points and normals for each glyph.
+  vtkSMPTools::For(0, numGlyphs, [&](vtkIdType begin, vtkIdType end) {
+    vtkNew<vtkTransform> trans;
+    double normalMatrix[16];
+    double in[4];
+    double out[4];
+    for (vtkIdType glyph = begin; glyph < end; ++glyph)
     {
-      if (scaleArray->GetNumberOfComponents() == 1)
-      {
-        scalex = scaley = scalez = scaleArray->GetComponent(inPtId, 0);
-      }
-      else
+      const vtkIdType inPtId = glyphPoints[glyph];
+      double scalex(1.0), scaley(1.0), scalez(1.0);
+
+      // Get the scalar and vector data
+      if (scaleArray)
       {
-        // Consider the vector scaling mode
-        if (scaleArray->GetNumberOfComponents() == 2)
+        if (scaleArray->GetNumberOfComponents() == 1)
         {
-          double* vec2 = scaleArray->GetTuple(inPtId);
-          if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
-          {
-            scalex = scaley = scalez = vtkMath::Norm2D(vec2);
-          }
-          else if (this->VectorScaleMode == SCALE_BY_COMPONENTS)
-          {
-            scalex = vec2[0];
-            scaley = vec2[1];
-            // leave scalez alone for 2D
-          }
+          scalex = scaley = scalez = scaleArray->GetComponent(inPtId, 0);
         }
-        else if (scaleArray->GetNumberOfComponents() == 3)
+        else
         {
-          double* vec3 = scaleArray->GetTuple(inPtId);
-          if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
+          // Consider the vector scaling mode
+          if (scaleArray->GetNumberOfComponents() == 2)
           {
-            scalex = scaley = scalez = vtkMath::Norm(vec3);
+            double vec2[2];
+            scaleArray->GetTuple(inPtId, vec2);
+            if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
+            {
+              scalex = scaley = scalez = vtkMath::Norm2D(vec2);
+            }
+            else if (this->VectorScaleMode == SCALE_BY_COMPONENTS)
+            {
+              scalex = vec2[0];
+              scaley = vec2[1];
+              // leave scalez alone for 2D
+            }
           }
-          else
+          else if (scaleArray->GetNumberOfComponents() == 3)
           {
-            scalex = vec3[0];
-            scaley = vec3[1];
-            scalez = vec3[2];
+            double vec3[3];
+            scaleArray->GetTuple(inPtId, vec3);
+            if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
+            {
+              scalex = scaley = scalez = vtkMath::Norm(vec3);
+            }
+            else
+            {
+              scalex = vec3[0];
+              scaley = vec3[1];
+              scalez = vec3[2];
+            }
           }
         }
       }
-    }
 
-    // Apply scale factor
-    scalex *= this->ScaleFactor;
-    scaley *= this->ScaleFactor;
-    scalez *= this->ScaleFactor;
+      // Apply scale factor
+      scalex *= this->ScaleFactor;
+      scaley *= this->ScaleFactor;
+      scalez *= this->ScaleFactor;
 
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate
-    // glyphs on the borders.
-    if (inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT)
-    {
-      continue;
-    }
+      // Now begin copying/transforming glyph
+      trans->Identity();
 
-    // this is used to respect blanking specified on uniform grids.
-    vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
-    }
+      // translate Source to Input point
+      double x[3];
+      input->GetPoint(inPtId, x);
+      trans->Translate(x[0], x[1], x[2]);
 
-    if (!this->IsPointVisible(index, input, inPtId, cellCenters))
-    {
-      continue;
-    }
-
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
-    // Copy all topology (transformation independent)
-    for (vtkIdType cellId = 0; cellId < numSourceCells; cellId++)
-    {
-      source->GetCellPoints(cellId, pointIdList);
-      int npts = pointIdList->GetNumberOfIds();
-      pts->Reset();
-      for (vtkIdType i = 0; i < npts; i++)
-      {
-        pts->InsertId(i, pointIdList->GetId(i) + ptIncr);
-      }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
-    }
-
-    // translate Source to Input point
-    double x[3];
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
-
-    if (orientArray)
-    {
-      double v[3] = { 0.0 };
-      orientArray->GetTuple(inPtId, v);
-      double vMag = vtkMath::Norm(v);
-      if (vMag > 0.0)
+      if (orientArray)
       {
-        // if there is no y or z component
-        if (v[1] == 0.0 && v[2] == 0.0)
+        double v[3] = { 0.0 };
+        orientArray->GetTuple(inPtId, v);
+        double vMag = vtkMath::Norm(v);
+        if (vMag > 0.0)
         {
-          if (v[0] < 0) // just flip x if we need to
+          // if there is no y or z component
+          if (v[1] == 0.0 && v[2] == 0.0)
           {
-            trans->RotateWXYZ(180.0, 0, 1, 0);
+            if (v[0] < 0) // just flip x if we need to
+            {
+              trans->RotateWXYZ(180.0, 0, 1, 0);
+            }
+          }
+          else
+          {
+            double vNew[3];
+            vNew[0] = (v[0] + vMag) / 2.0;
+            vNew[1] = v[1] / 2.0;
+            vNew[2] = v[2] / 2.0;
+            trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
           }
-        }
-        else
-        {
-          double vNew[3];
-          vNew[0] = (v[0] + vMag) / 2.0;
-          vNew[1] = v[1] / 2.0;
-          vNew[2] = v[2] / 2.0;
-          trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
         }
       }
-    }
 
-    // scale data if appropriate
-    if (scalex == 0.0)
-    {
-      scalex = 1.0e-10;
-    }
-    if (scaley == 0.0)
-    {
-      scaley = 1.0e-10;
-    }
-    if (scalez == 0.0)
-    {
-      scalez = 1.0e-10;
-    }
-    trans->Scale(scalex, scaley, scalez);
-
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
-    {
-      trans->TransformPoints(sourcePts, newPts);
-    }
-
-    if (newNormals.GetPointer())
-    {
-      trans->TransformNormals(sourceNormals, newNormals);
-    }
+      // scale data if appropriate
+      if (scalex == 0.0)
+      {
+        scalex = 1.0e-10;
+      }
+      if (scaley == 0.0)
+      {
+        scaley = 1.0e-10;
+      }
+      if (scalez == 0.0)
+      {
+        scalez = 1.0e-10;
+      }
+      trans->Scale(scalex, scaley, scalez);
 
-    // Copy point data from source (if possible)
-    if (pd)
-    {
+      // multiply points and normals by resulting matrix, as
+      // vtkLinearTransform::TransformPoints() and TransformNormals() do.
+      const double* matrix = trans->GetMatrix()->GetData();
+      if (newNormals.GetPointer())
+      {
+        vtkMatrix4x4::Invert(matrix, normalMatrix);
+        vtkMatrix4x4::Transpose(normalMatrix, normalMatrix);
+      }
       for (vtkIdType i = 0; i < numSourcePts; ++i)
       {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
+        const vtkIdType outPtId = glyph * numSourcePts + i;
+        std::copy(&sourceCoords[3 * i], &sourceCoords[3 * i] + 3, in);
+        in[3] = 1.0;
+        vtkMatrix4x4::MultiplyPoint(matrix, in, out);
+        newPts->SetPoint(outPtId, out);
+        if (newNormals.GetPointer())
+        {
+          std::copy(&sourceNormalCoords[3 * i], &sourceNormalCoords[3 * i] + 3, in);
+          in[3] = 0.0;
+          vtkMatrix4x4::MultiplyPoint(normalMatrix, in, out);
+          vtkMath::Normalize(out);
+          newNormals->SetTuple(outPtId, out);
+        }
       }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
     }
+  });
+  this->UpdateProgress(0.6);
 
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
+  // Copy all topology (transformation independent)
+  if (source->GetNumberOfVerts() > 0)
+  {
+    output->SetVerts(ReplicateCells(source->GetVerts(), numGlyphs, numSourcePts));
+  }
+  if (source->GetNumberOfLines() > 0)
+  {
+    output->SetLines(ReplicateCells(source->GetLines(), numGlyphs, numSourcePts));
+  }
+  if (source->GetNumberOfPolys() > 0)
+  {
+    output->SetPolys(ReplicateCells(source->GetPolys(), numGlyphs, numSourcePts));
+  }
+  if (source->GetNumberOfStrips() > 0)
+  {
+    output->SetStrips(ReplicateCells(source->GetStrips(), numGlyphs, numSourcePts));
+  }
+  this->UpdateProgress(0.8);
+
+  // Copy point data from source (if possible)
+  vtkPointData* outputPD = output->GetPointData();
+  outputPD->CopyNormalsOff();
+  if (pd)
+  {
+    vtkDataSetAttributes::FieldList fields(1);
+    fields.InitializeFieldList(pd);
+    outputPD->CopyAllocate(fields, numNewPts);
+    auto copy = [&](vtkAbstractArray* inArray, vtkAbstractArray* outArray) {
+      CopyGlyphTuples(inArray, outArray, glyphPoints, numSourcePts);
+    };
+    fields.TransformData(0, pd, outputPD, copy);
   }
 
   if (newNormals.GetPointer())
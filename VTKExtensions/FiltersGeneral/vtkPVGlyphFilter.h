@@ -54,6 +54,11 @@
  * In parallel and with composite dataset, this filter ensures that each piece
  * samples only a representative number of points.
  * Note that the grid will be tetrahedralized first.
+ *
+ * Glyphs are generated in parallel with vtkSMPTools: the points to glyph are
+ * found first, then the points, normals, cells and point data of all the
+ * glyphs are filled concurrently. The output is identical to a serial
+ * traversal of the input points.
 */
 
 #ifndef vtkPVGlyphFilter_h
@@ -206,9 +211,21 @@ protected:
    * Returns 1 if point is to be glyphed, otherwise returns 0.
    * \c index is the flat index of the dataset when using composite dataset.
    * \c cellCenters is a flag to know if cellCenters are currently used
+   * With ALL_POINTS and EVERY_NTH_POINT, this is called concurrently from
+   * several threads when IsPointVisibleThreadSafe() returns true. Otherwise,
+   * this is called from a single thread with increasing point ids.
    */
   virtual int IsPointVisible(unsigned int index, vtkDataSet* ds, vtkIdType ptId, bool cellCenters);
 
+  /**
+   * Returns true if IsPointVisible() can be called concurrently from several
+   * threads. This returns true for vtkPVGlyphFilter itself and false for its
+   * subclasses, so that an overridden IsPointVisible() is called serially.
+   * Subclasses whose IsPointVisible() is thread safe can override this to
+   * return true.
+   */
+  virtual bool IsPointVisibleThreadSafe();
+
   /**
    * Returns true if input Scalars and Vectors are compatible, otherwise returns 0.
    */
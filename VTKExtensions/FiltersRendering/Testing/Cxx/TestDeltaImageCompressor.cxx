@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestDeltaImageCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Sends a sequence of frames where only a small square moves through
+// vtkDeltaImageCompressor and checks that the frames are reconstructed
+// exactly while only the changed tiles are transmitted.
+
+#include "vtkDeltaImageCompressor.h"
+#include "vtkNew.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstring>
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+const int Width = 640;
+const int Height = 480;
+
+void RenderFrame(vtkUnsignedCharArray* image, int frame)
+{
+  image->SetNumberOfComponents(4);
+  image->SetNumberOfTuples(Width * Height);
+  unsigned char* ptr = image->GetPointer(0);
+  for (int j = 0; j < Height; ++j)
+  {
+    for (int i = 0; i < Width; ++i, ptr += 4)
+    {
+      const bool inSquare = (i >= 10 * frame && i < 10 * frame + 32 && j >= 100 && j < 132);
+      ptr[0] = inSquare ? 255 : static_cast<unsigned char>(i % 256);
+      ptr[1] = inSquare ? 0 : static_cast<unsigned char>(j % 256);
+      ptr[2] = 128;
+      ptr[3] = 255;
+    }
+  }
+}
+
+bool SendFrame(vtkDeltaImageCompressor* sender, vtkDeltaImageCompressor* receiver,
+  vtkUnsignedCharArray* image, vtkUnsignedCharArray* compressed, vtkUnsignedCharArray* output)
+{
+  sender->SetImageResolution(Width, Height);
+  sender->SetInput(image);
+  sender->SetOutput(compressed);
+  if (sender->Compress() != VTK_OK)
+  {
+    cerr << "Compress failed." << endl;
+    return false;
+  }
+
+  output->SetNumberOfComponents(4);
+  output->SetNumberOfTuples(Width * Height);
+  receiver->SetImageResolution(Width, Height);
+  receiver->SetInput(compressed);
+  receiver->SetOutput(output);
+  return receiver->Decompress() == VTK_OK;
+}
+}
+
+int TestDeltaImageCompressor(int, char* [])
+{
+  vtkNew<vtkDeltaImageCompressor> sender;
+  vtkNew<vtkDeltaImageCompressor> receiver;
+  sender->SetLossLessMode(1);
+  sender->SetKeyFrameInterval(5);
+
+  vtkNew<vtkUnsignedCharArray> image;
+  vtkNew<vtkUnsignedCharArray> compressed;
+  vtkNew<vtkUnsignedCharArray> output;
+  const int numTiles = ((Width + 63) / 64) * ((Height + 63) / 64);
+  vtkIdType keyFrameSize = 0;
+  for (int frame = 0; frame < 10; ++frame)
+  {
+    RenderFrame(image, frame);
+    if (!SendFrame(sender, receiver, image, compressed, output))
+    {
+      cerr << "Failed to transmit frame " << frame << "." << endl;
+      return TEST_FAILED;
+    }
+    if (memcmp(image->GetPointer(0), output->GetPointer(0), 4 * Width * Height) != 0)
+    {
+      cerr << "Frame " << frame << " was not reconstructed exactly." << endl;
+      return TEST_FAILED;
+    }
+
+    const bool expectKeyFrame = (frame % 5) == 0;
+    if (sender->GetLastFrameWasKeyFrame() != expectKeyFrame)
+    {
+      cerr << "Unexpected key frame state for frame " << frame << "." << endl;
+      return TEST_FAILED;
+    }
+    if (expectKeyFrame)
+    {
+      keyFrameSize = compressed->GetNumberOfTuples();
+      if (sender->GetLastNumberOfDirtyTiles() != numTiles)
+      {
+        cerr << "Key frame does not contain all tiles." << endl;
+        return TEST_FAILED;
+      }
+    }
+    else if (sender->GetLastNumberOfDirtyTiles() > 4 ||
+      compressed->GetNumberOfTuples() * 4 > keyFrameSize)
+    {
+      cerr << "Too many tiles transmitted for frame " << frame << ": "
+           << sender->GetLastNumberOfDirtyTiles() << " (" << compressed->GetNumberOfTuples()
+           << " bytes vs. " << keyFrameSize << " for key frames)." << endl;
+      return TEST_FAILED;
+    }
+  }
+
+  // A skipped frame must be rejected until the next key frame.
+  RenderFrame(image, 20);
+  sender->SetInput(image);
+  sender->SetOutput(compressed);
+  sender->Compress();
+  RenderFrame(image, 21);
+  if (SendFrame(sender, receiver, image, compressed, output))
+  {
+    cerr << "Out of sequence frame was not rejected." << endl;
+    return TEST_FAILED;
+  }
+  sender->RequestKeyFrame();
+  if (!SendFrame(sender, receiver, image, compressed, output) ||
+    memcmp(image->GetPointer(0), output->GetPointer(0), 4 * Width * Height) != 0)
+  {
+    cerr << "Failed to recover from a key frame." << endl;
+    return TEST_FAILED;
+  }
+
+  // Configuration round trip.
+  std::string config = sender->SaveConfiguration();
+  if (config != "vtkDeltaImageCompressor 1 3 5" ||
+    !receiver->RestoreConfiguration(config.c_str()) || receiver->GetKeyFrameInterval() != 5)
+  {
+    cerr << "Configuration round trip failed: " << config << endl;
+    return TEST_FAILED;
+  }
+  return TEST_SUCCESS;
+}
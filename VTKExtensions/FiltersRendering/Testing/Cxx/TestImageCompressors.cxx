@@ -26,6 +26,7 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vtksys/CommandLineArguments.hxx>
@@ -81,6 +82,56 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   return true;
 }
 
+// Squirt streams without the tile header (ParaView 5.8 and earlier) must
+// still decompress. A single tile stream minus its header is such a stream.
+bool TestLegacySquirtStream(vtkUnsignedCharArray* input)
+{
+  vtkNew<vtkSquirtCompressor> squirt;
+  squirt->SetSquirtLevel(0);
+  squirt->SetTileSize(0);
+  vtkNew<vtkUnsignedCharArray> compressed;
+  squirt->SetInput(input);
+  squirt->SetOutput(compressed);
+  if (!squirt->Compress())
+  {
+    return false;
+  }
+
+  // header: magic, number of pixels, pixels per tile, number of tiles (1),
+  // number of words for the tile.
+  const vtkIdType headerBytes = 5 * 4;
+  vtkNew<vtkUnsignedCharArray> legacy;
+  legacy->SetNumberOfTuples(compressed->GetNumberOfTuples() - headerBytes);
+  std::copy(compressed->GetPointer(headerBytes),
+    compressed->GetPointer(0) + compressed->GetNumberOfTuples(), legacy->GetPointer(0));
+
+  // RGBA streams quantize the opacity, so compare against the decompressed
+  // stream rather than the input.
+  vtkNew<vtkUnsignedCharArray> expected;
+  expected->SetNumberOfComponents(input->GetNumberOfComponents());
+  expected->SetNumberOfTuples(input->GetNumberOfTuples());
+  squirt->SetInput(compressed);
+  squirt->SetOutput(expected);
+  vtkNew<vtkUnsignedCharArray> output;
+  output->SetNumberOfComponents(input->GetNumberOfComponents());
+  output->SetNumberOfTuples(input->GetNumberOfTuples());
+  if (!squirt->Decompress())
+  {
+    return false;
+  }
+  squirt->SetInput(legacy);
+  squirt->SetOutput(output);
+  if (!squirt->Decompress() ||
+    !std::equal(expected->GetPointer(0),
+      expected->GetPointer(0) + expected->GetNumberOfTuples() * expected->GetNumberOfComponents(),
+      output->GetPointer(0)))
+  {
+    cerr << "Failed to decompress legacy SQUIRT stream." << endl;
+    return false;
+  }
+  return true;
+}
+
 int TestImageCompressors(int argc, char* argv[])
 {
   int max_count = 10;
@@ -120,6 +171,11 @@ int TestImageCompressors(int argc, char* argv[])
     vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetScalars());
   vtkIdType uncompressedSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
 
+  if (!TestLegacySquirtStream(input))
+  {
+    return TEST_FAILED;
+  }
+
   MapType datas;
   for (int cc = 0; cc < max_count; cc++)
   {
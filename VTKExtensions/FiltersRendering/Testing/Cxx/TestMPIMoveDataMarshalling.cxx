@@ -0,0 +1,353 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMPIMoveDataMarshalling.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Round-trips poly data, unstructured grids and image data (with vtkIdType
+// and string arrays) through vtkMPIMoveData's marshalling code using each
+// marshalling mode and reports the throughput. Use `--resolution=<N>` to
+// benchmark with larger spheres.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMPIMoveData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStringArray.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <algorithm>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+// Exposes the protected marshalling API for testing.
+class vtkTestMPIMoveData : public vtkMPIMoveData
+{
+public:
+  static vtkTestMPIMoveData* New();
+  vtkTypeMacro(vtkTestMPIMoveData, vtkMPIMoveData);
+
+  vtkIdType Marshal(vtkDataObject* data)
+  {
+    this->ClearBuffer();
+    this->MarshalDataToBuffer(data);
+    return this->BufferTotalLength;
+  }
+
+  void Reconstruct(vtkDataObject* data)
+  {
+    this->ReconstructDataFromBuffer(data);
+    this->ClearBuffer();
+  }
+};
+vtkStandardNewMacro(vtkTestMPIMoveData);
+
+bool CompareArrays(vtkAbstractArray* a, vtkAbstractArray* b)
+{
+  if (a == nullptr || b == nullptr || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0, max = a->GetNumberOfValues(); cc < max; ++cc)
+  {
+    if (a->GetVariantValue(cc) != b->GetVariantValue(cc))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareFieldData(vtkFieldData* a, vtkFieldData* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    vtkAbstractArray* array = a->GetAbstractArray(cc);
+    vtkAbstractArray* other = b->GetAbstractArray(array->GetName());
+    if (other == nullptr || array->GetDataType() != other->GetDataType() ||
+      !CompareArrays(array, other))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareDataSets(vtkDataSet* a, vtkDataSet* b)
+{
+  if (a == nullptr || b == nullptr || a->GetDataObjectType() != b->GetDataObjectType() ||
+    a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells() ||
+    !CompareFieldData(a->GetFieldData(), b->GetFieldData()) ||
+    !CompareFieldData(a->GetPointData(), b->GetPointData()) ||
+    !CompareFieldData(a->GetCellData(), b->GetCellData()))
+  {
+    return false;
+  }
+
+  if (auto pdA = vtkPolyData::SafeDownCast(a))
+  {
+    auto pdB = vtkPolyData::SafeDownCast(b);
+    return CompareArrays(pdA->GetPoints()->GetData(), pdB->GetPoints()->GetData()) &&
+      CompareArrays(
+        pdA->GetPolys()->GetConnectivityArray(), pdB->GetPolys()->GetConnectivityArray());
+  }
+  if (auto ugA = vtkUnstructuredGrid::SafeDownCast(a))
+  {
+    auto ugB = vtkUnstructuredGrid::SafeDownCast(b);
+    return CompareArrays(ugA->GetPoints()->GetData(), ugB->GetPoints()->GetData()) &&
+      CompareArrays(ugA->GetCellTypesArray(), ugB->GetCellTypesArray()) &&
+      CompareArrays(ugA->GetCells()->GetOffsetsArray(), ugB->GetCells()->GetOffsetsArray()) &&
+      CompareArrays(
+        ugA->GetCells()->GetConnectivityArray(), ugB->GetCells()->GetConnectivityArray());
+  }
+  if (auto idA = vtkImageData::SafeDownCast(a))
+  {
+    auto idB = vtkImageData::SafeDownCast(b);
+    int extentA[6], extentB[6];
+    double originA[3], originB[3], spacingA[3], spacingB[3];
+    idA->GetExtent(extentA);
+    idB->GetExtent(extentB);
+    idA->GetOrigin(originA);
+    idB->GetOrigin(originB);
+    idA->GetSpacing(spacingA);
+    idB->GetSpacing(spacingB);
+    return std::equal(extentA, extentA + 6, extentB) &&
+      std::equal(originA, originA + 3, originB) && std::equal(spacingA, spacingA + 3, spacingB);
+  }
+  return false;
+}
+
+bool DoTest(vtkDataSet* input, int mode, const char* label, int iterations)
+{
+  vtkMPIMoveData::SetMarshallingMode(mode);
+  vtkNew<vtkTestMPIMoveData> mover;
+  vtkNew<vtkTimerLog> timer;
+
+  double marshalTime = 0.0;
+  double reconstructTime = 0.0;
+  vtkIdType bytes = 0;
+  for (int cc = 0; cc < iterations; ++cc)
+  {
+    timer->StartTimer();
+    bytes = mover->Marshal(input);
+    timer->StopTimer();
+    marshalTime += timer->GetElapsedTime();
+
+    vtkSmartPointer<vtkDataSet> output;
+    output.TakeReference(input->NewInstance());
+    timer->StartTimer();
+    mover->Reconstruct(output);
+    timer->StopTimer();
+    reconstructTime += timer->GetElapsedTime();
+
+    if (!CompareDataSets(input, output))
+    {
+      cerr << label << ": reconstructed " << input->GetClassName() << " does not match input."
+           << endl;
+      return false;
+    }
+  }
+
+  // also exercise composite datasets.
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetBlock(0, input);
+  mb->SetBlock(2, input);
+  mover->Marshal(mb);
+  vtkNew<vtkMultiBlockDataSet> mbOutput;
+  mover->Reconstruct(mbOutput);
+  // the legacy writer loses the extents of image data blocks.
+  const bool compareBlocks =
+    mode == vtkMPIMoveData::MARSHAL_RAW_ARRAYS || !input->IsA("vtkImageData");
+  if (mbOutput->GetNumberOfBlocks() != 3 || mbOutput->GetBlock(1) != nullptr ||
+    (compareBlocks && !CompareDataSets(input, vtkDataSet::SafeDownCast(mbOutput->GetBlock(2)))))
+  {
+    cerr << label << ": reconstructed multiblock of " << input->GetClassName()
+         << " does not match input." << endl;
+    return false;
+  }
+
+  const double mb_size = input->GetActualMemorySize() / 1024.0;
+  cout << label << " (" << input->GetClassName() << "): buffer size: " << bytes << " bytes"
+       << " marshal: " << (marshalTime / iterations) << " s ("
+       << (mb_size * iterations / marshalTime) << " MB/s)"
+       << " reconstruct: " << (reconstructTime / iterations) << " s ("
+       << (mb_size * iterations / reconstructTime) << " MB/s)" << endl;
+  return true;
+}
+
+bool DoTest(const std::vector<vtkSmartPointer<vtkDataSet> >& inputs, int mode, const char* label,
+  int iterations)
+{
+  for (const auto& input : inputs)
+  {
+    if (!DoTest(input, mode, label, iterations))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Adds a vtkIdType point array and a string field array.
+void AddExtraArrays(vtkDataSet* ds)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("PointIds");
+  ids->SetNumberOfTuples(ds->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < ds->GetNumberOfPoints(); ++cc)
+  {
+    ids->SetValue(cc, cc * 3);
+  }
+  ds->GetPointData()->AddArray(ids);
+
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("Labels");
+  labels->InsertNextValue("first");
+  labels->InsertNextValue("second label");
+  labels->InsertNextValue("third");
+  ds->GetFieldData()->AddArray(labels);
+}
+
+// Triangulated sphere as an unstructured grid.
+vtkSmartPointer<vtkUnstructuredGrid> MakeUnstructuredGrid(vtkPolyData* pd)
+{
+  auto ug = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  ug->SetPoints(pd->GetPoints());
+  ug->Allocate(pd->GetNumberOfPolys());
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = pd->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    ug->InsertNextCell(npts == 3 ? VTK_TRIANGLE : VTK_POLYGON, npts, pts);
+  }
+  ug->GetPointData()->ShallowCopy(pd->GetPointData());
+  ug->GetFieldData()->ShallowCopy(pd->GetFieldData());
+  return ug;
+}
+
+vtkSmartPointer<vtkImageData> MakeImageData(int resolution)
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  // non-zero based extents and origin are lost unless the marshalling keeps them.
+  image->SetExtent(-3, resolution / 4, 2, 9, 0, 5);
+  image->SetOrigin(0.5, -1.25, 2.0);
+  image->SetSpacing(0.25, 0.5, 1.0);
+
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    scalars->SetValue(cc, 0.5 * cc);
+  }
+  image->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(image->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfCells(); ++cc)
+  {
+    cellIds->SetValue(cc, cc);
+  }
+  image->GetCellData()->AddArray(cellIds);
+  AddExtraArrays(image);
+  return image;
+}
+}
+
+int TestMPIMoveDataMarshalling(int argc, char* argv[])
+{
+  int resolution = 256;
+  int iterations = 1;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument("--resolution", argT::EQUAL_ARGUMENT, &resolution,
+    "Theta/phi resolution for the sphere to marshal.");
+  arg.AddArgument(
+    "--iterations", argT::EQUAL_ARGUMENT, &iterations, "Number of iterations to average over.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse())
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(resolution);
+  sphere->SetPhiResolution(resolution);
+  sphere->Update();
+  vtkNew<vtkPolyData> polydata;
+  polydata->ShallowCopy(sphere->GetOutput());
+  AddExtraArrays(polydata);
+
+  std::vector<vtkSmartPointer<vtkDataSet> > input;
+  input.push_back(polydata.GetPointer());
+  input.push_back(MakeUnstructuredGrid(polydata));
+  input.push_back(MakeImageData(resolution));
+
+  const int originalMode = vtkMPIMoveData::GetMarshallingMode();
+  bool success =
+    DoTest(input, vtkMPIMoveData::MARSHAL_LEGACY_WRITER, "Legacy writer", iterations) &&
+    DoTest(input, vtkMPIMoveData::MARSHAL_RAW_ARRAYS, "Raw arrays", iterations);
+
+  // chunk sizes must fit the codecs' int lengths.
+  const vtkIdType originalChunkSize = vtkMPIMoveData::GetCompressionChunkSize();
+  vtkMPIMoveData::SetCompressionChunkSize(VTK_ID_MAX);
+  if (vtkMPIMoveData::GetCompressionChunkSize() > VTK_INT_MAX)
+  {
+    cerr << "CompressionChunkSize was not clamped." << endl;
+    success = false;
+  }
+
+  // use small chunks to exercise parallel (de)compression.
+  vtkMPIMoveData::SetCompressionChunkSize(64 * 1024);
+  vtkMPIMoveData::SetCompressionCodec(vtkMPIMoveData::COMPRESSION_ZLIB);
+  success = success &&
+    DoTest(input, vtkMPIMoveData::MARSHAL_RAW_ARRAYS, "Raw arrays (zlib)", iterations);
+  vtkMPIMoveData::SetCompressionCodec(vtkMPIMoveData::COMPRESSION_LZ4);
+  success = success &&
+    DoTest(input, vtkMPIMoveData::MARSHAL_RAW_ARRAYS, "Raw arrays (lz4)", iterations) &&
+    DoTest(input, vtkMPIMoveData::MARSHAL_LEGACY_WRITER, "Legacy writer (lz4)", iterations);
+  vtkMPIMoveData::SetCompressionCodec(vtkMPIMoveData::COMPRESSION_NONE);
+  vtkMPIMoveData::SetCompressionChunkSize(originalChunkSize);
+
+  vtkMPIMoveData::SetMarshallingMode(originalMode);
+  return success ? TEST_SUCCESS : TEST_FAILED;
+}
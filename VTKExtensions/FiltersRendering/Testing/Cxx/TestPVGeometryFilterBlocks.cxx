@@ -0,0 +1,183 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVGeometryFilterBlocks.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Extracts surfaces from a multiblock dataset serially and concurrently and
+// checks that both produce the same blocks, in the same order, with the same
+// composite indices, and that progress is reported on the calling thread.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCellData.h"
+#include "vtkCommand.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedIntArray.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+vtkSmartPointer<vtkMultiBlockDataSet> CreateInput()
+{
+  auto mb = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  for (unsigned int cc = 0; cc < 16; ++cc)
+  {
+    if (cc % 2 == 0)
+    {
+      vtkNew<vtkSphereSource> sphere;
+      sphere->SetCenter(cc, 0, 0);
+      sphere->SetThetaResolution(8 + cc);
+      sphere->Update();
+      mb->SetBlock(cc, sphere->GetOutput());
+    }
+    else
+    {
+      vtkNew<vtkImageData> image;
+      image->SetDimensions(4 + cc, 5, 6);
+      image->SetOrigin(cc, 0, 0);
+      mb->SetBlock(cc, image);
+    }
+  }
+  // an empty block, and a block appearing twice.
+  mb->SetBlock(16, nullptr);
+  mb->SetBlock(17, mb->GetBlock(3));
+  return mb;
+}
+
+struct ProgressRecord
+{
+  std::thread::id Thread = std::this_thread::get_id();
+  std::vector<double> Values;
+  bool OtherThread = false;
+};
+
+void RecordProgress(vtkObject*, unsigned long, void* clientData, void* callData)
+{
+  auto record = static_cast<ProgressRecord*>(clientData);
+  record->Values.push_back(*static_cast<double*>(callData));
+  record->OtherThread = record->OtherThread || std::this_thread::get_id() != record->Thread;
+}
+
+// Concurrent progress must be reported on the calling thread, never decrease
+// and be reported between blocks too.
+bool CheckProgress(const ProgressRecord& record, int concurrency)
+{
+  const bool intermediate = std::any_of(record.Values.begin(), record.Values.end(),
+    [](double value) { return value > 0.0 && value < 1.0; });
+  if (record.OtherThread || record.Values.empty() || record.Values.back() != 1.0 ||
+    !std::is_sorted(record.Values.begin(), record.Values.end()) || !intermediate)
+  {
+    cerr << "Incorrect progress (concurrency " << concurrency << ")." << endl;
+    return false;
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkDataObject> Extract(
+  vtkMultiBlockDataSet* input, int concurrency, bool& progressValid)
+{
+  vtkPVGeometryFilter::SetBlockExecutionConcurrency(concurrency);
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetUseOutline(0);
+  filter->SetInputData(input);
+
+  ProgressRecord record;
+  vtkNew<vtkCallbackCommand> observer;
+  observer->SetCallback(RecordProgress);
+  observer->SetClientData(&record);
+  filter->AddObserver(vtkCommand::ProgressEvent, observer);
+  filter->Update();
+  // serially, the progress of each block's internal filters is forwarded too.
+  if (concurrency != 1)
+  {
+    progressValid = CheckProgress(record, concurrency) && progressValid;
+  }
+  return filter->GetOutputDataObject(0);
+}
+
+bool Compare(vtkDataObject* expected, vtkDataObject* actual, int concurrency)
+{
+  auto expectedTree = vtkDataObjectTree::SafeDownCast(expected);
+  auto actualTree = vtkDataObjectTree::SafeDownCast(actual);
+  if (!expectedTree || !actualTree)
+  {
+    cerr << "Missing composite output." << endl;
+    return false;
+  }
+
+  vtkSmartPointer<vtkDataObjectTreeIterator> expectedIter;
+  expectedIter.TakeReference(expectedTree->NewTreeIterator());
+  vtkSmartPointer<vtkDataObjectTreeIterator> actualIter;
+  actualIter.TakeReference(actualTree->NewTreeIterator());
+  expectedIter->SkipEmptyNodesOff();
+  actualIter->SkipEmptyNodesOff();
+  actualIter->InitTraversal();
+  for (expectedIter->InitTraversal(); !expectedIter->IsDoneWithTraversal();
+       expectedIter->GoToNextItem(), actualIter->GoToNextItem())
+  {
+    if (actualIter->IsDoneWithTraversal())
+    {
+      cerr << "Too few blocks (concurrency " << concurrency << ")." << endl;
+      return false;
+    }
+    auto e = vtkPolyData::SafeDownCast(expectedIter->GetCurrentDataObject());
+    auto a = vtkPolyData::SafeDownCast(actualIter->GetCurrentDataObject());
+    if ((e == nullptr) != (a == nullptr))
+    {
+      cerr << "Mismatched empty block at " << expectedIter->GetCurrentFlatIndex() << endl;
+      return false;
+    }
+    if (e == nullptr)
+    {
+      continue;
+    }
+    auto eindex =
+      vtkUnsignedIntArray::SafeDownCast(e->GetCellData()->GetArray("vtkCompositeIndex"));
+    auto aindex =
+      vtkUnsignedIntArray::SafeDownCast(a->GetCellData()->GetArray("vtkCompositeIndex"));
+    if (e->GetNumberOfPoints() != a->GetNumberOfPoints() ||
+      e->GetNumberOfCells() != a->GetNumberOfCells() || !eindex || !aindex ||
+      eindex->GetValue(0) != aindex->GetValue(0) ||
+      aindex->GetValue(0) != actualIter->GetCurrentFlatIndex())
+    {
+      cerr << "Mismatched block at " << expectedIter->GetCurrentFlatIndex() << " (concurrency "
+           << concurrency << ")." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestPVGeometryFilterBlocks(int, char* [])
+{
+  const int original = vtkPVGeometryFilter::GetBlockExecutionConcurrency();
+  auto input = CreateInput();
+  bool progressValid = true;
+  auto expected = Extract(input, 1, progressValid);
+  bool success = Compare(expected, Extract(input, 0, progressValid), 0) &&
+    Compare(expected, Extract(input, 3, progressValid), 3);
+  vtkPVGeometryFilter::SetBlockExecutionConcurrency(original);
+  return success && progressValid ? TEST_SUCCESS : TEST_FAILED;
+}
@@ -0,0 +1,245 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVGeometryFilterStaticMesh.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Extracts surfaces from a sequence of unstructured grids sharing the same
+// cells with and without CacheStaticMeshSurfaces and checks that the cached
+// surfaces carry the points and attributes of the current grid.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+const int Dimension = 8;
+
+// Creates a grid of (Dimension - 1)^3 hexahedra, skipping the hexahedra for
+// which `skip` returns true. Points and attributes depend on `step`.
+template <typename SkipT>
+vtkSmartPointer<vtkUnstructuredGrid> CreateGrid(double step, SkipT skip)
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("pointValues");
+  for (int k = 0; k < Dimension; ++k)
+  {
+    for (int j = 0; j < Dimension; ++j)
+    {
+      for (int i = 0; i < Dimension; ++i)
+      {
+        points->InsertNextPoint(i, j, k + step * i);
+        pointValues->InsertNextValue(step + i + 10 * j + 100 * k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(pointValues);
+
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("cellValues");
+  cellValues->SetNumberOfComponents(2);
+  grid->Allocate();
+  auto index = [](int i, int j, int k) { return i + Dimension * (j + Dimension * k); };
+  for (int k = 0; k + 1 < Dimension; ++k)
+  {
+    for (int j = 0; j + 1 < Dimension; ++j)
+    {
+      for (int i = 0; i + 1 < Dimension; ++i)
+      {
+        if (skip(i, j, k))
+        {
+          continue;
+        }
+        const vtkIdType hex[8] = { index(i, j, k), index(i + 1, j, k), index(i + 1, j + 1, k),
+          index(i, j + 1, k), index(i, j, k + 1), index(i + 1, j, k + 1),
+          index(i + 1, j + 1, k + 1), index(i, j + 1, k + 1) };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        cellValues->InsertNextTuple2(step * grid->GetNumberOfCells(), -step);
+      }
+    }
+  }
+  grid->GetCellData()->AddArray(cellValues);
+  return grid;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> CreateGrid(double step)
+{
+  return CreateGrid(step, [](int, int, int) { return false; });
+}
+
+bool CompareArrays(vtkDataArray* a, vtkDataArray* b, const char* name)
+{
+  if (a == nullptr || b == nullptr || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    cerr << "Mismatched array: " << name << endl;
+    return false;
+  }
+  for (vtkIdType cc = 0, max = a->GetNumberOfValues(); cc < max; ++cc)
+  {
+    if (a->GetVariantValue(cc) != b->GetVariantValue(cc))
+    {
+      cerr << "Mismatched values in array: " << name << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Compare(vtkPolyData* expected, vtkPolyData* actual)
+{
+  if (expected->GetNumberOfPoints() != actual->GetNumberOfPoints() ||
+    expected->GetNumberOfCells() != actual->GetNumberOfCells())
+  {
+    cerr << "Mismatched surface: " << actual->GetNumberOfPoints() << " points, "
+         << actual->GetNumberOfCells() << " cells (expected " << expected->GetNumberOfPoints()
+         << ", " << expected->GetNumberOfCells() << ")" << endl;
+    return false;
+  }
+
+  vtkNew<vtkIdList> expectedIds;
+  vtkNew<vtkIdList> actualIds;
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfCells(); ++cc)
+  {
+    expected->GetCellPoints(cc, expectedIds);
+    actual->GetCellPoints(cc, actualIds);
+    if (expectedIds->GetNumberOfIds() != actualIds->GetNumberOfIds())
+    {
+      cerr << "Mismatched cell " << cc << endl;
+      return false;
+    }
+    for (vtkIdType id = 0; id < expectedIds->GetNumberOfIds(); ++id)
+    {
+      if (expectedIds->GetId(id) != actualIds->GetId(id))
+      {
+        cerr << "Mismatched cell " << cc << endl;
+        return false;
+      }
+    }
+  }
+
+  if (actual->GetPointData()->GetScalars() == nullptr ||
+    strcmp(actual->GetPointData()->GetScalars()->GetName(), "pointValues") != 0)
+  {
+    cerr << "Missing active scalars." << endl;
+    return false;
+  }
+
+  return CompareArrays(expected->GetPoints()->GetData(), actual->GetPoints()->GetData(),
+           "Points") &&
+    CompareArrays(expected->GetPointData()->GetArray("pointValues"),
+           actual->GetPointData()->GetArray("pointValues"), "pointValues") &&
+    CompareArrays(expected->GetPointData()->GetArray("vtkOriginalPointIds"),
+           actual->GetPointData()->GetArray("vtkOriginalPointIds"), "vtkOriginalPointIds") &&
+    CompareArrays(expected->GetCellData()->GetArray("cellValues"),
+           actual->GetCellData()->GetArray("cellValues"), "cellValues") &&
+    CompareArrays(expected->GetCellData()->GetArray("vtkOriginalCellIds"),
+           actual->GetCellData()->GetArray("vtkOriginalCellIds"), "vtkOriginalCellIds");
+}
+
+bool Extract(vtkPVGeometryFilter* cached, vtkUnstructuredGrid* input, int step)
+{
+  vtkNew<vtkPVGeometryFilter> reference;
+  reference->SetUseOutline(0);
+  reference->SetTriangulate(cached->GetTriangulate());
+  reference->SetInputData(input);
+  reference->Update();
+
+  cached->SetInputData(input);
+  cached->Update();
+  if (!Compare(vtkPolyData::SafeDownCast(reference->GetOutputDataObject(0)),
+        vtkPolyData::SafeDownCast(cached->GetOutputDataObject(0))))
+  {
+    cerr << "Failed at step " << step << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPVGeometryFilterStaticMesh(int, char* [])
+{
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetUseOutline(0);
+  filter->SetCacheStaticMeshSurfaces(true);
+
+  int step = 0;
+  // new grids with the same cells: the surface is reused.
+  for (; step < 3; ++step)
+  {
+    if (!Extract(filter, CreateGrid(step), step))
+    {
+      return TEST_FAILED;
+    }
+  }
+
+  // the same grid with modified attributes.
+  auto grid = CreateGrid(step);
+  if (!Extract(filter, grid, step++))
+  {
+    return TEST_FAILED;
+  }
+  auto values = vtkDoubleArray::SafeDownCast(grid->GetPointData()->GetArray("pointValues"));
+  values->FillComponent(0, 42.0);
+  values->Modified();
+  if (!Extract(filter, grid, step++))
+  {
+    return TEST_FAILED;
+  }
+
+  // a new attribute array is not in the cached surface.
+  vtkNew<vtkDoubleArray> extra;
+  extra->SetName("extra");
+  extra->SetNumberOfTuples(grid->GetNumberOfPoints());
+  extra->FillComponent(0, 1.0);
+  grid->GetPointData()->AddArray(extra);
+  grid->Modified();
+  if (!Extract(filter, grid, step++) ||
+    vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0))->GetPointData()->GetArray("extra") ==
+      nullptr)
+  {
+    cerr << "Missing array added to the input." << endl;
+    return TEST_FAILED;
+  }
+
+  // changing the cells changes the surface.
+  auto holed = CreateGrid(step, [](int i, int j, int k) { return i == 0 && j == 3 && k == 3; });
+  if (!Extract(filter, holed, step++) || !Extract(filter, CreateGrid(step), step))
+  {
+    return TEST_FAILED;
+  }
+
+  // settings are part of the cache key.
+  filter->SetTriangulate(1);
+  if (!Extract(filter, CreateGrid(step), step))
+  {
+    return TEST_FAILED;
+  }
+  return TEST_SUCCESS;
+}
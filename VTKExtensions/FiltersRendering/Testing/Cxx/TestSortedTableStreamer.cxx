@@ -0,0 +1,177 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSortedTableStreamer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Fetches all the blocks of a table sorted by vtkSortedTableStreamer and
+// compares them against std::sort, for a scalar column, a vector magnitude
+// and both orders. Use `--rows=<N>` to time the sort of larger tables.
+
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkSortedTableStreamer.h"
+#include "vtkTable.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+bool DoTest(vtkTable* table, const char* column, int component, int invert, vtkIdType blockSize)
+{
+  vtkDataArray* array = vtkDataArray::SafeDownCast(table->GetColumnByName(column));
+  const int numComponents = array->GetNumberOfComponents();
+  std::vector<double> expected(array->GetNumberOfTuples());
+  for (vtkIdType cc = 0; cc < array->GetNumberOfTuples(); ++cc)
+  {
+    if (component < 0)
+    {
+      double value = 0;
+      for (int k = 0; k < numComponents; ++k)
+      {
+        value += array->GetComponent(cc, k) * array->GetComponent(cc, k);
+      }
+      expected[cc] = std::sqrt(value) / std::sqrt(static_cast<double>(numComponents));
+    }
+    else
+    {
+      expected[cc] = array->GetComponent(cc, component);
+    }
+  }
+  if (invert)
+  {
+    std::sort(expected.begin(), expected.end(), std::greater<double>());
+  }
+  else
+  {
+    std::sort(expected.begin(), expected.end());
+  }
+
+  vtkNew<vtkSortedTableStreamer> streamer;
+  streamer->SetInputData(table);
+  streamer->SetColumnNameToSort(column);
+  streamer->SetSelectedComponent(component);
+  streamer->SetInvertOrder(invert);
+  streamer->SetBlockSize(blockSize);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  vtkIdType row = 0;
+  for (vtkIdType block = 0; block * blockSize < table->GetNumberOfRows(); ++block)
+  {
+    streamer->SetBlock(block);
+    streamer->Update();
+    vtkTable* output = streamer->GetOutput();
+    vtkDataArray* sorted = vtkDataArray::SafeDownCast(output->GetColumnByName(column));
+    vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(output->GetColumnByName("ids"));
+    const vtkIdType expectedRows =
+      std::min(blockSize, table->GetNumberOfRows() - block * blockSize);
+    if (sorted == nullptr || ids == nullptr || output->GetNumberOfRows() != expectedRows)
+    {
+      cerr << column << ": incorrect block " << block << endl;
+      return false;
+    }
+    for (vtkIdType cc = 0; cc < output->GetNumberOfRows(); ++cc, ++row)
+    {
+      // the other columns must follow the sorted one.
+      const vtkIdType id = ids->GetValue(cc);
+      for (int k = 0; k < numComponents; ++k)
+      {
+        if (sorted->GetComponent(cc, k) != array->GetComponent(id, k))
+        {
+          cerr << column << ": mismatched row " << row << endl;
+          return false;
+        }
+      }
+      const double value = component < 0 ? vtkMath::Norm(sorted->GetTuple3(cc)) / std::sqrt(3.0)
+                                         : sorted->GetComponent(cc, component);
+      if (std::abs(value - expected[row]) > 1e-6 * std::abs(expected[row]))
+      {
+        cerr << column << ": incorrect value at row " << row << ": " << value << " (expected "
+             << expected[row] << ")" << endl;
+        return false;
+      }
+    }
+  }
+  timer->StopTimer();
+  cout << column << " (component " << component << ", invert " << invert << "): "
+       << timer->GetElapsedTime() << " s" << endl;
+  return true;
+}
+}
+
+int TestSortedTableStreamer(int argc, char* argv[])
+{
+  int rows = 10000;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument("--rows", argT::EQUAL_ARGUMENT, &rows, "Number of rows to sort.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse() || rows < 1)
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("scalars");
+  vtkNew<vtkIntArray> repeated;
+  repeated->SetName("repeated");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkMath::RandomSeed(1234);
+  for (vtkIdType cc = 0; cc < rows; ++cc)
+  {
+    ids->InsertNextValue(cc);
+    scalars->InsertNextValue(vtkMath::Random(-1.0, 1.0));
+    repeated->InsertNextValue(static_cast<int>(vtkMath::Random(0.0, 10.0)));
+    vectors->InsertNextTuple3(vtkMath::Random(), vtkMath::Random(), vtkMath::Random());
+  }
+
+  vtkNew<vtkTable> table;
+  table->AddColumn(ids);
+  table->AddColumn(scalars);
+  table->AddColumn(repeated);
+  table->AddColumn(vectors);
+
+  bool success = true;
+  for (int invert = 0; invert < 2 && success; ++invert)
+  {
+    success = DoTest(table, "scalars", 0, invert, 1024) &&
+      DoTest(table, "repeated", 0, invert, 100) && DoTest(table, "vectors", -1, invert, 1000) &&
+      DoTest(table, "vectors", 1, invert, 4096);
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? TEST_SUCCESS : TEST_FAILED;
+}
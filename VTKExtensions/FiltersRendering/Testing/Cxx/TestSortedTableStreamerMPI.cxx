@@ -0,0 +1,206 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSortedTableStreamerMPI.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Sorts a table distributed over all the ranks with vtkSortedTableStreamer,
+// fetches all the blocks and compares them against std::sort of the whole
+// column, for a scalar column, a column with NaNs and both orders. Must run
+// on at least 2 ranks. Use `--rows=<N>` to set the rows of each rank.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMPIController.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSortedTableStreamer.h"
+#include "vtkTable.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+bool Same(double a, double b)
+{
+  return (std::isnan(a) && std::isnan(b)) || a == b;
+}
+
+// `values` holds the column of every rank, indexed by the global ids.
+bool DoTest(vtkMultiProcessController* controller, vtkTable* table, const char* column,
+  const std::vector<double>& values, int invert, vtkIdType blockSize)
+{
+  // NaNs come last in both orders.
+  std::vector<double> expected(values);
+  std::sort(expected.begin(), expected.end(), [invert](double a, double b) {
+    if (std::isnan(a) || std::isnan(b))
+    {
+      return !std::isnan(a) && std::isnan(b);
+    }
+    return invert ? a > b : a < b;
+  });
+  const vtkIdType totalRows = static_cast<vtkIdType>(expected.size());
+
+  vtkNew<vtkSortedTableStreamer> streamer;
+  streamer->SetInputData(table);
+  streamer->SetColumnNameToSort(column);
+  streamer->SetSelectedComponent(0);
+  streamer->SetInvertOrder(invert);
+  streamer->SetBlockSize(blockSize);
+
+  for (vtkIdType block = 0; block * blockSize < totalRows; ++block)
+  {
+    streamer->SetBlock(block);
+    streamer->Update();
+    vtkTable* output = streamer->GetOutput();
+    const vtkIdType expectedRows = std::min(blockSize, totalRows - block * blockSize);
+
+    // the block is merged on a single rank.
+    vtkIdType localRows = output->GetNumberOfRows();
+    vtkIdType rows = 0;
+    controller->AllReduce(&localRows, &rows, 1, vtkCommunicator::SUM_OP);
+    vtkDataArray* sorted = vtkDataArray::SafeDownCast(output->GetColumnByName(column));
+    vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(output->GetColumnByName("ids"));
+    int success = rows == expectedRows &&
+      (localRows == 0 || (localRows == expectedRows && sorted != nullptr && ids != nullptr));
+    if (!success)
+    {
+      cerr << column << ": incorrect block " << block << endl;
+    }
+    for (vtkIdType cc = 0; success && cc < localRows; ++cc)
+    {
+      // the other columns must follow the sorted one.
+      const vtkIdType row = block * blockSize + cc;
+      const double value = sorted->GetComponent(cc, 0);
+      if (!Same(value, values[ids->GetValue(cc)]))
+      {
+        cerr << column << ": mismatched row " << row << endl;
+        success = 0;
+      }
+      else if (!Same(value, expected[row]))
+      {
+        cerr << column << ": incorrect value at row " << row << ": " << value << " (expected "
+             << expected[row] << ")" << endl;
+        success = 0;
+      }
+    }
+
+    int allSuccess = 0;
+    controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::MIN_OP);
+    if (!allSuccess)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Gathers the column of every rank, in the order of the global ids.
+std::vector<double> GatherColumn(vtkMultiProcessController* controller, vtkDataArray* array)
+{
+  const int numProcs = controller->GetNumberOfProcesses();
+  vtkIdType length = array->GetNumberOfTuples();
+  std::vector<vtkIdType> lengths(numProcs);
+  std::vector<vtkIdType> offsets(numProcs);
+  controller->AllGather(&length, &lengths[0], 1);
+  vtkIdType total = 0;
+  for (int pid = 0; pid < numProcs; ++pid)
+  {
+    offsets[pid] = total;
+    total += lengths[pid];
+  }
+  std::vector<double> local(length);
+  for (vtkIdType cc = 0; cc < length; ++cc)
+  {
+    local[cc] = array->GetComponent(cc, 0);
+  }
+  std::vector<double> values(total);
+  controller->AllGatherV(local.data(), values.data(), length, &lengths[0], &offsets[0]);
+  return values;
+}
+}
+
+int TestSortedTableStreamerMPI(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const int me = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  int rows = 5000;
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument("--rows", argT::EQUAL_ARGUMENT, &rows, "Number of rows of each rank.");
+  arg.StoreUnusedArguments(true);
+  bool success = true;
+  if (!arg.Parse() || rows < 1 || numProcs < 2)
+  {
+    cerr << "Problem parsing arguments or fewer than 2 ranks" << endl;
+    success = false;
+  }
+
+  if (success)
+  {
+    // uneven distribution, global ids follow the ranks.
+    const vtkIdType localRows = rows + me * rows / 4;
+    vtkIdType offset = 0;
+    std::vector<vtkIdType> allRows(numProcs);
+    controller->AllGather(&localRows, &allRows[0], 1);
+    for (int pid = 0; pid < me; ++pid)
+    {
+      offset += allRows[pid];
+    }
+
+    vtkNew<vtkIdTypeArray> ids;
+    ids->SetName("ids");
+    vtkNew<vtkDoubleArray> scalars;
+    scalars->SetName("scalars");
+    vtkNew<vtkDoubleArray> nans;
+    nans->SetName("nans");
+    vtkMath::RandomSeed(1234 + me);
+    for (vtkIdType cc = 0; cc < localRows; ++cc)
+    {
+      ids->InsertNextValue(offset + cc);
+      scalars->InsertNextValue(vtkMath::Random(-1.0, 1.0));
+      nans->InsertNextValue(
+        cc % 13 == 0 ? vtkMath::Nan() : static_cast<int>(vtkMath::Random(0.0, 10.0)));
+    }
+
+    vtkNew<vtkTable> table;
+    table->AddColumn(ids);
+    table->AddColumn(scalars);
+    table->AddColumn(nans);
+
+    const std::vector<double> allScalars = GatherColumn(controller, scalars);
+    const std::vector<double> allNans = GatherColumn(controller, nans);
+    for (int invert = 0; invert < 2 && success; ++invert)
+    {
+      success = DoTest(controller, table, "scalars", allScalars, invert, 1024) &&
+        DoTest(controller, table, "nans", allNans, invert, 700);
+    }
+  }
+
+  int localSuccess = success ? 1 : 0;
+  int allSuccess = 0;
+  controller->AllReduce(&localSuccess, &allSuccess, 1, vtkCommunicator::MIN_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? TEST_SUCCESS : TEST_FAILED;
+}
@@ -0,0 +1,159 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSquirtCompressorPerformance.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compresses and decompresses a synthetic 4K frame with vtkSquirtCompressor
+// using a single tile and using the default tiling, validates the round trip
+// and reports frames/s. Use `--width`, `--height` and `--iterations` to
+// change the benchmark.
+
+#include "vtkNew.h"
+#include "vtkSquirtCompressor.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vtksys/CommandLineArguments.hxx>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+// Fills `image` with something resembling a rendering: a flat background
+// with a few shaded, partially translucent shapes.
+void FillImage(vtkUnsignedCharArray* image, int width, int height, int numComps)
+{
+  image->SetNumberOfComponents(numComps);
+  image->SetNumberOfTuples(static_cast<vtkIdType>(width) * height);
+  unsigned char* ptr = image->GetPointer(0);
+  for (int j = 0; j < height; ++j)
+  {
+    for (int i = 0; i < width; ++i, ptr += numComps)
+    {
+      const double x = (i - width / 2.0) / height;
+      const double y = (j - height / 2.0) / height;
+      unsigned char rgba[4] = { 82, 87, 110, 0 };
+      if (x * x + y * y < 0.1)
+      {
+        rgba[0] = static_cast<unsigned char>(128 + 127 * x);
+        rgba[1] = static_cast<unsigned char>(128 + 127 * y);
+        rgba[2] = static_cast<unsigned char>((i / 8 + j / 8) % 2 ? 200 : 40);
+        rgba[3] = 255;
+      }
+      else if (x > 0.4 && y > 0.1)
+      {
+        rgba[0] = 250;
+        rgba[1] = 10;
+        rgba[2] = static_cast<unsigned char>(i % 256);
+        rgba[3] = 128;
+      }
+      std::copy(rgba, rgba + numComps, ptr);
+    }
+  }
+}
+
+bool DoTest(vtkUnsignedCharArray* input, int tileSize, int iterations)
+{
+  vtkNew<vtkSquirtCompressor> squirt;
+  squirt->SetSquirtLevel(0);
+  squirt->SetTileSize(tileSize);
+
+  vtkNew<vtkUnsignedCharArray> compressed;
+  vtkNew<vtkUnsignedCharArray> output;
+  output->SetNumberOfComponents(input->GetNumberOfComponents());
+  output->SetNumberOfTuples(input->GetNumberOfTuples());
+
+  vtkNew<vtkTimerLog> timer;
+  double compressTime = 0.0;
+  double decompressTime = 0.0;
+  for (int cc = 0; cc < iterations; ++cc)
+  {
+    squirt->SetInput(input);
+    squirt->SetOutput(compressed);
+    timer->StartTimer();
+    if (squirt->Compress() != VTK_OK)
+    {
+      cerr << "Compress failed." << endl;
+      return false;
+    }
+    timer->StopTimer();
+    compressTime += timer->GetElapsedTime();
+
+    squirt->SetInput(compressed);
+    squirt->SetOutput(output);
+    timer->StartTimer();
+    if (squirt->Decompress() != VTK_OK)
+    {
+      cerr << "Decompress failed." << endl;
+      return false;
+    }
+    timer->StopTimer();
+    decompressTime += timer->GetElapsedTime();
+  }
+
+  // Squirt only keeps 4 bits of opacity, so compare the colors.
+  const int numComps = input->GetNumberOfComponents();
+  const unsigned char* in = input->GetPointer(0);
+  const unsigned char* out = output->GetPointer(0);
+  for (vtkIdType cc = 0, max = input->GetNumberOfTuples(); cc < max; ++cc)
+  {
+    if (memcmp(in + numComps * cc, out + numComps * cc, 3) != 0)
+    {
+      cerr << "Mismatched pixel " << cc << " (tile size: " << tileSize << ")." << endl;
+      return false;
+    }
+  }
+
+  cout << "components: " << numComps << " tile size: " << tileSize
+       << " compressed size: " << compressed->GetNumberOfTuples()
+       << " compress: " << (iterations / compressTime) << " frames/s"
+       << " decompress: " << (iterations / decompressTime) << " frames/s" << endl;
+  return true;
+}
+}
+
+int TestSquirtCompressorPerformance(int argc, char* argv[])
+{
+  int width = 3840;
+  int height = 2160;
+  int iterations = 3;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument("--width", argT::EQUAL_ARGUMENT, &width, "Image width.");
+  arg.AddArgument("--height", argT::EQUAL_ARGUMENT, &height, "Image height.");
+  arg.AddArgument(
+    "--iterations", argT::EQUAL_ARGUMENT, &iterations, "Number of iterations to average over.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse())
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  vtkNew<vtkSquirtCompressor> defaults;
+  for (int numComps = 3; numComps <= 4; ++numComps)
+  {
+    vtkNew<vtkUnsignedCharArray> image;
+    FillImage(image, width, height, numComps);
+    if (!DoTest(image, 0, iterations) || !DoTest(image, defaults->GetTileSize(), iterations) ||
+      !DoTest(image, 1000, 1))
+    {
+      return TEST_FAILED;
+    }
+  }
+  return TEST_SUCCESS;
+}
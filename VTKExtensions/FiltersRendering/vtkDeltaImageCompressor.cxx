@@ -0,0 +1,522 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDeltaImageCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDeltaImageCompressor.h"
+
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "vtk_lz4.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+// A compressed frame is laid out as follows (all words are 32-bit):
+//
+//   header (see HeaderWords below),
+//   dirty tile bitmap (one bit per tile, padded to a whole word),
+//   compressed size of each dirty tile, in tile order,
+//   compressed bytes of each dirty tile, in tile order.
+const unsigned int DeltaStreamMagic = 0x31544c44; // "DLT1"
+const unsigned int KeyFrameFlag = 0x1;
+enum HeaderWords
+{
+  HEADER_MAGIC = 0,
+  HEADER_FRAME,
+  HEADER_FLAGS,
+  HEADER_WIDTH,
+  HEADER_HEIGHT,
+  HEADER_COMPONENTS,
+  HEADER_TILE_SIZE,
+  HEADER_SIZE
+};
+
+const unsigned char DeltaCompressMasks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF },
+  { 0xFE, 0xFF, 0xFE, 0xFE }, { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 },
+  { 0xF0, 0xF8, 0xF0, 0xF0 }, { 0xE0, 0xF0, 0xE0, 0xE0 } };
+
+// Describes how an image is split into tiles.
+struct TileLayout
+{
+  int Width;
+  int Height;
+  int NumberOfComponents;
+  int TileSize;
+  int TilesX;
+  int TilesY;
+
+  TileLayout(int width, int height, int numComps, int tileSize)
+    : Width(width)
+    , Height(height)
+    , NumberOfComponents(numComps)
+    , TileSize(tileSize)
+    , TilesX((width + tileSize - 1) / tileSize)
+    , TilesY((height + tileSize - 1) / tileSize)
+  {
+  }
+
+  int GetNumberOfTiles() const { return this->TilesX * this->TilesY; }
+
+  // Computes the origin (in pixels), the size (in pixels) of a tile and the
+  // number of bytes in a row of the tile.
+  void GetTile(int tile, int& x, int& y, int& width, int& height, int& rowSize) const
+  {
+    x = (tile % this->TilesX) * this->TileSize;
+    y = (tile / this->TilesX) * this->TileSize;
+    width = std::min(this->TileSize, this->Width - x);
+    height = std::min(this->TileSize, this->Height - y);
+    rowSize = width * this->NumberOfComponents;
+  }
+
+  vtkIdType GetOffset(int x, int y) const
+  {
+    return (static_cast<vtkIdType>(y) * this->Width + x) * this->NumberOfComponents;
+  }
+};
+}
+
+class vtkDeltaImageCompressor::vtkInternals
+{
+public:
+  // Frame last transmitted, as the decompressor will reconstruct it.
+  vtkNew<vtkUnsignedCharArray> EncoderReference;
+  int EncoderSize[2] = { 0, 0 };
+  unsigned int EncoderFrame = 0;
+  int FramesSinceKeyFrame = 0;
+  bool EncoderValid = false;
+  bool ForceKeyFrame = true;
+  bool LastFrameWasKeyFrame = false;
+  int LastNumberOfDirtyTiles = 0;
+  std::vector<std::vector<char> > Payloads;
+  std::vector<unsigned char> Dirty;
+
+  // Last frame decompressed.
+  vtkNew<vtkUnsignedCharArray> DecoderReference;
+  int DecoderSize[2] = { 0, 0 };
+  unsigned int DecoderFrame = 0;
+  bool DecoderValid = false;
+};
+
+vtkStandardNewMacro(vtkDeltaImageCompressor);
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::vtkDeltaImageCompressor()
+  : Quality(3)
+  , KeyFrameInterval(30)
+  , TileSize(64)
+  , Internals(new vtkDeltaImageCompressor::vtkInternals())
+{
+  this->ImageResolution[0] = this->ImageResolution[1] = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::~vtkDeltaImageCompressor()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SetImageResolution(int width, int height)
+{
+  this->ImageResolution[0] = width;
+  this->ImageResolution[1] = height;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::RequestKeyFrame()
+{
+  this->Internals->ForceKeyFrame = true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDeltaImageCompressor::GetLastFrameWasKeyFrame() const
+{
+  return this->Internals->LastFrameWasKeyFrame;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::GetLastNumberOfDirtyTiles() const
+{
+  return this->Internals->LastNumberOfDirtyTiles;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  vtkUnsignedCharArray* input = this->Input;
+  const int numComps = input->GetNumberOfComponents();
+  if (numComps != 3 && numComps != 4)
+  {
+    vtkErrorMacro("vtkDeltaImageCompressor only works with RGBA or RGB");
+    return VTK_ERROR;
+  }
+
+  // Without a matching resolution, treat the image as a single row.
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  int width = this->ImageResolution[0];
+  int height = this->ImageResolution[1];
+  if (static_cast<vtkIdType>(width) * height != numPixels)
+  {
+    width = static_cast<int>(numPixels);
+    height = numPixels > 0 ? 1 : 0;
+  }
+
+  const int compress_level = this->LossLessMode ? 0 : this->Quality;
+  const unsigned char* mask = DeltaCompressMasks[compress_level];
+
+  auto& internals = *this->Internals;
+  vtkUnsignedCharArray* reference = internals.EncoderReference;
+  const bool keyFrame = internals.ForceKeyFrame || !internals.EncoderValid ||
+    internals.EncoderSize[0] != width || internals.EncoderSize[1] != height ||
+    reference->GetNumberOfComponents() != numComps ||
+    internals.FramesSinceKeyFrame + 1 >= this->KeyFrameInterval;
+  if (keyFrame)
+  {
+    reference->SetNumberOfComponents(numComps);
+    reference->SetNumberOfTuples(numPixels);
+    internals.EncoderSize[0] = width;
+    internals.EncoderSize[1] = height;
+  }
+
+  const TileLayout layout(width, height, numComps, this->TileSize);
+  const int numTiles = layout.GetNumberOfTiles();
+  internals.Payloads.resize(numTiles);
+  internals.Dirty.assign(numTiles, 0);
+
+  const unsigned char* in = input->GetPointer(0);
+  unsigned char* ref = reference->GetPointer(0);
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, numTiles, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<unsigned char> scratch(
+      static_cast<size_t>(layout.TileSize) * layout.TileSize * numComps);
+    for (vtkIdType tile = begin; tile < end; ++tile)
+    {
+      int x, y, tileWidth, tileHeight, rowSize;
+      layout.GetTile(static_cast<int>(tile), x, y, tileWidth, tileHeight, rowSize);
+
+      // Gather the (color reduced) tile and compare it with what the
+      // decompressor already has.
+      bool dirty = keyFrame;
+      for (int row = 0; row < tileHeight; ++row)
+      {
+        const vtkIdType offset = layout.GetOffset(x, y + row);
+        unsigned char* dest = &scratch[static_cast<size_t>(row) * rowSize];
+        if (compress_level > 0)
+        {
+          for (int cc = 0; cc < rowSize; ++cc)
+          {
+            dest[cc] = in[offset + cc] & mask[cc % numComps];
+          }
+        }
+        else
+        {
+          std::copy(in + offset, in + offset + rowSize, dest);
+        }
+        dirty = dirty || memcmp(dest, ref + offset, rowSize) != 0;
+      }
+      if (!dirty)
+      {
+        continue;
+      }
+
+      for (int row = 0; row < tileHeight; ++row)
+      {
+        const unsigned char* src = &scratch[static_cast<size_t>(row) * rowSize];
+        std::copy(src, src + rowSize, ref + layout.GetOffset(x, y + row));
+      }
+
+      const int tileBytes = rowSize * tileHeight;
+      std::vector<char>& payload = internals.Payloads[tile];
+      payload.resize(LZ4_compressBound(tileBytes));
+      const int compressedSize = LZ4_compress_default(reinterpret_cast<const char*>(&scratch[0]),
+        &payload[0], tileBytes, static_cast<int>(payload.size()));
+      if (compressedSize <= 0)
+      {
+        failed = true;
+      }
+      payload.resize(std::max(compressedSize, 0));
+      internals.Dirty[tile] = 1;
+    }
+  });
+
+  if (failed)
+  {
+    // the reference may now be out of sync with the decompressor.
+    internals.EncoderValid = false;
+    vtkErrorMacro("Failed to compress image tiles.");
+    return VTK_ERROR;
+  }
+
+  // Assemble the stream.
+  const int bitmapWords = (numTiles + 31) / 32;
+  int numDirty = 0;
+  size_t payloadBytes = 0;
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    if (internals.Dirty[tile])
+    {
+      ++numDirty;
+      payloadBytes += internals.Payloads[tile].size();
+    }
+  }
+
+  const size_t headerBytes = sizeof(unsigned int) * (HEADER_SIZE + bitmapWords + numDirty);
+  this->Output->SetNumberOfComponents(1);
+  this->Output->SetNumberOfTuples(static_cast<vtkIdType>(headerBytes + payloadBytes));
+  unsigned char* out = this->Output->GetPointer(0);
+  std::vector<unsigned int> header(HEADER_SIZE + bitmapWords + numDirty, 0);
+
+  internals.EncoderFrame++;
+  header[HEADER_MAGIC] = DeltaStreamMagic;
+  header[HEADER_FRAME] = internals.EncoderFrame;
+  header[HEADER_FLAGS] = keyFrame ? KeyFrameFlag : 0;
+  header[HEADER_WIDTH] = static_cast<unsigned int>(width);
+  header[HEADER_HEIGHT] = static_cast<unsigned int>(height);
+  header[HEADER_COMPONENTS] = static_cast<unsigned int>(numComps);
+  header[HEADER_TILE_SIZE] = static_cast<unsigned int>(layout.TileSize);
+  unsigned char* payloadOut = out + headerBytes;
+  for (int tile = 0, dirtyIndex = 0; tile < numTiles; ++tile)
+  {
+    if (internals.Dirty[tile])
+    {
+      const std::vector<char>& payload = internals.Payloads[tile];
+      header[HEADER_SIZE + tile / 32] |= (1u << (tile % 32));
+      header[HEADER_SIZE + bitmapWords + dirtyIndex++] = static_cast<unsigned int>(payload.size());
+      std::copy(payload.begin(), payload.end(), payloadOut);
+      payloadOut += payload.size();
+    }
+  }
+  memcpy(out, &header[0], headerBytes);
+
+  internals.EncoderValid = true;
+  internals.ForceKeyFrame = false;
+  internals.FramesSinceKeyFrame = keyFrame ? 0 : internals.FramesSinceKeyFrame + 1;
+  internals.LastFrameWasKeyFrame = keyFrame;
+  internals.LastNumberOfDirtyTiles = numDirty;
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  auto& internals = *this->Internals;
+  const unsigned char* in = this->Input->GetPointer(0);
+  const size_t inputBytes =
+    static_cast<size_t>(this->Input->GetNumberOfTuples()) * this->Input->GetNumberOfComponents();
+  if (inputBytes < sizeof(unsigned int) * HEADER_SIZE)
+  {
+    vtkErrorMacro("Invalid compressed frame.");
+    internals.DecoderValid = false;
+    return VTK_ERROR;
+  }
+
+  std::vector<unsigned int> header(HEADER_SIZE);
+  memcpy(&header[0], in, sizeof(unsigned int) * HEADER_SIZE);
+  const int width = static_cast<int>(header[HEADER_WIDTH]);
+  const int height = static_cast<int>(header[HEADER_HEIGHT]);
+  const int numComps = static_cast<int>(header[HEADER_COMPONENTS]);
+  const int tileSize = static_cast<int>(header[HEADER_TILE_SIZE]);
+  const bool keyFrame = (header[HEADER_FLAGS] & KeyFrameFlag) != 0;
+  const vtkIdType numPixels = static_cast<vtkIdType>(width) * height;
+  if (header[HEADER_MAGIC] != DeltaStreamMagic || width < 0 || height < 0 || tileSize <= 0 ||
+    tileSize > 4096 || numComps != this->Output->GetNumberOfComponents() ||
+    numPixels != this->Output->GetNumberOfTuples())
+  {
+    vtkErrorMacro("Invalid compressed frame or mismatched output buffer.");
+    internals.DecoderValid = false;
+    return VTK_ERROR;
+  }
+
+  vtkUnsignedCharArray* reference = internals.DecoderReference;
+  if (keyFrame)
+  {
+    reference->SetNumberOfComponents(numComps);
+    reference->SetNumberOfTuples(numPixels);
+    internals.DecoderSize[0] = width;
+    internals.DecoderSize[1] = height;
+  }
+  else if (!internals.DecoderValid || internals.DecoderSize[0] != width ||
+    internals.DecoderSize[1] != height || reference->GetNumberOfComponents() != numComps ||
+    header[HEADER_FRAME] != internals.DecoderFrame + 1)
+  {
+    vtkErrorMacro("Cannot apply frame " << header[HEADER_FRAME]
+                                        << ", waiting for the next key frame.");
+    internals.DecoderValid = false;
+    return VTK_ERROR;
+  }
+
+  // Read the bitmap and locate each dirty tile's payload.
+  const TileLayout layout(width, height, numComps, tileSize);
+  const int numTiles = layout.GetNumberOfTiles();
+  const int bitmapWords = (numTiles + 31) / 32;
+  size_t offset = sizeof(unsigned int) * (HEADER_SIZE + bitmapWords);
+  if (inputBytes < offset)
+  {
+    vtkErrorMacro("Truncated compressed frame.");
+    internals.DecoderValid = false;
+    return VTK_ERROR;
+  }
+  std::vector<unsigned int> bitmap(bitmapWords);
+  if (bitmapWords > 0)
+  {
+    memcpy(&bitmap[0], in + sizeof(unsigned int) * HEADER_SIZE, sizeof(unsigned int) * bitmapWords);
+  }
+  std::vector<int> dirtyTiles;
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    if (bitmap[tile / 32] & (1u << (tile % 32)))
+    {
+      dirtyTiles.push_back(tile);
+    }
+  }
+
+  const size_t sizesOffset = offset;
+  offset += sizeof(unsigned int) * dirtyTiles.size();
+  std::vector<size_t> payloadOffsets(dirtyTiles.size());
+  std::vector<int> payloadSizes(dirtyTiles.size());
+  for (size_t cc = 0; cc < dirtyTiles.size() && offset <= inputBytes; ++cc)
+  {
+    unsigned int size;
+    memcpy(&size, in + sizesOffset + sizeof(unsigned int) * cc, sizeof(unsigned int));
+    payloadOffsets[cc] = offset;
+    payloadSizes[cc] = static_cast<int>(std::min(size, 0x7fffffffu));
+    offset += payloadSizes[cc];
+  }
+  if (offset > inputBytes)
+  {
+    vtkErrorMacro("Truncated compressed frame.");
+    internals.DecoderValid = false;
+    return VTK_ERROR;
+  }
+
+  unsigned char* ref = reference->GetPointer(0);
+  std::atomic<bool> failed(false);
+  const vtkIdType numDirty = static_cast<vtkIdType>(dirtyTiles.size());
+  vtkSMPTools::For(0, numDirty, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<char> scratch(static_cast<size_t>(tileSize) * tileSize * numComps);
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      int x, y, tileWidth, tileHeight, rowSize;
+      layout.GetTile(dirtyTiles[cc], x, y, tileWidth, tileHeight, rowSize);
+      const int tileBytes = rowSize * tileHeight;
+      const int decompressedSize =
+        LZ4_decompress_safe(reinterpret_cast<const char*>(in + payloadOffsets[cc]), &scratch[0],
+          payloadSizes[cc], tileBytes);
+      if (decompressedSize != tileBytes)
+      {
+        failed = true;
+        continue;
+      }
+      for (int row = 0; row < tileHeight; ++row)
+      {
+        const char* src = &scratch[static_cast<size_t>(row) * rowSize];
+        std::copy(src, src + rowSize, ref + layout.GetOffset(x, y + row));
+      }
+    }
+  });
+
+  if (failed || (keyFrame && static_cast<int>(dirtyTiles.size()) != numTiles))
+  {
+    vtkErrorMacro("Corrupt compressed frame, waiting for the next key frame.");
+    internals.DecoderValid = false;
+    return VTK_ERROR;
+  }
+
+  std::copy(ref, ref + numPixels * numComps, this->Output->GetPointer(0));
+  internals.DecoderFrame = header[HEADER_FRAME];
+  internals.DecoderValid = true;
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
+{
+  this->Superclass::SaveConfiguration(stream);
+  *stream << this->Quality << this->KeyFrameInterval;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkDeltaImageCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
+{
+  if (this->Superclass::RestoreConfiguration(stream))
+  {
+    int quality, interval;
+    *stream >> quality >> interval;
+    this->SetQuality(quality);
+    this->SetKeyFrameInterval(interval);
+    this->RequestKeyFrame();
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::SaveConfiguration()
+{
+  std::ostringstream oss;
+  oss << this->Superclass::SaveConfiguration() << " " << this->Quality << " "
+      << this->KeyFrameInterval;
+  this->SetConfiguration(oss.str().c_str());
+  return this->Configuration;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::RestoreConfiguration(const char* stream)
+{
+  stream = this->Superclass::RestoreConfiguration(stream);
+  if (stream)
+  {
+    std::istringstream iss(stream);
+    int quality, interval;
+    iss >> quality >> interval;
+    if (iss.fail())
+    {
+      return 0;
+    }
+    this->SetQuality(quality);
+    this->SetKeyFrameInterval(interval);
+    this->RequestKeyFrame();
+    return iss.eof() ? stream + strlen(stream) : stream + iss.tellg();
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "KeyFrameInterval: " << this->KeyFrameInterval << endl;
+  os << indent << "TileSize: " << this->TileSize << endl;
+}
@@ -0,0 +1,142 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDeltaImageCompressor.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDeltaImageCompressor
+ * @brief   image compressor that only transmits the tiles changed since the
+ * previous frame.
+ *
+ * vtkDeltaImageCompressor splits images into square tiles and keeps the
+ * previously transmitted frame on both the compressing and the
+ * decompressing end. Each compressed frame carries a bitmap of the tiles
+ * that differ from the previous frame followed by the LZ4 compressed pixels
+ * for those tiles only. Interactions that only change a small part of the
+ * view, such as dragging a widget or editing a scalar bar, are thus
+ * transmitted at a fraction of the cost of a full frame.
+ *
+ * Every `KeyFrameInterval` frames, and whenever the image size or the
+ * configuration changes, a key frame containing all tiles is sent. Frames
+ * must be decompressed in the order they were compressed; if a frame is
+ * lost or fails to decompress, the following frames are rejected until the
+ * next key frame.
+ *
+ * `Quality` applies the same color reducing mask as vtkLZ4Compressor before
+ * comparing and compressing tiles. It is ignored when LossLessMode is set.
+ *
+ * The configuration stream is `vtkDeltaImageCompressor <LossLessMode>
+ * <Quality> <KeyFrameInterval>`.
+ */
+
+#ifndef vtkDeltaImageCompressor_h
+#define vtkDeltaImageCompressor_h
+
+#include "vtkImageCompressor.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkDeltaImageCompressor : public vtkImageCompressor
+{
+public:
+  static vtkDeltaImageCompressor* New();
+  vtkTypeMacro(vtkDeltaImageCompressor, vtkImageCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set the quality measure. The value can be between 0 and 5. 0 means
+   * preserve input image quality while 5 means improve compression at the
+   * cost of image quality. Default is 3.
+   */
+  vtkSetClampMacro(Quality, int, 0, 5);
+  vtkGetMacro(Quality, int);
+  //@}
+
+  //@{
+  /**
+   * Set the number of frames between two key frames. A key frame contains
+   * the whole image and lets the decompressor recover from lost or
+   * corrupted frames. The decompressor cannot request a key frame, so
+   * periodic key frames are always sent. Default is 30.
+   */
+  vtkSetClampMacro(KeyFrameInterval, int, 1, VTK_INT_MAX);
+  vtkGetMacro(KeyFrameInterval, int);
+  //@}
+
+  //@{
+  /**
+   * Set the width (and height) of the tiles in pixels. This is only used
+   * when compressing; the tile size is recorded in the compressed stream.
+   * Default is 64.
+   */
+  vtkSetClampMacro(TileSize, int, 8, 4096);
+  vtkGetMacro(TileSize, int);
+  //@}
+
+  /**
+   * Forces the next compressed frame to be a key frame.
+   */
+  void RequestKeyFrame();
+
+  /**
+   * Returns true if the last compressed frame was a key frame.
+   */
+  bool GetLastFrameWasKeyFrame() const;
+
+  /**
+   * Returns the number of tiles transmitted in the last compressed frame.
+   */
+  int GetLastNumberOfDirtyTiles() const;
+
+  //@{
+  /**
+   * Compress/Decompress data array on the objects input with results
+   * in the objects output. See also Set/GetInput/Output.
+   */
+  int Compress() override;
+  int Decompress() override;
+  //@}
+
+  /**
+   * Communicates the next expected image resolution. This is needed to
+   * split the image into tiles.
+   */
+  void SetImageResolution(int width, int height) override;
+
+  //@{
+  /**
+   * Serialize/Restore compressor configuration (but not the data) into the stream.
+   */
+  void SaveConfiguration(vtkMultiProcessStream* stream) override;
+  bool RestoreConfiguration(vtkMultiProcessStream* stream) override;
+  const char* SaveConfiguration() override;
+  const char* RestoreConfiguration(const char* stream) override;
+  //@}
+
+protected:
+  vtkDeltaImageCompressor();
+  ~vtkDeltaImageCompressor() override;
+
+  int Quality;
+  int KeyFrameInterval;
+  int TileSize;
+  int ImageResolution[2];
+
+private:
+  vtkDeltaImageCompressor(const vtkDeltaImageCompressor&) = delete;
+  void operator=(const vtkDeltaImageCompressor&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -15,12 +15,16 @@
 #include "vtkMPIMoveData.h"
 
 #include "vtkAllToNRedistributeCompositePolyData.h"
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkGenericDataObjectWriter.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -34,21 +38,40 @@
 #include "vtkPVLogger.h"
 #include "vtkPVSession.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkProcessModule.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringArray.h"
 #include "vtkTimerLog.h"
 #include "vtkToolkits.h"
+#include "vtkTypeInt32Array.h"
+#include "vtkTypeInt64Array.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
 
+#include "vtk_lz4.h"
 #include "vtk_zlib.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <string>
 #include <vector>
 
-#include <vector>
-
-bool vtkMPIMoveData::UseZLibCompression = false;
+int vtkMPIMoveData::CompressionCodec = vtkMPIMoveData::COMPRESSION_NONE;
+int vtkMPIMoveData::CompressionLevel = 0;
+vtkIdType vtkMPIMoveData::CompressionChunkSize = 1 << 20;
+int vtkMPIMoveData::MarshallingMode = vtkMPIMoveData::MARSHAL_LEGACY_WRITER;
 
 namespace
 {
@@ -82,6 +105,1003 @@ void unsetGlobalIdsAttribute(vtkDataObject* piece)
     it->Delete();
   }
 }
+
+//-----------------------------------------------------------------------------
+// Raw array marshalling (vtkMPIMoveData::MARSHAL_RAW_ARRAYS).
+//
+// A marshalled piece is a small metadata stream interleaved with the raw
+// contents of every vtkDataArray in the data object. Payloads are padded to
+// 8-byte boundaries so that the receiver can wrap them as vtkDataArrays
+// directly on the received memory instead of copying (or parsing) them.
+//
+// Layout: "vtkraw01" | uint32 endian-tag | int32 sizeof(vtkIdType) | object
+//-----------------------------------------------------------------------------
+static const char RawMarshalMagic[] = "vtkraw01";
+static const size_t RawMarshalMagicLength = 8;
+static const uint32_t RawMarshalEndianTag = 0x01020304;
+static const size_t RawMarshalAlignment = 8;
+
+enum RawArrayKinds
+{
+  RAW_DATA_ARRAY = 0,
+  RAW_STRING_ARRAY = 1
+};
+
+// Keeps received buffers alive for as long as any array wraps a region of
+// them. vtkAbstractArray::SetArrayFreeFunction only accepts a plain function
+// pointer, hence the registry keyed by the wrapped pointer.
+class RawBufferRegistry
+{
+public:
+  static void Register(void* region, const std::shared_ptr<char>& block)
+  {
+    std::lock_guard<std::mutex> lock(RawBufferRegistry::Mutex);
+    RawBufferRegistry::Regions.insert(std::make_pair(region, block));
+  }
+
+  static void Release(void* region)
+  {
+    std::shared_ptr<char> block;
+    {
+      std::lock_guard<std::mutex> lock(RawBufferRegistry::Mutex);
+      auto iter = RawBufferRegistry::Regions.find(region);
+      if (iter != RawBufferRegistry::Regions.end())
+      {
+        // release the block outside the lock.
+        block = iter->second;
+        RawBufferRegistry::Regions.erase(iter);
+      }
+    }
+  }
+
+private:
+  static std::mutex Mutex;
+  static std::multimap<void*, std::shared_ptr<char> > Regions;
+};
+std::mutex RawBufferRegistry::Mutex;
+std::multimap<void*, std::shared_ptr<char> > RawBufferRegistry::Regions;
+
+//-----------------------------------------------------------------------------
+class RawMarshaller
+{
+public:
+  RawMarshaller()
+    : TotalLength(0)
+  {
+    this->Metadata.emplace_back();
+  }
+
+  bool Marshal(vtkDataObject* data)
+  {
+    this->WriteBytes(RawMarshalMagic, RawMarshalMagicLength);
+    this->Write<uint32_t>(RawMarshalEndianTag);
+    this->Write<int32_t>(static_cast<int32_t>(sizeof(vtkIdType)));
+    if (!this->WriteObject(data))
+    {
+      return false;
+    }
+    // keep pieces 8-byte sized so that pieces concatenated by gathers stay aligned.
+    this->Pad();
+    return true;
+  }
+
+  vtkIdType GetTotalLength() const { return static_cast<vtkIdType>(this->TotalLength); }
+
+  // Calls `functor(const char* data, size_t length)` for each non-empty
+  // metadata chunk and payload in stream order. Payloads refer to the arrays'
+  // own memory.
+  template <typename Functor>
+  void ForEachSegment(Functor&& functor) const
+  {
+    for (size_t cc = 0; cc < this->Metadata.size(); ++cc)
+    {
+      const std::string& chunk = this->Metadata[cc];
+      if (!chunk.empty())
+      {
+        functor(chunk.data(), chunk.size());
+      }
+      if (cc < this->Payloads.size() && this->Payloads[cc].second > 0)
+      {
+        functor(this->Payloads[cc].first, this->Payloads[cc].second);
+      }
+    }
+  }
+
+  // Gathers metadata chunks and payloads, interleaved, into `buffer` which
+  // must be GetTotalLength() long. Only needed when the stream has to be
+  // contiguous, i.e. for compression and collective operations.
+  void Flatten(char* buffer) const
+  {
+    size_t offset = 0;
+    this->ForEachSegment([&](const char* data, size_t length) {
+      std::memcpy(buffer + offset, data, length);
+      offset += length;
+    });
+  }
+
+private:
+  // Metadata.size() == Payloads.size() + 1 at all times.
+  std::deque<std::string> Metadata;
+  std::vector<std::pair<const char*, size_t> > Payloads;
+  std::vector<vtkSmartPointer<vtkDataArray> > Temporaries;
+  size_t TotalLength;
+
+  void WriteBytes(const void* data, size_t length)
+  {
+    this->Metadata.back().append(reinterpret_cast<const char*>(data), length);
+    this->TotalLength += length;
+  }
+
+  template <typename T>
+  void Write(const T& value)
+  {
+    this->WriteBytes(&value, sizeof(T));
+  }
+
+  void WriteString(const char* str)
+  {
+    const int32_t length = str ? static_cast<int32_t>(strlen(str)) : -1;
+    this->Write<int32_t>(length);
+    if (length > 0)
+    {
+      this->WriteBytes(str, static_cast<size_t>(length));
+    }
+  }
+
+  void Pad()
+  {
+    const size_t padding =
+      (RawMarshalAlignment - (this->TotalLength % RawMarshalAlignment)) % RawMarshalAlignment;
+    static const char zeros[RawMarshalAlignment] = { 0 };
+    this->WriteBytes(zeros, padding);
+  }
+
+  // Adds a payload referring to `data` without copying it.
+  void WritePayload(const void* data, size_t length)
+  {
+    this->Pad();
+    this->Payloads.push_back(std::make_pair(reinterpret_cast<const char*>(data), length));
+    this->TotalLength += length;
+    this->Metadata.emplace_back();
+    this->Pad();
+  }
+
+  bool WriteObject(vtkDataObject* data)
+  {
+    const int32_t type = data ? data->GetDataObjectType() : -1;
+    this->Write<int32_t>(type);
+    switch (type)
+    {
+      case -1:
+        return true;
+
+      case VTK_POLY_DATA:
+      {
+        vtkPolyData* pd = vtkPolyData::SafeDownCast(data);
+        return this->WriteFieldData(pd->GetFieldData()) &&
+          this->WriteOptionalArray(pd->GetPoints() ? pd->GetPoints()->GetData() : nullptr) &&
+          this->WriteCells(pd->GetVerts()) && this->WriteCells(pd->GetLines()) &&
+          this->WriteCells(pd->GetPolys()) && this->WriteCells(pd->GetStrips()) &&
+          this->WriteFieldData(pd->GetPointData()) && this->WriteFieldData(pd->GetCellData());
+      }
+
+      case VTK_UNSTRUCTURED_GRID:
+      {
+        vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(data);
+        return this->WriteFieldData(ug->GetFieldData()) &&
+          this->WriteOptionalArray(ug->GetPoints() ? ug->GetPoints()->GetData() : nullptr) &&
+          this->WriteCells(ug->GetCells()) && this->WriteOptionalArray(ug->GetCellTypesArray()) &&
+          this->WriteOptionalArray(ug->GetFaces()) &&
+          this->WriteOptionalArray(ug->GetFaceLocations()) &&
+          this->WriteFieldData(ug->GetPointData()) && this->WriteFieldData(ug->GetCellData());
+      }
+
+      case VTK_IMAGE_DATA:
+      case VTK_STRUCTURED_POINTS:
+      {
+        vtkImageData* id = vtkImageData::SafeDownCast(data);
+        const int* extent = id->GetExtent();
+        for (int cc = 0; cc < 6; ++cc)
+        {
+          this->Write<int32_t>(extent[cc]);
+        }
+        const double* origin = id->GetOrigin();
+        const double* spacing = id->GetSpacing();
+        for (int cc = 0; cc < 3; ++cc)
+        {
+          this->Write<double>(origin[cc]);
+          this->Write<double>(spacing[cc]);
+        }
+        return this->WriteFieldData(id->GetFieldData()) &&
+          this->WriteFieldData(id->GetPointData()) && this->WriteFieldData(id->GetCellData());
+      }
+
+      case VTK_MULTIBLOCK_DATA_SET:
+      {
+        vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(data);
+        const unsigned int numBlocks = mb->GetNumberOfBlocks();
+        this->Write<uint32_t>(numBlocks);
+        for (unsigned int cc = 0; cc < numBlocks; ++cc)
+        {
+          const char* name = mb->HasMetaData(cc) &&
+              mb->GetMetaData(cc)->Has(vtkCompositeDataSet::NAME())
+            ? mb->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME())
+            : nullptr;
+          this->WriteString(name);
+          if (!this->WriteObject(mb->GetBlock(cc)))
+          {
+            return false;
+          }
+        }
+        return this->WriteFieldData(mb->GetFieldData());
+      }
+
+      default:
+        // other types are handled by the legacy writer.
+        return false;
+    }
+  }
+
+  bool WriteCells(vtkCellArray* cells)
+  {
+    if (cells == nullptr)
+    {
+      this->Write<int32_t>(0);
+      return true;
+    }
+    this->Write<int32_t>(1);
+    return this->WriteArray(cells->GetOffsetsArray()) &&
+      this->WriteArray(cells->GetConnectivityArray());
+  }
+
+  bool WriteOptionalArray(vtkAbstractArray* array)
+  {
+    this->Write<int32_t>(array ? 1 : 0);
+    return array ? this->WriteArray(array) : true;
+  }
+
+  // Used for vtkFieldData as well as vtkDataSetAttributes subclasses; the
+  // attribute type for each array (or -1) is written along with the array.
+  bool WriteFieldData(vtkFieldData* fd)
+  {
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    const int32_t numArrays = fd ? fd->GetNumberOfArrays() : 0;
+    this->Write<int32_t>(numArrays);
+    for (int32_t cc = 0; cc < numArrays; ++cc)
+    {
+      this->Write<int32_t>(dsa ? dsa->IsArrayAnAttribute(cc) : -1);
+      if (!this->WriteArray(fd->GetAbstractArray(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool WriteArray(vtkAbstractArray* array)
+  {
+    if (auto sarray = vtkStringArray::SafeDownCast(array))
+    {
+      this->Write<int32_t>(RAW_STRING_ARRAY);
+      this->WriteString(sarray->GetName());
+      this->Write<int32_t>(sarray->GetNumberOfComponents());
+      this->Write<int64_t>(sarray->GetNumberOfTuples());
+      for (vtkIdType cc = 0, max = sarray->GetNumberOfValues(); cc < max; ++cc)
+      {
+        this->WriteString(sarray->GetValue(cc).c_str());
+      }
+      return true;
+    }
+
+    vtkDataArray* darray = vtkDataArray::SafeDownCast(array);
+    if (darray == nullptr || darray->GetDataType() == VTK_BIT)
+    {
+      return false;
+    }
+
+    if (!darray->HasStandardMemoryLayout())
+    {
+      // SOA or implicit arrays need to be copied to a contiguous layout first.
+      vtkSmartPointer<vtkDataArray> aos;
+      aos.TakeReference(vtkDataArray::CreateDataArray(darray->GetDataType()));
+      aos->DeepCopy(darray);
+      this->Temporaries.push_back(aos);
+      darray = aos;
+    }
+
+    this->Write<int32_t>(RAW_DATA_ARRAY);
+    this->WriteString(darray->GetName());
+    this->Write<int32_t>(darray->GetDataType());
+    this->Write<int32_t>(darray->GetDataTypeSize());
+    this->Write<int32_t>(darray->GetNumberOfComponents());
+    this->Write<int64_t>(darray->GetNumberOfTuples());
+    this->WritePayload(darray->GetVoidPointer(0),
+      static_cast<size_t>(darray->GetNumberOfValues()) * darray->GetDataTypeSize());
+    return true;
+  }
+};
+
+//-----------------------------------------------------------------------------
+class RawUnmarshaller
+{
+public:
+  RawUnmarshaller(char* buffer, vtkIdType length, const std::shared_ptr<char>& block)
+    : Buffer(buffer)
+    , Length(static_cast<size_t>(length))
+    , Offset(0)
+    , Block(block)
+    , SwapBytes(false)
+    , IdTypeSize(0)
+  {
+  }
+
+  static bool IsRaw(const char* buffer, vtkIdType length)
+  {
+    return length >= static_cast<vtkIdType>(RawMarshalMagicLength) &&
+      strncmp(buffer, RawMarshalMagic, RawMarshalMagicLength) == 0;
+  }
+
+  vtkSmartPointer<vtkDataObject> Unmarshal()
+  {
+    uint32_t endianTag = 0;
+    int32_t idTypeSize = 0;
+    if (!this->Skip(RawMarshalMagicLength) || !this->Read(endianTag) || !this->Read(idTypeSize))
+    {
+      return nullptr;
+    }
+    if (endianTag != RawMarshalEndianTag)
+    {
+      vtkByteSwap::SwapVoidRange(&endianTag, 1, sizeof(endianTag));
+      if (endianTag != RawMarshalEndianTag)
+      {
+        return nullptr;
+      }
+      vtkByteSwap::SwapVoidRange(&idTypeSize, 1, sizeof(idTypeSize));
+      this->SwapBytes = true;
+    }
+    this->IdTypeSize = idTypeSize;
+
+    vtkSmartPointer<vtkDataObject> result;
+    if (!this->ReadObject(result))
+    {
+      return nullptr;
+    }
+    return result;
+  }
+
+private:
+  char* Buffer;
+  size_t Length;
+  size_t Offset;
+  std::shared_ptr<char> Block;
+  bool SwapBytes;
+  int32_t IdTypeSize;
+
+  bool Skip(size_t count)
+  {
+    if (this->Offset + count > this->Length)
+    {
+      return false;
+    }
+    this->Offset += count;
+    return true;
+  }
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (this->Offset + sizeof(T) > this->Length)
+    {
+      return false;
+    }
+    std::memcpy(&value, this->Buffer + this->Offset, sizeof(T));
+    if (this->SwapBytes)
+    {
+      vtkByteSwap::SwapVoidRange(&value, 1, sizeof(T));
+    }
+    this->Offset += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(std::string& str, bool& valid)
+  {
+    int32_t length = 0;
+    if (!this->Read(length))
+    {
+      return false;
+    }
+    valid = (length >= 0);
+    str.clear();
+    if (length > 0)
+    {
+      if (this->Offset + static_cast<size_t>(length) > this->Length)
+      {
+        return false;
+      }
+      str.assign(this->Buffer + this->Offset, static_cast<size_t>(length));
+      this->Offset += static_cast<size_t>(length);
+    }
+    return true;
+  }
+
+  bool Align()
+  {
+    return this->Skip(
+      (RawMarshalAlignment - (this->Offset % RawMarshalAlignment)) % RawMarshalAlignment);
+  }
+
+  bool ReadObject(vtkSmartPointer<vtkDataObject>& result)
+  {
+    int32_t type = 0;
+    if (!this->Read(type))
+    {
+      return false;
+    }
+    if (type == -1)
+    {
+      result = nullptr;
+      return true;
+    }
+    result.TakeReference(vtkDataObjectTypes::NewDataObject(type));
+    switch (type)
+    {
+      case VTK_POLY_DATA:
+      {
+        vtkPolyData* pd = vtkPolyData::SafeDownCast(result);
+        vtkSmartPointer<vtkAbstractArray> points;
+        vtkSmartPointer<vtkCellArray> verts, lines, polys, strips;
+        if (!this->ReadFieldData(pd->GetFieldData()) || !this->ReadOptionalArray(points) ||
+          !this->ReadCells(verts) || !this->ReadCells(lines) || !this->ReadCells(polys) ||
+          !this->ReadCells(strips))
+        {
+          return false;
+        }
+        pd->SetPoints(this->NewPoints(points));
+        pd->SetVerts(verts);
+        pd->SetLines(lines);
+        pd->SetPolys(polys);
+        pd->SetStrips(strips);
+        return this->ReadFieldData(pd->GetPointData()) && this->ReadFieldData(pd->GetCellData());
+      }
+
+      case VTK_UNSTRUCTURED_GRID:
+      {
+        vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(result);
+        vtkSmartPointer<vtkAbstractArray> points, types, faces, faceLocations;
+        vtkSmartPointer<vtkCellArray> cells;
+        if (!this->ReadFieldData(ug->GetFieldData()) || !this->ReadOptionalArray(points) ||
+          !this->ReadCells(cells) || !this->ReadOptionalArray(types) ||
+          !this->ReadOptionalArray(faces) || !this->ReadOptionalArray(faceLocations))
+        {
+          return false;
+        }
+        ug->SetPoints(this->NewPoints(points));
+        if (cells && types)
+        {
+          auto typesArray = vtkUnsignedCharArray::SafeDownCast(types);
+          auto facesArray = this->ToIdTypeArray(faces);
+          auto locationsArray = this->ToIdTypeArray(faceLocations);
+          if (typesArray == nullptr)
+          {
+            return false;
+          }
+          ug->SetCells(typesArray, cells, locationsArray, facesArray);
+        }
+        return this->ReadFieldData(ug->GetPointData()) && this->ReadFieldData(ug->GetCellData());
+      }
+
+      case VTK_IMAGE_DATA:
+      case VTK_STRUCTURED_POINTS:
+      {
+        vtkImageData* id = vtkImageData::SafeDownCast(result);
+        int32_t extent[6];
+        double origin[3], spacing[3];
+        for (int cc = 0; cc < 6; ++cc)
+        {
+          if (!this->Read(extent[cc]))
+          {
+            return false;
+          }
+        }
+        for (int cc = 0; cc < 3; ++cc)
+        {
+          if (!this->Read(origin[cc]) || !this->Read(spacing[cc]))
+          {
+            return false;
+          }
+        }
+        id->SetExtent(extent[0], extent[1], extent[2], extent[3], extent[4], extent[5]);
+        id->SetOrigin(origin);
+        id->SetSpacing(spacing);
+        return this->ReadFieldData(id->GetFieldData()) &&
+          this->ReadFieldData(id->GetPointData()) && this->ReadFieldData(id->GetCellData());
+      }
+
+      case VTK_MULTIBLOCK_DATA_SET:
+      {
+        vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(result);
+        uint32_t numBlocks = 0;
+        if (!this->Read(numBlocks))
+        {
+          return false;
+        }
+        mb->SetNumberOfBlocks(numBlocks);
+        for (unsigned int cc = 0; cc < numBlocks; ++cc)
+        {
+          std::string name;
+          bool hasName = false;
+          vtkSmartPointer<vtkDataObject> block;
+          if (!this->ReadString(name, hasName) || !this->ReadObject(block))
+          {
+            return false;
+          }
+          mb->SetBlock(cc, block);
+          if (hasName)
+          {
+            mb->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), name.c_str());
+          }
+        }
+        return this->ReadFieldData(mb->GetFieldData());
+      }
+
+      default:
+        return false;
+    }
+  }
+
+  vtkSmartPointer<vtkPoints> NewPoints(vtkAbstractArray* data)
+  {
+    vtkDataArray* darray = vtkDataArray::SafeDownCast(data);
+    if (darray == nullptr)
+    {
+      return nullptr;
+    }
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(darray);
+    return points;
+  }
+
+  vtkSmartPointer<vtkIdTypeArray> ToIdTypeArray(vtkAbstractArray* array)
+  {
+    if (array == nullptr)
+    {
+      return nullptr;
+    }
+    if (auto idarray = vtkIdTypeArray::SafeDownCast(array))
+    {
+      return idarray;
+    }
+    auto idarray = vtkSmartPointer<vtkIdTypeArray>::New();
+    idarray->DeepCopy(array);
+    return idarray;
+  }
+
+  bool ReadCells(vtkSmartPointer<vtkCellArray>& cells)
+  {
+    int32_t present = 0;
+    if (!this->Read(present))
+    {
+      return false;
+    }
+    if (!present)
+    {
+      cells = nullptr;
+      return true;
+    }
+    vtkSmartPointer<vtkAbstractArray> offsets, connectivity;
+    if (!this->ReadArray(offsets, /*forCells=*/true) ||
+      !this->ReadArray(connectivity, /*forCells=*/true))
+    {
+      return false;
+    }
+    cells = vtkSmartPointer<vtkCellArray>::New();
+    return cells->SetData(
+      vtkDataArray::SafeDownCast(offsets), vtkDataArray::SafeDownCast(connectivity));
+  }
+
+  bool ReadOptionalArray(vtkSmartPointer<vtkAbstractArray>& array)
+  {
+    int32_t present = 0;
+    if (!this->Read(present))
+    {
+      return false;
+    }
+    array = nullptr;
+    return present ? this->ReadArray(array) : true;
+  }
+
+  bool ReadFieldData(vtkFieldData* fd)
+  {
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    int32_t numArrays = 0;
+    if (!this->Read(numArrays))
+    {
+      return false;
+    }
+    for (int32_t cc = 0; cc < numArrays; ++cc)
+    {
+      int32_t attributeType = -1;
+      vtkSmartPointer<vtkAbstractArray> array;
+      if (!this->Read(attributeType) || !this->ReadArray(array))
+      {
+        return false;
+      }
+      const int idx = fd->AddArray(array);
+      if (dsa && attributeType >= 0 && attributeType < vtkDataSetAttributes::NUM_ATTRIBUTES)
+      {
+        dsa->SetActiveAttribute(idx, attributeType);
+      }
+    }
+    return true;
+  }
+
+  bool ReadArray(vtkSmartPointer<vtkAbstractArray>& result, bool forCells = false)
+  {
+    int32_t kind = 0;
+    std::string name;
+    bool hasName = false;
+    if (!this->Read(kind) || !this->ReadString(name, hasName))
+    {
+      return false;
+    }
+
+    if (kind == RAW_STRING_ARRAY)
+    {
+      int32_t numComps = 0;
+      int64_t numTuples = 0;
+      if (!this->Read(numComps) || !this->Read(numTuples) || numComps < 1 || numTuples < 0)
+      {
+        return false;
+      }
+      auto sarray = vtkSmartPointer<vtkStringArray>::New();
+      sarray->SetNumberOfComponents(numComps);
+      sarray->SetNumberOfTuples(static_cast<vtkIdType>(numTuples));
+      for (vtkIdType cc = 0, max = sarray->GetNumberOfValues(); cc < max; ++cc)
+      {
+        std::string value;
+        bool valid;
+        if (!this->ReadString(value, valid))
+        {
+          return false;
+        }
+        sarray->SetValue(cc, value);
+      }
+      sarray->SetName(hasName ? name.c_str() : nullptr);
+      result = sarray;
+      return true;
+    }
+
+    int32_t dataType = 0, typeSize = 0, numComps = 0;
+    int64_t numTuples = 0;
+    if (kind != RAW_DATA_ARRAY || !this->Read(dataType) || !this->Read(typeSize) ||
+      !this->Read(numComps) || !this->Read(numTuples) || typeSize <= 0 || numComps < 1 ||
+      numTuples < 0 || !this->Align())
+    {
+      return false;
+    }
+
+    const size_t numValues = static_cast<size_t>(numTuples) * static_cast<size_t>(numComps);
+    const size_t numBytes = numValues * static_cast<size_t>(typeSize);
+    char* payload = this->Buffer + this->Offset;
+    if (!this->Skip(numBytes) || !this->Align())
+    {
+      return false;
+    }
+
+    vtkSmartPointer<vtkDataArray> array;
+    if (forCells)
+    {
+      // vtkCellArray can only adopt storage of these exact types.
+      if (typeSize == 4)
+      {
+        array = vtkSmartPointer<vtkTypeInt32Array>::New();
+      }
+      else if (typeSize == 8)
+      {
+        array = vtkSmartPointer<vtkTypeInt64Array>::New();
+      }
+    }
+    else if (dataType == VTK_ID_TYPE && typeSize != static_cast<int32_t>(sizeof(vtkIdType)))
+    {
+      // vtkIdType differs between sender and receiver; read as sized integers
+      // and convert.
+      array.TakeReference(
+        vtkDataArray::CreateDataArray(typeSize == 4 ? VTK_TYPE_INT32 : VTK_TYPE_INT64));
+    }
+    else
+    {
+      array.TakeReference(vtkDataArray::CreateDataArray(dataType));
+    }
+    if (!array || array->GetDataTypeSize() != typeSize)
+    {
+      return false;
+    }
+    array->SetNumberOfComponents(numComps);
+
+    const bool aligned =
+      (reinterpret_cast<uintptr_t>(payload) % static_cast<uintptr_t>(typeSize)) == 0;
+    if (numValues > 0 && aligned && !this->SwapBytes && this->Block)
+    {
+      // zero-copy: wrap the received memory.
+      RawBufferRegistry::Register(payload, this->Block);
+      array->SetVoidArray(payload, static_cast<vtkIdType>(numValues), /*save=*/0,
+        vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+      array->SetArrayFreeFunction(&RawBufferRegistry::Release);
+    }
+    else
+    {
+      array->SetNumberOfTuples(static_cast<vtkIdType>(numTuples));
+      if (numBytes > 0)
+      {
+        std::memcpy(array->GetVoidPointer(0), payload, numBytes);
+        if (this->SwapBytes && typeSize > 1)
+        {
+          vtkByteSwap::SwapVoidRange(array->GetVoidPointer(0), static_cast<vtkIdType>(numValues),
+            typeSize);
+        }
+      }
+    }
+
+    if (!forCells && dataType == VTK_ID_TYPE && array->GetDataType() != VTK_ID_TYPE)
+    {
+      auto idarray = vtkSmartPointer<vtkIdTypeArray>::New();
+      idarray->DeepCopy(array);
+      array = idarray;
+    }
+    array->SetName(hasName ? name.c_str() : nullptr);
+    result = array;
+    return true;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Chunked compression.
+//
+// The buffer is split into fixed size chunks which are compressed (and
+// decompressed) independently using vtkSMPTools. The codec is recorded in the
+// frame so the receiver can always decode it irrespective of its own settings.
+//
+// Layout: "vtkcmp01" | uint32 codec | uint32 number-of-chunks |
+//         uint64 uncompressed-length | uint64 chunk-size |
+//         uint64 compressed-chunk-length[number-of-chunks] | chunks...
+//-----------------------------------------------------------------------------
+static const char CompressedFrameMagic[] = "vtkcmp01";
+static const size_t CompressedFrameMagicLength = 8;
+static const size_t CompressedFrameHeaderLength = CompressedFrameMagicLength + 24;
+// zlib's maximum compression ratio, larger than LZ4's. Used to reject frames
+// whose uncompressed length cannot come from their payload.
+static const uint64_t MaximumCompressionRatio = 1032;
+
+struct CompressionCodec
+{
+  const char* Name;
+  size_t (*Bound)(size_t inputLength);
+  // Returns compressed length, or 0 on failure.
+  size_t (*Compress)(const char* input, size_t inputLength, char* output, size_t outputLength,
+    int level);
+  bool (*Decompress)(const char* input, size_t inputLength, char* output, size_t outputLength);
+};
+
+size_t ZLibBound(size_t inputLength)
+{
+  return compressBound(static_cast<uLong>(inputLength));
+}
+
+size_t ZLibCompress(
+  const char* input, size_t inputLength, char* output, size_t outputLength, int level)
+{
+  uLongf outSize = static_cast<uLongf>(outputLength);
+  const int zlevel = (level < 1 || level > 9) ? Z_DEFAULT_COMPRESSION : level;
+  if (compress2(reinterpret_cast<Bytef*>(output), &outSize,
+        reinterpret_cast<const Bytef*>(input), static_cast<uLong>(inputLength), zlevel) != Z_OK)
+  {
+    return 0;
+  }
+  return static_cast<size_t>(outSize);
+}
+
+bool ZLibDecompress(const char* input, size_t inputLength, char* output, size_t outputLength)
+{
+  uLongf destLen = static_cast<uLongf>(outputLength);
+  return uncompress(reinterpret_cast<Bytef*>(output), &destLen,
+           reinterpret_cast<const Bytef*>(input), static_cast<uLong>(inputLength)) == Z_OK &&
+    destLen == outputLength;
+}
+
+// LZ4 takes int lengths; chunks larger than LZ4_MAX_INPUT_SIZE are rejected
+// rather than truncated. A bound of 0 makes CompressFrame fail (and the data
+// get sent uncompressed).
+size_t LZ4Bound(size_t inputLength)
+{
+  if (inputLength > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+  {
+    return 0;
+  }
+  return static_cast<size_t>(LZ4_compressBound(static_cast<int>(inputLength)));
+}
+
+size_t LZ4Compress(
+  const char* input, size_t inputLength, char* output, size_t outputLength, int level)
+{
+  if (inputLength > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+  {
+    return 0;
+  }
+  // LZ4's acceleration trades ratio for speed; map level 1 (fastest) to 9
+  // (best ratio) onto acceleration 9 to 1.
+  const int acceleration = (level < 1 || level > 9) ? 1 : 10 - level;
+  const size_t capacity = std::min(outputLength, static_cast<size_t>(VTK_INT_MAX));
+  const int result = LZ4_compress_fast(input, output, static_cast<int>(inputLength),
+    static_cast<int>(capacity), acceleration);
+  return result > 0 ? static_cast<size_t>(result) : 0;
+}
+
+bool LZ4Decompress(const char* input, size_t inputLength, char* output, size_t outputLength)
+{
+  // lengths come from the received frame; never let them wrap.
+  if (inputLength > static_cast<size_t>(VTK_INT_MAX) ||
+    outputLength > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+  {
+    return false;
+  }
+  return LZ4_decompress_safe(input, output, static_cast<int>(inputLength),
+           static_cast<int>(outputLength)) == static_cast<int>(outputLength);
+}
+
+// Indexed by vtkMPIMoveData::CompressionCodecs.
+static const CompressionCodec CompressionCodecRegistry[] = {
+  { "none", nullptr, nullptr, nullptr },
+  { "zlib", &ZLibBound, &ZLibCompress, &ZLibDecompress },
+  { "lz4", &LZ4Bound, &LZ4Compress, &LZ4Decompress },
+};
+static const int NumberOfCompressionCodecs =
+  static_cast<int>(sizeof(CompressionCodecRegistry) / sizeof(CompressionCodecRegistry[0]));
+
+template <typename T>
+void WriteFrameValue(char*& ptr, T value)
+{
+  std::memcpy(ptr, &value, sizeof(T));
+  ptr += sizeof(T);
+}
+
+template <typename T>
+T ReadFrameValue(const char*& ptr)
+{
+  T value;
+  std::memcpy(&value, ptr, sizeof(T));
+  ptr += sizeof(T);
+  return value;
+}
+
+// Compresses `input` using `codecId`. Returns nullptr on failure, otherwise a
+// new[]'d buffer with the frame (and its length in `outputLength`).
+char* CompressFrame(const char* input, size_t inputLength, int codecId, int level,
+  size_t chunkSize, vtkIdType& outputLength)
+{
+  const CompressionCodec& codec = CompressionCodecRegistry[codecId];
+  chunkSize = std::max<size_t>(chunkSize, 1024);
+  const size_t numChunks = std::max<size_t>((inputLength + chunkSize - 1) / chunkSize, 1);
+
+  std::vector<std::vector<char> > chunks(numChunks);
+  std::vector<uint64_t> chunkLengths(numChunks, 0);
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numChunks), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const size_t offset = static_cast<size_t>(cc) * chunkSize;
+      const size_t length = std::min(chunkSize, inputLength - std::min(offset, inputLength));
+      auto& chunk = chunks[cc];
+      chunk.resize(codec.Bound(length));
+      chunkLengths[cc] = codec.Compress(input + offset, length, chunk.data(), chunk.size(), level);
+      if (chunkLengths[cc] == 0 && length > 0)
+      {
+        failed = true;
+      }
+    }
+  });
+  if (failed)
+  {
+    return nullptr;
+  }
+
+  size_t total = CompressedFrameHeaderLength + numChunks * sizeof(uint64_t);
+  for (const auto& length : chunkLengths)
+  {
+    total += static_cast<size_t>(length);
+  }
+
+  char* frame = new char[total];
+  char* ptr = frame;
+  std::memcpy(ptr, CompressedFrameMagic, CompressedFrameMagicLength);
+  ptr += CompressedFrameMagicLength;
+  WriteFrameValue<uint32_t>(ptr, static_cast<uint32_t>(codecId));
+  WriteFrameValue<uint32_t>(ptr, static_cast<uint32_t>(numChunks));
+  WriteFrameValue<uint64_t>(ptr, static_cast<uint64_t>(inputLength));
+  WriteFrameValue<uint64_t>(ptr, static_cast<uint64_t>(chunkSize));
+  for (const auto& length : chunkLengths)
+  {
+    WriteFrameValue<uint64_t>(ptr, length);
+  }
+  for (size_t cc = 0; cc < numChunks; ++cc)
+  {
+    std::memcpy(ptr, chunks[cc].data(), static_cast<size_t>(chunkLengths[cc]));
+    ptr += chunkLengths[cc];
+  }
+  outputLength = static_cast<vtkIdType>(total);
+  return frame;
+}
+
+bool IsCompressedFrame(const char* buffer, vtkIdType length)
+{
+  return length >= static_cast<vtkIdType>(CompressedFrameHeaderLength) &&
+    strncmp(buffer, CompressedFrameMagic, CompressedFrameMagicLength) == 0;
+}
+
+// Decompresses a frame created by CompressFrame. Returns nullptr on failure,
+// otherwise a new[]'d buffer (and its length in `outputLength`).
+char* DecompressFrame(const char* frame, vtkIdType frameLength, vtkIdType& outputLength)
+{
+  const char* ptr = frame + CompressedFrameMagicLength;
+  const uint32_t codecId = ReadFrameValue<uint32_t>(ptr);
+  const uint32_t numChunks = ReadFrameValue<uint32_t>(ptr);
+  const uint64_t uncompressedLength = ReadFrameValue<uint64_t>(ptr);
+  const uint64_t chunkSize = ReadFrameValue<uint64_t>(ptr);
+  if (codecId == 0 || codecId >= static_cast<uint32_t>(NumberOfCompressionCodecs) ||
+    chunkSize == 0 ||
+    CompressedFrameHeaderLength + numChunks * sizeof(uint64_t) > static_cast<size_t>(frameLength))
+  {
+    return nullptr;
+  }
+
+  // compute the offsets for each compressed chunk.
+  std::vector<size_t> offsets(numChunks + 1);
+  offsets[0] = CompressedFrameHeaderLength + numChunks * sizeof(uint64_t);
+  for (uint32_t cc = 0; cc < numChunks; ++cc)
+  {
+    offsets[cc + 1] = offsets[cc] + static_cast<size_t>(ReadFrameValue<uint64_t>(ptr));
+  }
+  if (offsets[numChunks] > static_cast<size_t>(frameLength))
+  {
+    return nullptr;
+  }
+
+  // the chunks must cover the uncompressed length exactly, and the payload
+  // must be large enough to expand to it, before anything is allocated.
+  const uint64_t expectedChunks = std::max<uint64_t>(
+    uncompressedLength / chunkSize + (uncompressedLength % chunkSize != 0 ? 1 : 0), 1);
+  const uint64_t payloadLength = offsets[numChunks] - offsets[0];
+  if (numChunks != expectedChunks ||
+    uncompressedLength > payloadLength * MaximumCompressionRatio ||
+    uncompressedLength > static_cast<uint64_t>(VTK_ID_MAX))
+  {
+    return nullptr;
+  }
+
+  const CompressionCodec& codec = CompressionCodecRegistry[codecId];
+  char* output = new char[uncompressedLength];
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numChunks), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const uint64_t offset = static_cast<uint64_t>(cc) * chunkSize;
+      const uint64_t length =
+        std::min(chunkSize, uncompressedLength - std::min(offset, uncompressedLength));
+      if (length > 0 &&
+        !codec.Decompress(frame + offsets[cc], offsets[cc + 1] - offsets[cc], output + offset,
+          static_cast<size_t>(length)))
+      {
+        failed = true;
+      }
+    }
+  });
+  if (failed)
+  {
+    delete[] output;
+    return nullptr;
+  }
+  outputLength = static_cast<vtkIdType>(uncompressedLength);
+  return output;
+}
 };
 
 vtkStandardNewMacro(vtkMPIMoveData);
@@ -171,13 +1191,68 @@ void vtkMPIMoveData::InitializeForCommunicationForParaView()
 //----------------------------------------------------------------------------
 void vtkMPIMoveData::SetUseZLibCompression(bool b)
 {
-  vtkMPIMoveData::UseZLibCompression = b;
+  vtkMPIMoveData::SetCompressionCodec(
+    b ? vtkMPIMoveData::COMPRESSION_ZLIB : vtkMPIMoveData::COMPRESSION_NONE);
 }
 
 //----------------------------------------------------------------------------
 bool vtkMPIMoveData::GetUseZLibCompression()
 {
-  return vtkMPIMoveData::UseZLibCompression;
+  return vtkMPIMoveData::CompressionCodec == vtkMPIMoveData::COMPRESSION_ZLIB;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetCompressionCodec(int codec)
+{
+  vtkMPIMoveData::CompressionCodec = (codec > 0 && codec < NumberOfCompressionCodecs)
+    ? codec
+    : vtkMPIMoveData::COMPRESSION_NONE;
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetCompressionCodec()
+{
+  return vtkMPIMoveData::CompressionCodec;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetCompressionLevel(int level)
+{
+  vtkMPIMoveData::CompressionLevel = std::max(0, std::min(level, 9));
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetCompressionLevel()
+{
+  return vtkMPIMoveData::CompressionLevel;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetCompressionChunkSize(vtkIdType size)
+{
+  // chunks must fit the codecs' int lengths.
+  vtkMPIMoveData::CompressionChunkSize = std::min<vtkIdType>(
+    std::max<vtkIdType>(size, 1024), static_cast<vtkIdType>(LZ4_MAX_INPUT_SIZE));
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkMPIMoveData::GetCompressionChunkSize()
+{
+  return vtkMPIMoveData::CompressionChunkSize;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetMarshallingMode(int mode)
+{
+  vtkMPIMoveData::MarshallingMode = (mode == vtkMPIMoveData::MARSHAL_RAW_ARRAYS)
+    ? vtkMPIMoveData::MARSHAL_RAW_ARRAYS
+    : vtkMPIMoveData::MARSHAL_LEGACY_WRITER;
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetMarshallingMode()
+{
+  return vtkMPIMoveData::MarshallingMode;
 }
 
 //----------------------------------------------------------------------------
@@ -706,12 +1781,7 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
 
   // int fixme;
   // We might be able to eliminate this marshal.
-  this->ClearBuffer();
-  this->MarshalDataToBuffer(output);
-
-  com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
-  com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-  com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
+  this->SendData(output, com, 23480);
 }
 
 //-----------------------------------------------------------------------------
@@ -727,24 +1797,8 @@ void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
 
-  this->ClearBuffer();
-  com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
-  this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-  com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-  // Compute additional buffer information.
-  this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
-  this->BufferTotalLength = 0;
-  for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
-  {
-    this->BufferOffsets[idx] = this->BufferTotalLength;
-    this->BufferTotalLength += this->BufferLengths[idx];
-  }
-  this->Buffers = new char[this->BufferTotalLength];
-  com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
-
   // int fixme;  // Can we avoid this?
-  this->ReconstructDataFromBuffer(output);
-  this->ClearBuffer();
+  this->ReceiveData(output, com, 23480);
 }
 
 //-----------------------------------------------------------------------------
@@ -767,12 +1821,7 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
 
     // int fixme;
     // We might be able to eliminate this marshal.
-    this->ClearBuffer();
-    this->MarshalDataToBuffer(data);
-    com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
-    com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-    com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
-    this->ClearBuffer();
+    this->SendData(data, com, 23480);
   }
 }
 
@@ -793,24 +1842,8 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* da
 
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver-root");
 
-    this->ClearBuffer();
-    com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
-    this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-    com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-    // Compute additional buffer information.
-    this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
-    this->BufferTotalLength = 0;
-    for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
-    {
-      this->BufferOffsets[idx] = this->BufferTotalLength;
-      this->BufferTotalLength += this->BufferLengths[idx];
-    }
-    this->Buffers = new char[this->BufferTotalLength];
-    com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
-
     // int fixme;  // Can we avoid this?
-    this->ReconstructDataFromBuffer(data);
-    this->ClearBuffer();
+    this->ReceiveData(data, com, 23480);
   }
 }
 
@@ -828,13 +1861,7 @@ void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
   {
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-client");
     vtkTimerLog::MarkStartEvent("Dataserver sending to client");
-    this->ClearBuffer();
-    this->MarshalDataToBuffer(output);
-    this->ClientDataServerSocketController->Send(&(this->NumberOfBuffers), 1, 1, 23490);
-    this->ClientDataServerSocketController->Send(
-      this->BufferLengths, this->NumberOfBuffers, 1, 23491);
-    this->ClientDataServerSocketController->Send(this->Buffers, this->BufferTotalLength, 1, 23492);
-    this->ClearBuffer();
+    this->SendData(output, this->ClientDataServerSocketController->GetCommunicator(), 23490);
     vtkTimerLog::MarkEndEvent("Dataserver sending to client");
   }
 }
@@ -852,22 +1879,7 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
 
-  this->ClearBuffer();
-  com->Receive(&(this->NumberOfBuffers), 1, 1, 23490);
-  this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-  com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23491);
-  // Compute additional buffer information.
-  this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
-  this->BufferTotalLength = 0;
-  for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
-  {
-    this->BufferOffsets[idx] = this->BufferTotalLength;
-    this->BufferTotalLength += this->BufferLengths[idx];
-  }
-  this->Buffers = new char[this->BufferTotalLength];
-  com->Receive(this->Buffers, this->BufferTotalLength, 1, 23492);
-  this->ReconstructDataFromBuffer(output);
-  this->ClearBuffer();
+  this->ReceiveData(output, com, 23490);
 }
 
 //-----------------------------------------------------------------------------
@@ -925,6 +1937,91 @@ void vtkMPIMoveData::RenderServerZeroBroadcast(vtkDataObject* data)
   this->ClearBuffer();
 }
 
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::SendData(vtkDataObject* data, vtkCommunicator* com, int tag)
+{
+  this->ClearBuffer();
+
+  // Uncompressed raw marshalled data need not be contiguous for a
+  // point-to-point send: send the metadata and each array's memory as is
+  // instead of flattening them into a single buffer first.
+  std::vector<vtkIdType> segmentLengths;
+  std::vector<const char*> segments;
+  RawMarshaller marshaller;
+  if (vtkMPIMoveData::MarshallingMode == vtkMPIMoveData::MARSHAL_RAW_ARRAYS &&
+    vtkMPIMoveData::CompressionCodec == vtkMPIMoveData::COMPRESSION_NONE &&
+    marshaller.Marshal(data))
+  {
+    marshaller.ForEachSegment([&](const char* segment, size_t length) {
+      segments.push_back(segment);
+      segmentLengths.push_back(static_cast<vtkIdType>(length));
+    });
+    this->NumberOfBuffers = 1;
+    this->BufferLengths = new vtkIdType[1];
+    this->BufferLengths[0] = marshaller.GetTotalLength();
+    this->BufferOffsets = new vtkIdType[1];
+    this->BufferOffsets[0] = 0;
+    this->BufferTotalLength = this->BufferLengths[0];
+  }
+  else
+  {
+    this->MarshalDataToBuffer(data);
+    segments.push_back(this->Buffers);
+    segmentLengths.push_back(this->BufferTotalLength);
+  }
+
+  vtkIdType numSegments = static_cast<vtkIdType>(segments.size());
+  com->Send(&(this->NumberOfBuffers), 1, 1, tag);
+  com->Send(this->BufferLengths, this->NumberOfBuffers, 1, tag + 1);
+  com->Send(&numSegments, 1, 1, tag + 3);
+  com->Send(segmentLengths.data(), numSegments, 1, tag + 3);
+  for (vtkIdType cc = 0; cc < numSegments; ++cc)
+  {
+    com->Send(segments[cc], segmentLengths[cc], 1, tag + 2);
+  }
+  this->ClearBuffer();
+}
+
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::ReceiveData(vtkDataObject* data, vtkCommunicator* com, int tag)
+{
+  this->ClearBuffer();
+  com->Receive(&(this->NumberOfBuffers), 1, 1, tag);
+  this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
+  com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, tag + 1);
+  // Compute additional buffer information.
+  this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
+  this->BufferTotalLength = 0;
+  for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
+  {
+    this->BufferOffsets[idx] = this->BufferTotalLength;
+    this->BufferTotalLength += this->BufferLengths[idx];
+  }
+  this->Buffers = new char[this->BufferTotalLength];
+
+  // The buffers arrive as a sequence of segments (see SendData) that are
+  // received back to back.
+  vtkIdType numSegments = 0;
+  com->Receive(&numSegments, 1, 1, tag + 3);
+  std::vector<vtkIdType> segmentLengths(static_cast<size_t>(numSegments));
+  com->Receive(segmentLengths.data(), numSegments, 1, tag + 3);
+  vtkIdType offset = 0;
+  for (vtkIdType cc = 0; cc < numSegments; ++cc)
+  {
+    if (segmentLengths[cc] < 0 || offset + segmentLengths[cc] > this->BufferTotalLength)
+    {
+      vtkErrorMacro("Received segments do not match the buffer lengths.");
+      this->ClearBuffer();
+      return;
+    }
+    com->Receive(this->Buffers + offset, segmentLengths[cc], 1, tag + 2);
+    offset += segmentLengths[cc];
+  }
+
+  this->ReconstructDataFromBuffer(data);
+  this->ClearBuffer();
+}
+
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::ClearBuffer()
 {
@@ -959,52 +2056,76 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
     this->NumberOfBuffers = 0;
   }
 
-  // Copy input to isolate reader from the pipeline.
-  vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
-  writer->SetInputData(data);
-  if (imageData)
+  const char* uncompressed = NULL;
+  vtkIdType uncompressed_length = 0;
+
+  // Raw marshalling writes array buffers as is. Data types it does not
+  // support fall back to the legacy writer.
+  char* rawBuffer = NULL;
+  if (vtkMPIMoveData::MarshallingMode == vtkMPIMoveData::MARSHAL_RAW_ARRAYS)
   {
-    // We add the image extents to the header, since the writer doesn't preserve
-    // the extents.
-    int* extent = imageData->GetExtent();
-    double* origin = imageData->GetOrigin();
-    std::ostringstream stream;
-    stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
-           << " " << extent[4] << " " << extent[5];
-    stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
-    writer->SetHeader(stream.str().c_str());
+    vtkTimerLog::MarkStartEvent("Raw marshal");
+    RawMarshaller marshaller;
+    if (marshaller.Marshal(data))
+    {
+      uncompressed_length = marshaller.GetTotalLength();
+      rawBuffer = new char[uncompressed_length];
+      marshaller.Flatten(rawBuffer);
+      uncompressed = rawBuffer;
+    }
+    vtkTimerLog::MarkEndEvent("Raw marshal");
   }
 
-  writer->SetFileTypeToBinary();
-  writer->WriteToOutputStringOn();
-  writer->Write();
+  vtkSmartPointer<vtkDataWriter> writer;
+  if (rawBuffer == NULL)
+  {
+    // Copy input to isolate reader from the pipeline.
+    writer = vtkSmartPointer<vtkGenericDataObjectWriter>::New();
+    writer->SetInputData(data);
+    if (imageData)
+    {
+      // We add the image extents to the header, since the writer doesn't preserve
+      // the extents.
+      int* extent = imageData->GetExtent();
+      double* origin = imageData->GetOrigin();
+      std::ostringstream stream;
+      stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
+             << " " << extent[4] << " " << extent[5];
+      stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
+      writer->SetHeader(stream.str().c_str());
+    }
+
+    writer->SetFileTypeToBinary();
+    writer->WriteToOutputStringOn();
+    writer->Write();
+    uncompressed = writer->GetOutputString();
+    uncompressed_length = writer->GetOutputStringLength();
+  }
 
   char* buffer = NULL;
   vtkIdType buffer_length = 0;
 
-  if (vtkMPIMoveData::UseZLibCompression)
+  if (vtkMPIMoveData::CompressionCodec != vtkMPIMoveData::COMPRESSION_NONE)
   {
-    vtkTimerLog::MarkStartEvent("Zlib compress");
-    // Use z-lib compression.
-    uLongf out_size = compressBound(writer->GetOutputStringLength());
-    buffer = new char[out_size + 8];
-    memcpy(buffer, "zlib0000", 8);
-
-    compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
-      reinterpret_cast<const Bytef*>(writer->GetOutputString()), writer->GetOutputStringLength(),
-      /* compression_level */ Z_DEFAULT_COMPRESSION);
-    vtkTimerLog::MarkEndEvent("Zlib compress");
-    int in_size = static_cast<int>(writer->GetOutputStringLength());
-    for (int cc = 0; cc < 4; cc++)
+    vtkTimerLog::MarkStartEvent("Compress");
+    buffer = CompressFrame(uncompressed, static_cast<size_t>(uncompressed_length),
+      vtkMPIMoveData::CompressionCodec, vtkMPIMoveData::CompressionLevel,
+      static_cast<size_t>(vtkMPIMoveData::CompressionChunkSize), buffer_length);
+    vtkTimerLog::MarkEndEvent("Compress");
+    if (buffer == NULL)
     {
-      // the first 4 bytes in the header are "zlib" which helps the receiver
-      // identify that zlib compression has been used.
-      // the next 4 bytes are the original length since zlib doesn't provide
-      // that to the receiver.
-      buffer[4 + cc] = (in_size & 0x0ff);
-      in_size = in_size >> 8;
+      vtkWarningMacro("Compression failed. Data will be sent uncompressed.");
     }
-    buffer_length = out_size + 8;
+  }
+
+  if (buffer)
+  {
+    delete[] rawBuffer;
+  }
+  else if (rawBuffer)
+  {
+    buffer_length = uncompressed_length;
+    buffer = rawBuffer;
   }
   else
   {
@@ -1020,9 +2141,6 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   this->BufferOffsets[0] = 0;
   this->Buffers = buffer;
   this->BufferTotalLength = this->BufferLengths[0];
-
-  writer->Delete();
-  writer = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -1037,15 +2155,21 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
   bool is_image_data = data->IsA("vtkImageData") != 0;
   std::vector<vtkSmartPointer<vtkDataObject> > pieces;
 
+  // Raw marshalled arrays are wrapped without copying, so the received buffer
+  // must outlive this call. `sharedBuffers` takes over this->Buffers the first
+  // time a raw piece is encountered.
+  char* buffers = this->Buffers;
+  std::shared_ptr<char> sharedBuffers;
+
   for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
   {
-    char* bufferArray = this->Buffers + this->BufferOffsets[idx];
+    char* bufferArray = buffers + this->BufferOffsets[idx];
     vtkIdType bufferLength = this->BufferLengths[idx];
 
     char* realBuffer = 0;
     if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
     {
-      // sender used zlib compression. Decompress it.
+      // sender used (legacy, unchunked) zlib compression. Decompress it.
       vtkIdType compressed_length = bufferLength - 8; // remove the zlib header.
       vtkIdType uncompressed_length = 0;
       for (int cc = 0; cc < 4; cc++)
@@ -1064,6 +2188,53 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
       bufferArray = realBuffer;
       bufferLength = uncompressed_length;
     }
+    else if (IsCompressedFrame(bufferArray, bufferLength))
+    {
+      vtkTimerLog::MarkStartEvent("Decompress");
+      vtkIdType uncompressed_length = 0;
+      realBuffer = DecompressFrame(bufferArray, bufferLength, uncompressed_length);
+      vtkTimerLog::MarkEndEvent("Decompress");
+      if (realBuffer == 0)
+      {
+        vtkErrorMacro("Failed to decompress piece " << idx << ".");
+        continue;
+      }
+      bufferArray = realBuffer;
+      bufferLength = uncompressed_length;
+    }
+
+    if (RawUnmarshaller::IsRaw(bufferArray, bufferLength))
+    {
+      std::shared_ptr<char> block;
+      if (realBuffer)
+      {
+        block.reset(realBuffer, std::default_delete<char[]>());
+        realBuffer = 0;
+      }
+      else
+      {
+        if (!sharedBuffers)
+        {
+          sharedBuffers.reset(this->Buffers, std::default_delete<char[]>());
+          this->Buffers = 0;
+        }
+        block = sharedBuffers;
+      }
+
+      vtkTimerLog::MarkStartEvent("Raw unmarshal");
+      RawUnmarshaller unmarshaller(bufferArray, bufferLength, block);
+      vtkSmartPointer<vtkDataObject> output = unmarshaller.Unmarshal();
+      vtkTimerLog::MarkEndEvent("Raw unmarshal");
+      if (!output)
+      {
+        vtkErrorMacro("Failed to unmarshal raw data for piece " << idx << ".");
+        continue;
+      }
+      // reconstructing data distributted on MPI node, so global ids are valid
+      unsetGlobalIdsAttribute(output);
+      pieces.push_back(output);
+      continue;
+    }
 
     // Setup a reader.
     vtkDataReader* reader = vtkGenericDataObjectReader::New();
@@ -1127,6 +2298,11 @@ void vtkMPIMoveData::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Server: " << this->Server << endl;
   os << indent << "MoveMode: " << this->MoveMode << endl;
   os << indent << "SkipDataServerGatherToZero: " << this->SkipDataServerGatherToZero << endl;
+  os << indent << "MarshallingMode: " << vtkMPIMoveData::MarshallingMode << endl;
+  os << indent << "CompressionCodec: "
+     << CompressionCodecRegistry[vtkMPIMoveData::CompressionCodec].Name << endl;
+  os << indent << "CompressionLevel: " << vtkMPIMoveData::CompressionLevel << endl;
+  os << indent << "CompressionChunkSize: " << vtkMPIMoveData::CompressionChunkSize << endl;
   os << indent << "OutputDataType: ";
   if (this->OutputDataType == VTK_POLY_DATA)
   {
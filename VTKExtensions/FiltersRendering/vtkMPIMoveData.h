@@ -29,6 +29,7 @@
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" //needed for exports
 #include "vtkPassInputTypeAlgorithm.h"
 
+class vtkCommunicator;
 class vtkMultiProcessController;
 class vtkSocketController;
 class vtkMPIMToNSocketConnection;
@@ -103,16 +104,62 @@ public:
   vtkGetMacro(OutputDataType, int);
   //@}
 
+  enum CompressionCodecs
+  {
+    COMPRESSION_NONE = 0,
+    COMPRESSION_ZLIB = 1,
+    COMPRESSION_LZ4 = 2
+  };
+
+  //@{
+  /**
+   * Choose the codec used to compress marshalled data. COMPRESSION_NONE by
+   * default. The buffer is split into chunks of CompressionChunkSize bytes
+   * that are compressed and decompressed concurrently using vtkSMPTools.
+   * CompressionLevel ranges from 1 (fastest) to 9 (best ratio); 0 uses the
+   * codec's default. CompressionChunkSize is clamped to [1024, LZ4_MAX_INPUT_SIZE]
+   * since the codecs take int lengths.
+   * These values have any effect only on the data-sender processes. The
+   * codec is recorded with the data, so the receiver can always decompress it.
+   */
+  static void SetCompressionCodec(int codec);
+  static int GetCompressionCodec();
+  static void SetCompressionLevel(int level);
+  static int GetCompressionLevel();
+  static void SetCompressionChunkSize(vtkIdType size);
+  static vtkIdType GetCompressionChunkSize();
+  //@}
+
   //@{
   /**
    * When set to true, zlib compression is used. False by default.
-   * This value has any effect only on the data-sender processes. The receiver
-   * always checks the received data to see if zlib decompression is required.
+   * This is equivalent to `SetCompressionCodec(COMPRESSION_ZLIB)`.
    */
   static void SetUseZLibCompression(bool b);
   static bool GetUseZLibCompression();
   //@}
 
+  enum MarshallingModes
+  {
+    MARSHAL_LEGACY_WRITER = 0,
+    MARSHAL_RAW_ARRAYS = 1
+  };
+
+  //@{
+  /**
+   * Choose how data is serialized for delivery. MARSHAL_LEGACY_WRITER (the
+   * default) uses vtkGenericDataObjectWriter/vtkGenericDataObjectReader.
+   * MARSHAL_RAW_ARRAYS writes a compact header followed by the raw contents of
+   * each array; the receiver wraps the arrays directly on the received memory
+   * without parsing or copying them. Raw marshalling supports vtkPolyData,
+   * vtkUnstructuredGrid, vtkImageData and vtkMultiBlockDataSet comprising
+   * these; other types silently fall back to the legacy writer.
+   * Like CompressionCodec, this only affects the data-sender processes.
+   */
+  static void SetMarshallingMode(int mode);
+  static int GetMarshallingMode();
+  //@}
+
   /**
    * vtkMPIMoveData doesn't necessarily generate a valid output data on all the
    * involved processes (depending on the MoveMode and Server ivars). This
@@ -175,6 +222,16 @@ protected:
   void MarshalDataToBuffer(vtkDataObject* data);
   void ReconstructDataFromBuffer(vtkDataObject* data);
 
+  //@{
+  /**
+   * Marshal `data` and send it over `com` (or receive and reconstruct it).
+   * Uses tags `tag` to `tag + 3`. Uncompressed raw marshalled data is sent
+   * without flattening it into a single buffer first.
+   */
+  void SendData(vtkDataObject* data, vtkCommunicator* com, int tag);
+  void ReceiveData(vtkDataObject* data, vtkCommunicator* com, int tag);
+  //@}
+
   int MoveMode;
   int Server;
 
@@ -196,7 +253,10 @@ private:
   vtkMPIMoveData(const vtkMPIMoveData&) = delete;
   void operator=(const vtkMPIMoveData&) = delete;
 
-  static bool UseZLibCompression;
+  static int CompressionCodec;
+  static int CompressionLevel;
+  static vtkIdType CompressionChunkSize;
+  static int MarshallingMode;
 };
 
 #endif
@@ -40,6 +40,8 @@
 #include "vtkHierarchicalBoxDataSet.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridGeometry.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerVectorKey.h"
@@ -54,10 +56,13 @@
 #include "vtkPVRecoverGeometryWireframe.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridOutlineFilter.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSelectionNode.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -74,10 +79,14 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
+#include <cstring>
 #include <map>
 #include <math.h>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 template <typename T>
@@ -150,6 +159,484 @@ public:
   int Commutative() override { return 1; }
 };
 
+//----------------------------------------------------------------------------
+// Runs ExecuteBlock() and CleanupOutputData() over a range of blocks. The
+// internal filters used by vtkPVGeometryFilter cannot be shared between
+// threads, so each thread gets its own vtkPVGeometryFilter configured like
+// the one being executed.
+class vtkPVGeometryFilter::BlockExecutor
+{
+public:
+  vtkPVGeometryFilter* Self;
+  const std::vector<vtkDataObject*>& Inputs;
+  std::vector<vtkSmartPointer<vtkPolyData> >& Outputs;
+  std::vector<int>& OutlineFlags;
+  const int* WholeExtent;
+  vtkSMPThreadLocalObject<vtkPVGeometryFilter> Workers;
+
+  // Blocks finished by any thread. Progress observers expect to be called on
+  // the thread executing the filter, so only that thread reports progress,
+  // accounting for the blocks finished by the others.
+  std::atomic<vtkIdType> NumberOfFinishedBlocks;
+  std::thread::id ExecutingThread;
+
+  BlockExecutor(vtkPVGeometryFilter* self, const std::vector<vtkDataObject*>& inputs,
+    std::vector<vtkSmartPointer<vtkPolyData> >& outputs, std::vector<int>& outlineFlags,
+    const int* wholeExtent)
+    : Self(self)
+    , Inputs(inputs)
+    , Outputs(outputs)
+    , OutlineFlags(outlineFlags)
+    , WholeExtent(wholeExtent)
+    , NumberOfFinishedBlocks(0)
+    , ExecutingThread(std::this_thread::get_id())
+  {
+  }
+
+  void Initialize() { this->Workers.Local()->CopyBlockExecutionSettings(this->Self); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkPVGeometryFilter* worker = this->Workers.Local();
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+      if (!this->Self->AbortExecute)
+      {
+        worker->ExecuteBlock(this->Inputs[cc], output, 0, 0, 1, 0, this->WholeExtent);
+        worker->CleanupOutputData(output, 0);
+      }
+      this->Outputs[cc] = output;
+      this->OutlineFlags[cc] = worker->OutlineFlag;
+
+      const vtkIdType finished = ++this->NumberOfFinishedBlocks;
+      if (std::this_thread::get_id() == this->ExecutingThread)
+      {
+        this->Self->UpdateProgress(static_cast<double>(finished) / this->Inputs.size());
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//----------------------------------------------------------------------------
+namespace
+{
+inline vtkTypeUInt64 vtkPVGeometryFilterHashCombine(vtkTypeUInt64 hash, vtkTypeUInt64 value)
+{
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 32;
+  hash ^= value;
+  return ((hash << 27) | (hash >> 37)) * 0x9e3779b97f4a7c15ULL + 0x632be59bd9b4e019ULL;
+}
+
+// Hashes the values of an array. Large arrays are hashed in chunks
+// concurrently. Returns false for arrays that do not use the standard memory
+// layout.
+bool vtkPVGeometryFilterHashArray(vtkDataArray* array, vtkTypeUInt64& hash)
+{
+  if (array == nullptr)
+  {
+    hash = vtkPVGeometryFilterHashCombine(hash, 0);
+    return true;
+  }
+  if (!array->HasStandardMemoryLayout())
+  {
+    return false;
+  }
+
+  const unsigned char* bytes = static_cast<const unsigned char*>(array->GetVoidPointer(0));
+  const size_t size = static_cast<size_t>(array->GetNumberOfValues()) * array->GetDataTypeSize();
+  const size_t chunkSize = 1 << 20;
+  std::vector<vtkTypeUInt64> chunkHashes((size + chunkSize - 1) / chunkSize);
+  const vtkIdType numChunks = static_cast<vtkIdType>(chunkHashes.size());
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+    {
+      const size_t last = std::min(static_cast<size_t>(chunk + 1) * chunkSize, size);
+      size_t cc = static_cast<size_t>(chunk) * chunkSize;
+      vtkTypeUInt64 chunkHash = 0;
+      for (; cc + sizeof(vtkTypeUInt64) <= last; cc += sizeof(vtkTypeUInt64))
+      {
+        vtkTypeUInt64 word;
+        memcpy(&word, bytes + cc, sizeof(word));
+        chunkHash = vtkPVGeometryFilterHashCombine(chunkHash, word);
+      }
+      for (; cc < last; ++cc)
+      {
+        chunkHash = vtkPVGeometryFilterHashCombine(chunkHash, bytes[cc]);
+      }
+      chunkHashes[chunk] = chunkHash;
+    }
+  });
+
+  hash = vtkPVGeometryFilterHashCombine(hash, static_cast<vtkTypeUInt64>(array->GetDataType()));
+  hash = vtkPVGeometryFilterHashCombine(hash, static_cast<vtkTypeUInt64>(size));
+  for (vtkTypeUInt64 chunkHash : chunkHashes)
+  {
+    hash = vtkPVGeometryFilterHashCombine(hash, chunkHash);
+  }
+  return true;
+}
+
+// Converts an original ids array to a vtkIdList. Returns nullptr if the array
+// is missing or if any id is outside [0, range), which happens when the
+// surface has points that are not in the input, e.g. after nonlinear
+// subdivision.
+vtkSmartPointer<vtkIdList> vtkPVGeometryFilterGetOriginalIds(
+  vtkDataArray* array, vtkIdType count, vtkIdType range)
+{
+  vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(array);
+  if (ids == nullptr || ids->GetNumberOfComponents() != 1 || ids->GetNumberOfTuples() != count)
+  {
+    return nullptr;
+  }
+  vtkNew<vtkIdList> list;
+  list->SetNumberOfIds(count);
+  for (vtkIdType cc = 0; cc < count; ++cc)
+  {
+    const vtkIdType id = ids->GetValue(cc);
+    if (id < 0 || id >= range)
+    {
+      return nullptr;
+    }
+    list->SetId(cc, id);
+  }
+  return list.GetPointer();
+}
+
+bool vtkPVGeometryFilterIsOriginalIdsArray(const char* name)
+{
+  return strcmp(name, "vtkOriginalPointIds") == 0 || strcmp(name, "vtkOriginalCellIds") == 0;
+}
+
+// Names of the arrays of an input, and of those the extraction copied to the
+// surface. Arrays of the surface not listed in `Gathered` were generated by
+// the extraction.
+struct vtkPVGeometryFilterArraySet
+{
+  std::set<std::string> Input;
+  std::set<std::string> Gathered;
+};
+
+// Records the named arrays of `input` and which of them made it to `output`.
+// Returns false if either side has unnamed arrays, which cannot be matched.
+bool vtkPVGeometryFilterRecordArrays(
+  vtkFieldData* input, vtkFieldData* output, vtkPVGeometryFilterArraySet& arrays)
+{
+  for (int cc = 0; cc < input->GetNumberOfArrays(); ++cc)
+  {
+    const char* name = input->GetAbstractArray(cc)->GetName();
+    if (name == nullptr)
+    {
+      return false;
+    }
+    if (!vtkPVGeometryFilterIsOriginalIdsArray(name))
+    {
+      arrays.Input.insert(name);
+    }
+  }
+  for (int cc = 0; cc < output->GetNumberOfArrays(); ++cc)
+  {
+    const char* name = output->GetAbstractArray(cc)->GetName();
+    if (name == nullptr)
+    {
+      return false;
+    }
+    if (arrays.Input.count(name))
+    {
+      arrays.Gathered.insert(name);
+    }
+  }
+  return true;
+}
+
+// Rebuilds `output` from the current arrays of `input`, gathered at `ids`,
+// followed by the arrays `cached` got from the extraction itself. Gathered
+// arrays that are no longer in the input are dropped. Returns false if the
+// input has arrays the cached surface was not extracted with, or arrays
+// whose number of components changed.
+bool vtkPVGeometryFilterRebuildArrays(vtkDataSetAttributes* input, vtkIdList* ids,
+  vtkDataSetAttributes* cached, const vtkPVGeometryFilterArraySet& arrays,
+  vtkDataSetAttributes* output)
+{
+  output->Initialize();
+  for (int cc = 0; cc < input->GetNumberOfArrays(); ++cc)
+  {
+    vtkAbstractArray* source = input->GetAbstractArray(cc);
+    const char* name = source->GetName();
+    if (name == nullptr)
+    {
+      return false;
+    }
+    if (vtkPVGeometryFilterIsOriginalIdsArray(name))
+    {
+      continue;
+    }
+    if (arrays.Input.count(name) == 0)
+    {
+      return false;
+    }
+    if (arrays.Gathered.count(name) == 0)
+    {
+      continue;
+    }
+    vtkAbstractArray* cachedArray = cached->GetAbstractArray(name);
+    if (cachedArray == nullptr ||
+      cachedArray->GetNumberOfComponents() != source->GetNumberOfComponents())
+    {
+      return false;
+    }
+    vtkSmartPointer<vtkAbstractArray> gathered =
+      vtkSmartPointer<vtkAbstractArray>::Take(source->NewInstance());
+    gathered->SetName(name);
+    gathered->SetNumberOfComponents(source->GetNumberOfComponents());
+    gathered->CopyComponentNames(source);
+    gathered->SetNumberOfTuples(ids->GetNumberOfIds());
+    source->GetTuples(ids, gathered);
+    output->AddArray(gathered);
+    const int attribute = input->IsArrayAnAttribute(cc);
+    if (attribute >= 0)
+    {
+      output->SetActiveAttribute(name, attribute);
+    }
+  }
+  for (int cc = 0; cc < cached->GetNumberOfArrays(); ++cc)
+  {
+    vtkAbstractArray* array = cached->GetAbstractArray(cc);
+    if (arrays.Gathered.count(array->GetName()) == 0)
+    {
+      output->AddArray(array);
+      const int attribute = cached->IsArrayAnAttribute(cc);
+      if (attribute >= 0)
+      {
+        output->SetActiveAttribute(array->GetName(), attribute);
+      }
+    }
+  }
+  return true;
+}
+}
+
+//----------------------------------------------------------------------------
+// Keeps the surfaces extracted from unstructured grids, keyed by a hash of
+// their topology, so that inputs sharing a mesh only need their points and
+// attributes to be gathered. Entries not used by an execution are dropped at
+// its end. The cache is shared with the per-thread filters used by
+// ExecuteBlocks(), hence the mutex.
+class vtkPVGeometryFilter::StaticMeshCache
+{
+public:
+  struct Key
+  {
+    vtkTypeUInt64 Hash = 0;
+    vtkIdType NumberOfPoints = 0;
+    vtkIdType NumberOfCells = 0;
+    bool Valid = false;
+  };
+
+  /**
+   * Hashes the topology of `input` along with every setting of `self` that
+   * affects the extracted surface.
+   */
+  Key ComputeKey(vtkUnstructuredGrid* input, vtkPVGeometryFilter* self)
+  {
+    Key key;
+    vtkCellArray* cells = input->GetCells();
+    if (cells == nullptr || input->GetPoints() == nullptr)
+    {
+      return key;
+    }
+
+    vtkDataArray* arrays[] = { cells->GetOffsetsArray(), cells->GetConnectivityArray(),
+      input->GetCellTypesArray(), input->GetFaces(), input->GetFaceLocations(),
+      input->GetCellData()->GetArray(vtkDataSetAttributes::GhostArrayName()),
+      input->GetPointData()->GetArray(vtkDataSetAttributes::GhostArrayName()) };
+
+    // Readers often hand out the same arrays for every time step; skip
+    // hashing arrays that were hashed before and are unmodified since.
+    Signature signature;
+    for (vtkDataArray* array : arrays)
+    {
+      signature.emplace_back(array, array ? array->GetMTime() : 0);
+    }
+
+    vtkTypeUInt64 topology = 0;
+    bool known = false;
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto iter = this->Signatures.find(signature);
+      if (iter != this->Signatures.end())
+      {
+        topology = iter->second.first;
+        iter->second.second = this->Generation;
+        known = true;
+      }
+    }
+    if (!known)
+    {
+      for (vtkDataArray* array : arrays)
+      {
+        if (!vtkPVGeometryFilterHashArray(array, topology))
+        {
+          return key;
+        }
+      }
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Signatures[signature] = std::make_pair(topology, this->Generation);
+    }
+
+    key.NumberOfPoints = input->GetNumberOfPoints();
+    key.NumberOfCells = input->GetNumberOfCells();
+    key.Hash = topology;
+    for (vtkTypeUInt64 value : { static_cast<vtkTypeUInt64>(self->UseOutline),
+           static_cast<vtkTypeUInt64>(self->GenerateFeatureEdges),
+           static_cast<vtkTypeUInt64>(self->UseStrips),
+           static_cast<vtkTypeUInt64>(self->GenerateCellNormals),
+           static_cast<vtkTypeUInt64>(self->Triangulate),
+           static_cast<vtkTypeUInt64>(self->NonlinearSubdivisionLevel),
+           static_cast<vtkTypeUInt64>(self->PassThroughCellIds),
+           static_cast<vtkTypeUInt64>(self->PassThroughPointIds),
+           static_cast<vtkTypeUInt64>(self->GenerateProcessIds),
+           static_cast<vtkTypeUInt64>(self->HideInternalAMRFaces),
+           static_cast<vtkTypeUInt64>(self->UseNonOverlappingAMRMetaDataForOutlines),
+           static_cast<vtkTypeUInt64>(key.NumberOfPoints) })
+    {
+      key.Hash = vtkPVGeometryFilterHashCombine(key.Hash, value);
+    }
+    key.Valid = true;
+    return key;
+  }
+
+  /**
+   * Fills `output` with the cached surface for `key`, gathering points and
+   * attributes from `input`. Returns false if there is no usable entry.
+   */
+  bool Restore(const Key& key, vtkUnstructuredGrid* input, vtkPolyData* output)
+  {
+    Entry entry;
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto iter = this->Entries.find(key.Hash);
+      if (iter == this->Entries.end() || iter->second.NumberOfPoints != key.NumberOfPoints ||
+        iter->second.NumberOfCells != key.NumberOfCells)
+      {
+        return false;
+      }
+      iter->second.Generation = this->Generation;
+      entry = iter->second;
+    }
+
+    vtkPolyData* surface = entry.Surface;
+    vtkNew<vtkPointData> pointData;
+    vtkNew<vtkCellData> cellData;
+    if (!vtkPVGeometryFilterRebuildArrays(input->GetPointData(), entry.PointIds,
+          surface->GetPointData(), entry.PointArrays, pointData) ||
+      !vtkPVGeometryFilterRebuildArrays(input->GetCellData(), entry.CellIds,
+        surface->GetCellData(), entry.CellArrays, cellData))
+    {
+      return false;
+    }
+
+    output->CopyStructure(surface);
+    output->GetPointData()->ShallowCopy(pointData);
+    output->GetCellData()->ShallowCopy(cellData);
+
+    vtkNew<vtkPoints> points;
+    points->SetDataType(input->GetPoints()->GetDataType());
+    points->SetNumberOfPoints(entry.PointIds->GetNumberOfIds());
+    input->GetPoints()->GetData()->GetTuples(entry.PointIds, points->GetData());
+    output->SetPoints(points);
+    return true;
+  }
+
+  /**
+   * Adds the surface extracted from `input` to the cache. Surfaces that
+   * cannot be fully gathered from their input through the original ids are
+   * skipped.
+   */
+  void Store(const Key& key, vtkUnstructuredGrid* input, vtkPolyData* output)
+  {
+    Entry entry;
+    entry.NumberOfPoints = key.NumberOfPoints;
+    entry.NumberOfCells = key.NumberOfCells;
+    entry.PointIds =
+      vtkPVGeometryFilterGetOriginalIds(output->GetPointData()->GetArray("vtkOriginalPointIds"),
+        output->GetNumberOfPoints(), input->GetNumberOfPoints());
+    entry.CellIds =
+      vtkPVGeometryFilterGetOriginalIds(output->GetCellData()->GetArray("vtkOriginalCellIds"),
+        output->GetNumberOfCells(), input->GetNumberOfCells());
+    if (entry.PointIds == nullptr || entry.CellIds == nullptr ||
+      !vtkPVGeometryFilterRecordArrays(
+        input->GetPointData(), output->GetPointData(), entry.PointArrays) ||
+      !vtkPVGeometryFilterRecordArrays(
+        input->GetCellData(), output->GetCellData(), entry.CellArrays))
+    {
+      return;
+    }
+    entry.Surface = vtkSmartPointer<vtkPolyData>::New();
+    entry.Surface->CopyStructure(output);
+    entry.Surface->GetPointData()->ShallowCopy(output->GetPointData());
+    entry.Surface->GetCellData()->ShallowCopy(output->GetCellData());
+
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    entry.Generation = this->Generation;
+    this->Entries[key.Hash] = entry;
+  }
+
+  void BeginExecution()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    ++this->Generation;
+  }
+
+  void EndExecution()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+    {
+      iter = iter->second.Generation == this->Generation ? std::next(iter)
+                                                         : this->Entries.erase(iter);
+    }
+    for (auto iter = this->Signatures.begin(); iter != this->Signatures.end();)
+    {
+      iter = iter->second.second == this->Generation ? std::next(iter)
+                                                     : this->Signatures.erase(iter);
+    }
+  }
+
+  void Clear()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Entries.clear();
+    this->Signatures.clear();
+  }
+
+private:
+  struct Entry
+  {
+    vtkIdType NumberOfPoints = 0;
+    vtkIdType NumberOfCells = 0;
+    vtkSmartPointer<vtkPolyData> Surface;
+    vtkSmartPointer<vtkIdList> PointIds;
+    vtkSmartPointer<vtkIdList> CellIds;
+    vtkPVGeometryFilterArraySet PointArrays;
+    vtkPVGeometryFilterArraySet CellArrays;
+    unsigned long Generation = 0;
+  };
+
+  // Topology arrays and their modification times.
+  typedef std::vector<std::pair<const void*, vtkMTimeType> > Signature;
+
+  std::mutex Mutex;
+  std::map<vtkTypeUInt64, Entry> Entries;
+  std::map<Signature, std::pair<vtkTypeUInt64, unsigned long> > Signatures;
+  unsigned long Generation = 0;
+};
+
+int vtkPVGeometryFilter::BlockExecutionConcurrency = 0;
+
 //----------------------------------------------------------------------------
 vtkPVGeometryFilter::vtkPVGeometryFilter()
 {
@@ -195,6 +682,9 @@ vtkPVGeometryFilter::vtkPVGeometryFilter()
 
   this->HideInternalAMRFaces = true;
   this->UseNonOverlappingAMRMetaDataForOutlines = true;
+
+  this->CacheStaticMeshSurfaces = false;
+  this->MeshCache = std::make_shared<StaticMeshCache>();
 }
 
 //----------------------------------------------------------------------------
@@ -548,6 +1038,15 @@ int vtkPVGeometryFilter::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
   vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+  if (this->CacheStaticMeshSurfaces)
+  {
+    this->MeshCache->BeginExecution();
+  }
+  else
+  {
+    this->MeshCache->Clear();
+  }
+
   if (vtkCompositeDataSet::SafeDownCast(input))
   {
     vtkTimerLog::MarkStartEvent("vtkPVGeometryFilter::RequestData");
@@ -564,23 +1063,30 @@ int vtkPVGeometryFilter::RequestData(
     vtkGarbageCollector::DeferredCollectionPop();
     vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::GarbageCollect");
     vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::RequestData");
-    return 1;
   }
+  else
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outputVector, 0);
+    assert(output != NULL);
 
-  vtkPolyData* output = vtkPolyData::GetData(outputVector, 0);
-  assert(output != NULL);
+    int procid = 0;
+    int numProcs = 1;
+    if (this->Controller)
+    {
+      procid = this->Controller->GetLocalProcessId();
+      numProcs = this->Controller->GetNumberOfProcesses();
+    }
+    int* wholeExtent =
+      vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
+    this->ExecuteBlock(input, output, 1, procid, numProcs, 0, wholeExtent);
+    this->CleanupOutputData(output, 1);
+  }
 
-  int procid = 0;
-  int numProcs = 1;
-  if (this->Controller)
+  if (this->CacheStaticMeshSurfaces)
   {
-    procid = this->Controller->GetLocalProcessId();
-    numProcs = this->Controller->GetNumberOfProcesses();
+    // drop the surfaces of meshes that were not part of this input.
+    this->MeshCache->EndExecution();
   }
-  int* wholeExtent =
-    vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
-  this->ExecuteBlock(input, output, 1, procid, numProcs, 0, wholeExtent);
-  this->CleanupOutputData(output, 1);
   return 1;
 }
 
@@ -963,9 +1469,11 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
     ++totNumBlocks;
   }
 
-  int* wholeExtent =
-    vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
-  int numInputs = 0;
+  // Collect the blocks to process. A data object may appear in several
+  // leaves, it is only processed once.
+  std::vector<vtkDataObject*> inputs;
+  std::vector<size_t> leafInputs;
+  std::map<vtkDataObject*, size_t> inputIndices;
   for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
   {
     vtkDataObject* block = inIter->GetCurrentDataObject();
@@ -973,27 +1481,46 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
     {
       continue;
     }
+    auto inserted = inputIndices.insert(std::make_pair(block, inputs.size()));
+    if (inserted.second)
+    {
+      inputs.push_back(block);
+    }
+    leafInputs.push_back(inserted.first->second);
+  }
+
+  int* wholeExtent =
+    vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
+  std::vector<vtkSmartPointer<vtkPolyData> > outputs(inputs.size());
+  this->ExecuteBlocks(inputs, outputs, wholeExtent);
+
+  // Assemble the output in block order.
+  std::vector<bool> used(outputs.size(), false);
+  size_t leaf = 0;
+  for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
+  {
+    if (!inIter->GetCurrentDataObject())
+    {
+      continue;
+    }
 
-    vtkPolyData* tmpOut = vtkPolyData::New();
-    this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
-    this->CleanupOutputData(tmpOut, 0);
+    const size_t inputIndex = leafInputs[leaf++];
+    vtkSmartPointer<vtkPolyData> tmpOut = outputs[inputIndex];
     // skip empty nodes.
     if (tmpOut->GetNumberOfPoints() > 0)
     {
+      if (used[inputIndex])
+      {
+        // each leaf needs its own composite index arrays.
+        tmpOut = vtkSmartPointer<vtkPolyData>::New();
+        tmpOut->ShallowCopy(outputs[inputIndex]);
+      }
+      used[inputIndex] = true;
       output->SetDataSet(inIter, tmpOut);
-      tmpOut->FastDelete();
 
       const unsigned int current_flat_index = inIter->GetCurrentFlatIndex();
       this->AddCompositeIndex(tmpOut, current_flat_index);
     }
-    else
-    {
-      tmpOut->Delete();
-      tmpOut = NULL;
-    }
-
-    numInputs++;
-    this->UpdateProgress(static_cast<float>(numInputs) / totNumBlocks);
   }
   vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ExecuteCompositeDataSet");
 
@@ -1095,6 +1622,67 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilter::ExecuteBlocks(const std::vector<vtkDataObject*>& inputs,
+  std::vector<vtkSmartPointer<vtkPolyData> >& outputs, const int* wholeExtent)
+{
+  const vtkIdType numInputs = static_cast<vtkIdType>(inputs.size());
+  const int concurrency = vtkPVGeometryFilter::BlockExecutionConcurrency;
+  if (concurrency == 1 || numInputs < 2)
+  {
+    for (vtkIdType cc = 0; cc < numInputs; ++cc)
+    {
+      outputs[cc] = vtkSmartPointer<vtkPolyData>::New();
+      this->ExecuteBlock(inputs[cc], outputs[cc], 0, 0, 1, 0, wholeExtent);
+      this->CleanupOutputData(outputs[cc], 0);
+      this->UpdateProgress(static_cast<double>(cc + 1) / numInputs);
+    }
+    return;
+  }
+
+  // Blocks usually are expensive to process, so hand them out one at a time
+  // unless the number of concurrent blocks is limited.
+  const vtkIdType grain = concurrency > 1 ? (numInputs + concurrency - 1) / concurrency : 1;
+  std::vector<int> outlineFlags(inputs.size(), 0);
+  vtkPVGeometryFilter::BlockExecutor executor(this, inputs, outputs, outlineFlags, wholeExtent);
+  vtkSMPTools::For(0, numInputs, grain, executor);
+
+  // match the serial behavior, where the flag is left by the last block.
+  this->OutlineFlag = outlineFlags.back();
+  this->UpdateProgress(1.0);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilter::CopyBlockExecutionSettings(vtkPVGeometryFilter* other)
+{
+  this->SetController(other->Controller);
+  this->SetUseOutline(other->UseOutline);
+  this->SetGenerateFeatureEdges(other->GenerateFeatureEdges);
+  this->SetUseStrips(other->UseStrips);
+  this->SetGenerateCellNormals(other->GenerateCellNormals);
+  this->SetTriangulate(other->Triangulate);
+  this->SetNonlinearSubdivisionLevel(other->NonlinearSubdivisionLevel);
+  this->SetPassThroughCellIds(other->PassThroughCellIds);
+  this->SetPassThroughPointIds(other->PassThroughPointIds);
+  this->SetGenerateProcessIds(other->GenerateProcessIds);
+  this->SetHideInternalAMRFaces(other->HideInternalAMRFaces);
+  this->SetUseNonOverlappingAMRMetaDataForOutlines(other->UseNonOverlappingAMRMetaDataForOutlines);
+  this->SetCacheStaticMeshSurfaces(other->CacheStaticMeshSurfaces);
+  this->MeshCache = other->MeshCache;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilter::SetBlockExecutionConcurrency(int value)
+{
+  vtkPVGeometryFilter::BlockExecutionConcurrency = std::max(value, 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGeometryFilter::GetBlockExecutionConcurrency()
+{
+  return vtkPVGeometryFilter::BlockExecutionConcurrency;
+}
+
 //----------------------------------------------------------------------------
 // We need to change the mapper.  Now it always flat shades when cell normals
 // are available.
@@ -1417,6 +2005,20 @@ void vtkPVGeometryFilter::UnstructuredGridExecute(
   {
     this->OutlineFlag = 0;
 
+    // Reuse the surface extracted from an earlier input with the same
+    // topology; only points and attributes need to be gathered then.
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+    StaticMeshCache::Key cacheKey;
+    if (this->CacheStaticMeshSurfaces && grid && this->PassThroughCellIds &&
+      this->PassThroughPointIds)
+    {
+      cacheKey = this->MeshCache->ComputeKey(grid, this);
+      if (cacheKey.Valid && this->MeshCache->Restore(cacheKey, grid, output))
+      {
+        return;
+      }
+    }
+
     bool handleSubdivision = (this->Triangulate != 0) && (input->GetNumberOfCells() > 0);
     if (!handleSubdivision && (this->NonlinearSubdivisionLevel > 0))
     {
@@ -1565,6 +2167,10 @@ void vtkPVGeometryFilter::UnstructuredGridExecute(
     }
 
     output->GetCellData()->RemoveArray(vtkPVRecoverGeometryWireframe::ORIGINAL_FACE_IDS());
+    if (cacheKey.Valid)
+    {
+      this->MeshCache->Store(cacheKey, grid, output);
+    }
     return;
   }
 
@@ -1807,6 +2413,9 @@ void vtkPVGeometryFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "PassThroughCellIds: " << (this->PassThroughCellIds ? "On\n" : "Off\n");
   os << indent << "PassThroughPointIds: " << (this->PassThroughPointIds ? "On\n" : "Off\n");
+  os << indent << "CacheStaticMeshSurfaces: " << (this->CacheStaticMeshSurfaces ? "On\n" : "Off\n");
+  os << indent
+     << "BlockExecutionConcurrency: " << vtkPVGeometryFilter::BlockExecutionConcurrency << endl;
 }
 
 //----------------------------------------------------------------------------
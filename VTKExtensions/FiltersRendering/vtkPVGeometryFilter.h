@@ -25,6 +25,10 @@
 
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+#include "vtkSmartPointer.h"                          // needed for vtkSmartPointer
+
+#include <memory> // needed for std::shared_ptr
+#include <vector> // needed for std::vector
 class vtkCallbackCommand;
 class vtkDataSet;
 class vtkDataSetSurfaceFilter;
@@ -207,6 +211,35 @@ public:
   vtkBooleanMacro(UseNonOverlappingAMRMetaDataForOutlines, bool);
   //@}
 
+  //@{
+  /**
+   * When on, the surfaces extracted from vtkUnstructuredGrid inputs are kept
+   * and reused for later inputs with the same topology, e.g. the time steps
+   * of a simulation on a static mesh. The topology is identified by a hash of
+   * the cell connectivity, cell types and ghost arrays; point coordinates and
+   * attribute arrays are gathered from the new input through the
+   * vtkOriginalPointIds and vtkOriginalCellIds arrays. The cache is only used
+   * when both PassThroughPointIds and PassThroughCellIds are on and it keeps a
+   * copy of the surface of every block processed by the last execution.
+   * Default is off.
+   */
+  vtkSetMacro(CacheStaticMeshSurfaces, bool);
+  vtkGetMacro(CacheStaticMeshSurfaces, bool);
+  vtkBooleanMacro(CacheStaticMeshSurfaces, bool);
+  //@}
+
+  //@{
+  /**
+   * Set the maximum number of leaf blocks of a composite dataset that are
+   * processed concurrently on each rank. 1 processes blocks serially; 0
+   * (default) lets vtkSMPTools use all of its threads. Outputs are assembled
+   * in block order regardless of this setting. This is a process-wide
+   * setting.
+   */
+  static void SetBlockExecutionConcurrency(int);
+  static int GetBlockExecutionConcurrency();
+  //@}
+
   // These keys are put in the output composite-data metadata for multipieces
   // since this filter merges multipieces together.
   static vtkInformationIntegerVectorKey* POINT_OFFSETS();
@@ -331,6 +364,7 @@ protected:
   bool HideInternalAMRFaces;
   bool UseNonOverlappingAMRMetaDataForOutlines;
   bool GenerateFeatureEdges;
+  bool CacheStaticMeshSurfaces;
 
 private:
   vtkPVGeometryFilter(const vtkPVGeometryFilter&) = delete;
@@ -348,6 +382,26 @@ private:
   void AddHierarchicalIndex(vtkPolyData* pd, unsigned int level, unsigned int index);
   class BoundsReductionOperation;
   //@}
+
+  /**
+   * Copies the settings that affect ExecuteBlock() and CleanupOutputData()
+   * from \c other. Used to set up the per-thread filters that process blocks
+   * concurrently.
+   */
+  void CopyBlockExecutionSettings(vtkPVGeometryFilter* other);
+
+  /**
+   * Executes ExecuteBlock() and CleanupOutputData() for each of the \c inputs
+   * using up to BlockExecutionConcurrency threads.
+   */
+  void ExecuteBlocks(const std::vector<vtkDataObject*>& inputs,
+    std::vector<vtkSmartPointer<vtkPolyData> >& outputs, const int* wholeExtent);
+  class BlockExecutor;
+
+  class StaticMeshCache;
+  std::shared_ptr<StaticMeshCache> MeshCache;
+
+  static int BlockExecutionConcurrency;
 };
 
 #endif
@@ -30,6 +30,7 @@
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
 #include "vtkSignedCharArray.h"
@@ -550,13 +551,59 @@ public:
       }
     }
   };
+  // Key of the distributed sort. The process id and the index of the row
+  // make the keys unique so that equal values are ordered consistently on
+  // every process.
+  class SortKey
+  {
+  public:
+    T Value;
+    int ProcessId;
+    vtkIdType Index;
+
+    bool IsNan() const { return vtkMath::IsNan(static_cast<double>(this->Value)); }
+
+    bool operator<(const SortKey& other) const
+    {
+      // NaNs compare neither less nor greater than anything, which breaks
+      // the strict weak ordering the sorts rely on; order them last.
+      const bool nan = this->IsNan();
+      const bool otherNan = other.IsNan();
+      if (nan != otherNan)
+      {
+        return otherNan;
+      }
+      if (this->Value < other.Value)
+      {
+        return true;
+      }
+      if (other.Value < this->Value)
+      {
+        return false;
+      }
+      if (this->ProcessId != other.ProcessId)
+      {
+        return this->ProcessId < other.ProcessId;
+      }
+      return this->Index < other.Index;
+    }
+  };
+  // Global position of a local row once sorted.
+  class SortPosition
+  {
+  public:
+    vtkIdType Index;
+    vtkIdType Position;
+
+    bool operator<(const SortPosition& other) const { return this->Position < other.Position; }
+  };
 
 public:
   Internals()
   {
     // Only used for testing
     this->LocalSorter = 0;
-    this->GlobalHistogram = 0;
+    this->TotalNumberOfRows = 0;
     this->Debug = false;
   }
 
@@ -581,15 +628,13 @@ public:
 
     // Create internal objects
     this->LocalSorter = new ArraySorter();
-    this->GlobalHistogram = new Histogram(HISTOGRAM_SIZE);
+    this->TotalNumberOfRows = 0;
   }
 
   ~Internals() override
   {
     if (this->LocalSorter)
       delete this->LocalSorter;
-    if (this->GlobalHistogram)
-      delete this->GlobalHistogram;
   }
 
   // --------------------------------------------------------------------------
@@ -661,9 +706,6 @@ public:
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
 
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
     // Is there something to sort ???
     if (!sortableArray)
     {
@@ -672,44 +714,83 @@ public:
       {
         this->LocalSorter->FillArray(this->DataToSort->GetNumberOfTuples());
       }
+      return 1;
     }
-    else
+
+    // ------------------------------------------------------------------------
+    // Distributed sample sort: sort the local keys, select splitters from a
+    // regular sample of every process, send each key to the process owning
+    // its range and sort again. Each process then knows the global position
+    // of the keys it received and sends it back to the process owning the row.
+    // ------------------------------------------------------------------------
+    std::vector<SortKey> keys = this->NewLocalKeys();
+    vtkSMPTools::Sort(keys.begin(), keys.end());
+
+    std::vector<SortKey> splitters = this->SelectSplitters(keys);
+    std::vector<std::vector<SortKey> > outgoingKeys(this->NumProcs);
+    auto first = keys.begin();
+    for (int pid = 0; pid < this->NumProcs; ++pid)
     {
-      if (this->DataToSort)
-      {
-        // Sort and build local histogram
-        this->LocalSorter->Update(static_cast<T*>(this->DataToSort->GetVoidPointer(0)),
-          this->DataToSort->GetNumberOfTuples(), this->DataToSort->GetNumberOfComponents(),
-          this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, invertOrder);
-      }
-      else
-      {
-        // Build empty local histogram
-        this->LocalSorter->Clear();
-        this->LocalSorter->Histo = new Histogram(HISTOGRAM_SIZE);
-        this->LocalSorter->Histo->SetScalarRange(this->CommonRange);
-        this->LocalSorter->Histo->Inverted = invertOrder;
-      }
+      auto last = (pid + 1 < this->NumProcs && !splitters.empty())
+        ? std::lower_bound(first, keys.end(), splitters[pid])
+        : keys.end();
+      outgoingKeys[pid].assign(first, last);
+      first = last;
+    }
+    std::vector<SortKey>().swap(keys);
 
-      // Initialize the global histogram with same range
-      this->LocalSorter->Histo->CopyRangeTo(*this->GlobalHistogram);
+    std::vector<SortKey> partition = this->AllToAll(outgoingKeys);
+    std::vector<std::vector<SortKey> >().swap(outgoingKeys);
+    vtkSMPTools::Sort(partition.begin(), partition.end());
 
-      // Make sure that the global histogram is properly initialized
-      this->GlobalHistogram->ClearHistogramValues();
-      this->GlobalHistogram->Inverted = invertOrder;
+    // Global position of the first key of the local partition
+    std::vector<vtkIdType> partitionSizes(this->NumProcs);
+    vtkIdType partitionSize = static_cast<vtkIdType>(partition.size());
+    this->MPI->AllGather(&partitionSize, &partitionSizes[0], 1);
+    vtkIdType offset = 0;
+    this->TotalNumberOfRows = 0;
+    for (int pid = 0; pid < this->NumProcs; ++pid)
+    {
+      offset += (pid < this->Me) ? partitionSizes[pid] : 0;
+      this->TotalNumberOfRows += partitionSizes[pid];
+    }
 
-      // Send local histogram and receive every histogram from everybody
-      this->MPI->AllGather(this->LocalSorter->Histo->Values, bufferHistogramValues, HISTOGRAM_SIZE);
+    // NaNs are sorted last; they stay last when the order is inverted.
+    vtkIdType localNumberOfNaNs = 0;
+    for (const SortKey& key : partition)
+    {
+      localNumberOfNaNs += key.IsNan() ? 1 : 0;
+    }
+    vtkIdType numberOfNaNs = 0;
+    this->MPI->AllReduce(&localNumberOfNaNs, &numberOfNaNs, 1, vtkCommunicator::SUM_OP);
+    const vtkIdType numberOfValues = this->TotalNumberOfRows - numberOfNaNs;
 
-      // Merge all histogram into the GlobalHistogram
-      for (int idx = 0, nb = this->NumProcs * HISTOGRAM_SIZE; idx < nb; ++idx)
+    std::vector<std::vector<SortPosition> > outgoingPositions(this->NumProcs);
+    for (vtkIdType idx = 0; idx < partitionSize; ++idx)
+    {
+      const SortKey& key = partition[idx];
+      SortPosition position;
+      position.Index = key.Index;
+      position.Position = offset + idx;
+      if (invertOrder && position.Position < numberOfValues)
       {
-        this->GlobalHistogram->TotalValues += bufferHistogramValues[idx];
-        this->GlobalHistogram->Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        position.Position = numberOfValues - 1 - position.Position;
       }
+      outgoingPositions[key.ProcessId].push_back(position);
     }
+    std::vector<SortKey>().swap(partition);
+
+    std::vector<SortPosition> positions = this->AllToAll(outgoingPositions);
+    std::vector<std::vector<SortPosition> >().swap(outgoingPositions);
+    vtkSMPTools::Sort(positions.begin(), positions.end());
 
-    delete[] bufferHistogramValues;
+    this->SortedIndices.resize(positions.size());
+    this->SortedPositions.resize(positions.size());
+    for (size_t idx = 0; idx < positions.size(); ++idx)
+    {
+      this->SortedIndices[idx] = positions[idx].Index;
+      this->SortedPositions[idx] = positions[idx].Position;
+    }
     return 1;
   }
 
@@ -853,8 +934,9 @@ public:
   {
     // ------------------------------------------------------------------------
     // Make sure that the Cache is built
-    //    This will sort the local array, that's why we don't want to do it
-    //    at each execution. Specially when we only change the requested block.
+    //    This will sort the whole array across processes, that's why we don't
+    //    want to do it at each execution. Specially when we only change the
+    //    requested block.
     // ------------------------------------------------------------------------
     if (this->NeedToBuildCache)
     {
@@ -862,36 +944,28 @@ public:
     }
 
     // ------------------------------------------------------------------------
-    // Search for lower bound
+    // Find the local rows that belong to the requested block
     // ------------------------------------------------------------------------
-    vtkIdType nbElementsToRemoveFromHead = 0;
-    vtkIdType localOffset = 0;
-    vtkIdType nbElementsInBar = 0;
-    this->SearchGlobalIndexLocation((block * blockSize), this->LocalSorter->Histo,
-      this->GlobalHistogram, nbElementsToRemoveFromHead, localOffset, nbElementsInBar);
+    const vtkIdType blockBegin = block * blockSize;
+    const vtkIdType blockEnd = vtkMath::Min(blockBegin + blockSize, this->TotalNumberOfRows);
+    const auto first =
+      std::lower_bound(this->SortedPositions.begin(), this->SortedPositions.end(), blockBegin);
+    const auto last = std::lower_bound(first, this->SortedPositions.end(), blockEnd);
+    const vtkIdType localOffset = static_cast<vtkIdType>(first - this->SortedPositions.begin());
+    const vtkIdType localSize = static_cast<vtkIdType>(last - first);
 
     // ------------------------------------------------------------------------
-    // Search for upper bound
-    // ------------------------------------------------------------------------
-    vtkIdType upperOffset = 0;
-    vtkIdType globalUpperOffset = 0;
-    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < (block + 1) * blockSize)
-      ? this->GlobalHistogram->TotalValues
-      : ((block + 1) * blockSize);
-    searchIdx--; // It is not a size it is an index (so -1)
-
-    this->SearchGlobalIndexLocation(searchIdx, this->LocalSorter->Histo, this->GlobalHistogram,
-      globalUpperOffset, upperOffset, nbElementsInBar);
-
-    // We have to include our searched index (so +1)
-    vtkIdType localSize = (upperOffset + nbElementsInBar) - localOffset + 1;
-
-    // ------------------------------------------------------------------------
-    // Build local subset table
+    // Build local subset table, keeping track of the global positions
     // ------------------------------------------------------------------------
     vtkSmartPointer<vtkTable> localSubset;
-    localSubset.TakeReference(
-      this->NewSubsetTable(input, this->LocalSorter, localOffset, localSize));
+    localSubset.TakeReference(this->NewSubsetTable(
+      input, localSize > 0 ? &this->SortedIndices[localOffset] : nullptr, localSize));
+
+    vtkSmartPointer<vtkIdTypeArray> positionArray = vtkSmartPointer<vtkIdTypeArray>::New();
+    positionArray->SetName(VTK_SORTED_POSITIONS_NAME);
+    positionArray->SetNumberOfTuples(localSize);
+    std::copy(first, last, positionArray->GetPointer(0));
+    localSubset->GetRowData()->AddArray(positionArray);
 
     // ------------------------------------------------------------------------
     // Find the process that will merge all subset table
@@ -906,7 +980,7 @@ public:
       vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
       processIdArray->SetName("vtkOriginalProcessIds");
       processIdArray->SetNumberOfComponents(1);
-      processIdArray->Allocate((blockSize < localSize) ? localSize : blockSize);
+      processIdArray->Allocate(blockSize);
       for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
       {
         processIdArray->InsertNextTuple1(mergePid);
@@ -920,127 +994,225 @@ public:
     if (this->Me != mergePid)
     {
       this->MPI->Send(localSubset.GetPointer(), mergePid, VTK_TABLE_EXCHANGE_TAG);
+
+      // Ask other processes to provide metadata for table decoration
+      this->DecorateTable(input, NULL, mergePid);
+      return 1;
     }
 
     // ------------------------------------------------------------------------
     // Merging procedure only on process mergePid
     // ------------------------------------------------------------------------
-    if (this->Me == mergePid)
+    vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
+    for (int i = 0; i < this->NumProcs; i++)
     {
-      vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
-      for (int i = 0; i < this->NumProcs; i++)
-      {
-        if (i == mergePid)
-          continue;
-
-        this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
-        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
-      }
+      if (i == mergePid)
+        continue;
 
-      // Sort new table/array
-      if (!this->DataToSort)
-      {
-        // This mean that no output can be provided
-        // cout << "ERROR the merge process have no DataArray." << endl;
-        return 1;
-      }
-      vtkDataArray* subsetArray =
-        vtkDataArray::SafeDownCast(localSubset->GetColumnByName(this->DataToSort->GetName()));
-
-      if (!subsetArray)
-      {
-        vtkSortedTableStreamer::PrintInfo(localSubset.GetPointer());
-      }
+      this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
+      this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
+    }
 
-      ArraySorter sorter;
-      sorter.Update(static_cast<T*>(subsetArray->GetVoidPointer(0)),
-        subsetArray->GetNumberOfTuples(), subsetArray->GetNumberOfComponents(),
-        this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, revertOrder);
+    // Put the rows in their global order using their positions
+    vtkIdTypeArray* positions =
+      vtkIdTypeArray::SafeDownCast(localSubset->GetColumnByName(VTK_SORTED_POSITIONS_NAME));
+    std::vector<vtkIdType> order(localSubset->GetNumberOfRows());
+    for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); ++idx)
+    {
+      order[positions->GetValue(idx) - blockBegin] = idx;
+    }
+    localSubset->RemoveColumnByName(VTK_SORTED_POSITIONS_NAME);
+    localSubset.TakeReference(this->NewSubsetTable(localSubset.GetPointer(),
+      order.empty() ? nullptr : &order[0], static_cast<vtkIdType>(order.size())));
 
-      // trim it (remove head and tail that don't belong to the result)
-      localSubset.TakeReference(this->NewSubsetTable(
-        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, blockSize));
+    // Add extra information such as structured indices, block number...
+    this->DecorateTable(input, localSubset.GetPointer(), mergePid);
 
-      // Add extra information such as structured indices, block number...
-      this->DecorateTable(input, localSubset.GetPointer(), mergePid);
+    // ShallowCopy it to the output
+    output->ShallowCopy(localSubset.GetPointer());
+    return 1;
+  }
 
-      // ShallowCopy it to the output
-      output->ShallowCopy(localSubset.GetPointer());
+  // --------------------------------------------------------------------------
+  // Build the sort keys of the local rows.
+  std::vector<SortKey> NewLocalKeys()
+  {
+    std::vector<SortKey> keys;
+    if (!this->DataToSort)
+    {
+      return keys;
     }
-    else
+
+    const T* dataPtr = static_cast<T*>(this->DataToSort->GetVoidPointer(0));
+    const int numComponents = this->DataToSort->GetNumberOfComponents();
+    int selectedComponent = this->SelectedComponent;
+    if (numComponents == 1 && selectedComponent < 0)
     {
-      // Ask other processes to provide metadata for table decoration
-      this->DecorateTable(input, NULL, mergePid);
+      selectedComponent = 0; // We can not compute magnitude on scalar value
     }
 
-    return 1;
+    keys.resize(this->DataToSort->GetNumberOfTuples());
+    const int me = this->Me;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(keys.size()), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        SortKey& key = keys[i];
+        key.ProcessId = me;
+        key.Index = i;
+        if (selectedComponent < 0)
+        {
+          // Compute magnitude
+          double value = 0;
+          for (int k = 0; k < numComponents; k++)
+          {
+            const double tmp = static_cast<double>(dataPtr[k + i * numComponents]);
+            value += tmp * tmp;
+          }
+          key.Value = static_cast<T>(sqrt(value) / sqrt(static_cast<double>(numComponents)));
+        }
+        else
+        {
+          key.Value = dataPtr[selectedComponent + i * numComponents];
+        }
+      }
+    });
+    return keys;
   }
 
   // --------------------------------------------------------------------------
-  // nbGlobalToSkip is the number of elements that should be skipped at the end
-  // if you exactly want to reach the searchedGlobalIndex.
-  // localOffset is the corresponding local index in the sorted table to the
-  // global index of (searchedGlobalIndex - nbGlobalToSkip)
-  // nbInLocalBar is the local number of elements that are available
-  // in the histogram bar where the searchedGlobalIndex has been found.
-  // nbInLocalBar is used when you want to get an upper bound that
-  // will include the searchedGlobalIndex.
-  void SearchGlobalIndexLocation(vtkIdType searchedGlobalIndex, Histogram* localHistogram,
-    Histogram* globalHistogram, vtkIdType& nbGlobalToSkip, vtkIdType& localOffset,
-    vtkIdType& nbInLocalBar)
+  // Select NumProcs - 1 splitters from a regular sample of the sorted keys of
+  // every process.
+  std::vector<SortKey> SelectSplitters(const std::vector<SortKey>& sortedKeys)
   {
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
+    std::vector<SortKey> splitters;
+    if (this->NumProcs == 1)
+    {
+      return splitters;
+    }
 
-    // Local internal working var
-    vtkIdType histogramBarIdx = -1;
-    double currentRange[2];
-    vtkIdType idx, idxEnd;
+    const vtkIdType numKeys = static_cast<vtkIdType>(sortedKeys.size());
+    const vtkIdType numSamples =
+      vtkMath::Min(numKeys, static_cast<vtkIdType>(NUMBER_OF_SAMPLES_PER_PROCESS));
+    std::vector<SortKey> samples(numSamples);
+    for (vtkIdType idx = 0; idx < numSamples; ++idx)
+    {
+      samples[idx] = sortedKeys[((2 * idx + 1) * numKeys) / (2 * numSamples)];
+    }
 
-    // Setup initial histogram range and values
-    Histogram _globalHistogram;
-    Histogram _localHistogram;
-    localHistogram->CopyTo(_localHistogram);
-    globalHistogram->CopyTo(_globalHistogram);
+    std::vector<vtkIdType> lengths(this->NumProcs);
+    std::vector<vtkIdType> offsets(this->NumProcs);
+    vtkIdType length = numSamples * static_cast<vtkIdType>(sizeof(SortKey));
+    this->MPI->AllGather(&length, &lengths[0], 1);
+    vtkIdType totalLength = 0;
+    for (int pid = 0; pid < this->NumProcs; ++pid)
+    {
+      offsets[pid] = totalLength;
+      totalLength += lengths[pid];
+    }
+    if (totalLength == 0)
+    {
+      return splitters;
+    }
 
-    // Reset local offsets
-    localOffset = 0;
-    nbGlobalToSkip = searchedGlobalIndex;
+    std::vector<SortKey> allSamples(totalLength / sizeof(SortKey));
+    this->MPI->AllGatherV(reinterpret_cast<char*>(samples.data()),
+      reinterpret_cast<char*>(&allSamples[0]), length, &lengths[0], &offsets[0]);
+    std::sort(allSamples.begin(), allSamples.end());
 
-    do
+    const vtkIdType numAllSamples = static_cast<vtkIdType>(allSamples.size());
+    for (int pid = 1; pid < this->NumProcs; ++pid)
     {
-      nbGlobalToSkip -= _globalHistogram.GetNewRange(nbGlobalToSkip, histogramBarIdx, currentRange);
-
-      localOffset += _localHistogram.GetNumberOfElements(0, histogramBarIdx);
-      nbInLocalBar = _localHistogram.GetNumberOfElements(histogramBarIdx, histogramBarIdx + 1);
+      splitters.push_back(allSamples[(pid * numAllSamples) / this->NumProcs]);
+    }
+    return splitters;
+  }
 
-      // Based on a narrowed range, build local histogram to get closer to the
-      // real index of the object
-      _localHistogram.SetScalarRange(currentRange);
-      _localHistogram.ClearHistogramValues();
+  // --------------------------------------------------------------------------
+  // Send outgoing[pid] to process pid and return what all the processes sent
+  // to this one, ordered by sending process. Large exchanges are split in
+  // rounds so that no single message exceeds MAXIMUM_EXCHANGE_SIZE bytes.
+  // Each round is a pairwise exchange: at step k every process trades its
+  // slice of outgoing with process (Me ^ k), the lower id sending first so
+  // that every blocking send meets its receive.
+  template <class V>
+  std::vector<V> AllToAll(const std::vector<std::vector<V> >& outgoing)
+  {
+    if (this->NumProcs == 1)
+    {
+      return outgoing[0];
+    }
 
-      idxEnd = localOffset + nbInLocalBar;
-      for (idx = localOffset; idx < idxEnd; ++idx)
-      {
-        _localHistogram.AddValue(this->LocalSorter->Array[idx].Value);
-      }
+    // Number of items sent by each process to each process
+    const int numProcs = this->NumProcs;
+    std::vector<vtkIdType> sendCounts(numProcs);
+    std::vector<vtkIdType> counts(numProcs * numProcs);
+    for (int pid = 0; pid < numProcs; ++pid)
+    {
+      sendCounts[pid] = static_cast<vtkIdType>(outgoing[pid].size());
+    }
+    this->MPI->AllGather(&sendCounts[0], &counts[0], numProcs);
 
-      // Exchange local histo with everyone
-      this->MPI->AllGather(_localHistogram.Values, bufferHistogramValues, HISTOGRAM_SIZE);
+    const vtkIdType chunkSize =
+      vtkMath::Max(static_cast<vtkIdType>(MAXIMUM_EXCHANGE_SIZE / sizeof(V)), vtkIdType(1));
+    vtkIdType maxCount = 0;
+    for (vtkIdType count : counts)
+    {
+      maxCount = vtkMath::Max(maxCount, count);
+    }
 
-      // Build global histogram
-      _globalHistogram.SetScalarRange(currentRange);
-      _globalHistogram.ClearHistogramValues();
+    std::vector<vtkIdType> incomingOffsets(numProcs);
+    vtkIdType numIncoming = 0;
+    for (int pid = 0; pid < numProcs; ++pid)
+    {
+      incomingOffsets[pid] = numIncoming;
+      numIncoming += counts[pid * numProcs + this->Me];
+    }
+    std::vector<V> incoming(numIncoming);
+    std::copy(outgoing[this->Me].begin(), outgoing[this->Me].end(),
+      incoming.begin() + incomingOffsets[this->Me]);
 
-      idxEnd = this->NumProcs * HISTOGRAM_SIZE;
-      for (idx = 0; idx < idxEnd; ++idx)
+    int numSteps = 1;
+    while (numSteps < numProcs)
+    {
+      numSteps *= 2;
+    }
+    for (vtkIdType round = 0; round * chunkSize < maxCount; ++round)
+    {
+      const vtkIdType roundBegin = round * chunkSize;
+      for (int step = 1; step < numSteps; ++step)
       {
-        _globalHistogram.TotalValues += bufferHistogramValues[idx];
-        _globalHistogram.Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        const int other = this->Me ^ step;
+        if (other >= numProcs)
+        {
+          continue;
+        }
+        const vtkIdType sendBegin = vtkMath::Min(roundBegin, sendCounts[other]);
+        const vtkIdType sendEnd = vtkMath::Min(roundBegin + chunkSize, sendCounts[other]);
+        const vtkIdType count = counts[other * numProcs + this->Me];
+        const vtkIdType recvBegin = vtkMath::Min(roundBegin, count);
+        const vtkIdType recvEnd = vtkMath::Min(roundBegin + chunkSize, count);
+        for (int turn = 0; turn < 2; ++turn)
+        {
+          if ((turn == 0) == (this->Me < other))
+          {
+            if (sendEnd > sendBegin)
+            {
+              this->MPI->Send(reinterpret_cast<const char*>(&outgoing[other][sendBegin]),
+                (sendEnd - sendBegin) * static_cast<vtkIdType>(sizeof(V)), other,
+                VTK_SORT_EXCHANGE_TAG);
+            }
+          }
+          else if (recvEnd > recvBegin)
+          {
+            this->MPI->Receive(
+              reinterpret_cast<char*>(&incoming[incomingOffsets[other] + recvBegin]),
+              (recvEnd - recvBegin) * static_cast<vtkIdType>(sizeof(V)), other,
+              VTK_SORT_EXCHANGE_TAG);
+          }
+        }
       }
-    } while (nbGlobalToSkip > 0 && _globalHistogram.CanBeReduced());
-
-    delete[] bufferHistogramValues;
+    }
+    return incoming;
   }
 
   // --------------------------------------------------------------------------
@@ -1095,6 +1267,37 @@ public:
     return subTable;
   }
 
+  // --------------------------------------------------------------------------
+  static vtkTable* NewSubsetTable(vtkTable* srcTable, const vtkIdType* indices, vtkIdType size)
+  {
+    vtkTable* subTable = vtkTable::New();
+
+    // Loop on all column of the table
+    for (vtkIdType colIdx = 0; colIdx < srcTable->GetNumberOfColumns(); ++colIdx)
+    {
+      vtkAbstractArray* srcArray = srcTable->GetColumn(colIdx);
+
+      // Manage subset items
+      vtkAbstractArray* subArray = srcArray->NewInstance();
+      subArray->SetNumberOfComponents(srcArray->GetNumberOfComponents());
+      subArray->SetName(srcArray->GetName());
+      subArray->SetNumberOfTuples(size);
+      if (auto sinfo = srcArray->GetInformation())
+      {
+        subArray->CopyInformation(sinfo);
+      }
+      for (vtkIdType idx = 0; idx < size; ++idx)
+      {
+        subArray->SetTuple(idx, indices[idx], srcArray);
+      }
+      subTable->GetRowData()->AddArray(subArray);
+      subArray->FastDelete();
+    }
+
+    // Return the new subset vtkTable
+    return subTable;
+  }
+
   // --------------------------------------------------------------------------
   void SetSelectedComponent(int newValue) override
   {
@@ -1305,20 +1508,23 @@ public:
   }
   // --------------------------------------------------------------------------
 private:
-  vtkMTimeType InputMTime;    // Keep the original input MTime
-  vtkMTimeType DataMTime;     // Keep the original data MTime
-  vtkDataArray* DataToSort;   // DataArray to sort
-  ArraySorter* LocalSorter;   // Local ArraySorter based on global range
-  Histogram* GlobalHistogram; // Globaly merged Histogram based on global range
-  double CommonRange[2];      // Scalar range used across processes
-  int Me;                     // Current process ID
-  int NumProcs;               // Number of processes involved
-  vtkCommunicator* MPI;       // MPI communicator to send/receive/gather
-  int SelectedComponent;      // Component used to sort array
+  vtkMTimeType InputMTime;                // Keep the original input MTime
+  vtkMTimeType DataMTime;                 // Keep the original data MTime
+  vtkDataArray* DataToSort;               // DataArray to sort
+  ArraySorter* LocalSorter;               // Local ArraySorter based on global range
+  std::vector<vtkIdType> SortedIndices;   // Local rows in the global order
+  std::vector<vtkIdType> SortedPositions; // Global positions of SortedIndices
+  vtkIdType TotalNumberOfRows;            // Number of rows across processes
+  double CommonRange[2];                  // Scalar range used across processes
+  int Me;                                 // Current process ID
+  int NumProcs;                           // Number of processes involved
+  vtkCommunicator* MPI;                   // MPI communicator to send/receive/gather
+  int SelectedComponent;                  // Component used to sort array
   bool NeedToBuildCache;
   bool Debug;
 
   const static int VTK_TABLE_EXCHANGE_TAG = 50;
+  const static int VTK_SORT_EXCHANGE_TAG = 51;
   // HISTOGRAM_SIZE could be computed dynamically based on the type of the
   // array to sort but to make sure that unsigned char won't be distributed
   // correctly we set the histogram size to be their max number of element
@@ -1326,6 +1532,14 @@ private:
   // Maybe make some test on huge cluster to see which histogram size is
   // the best.
   const static int HISTOGRAM_SIZE = 256;
+  // Number of keys each process contributes to the selection of the
+  // splitters of the distributed sort.
+  const static int NUMBER_OF_SAMPLES_PER_PROCESS = 256;
+  // Largest message, in bytes, sent to a single process while exchanging
+  // the keys of the distributed sort.
+  const static vtkIdType MAXIMUM_EXCHANGE_SIZE = 256 * 1024 * 1024;
+  // Temporary column holding the global positions of the rows of a block.
+  static constexpr const char* VTK_SORTED_POSITIONS_NAME = "vtkSortedPositions";
 };
 //****************************************************************************
 vtkStandardNewMacro(vtkSortedTableStreamer);
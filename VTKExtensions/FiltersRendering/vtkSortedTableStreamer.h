@@ -20,6 +20,11 @@
  * This filter is used quickly get a sorted subset of a given vtkTable.
  * By sorted we mean a subset build from a global sort even if some optimisation
  * allow us to skip a global table sorting.
+ *
+ * The column is sorted across processes with a distributed sample sort the
+ * first time a block is requested for a given column, component and order.
+ * Every process then keeps the global position of its rows so that any
+ * following block is extracted without sorting again.
 */
 
 #ifndef vtkSortedTableStreamer_h
@@ -19,15 +19,366 @@
 #include "vtkSquirtCompressor.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
 #include <sstream>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VTK_SQUIRT_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+// The compressed stream is a sequence of 32-bit words. It starts with a
+// header followed by the run-length encoded words for each tile:
+//
+//   magic, number of pixels, pixels per tile, number of tiles,
+//   number of words for tile 0, ..., number of words for tile N-1,
+//   tile 0 words..., tile N-1 words...
+//
+// Streams without a valid header are legacy (ParaView 5.8 and earlier)
+// streams, i.e. the run-length encoded words for the whole image as a single
+// tile, and are decoded as such.
+const unsigned int SquirtStreamMagic = 0x31545153; // "SQT1"
+const int SquirtHeaderSize = 4;
+
+const unsigned char SquirtCompressMasks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF },
+  { 0xFE, 0xFF, 0xFE, 0xFE }, { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 },
+  { 0xF0, 0xF8, 0xF0, 0xF0 }, { 0xE0, 0xF0, 0xE0, 0xE0 } };
+
+//-----------------------------------------------------------------------------
+// Returns the number of pixels at the start of `pixels` (at most `available`)
+// that match `color` once masked with `mask`. `color` must already be masked.
+inline int ComputeRun(
+  const unsigned int* pixels, int available, unsigned int color, unsigned int mask)
+{
+  int count = 0;
+#if defined(__AVX2__)
+  const __m256i vmask = _mm256_set1_epi32(static_cast<int>(mask));
+  const __m256i vcolor = _mm256_set1_epi32(static_cast<int>(color));
+  for (; count + 8 <= available; count += 8)
+  {
+    const __m256i values =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + count));
+    int bits = _mm256_movemask_ps(
+      _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(values, vmask), vcolor)));
+    if (bits != 0xFF)
+    {
+      for (; bits & 0x1; bits >>= 1)
+      {
+        ++count;
+      }
+      return count;
+    }
+  }
+#elif defined(VTK_SQUIRT_USE_SSE2)
+  const __m128i vmask = _mm_set1_epi32(static_cast<int>(mask));
+  const __m128i vcolor = _mm_set1_epi32(static_cast<int>(color));
+  for (; count + 4 <= available; count += 4)
+  {
+    const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + count));
+    int bits = _mm_movemask_ps(
+      _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(values, vmask), vcolor)));
+    if (bits != 0xF)
+    {
+      for (; bits & 0x1; bits >>= 1)
+      {
+        ++count;
+      }
+      return count;
+    }
+  }
+#endif
+  while (count < available && (pixels[count] & mask) == color)
+  {
+    ++count;
+  }
+  return count;
+}
+
+//-----------------------------------------------------------------------------
+// Same as ComputeRun for packed RGB pixels; `color` and `mask` hold the RGB
+// bytes in their low 3 bytes. The pixels are compared 3 bytes at a time
+// against the color and mask repeated every 3 bytes, so that they need not be
+// expanded to 32-bit words first.
+inline int ComputeRunRGB(
+  const unsigned char* pixels, int available, unsigned int color, unsigned int mask)
+{
+  int count = 0;
+#if defined(__AVX2__) || defined(VTK_SQUIRT_USE_SSE2)
+  // byte patterns of period 3, as 32-bit words: c0c1c2c0 c1c2c0c1 c2c0c1c2.
+  color &= 0x00FFFFFF;
+  mask &= 0x00FFFFFF;
+  const int color0 = static_cast<int>(color | (color << 24));
+  const int color1 = static_cast<int>((color >> 8) | (color << 16));
+  const int color2 = static_cast<int>((color >> 16) | (color << 8));
+  const int mask0 = static_cast<int>(mask | (mask << 24));
+  const int mask1 = static_cast<int>((mask >> 8) | (mask << 16));
+  const int mask2 = static_cast<int>((mask >> 16) | (mask << 8));
+#endif
+#if defined(__AVX2__)
+  // 10 pixels (30 bytes) per iteration; a 32 byte load must not read past
+  // the last available pixel.
+  const __m256i vmask =
+    _mm256_setr_epi32(mask0, mask1, mask2, mask0, mask1, mask2, mask0, mask1);
+  const __m256i vcolor =
+    _mm256_setr_epi32(color0, color1, color2, color0, color1, color2, color0, color1);
+  for (; count + 11 <= available; count += 10)
+  {
+    const __m256i values =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + 3 * count));
+    unsigned int bits = static_cast<unsigned int>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(values, vmask), vcolor)));
+    if ((bits & 0x3FFFFFFF) != 0x3FFFFFFF)
+    {
+      int bytes = 0;
+      for (; bits & 0x1; bits >>= 1)
+      {
+        ++bytes;
+      }
+      return count + bytes / 3;
+    }
+  }
+#elif defined(VTK_SQUIRT_USE_SSE2)
+  // 5 pixels (15 bytes) per iteration; a 16 byte load must not read past the
+  // last available pixel.
+  const __m128i vmask = _mm_setr_epi32(mask0, mask1, mask2, mask0);
+  const __m128i vcolor = _mm_setr_epi32(color0, color1, color2, color0);
+  for (; count + 6 <= available; count += 5)
+  {
+    const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 3 * count));
+    int bits = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(values, vmask), vcolor));
+    if ((bits & 0x7FFF) != 0x7FFF)
+    {
+      int bytes = 0;
+      for (; bits & 0x1; bits >>= 1)
+      {
+        ++bytes;
+      }
+      return count + bytes / 3;
+    }
+  }
+#endif
+  for (; count < available; ++count)
+  {
+    const unsigned char* p = pixels + 3 * count;
+    unsigned int value = 0;
+    unsigned char* v = reinterpret_cast<unsigned char*>(&value);
+    v[0] = p[0];
+    v[1] = p[1];
+    v[2] = p[2];
+    if ((value & mask) != color)
+    {
+      break;
+    }
+  }
+  return count;
+}
+
+//-----------------------------------------------------------------------------
+// Encodes `numPixels` RGBA pixels into `out`, returning the number of words
+// written (never more than `numPixels`).
+int CompressTileRGBA(
+  const unsigned int* in, int numPixels, unsigned int compress_mask, unsigned int* out)
+{
+  int index = 0;
+  int comp_index = 0;
+  while (index < numPixels)
+  {
+    // Record color
+    unsigned int current_color = out[comp_index] = in[index];
+    unsigned char opacity = *(((unsigned char*)&current_color) + 3);
+    index++;
+
+    // Compute Run
+    int count = ComputeRun(in + index, std::min(0x0F, numPixels - index),
+      current_color & compress_mask, compress_mask);
+    index += count;
+    if (opacity > 0)
+    {
+      opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
+      opacity = opacity << 4;
+      count |= opacity;
+    }
+
+    // Record Run length
+    *((unsigned char*)out + comp_index * 4 + 3) = (unsigned char)count;
+    comp_index++;
+  }
+  return comp_index;
+}
+
+//-----------------------------------------------------------------------------
+// Same as CompressTileRGBA for RGB pixels.
+int CompressTileRGB(
+  const unsigned char* in, int numPixels, unsigned int compress_mask, unsigned int* out)
+{
+  auto getColor = [in](int pixel) {
+    unsigned int color = 0;
+    unsigned char* p = (unsigned char*)&color;
+    p[0] = in[3 * pixel];
+    p[1] = in[3 * pixel + 1];
+    p[2] = in[3 * pixel + 2];
+    return color;
+  };
+
+  int index = 0;
+  int comp_index = 0;
+  while (index < numPixels)
+  {
+    // Record color
+    const unsigned int current_color = getColor(index);
+    out[comp_index] = current_color;
+    index++;
+
+    // Compute Run
+    const int count = ComputeRunRGB(in + 3 * index, std::min(255, numPixels - index),
+      current_color & compress_mask, compress_mask);
+    index += count;
+
+    // Record Run length
+    reinterpret_cast<unsigned char*>(out)[comp_index * 4 + 3] = static_cast<unsigned char>(count);
+    comp_index++;
+  }
+  return comp_index;
+}
+
+//-----------------------------------------------------------------------------
+// Expands a RGBA tile. Returns false if the tile does not decode to exactly
+// `numPixels` pixels.
+bool DecompressTileRGBA(const unsigned int* in, int numWords, unsigned int* out, int numPixels)
+{
+  int index = 0;
+  for (int i = 0; i < numWords; i++)
+  {
+    // Get color and count
+    unsigned int current_color = in[i];
+
+    // Get run length count;
+    int count = *((unsigned char*)&current_color + 3);
+
+    if (count > 0x0f)
+    {
+      // we have some opacity.
+      unsigned char opacity = (count & 0xF0);
+      opacity = opacity >> 4;
+      opacity *= 16;
+      *((unsigned char*)&current_color + 3) = opacity;
+    }
+    else
+    {
+      *((unsigned char*)&current_color + 3) = 0;
+    }
+    count &= 0x0F;
+
+    if (index + count + 1 > numPixels)
+    {
+      return false;
+    }
+
+    // Blast color into color buffer
+    std::fill(out + index, out + index + count + 1, current_color);
+    index += count + 1;
+  }
+  return index == numPixels;
+}
+
+//-----------------------------------------------------------------------------
+// Same as DecompressTileRGBA for RGB pixels.
+bool DecompressTileRGB(const unsigned int* in, int numWords, unsigned char* out, int numPixels)
+{
+  int index = 0;
+  for (int i = 0; i < numWords; i++)
+  {
+    // Get color and count
+    const unsigned int current_color = in[i];
+    const unsigned char* current_color_rgb = reinterpret_cast<const unsigned char*>(&current_color);
+
+    // Get run length count;
+    const int count = current_color_rgb[3];
+    if (index + count + 1 > numPixels)
+    {
+      return false;
+    }
+    for (int j = 0; j <= count; j++)
+    {
+      std::copy(current_color_rgb, current_color_rgb + 3, out);
+      out += 3;
+    }
+    index += count + 1;
+  }
+  return index == numPixels;
+}
+
+//-----------------------------------------------------------------------------
+// Validates the stream header and computes the offset of each tile's words.
+bool ParseHeader(vtkUnsignedCharArray* in, int numPixels, int& tileSize,
+  std::vector<vtkIdType>& tileOffsets, std::vector<int>& tileWords)
+{
+  const vtkIdType inputWords = in->GetNumberOfTuples() * in->GetNumberOfComponents() / 4;
+  if (inputWords < SquirtHeaderSize)
+  {
+    return false;
+  }
+  const unsigned int* header = reinterpret_cast<const unsigned int*>(in->GetPointer(0));
+  const vtkIdType numTiles = header[3];
+  tileSize = static_cast<int>(header[2]);
+  if (header[0] != SquirtStreamMagic || header[1] != static_cast<unsigned int>(numPixels) ||
+    inputWords < SquirtHeaderSize + numTiles)
+  {
+    return false;
+  }
+
+  // tiles must cover the image exactly.
+  const vtkIdType expectedTiles =
+    tileSize > 0 ? (numPixels + static_cast<vtkIdType>(tileSize) - 1) / tileSize : -1;
+  if (numPixels == 0 ? numTiles != 0 : numTiles != expectedTiles)
+  {
+    return false;
+  }
+
+  tileOffsets.resize(numTiles);
+  tileWords.resize(numTiles);
+  vtkIdType offset = SquirtHeaderSize + numTiles;
+  for (vtkIdType cc = 0; cc < numTiles; ++cc)
+  {
+    tileOffsets[cc] = offset;
+    tileWords[cc] = static_cast<int>(std::min(header[SquirtHeaderSize + cc], 0x7fffffffu));
+    offset += tileWords[cc];
+  }
+  return offset <= inputWords;
+}
+
+//-----------------------------------------------------------------------------
+// Computes the offset of each tile's words, treating streams without a valid
+// header as legacy streams made of a single tile.
+void ParseStream(vtkUnsignedCharArray* in, int numPixels, int& tileSize,
+  std::vector<vtkIdType>& tileOffsets, std::vector<int>& tileWords)
+{
+  if (!ParseHeader(in, numPixels, tileSize, tileOffsets, tileWords))
+  {
+    const vtkIdType inputWords = in->GetNumberOfTuples() * in->GetNumberOfComponents() / 4;
+    tileSize = std::max(numPixels, 1);
+    tileOffsets.assign(1, 0);
+    tileWords.assign(1, static_cast<int>(std::min<vtkIdType>(inputWords, 0x7fffffff)));
+  }
+}
+}
 
 vtkStandardNewMacro(vtkSquirtCompressor);
 
 //-----------------------------------------------------------------------------
 vtkSquirtCompressor::vtkSquirtCompressor()
   : SquirtLevel(3)
+  , TileSize(65536)
 {
 }
 
@@ -46,23 +397,15 @@ int vtkSquirtCompressor::Compress()
   }
 
   vtkUnsignedCharArray* input = this->GetInput();
+  const int numComps = input->GetNumberOfComponents();
 
-  if (input->GetNumberOfComponents() != 4 && input->GetNumberOfComponents() != 3)
+  if (numComps != 4 && numComps != 3)
   {
     vtkErrorMacro("Squirt only works with RGBA or RGB");
     return VTK_ERROR;
   }
 
-  int count = 0;
-  int index = 0;
-  int comp_index = 0;
-  int end_index;
   int compress_level = this->LossLessMode ? 0 : this->SquirtLevel;
-  unsigned int current_color;
-  unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
-    { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
-    { 0xE0, 0xF0, 0xE0, 0xE0 } };
-
   if (compress_level < 0 || compress_level > 5)
   {
     vtkErrorMacro("Squirt compression level (" << compress_level << ") is out of range [0,5].");
@@ -72,106 +415,63 @@ int vtkSquirtCompressor::Compress()
   // Set bitmask based on compress_level
   unsigned int compress_mask;
   // I shifted the level by one so that 0 means no compression.
-  memcpy(&compress_mask, &compress_masks[compress_level], 4);
-
-  // Access raw arrays directly
-  if (input->GetNumberOfComponents() == 4)
-  {
-    unsigned int* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned int*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < end_index) && (comp_index < end_index))
+  memcpy(&compress_mask, &SquirtCompressMasks[compress_level], 4);
+
+  const int numPixels = static_cast<int>(input->GetNumberOfTuples());
+  const int tileSize = (this->TileSize > 0 && this->TileSize < numPixels)
+    ? this->TileSize
+    : std::max(numPixels, 1);
+  const int numTiles = numPixels > 0 ? (numPixels + tileSize - 1) / tileSize : 0;
+
+  // Each tile is encoded at the offset it would have if nothing compressed;
+  // a tile never produces more words than it has pixels so tiles cannot
+  // overlap. They are then packed together once all are done.
+  const vtkIdType maxWords = SquirtHeaderSize + numTiles + static_cast<vtkIdType>(numPixels);
+  this->Output->SetNumberOfComponents(1);
+  unsigned int* _rawCompressedBuffer =
+    reinterpret_cast<unsigned int*>(this->Output->WritePointer(0, 4 * maxWords));
+  unsigned int* header = _rawCompressedBuffer;
+  unsigned int* tilesBuffer = _rawCompressedBuffer + SquirtHeaderSize + numTiles;
+
+  std::vector<int> tileWords(numTiles, 0);
+  const unsigned char* _rawColorBuffer = input->GetPointer(0);
+  vtkSMPTools::For(0, numTiles, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tile = begin; tile < end; ++tile)
     {
-
-      // Record color
-      current_color = _rawCompressedBuffer[comp_index] = _rawColorBuffer[index];
-      unsigned char opacity = *(((unsigned char*)&current_color) + 3);
-      index++;
-
-      // Compute Run
-      while ((index < end_index) && (count < 0x0F) &&
-        ((current_color & compress_mask) == (_rawColorBuffer[index] & compress_mask)))
+      const int first = static_cast<int>(tile) * tileSize;
+      const int count = std::min(tileSize, numPixels - first);
+      if (numComps == 4)
       {
-        index++;
-        count++;
+        tileWords[tile] =
+          CompressTileRGBA(reinterpret_cast<const unsigned int*>(_rawColorBuffer) + first, count,
+            compress_mask, tilesBuffer + first);
       }
-      if (opacity > 0)
+      else
       {
-        opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
-        opacity = opacity << 4;
-        count |= opacity;
+        tileWords[tile] =
+          CompressTileRGB(_rawColorBuffer + 3 * first, count, compress_mask, tilesBuffer + first);
       }
-
-      // Record Run length
-      *((unsigned char*)_rawCompressedBuffer + comp_index * 4 + 3) = (unsigned char)count;
-      comp_index++;
-
-      count = 0;
     }
-  }
-  else if (input->GetNumberOfComponents() == 3)
+  });
+
+  header[0] = SquirtStreamMagic;
+  header[1] = static_cast<unsigned int>(numPixels);
+  header[2] = static_cast<unsigned int>(tileSize);
+  header[3] = static_cast<unsigned int>(numTiles);
+  vtkIdType comp_index = 0;
+  for (int tile = 0; tile < numTiles; ++tile)
   {
-    unsigned char* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned char*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < 3 * numPixels) && (comp_index < end_index))
+    header[SquirtHeaderSize + tile] = static_cast<unsigned int>(tileWords[tile]);
+    unsigned int* tileStart = tilesBuffer + static_cast<vtkIdType>(tile) * tileSize;
+    if (tilesBuffer + comp_index != tileStart)
     {
-
-      int next_color = 0;
-      // Record color
-      unsigned char* p = (unsigned char*)&current_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      _rawCompressedBuffer[comp_index] = current_color;
-      index += 3;
-
-      p = (unsigned char*)&next_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      // Compute Run
-      while (((current_color & compress_mask) == (next_color & compress_mask)) &&
-        (index < 3 * numPixels) && (count < 255))
-      {
-        index += 3;
-        count++;
-        if (index < 3 * numPixels)
-        {
-          p = (unsigned char*)&next_color;
-          *p++ = _rawColorBuffer[index];
-          *p++ = _rawColorBuffer[index + 1];
-          *p++ = _rawColorBuffer[index + 2];
-          *p = 0x0;
-        }
-      }
-
-      // Record Run length
-      reinterpret_cast<unsigned char*>(_rawCompressedBuffer)[comp_index * 4 + 3] =
-        static_cast<unsigned char>(count);
-      comp_index++;
-
-      count = 0;
+      memmove(tilesBuffer + comp_index, tileStart, sizeof(unsigned int) * tileWords[tile]);
     }
+    comp_index += tileWords[tile];
   }
 
   // Back to vtk arrays :)
-  this->Output->SetNumberOfComponents(1);
-  this->Output->SetNumberOfTuples(4 * comp_index);
+  this->Output->SetNumberOfTuples(4 * (SquirtHeaderSize + numTiles + comp_index));
 
   return VTK_OK;
 }
@@ -209,50 +509,34 @@ int vtkSquirtCompressor::DecompressRGBA()
   vtkUnsignedCharArray* out = this->GetOutput();
   assert(out->GetNumberOfComponents() == 4);
 
-  int count = 0;
-  int index = 0;
-  unsigned int current_color;
-  unsigned int* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+  const int numPixels = static_cast<int>(out->GetNumberOfTuples());
+  int tileSize;
+  std::vector<vtkIdType> tileOffsets;
+  std::vector<int> tileWords;
+  ParseStream(in, numPixels, tileSize, tileOffsets, tileWords);
 
   // Access raw arrays directly
-  _rawColorBuffer = (unsigned int*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
-  {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
-
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
-
-    if (count > 0x0f)
-    {
-      // we have some opacity.
-      unsigned char opacity = (count & 0xF0);
-      opacity = opacity >> 4;
-      opacity *= 16;
-      *((unsigned char*)&current_color + 3) = opacity;
-    }
-    else
+  unsigned int* _rawColorBuffer = reinterpret_cast<unsigned int*>(out->GetPointer(0));
+  const unsigned int* _rawCompressedBuffer =
+    reinterpret_cast<const unsigned int*>(in->GetPointer(0));
+
+  std::atomic<bool> valid(true);
+  const vtkIdType numTiles = static_cast<vtkIdType>(tileWords.size());
+  vtkSMPTools::For(0, numTiles, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tile = begin; tile < end; ++tile)
     {
-      *((unsigned char*)&current_color + 3) = 0;
-    }
-    count &= 0x0F;
-
-    // Set color
-    _rawColorBuffer[index++] = current_color;
-
-    // Blast color into color buffer
-    for (int j = 0; j < count; j++)
-    {
-      _rawColorBuffer[index++] = current_color;
+      const int first = static_cast<int>(tile) * tileSize;
+      if (!DecompressTileRGBA(_rawCompressedBuffer + tileOffsets[tile], tileWords[tile],
+            _rawColorBuffer + first, std::min(tileSize, numPixels - first)))
+      {
+        valid = false;
+      }
     }
+  });
+  if (!valid)
+  {
+    vtkErrorMacro("Corrupt SQUIRT stream.");
+    return VTK_ERROR;
   }
   return VTK_OK;
 }
@@ -264,39 +548,35 @@ int vtkSquirtCompressor::DecompressRGB()
   vtkUnsignedCharArray* out = this->GetOutput();
   assert(out->GetNumberOfComponents() == 3);
 
-  int count = 0;
-  unsigned int current_color;
-  unsigned char* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+  const int numPixels = static_cast<int>(out->GetNumberOfTuples());
+  int tileSize;
+  std::vector<vtkIdType> tileOffsets;
+  std::vector<int> tileWords;
+  ParseStream(in, numPixels, tileSize, tileOffsets, tileWords);
 
   // Access raw arrays directly
-  _rawColorBuffer = (unsigned char*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
-  {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
-
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
-
-    *((unsigned char*)&current_color + 3) = 0xff;
-
-    unsigned char current_color_rgb[3];
-    std::copy(reinterpret_cast<const unsigned char*>(&current_color),
-      reinterpret_cast<const unsigned char*>(&current_color) + 3, current_color_rgb);
-    std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-    _rawColorBuffer += 3;
-    for (int j = 0; j < count; j++)
+  unsigned char* _rawColorBuffer = out->GetPointer(0);
+  const unsigned int* _rawCompressedBuffer =
+    reinterpret_cast<const unsigned int*>(in->GetPointer(0));
+
+  std::atomic<bool> valid(true);
+  const vtkIdType numTiles = static_cast<vtkIdType>(tileWords.size());
+  vtkSMPTools::For(0, numTiles, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tile = begin; tile < end; ++tile)
     {
-      std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-      _rawColorBuffer += 3;
+      const int first = static_cast<int>(tile) * tileSize;
+      if (!DecompressTileRGB(_rawCompressedBuffer + tileOffsets[tile], tileWords[tile],
+            _rawColorBuffer + 3 * static_cast<vtkIdType>(first),
+            std::min(tileSize, numPixels - first)))
+      {
+        valid = false;
+      }
     }
+  });
+  if (!valid)
+  {
+    vtkErrorMacro("Corrupt SQUIRT stream.");
+    return VTK_ERROR;
   }
   return VTK_OK;
 }
@@ -348,4 +628,5 @@ void vtkSquirtCompressor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "SquirtLevel: " << this->SquirtLevel << endl;
+  os << indent << "TileSize: " << this->TileSize << endl;
 }
@@ -44,6 +44,15 @@
  * The compressor uses a modified SQUIRT implementation where encode 4-bit
  * opacity information as well. This is needed to improve background color
  * blending for translucent renderings in ParaView.
+ *
+ * To keep up with large framebuffers, the image is split into tiles of
+ * `TileSize` pixels that are run-length encoded independently and
+ * concurrently (using vtkSMPTools). The compressed stream starts with a
+ * small header recording the tile layout, so that the decompressor can
+ * also expand tiles in parallel. Runs never span tiles. Streams without
+ * that header, as produced by ParaView 5.8 and earlier, are still
+ * decompressed. Run detection uses SSE2/AVX2 when the compiler targets those
+ * instruction sets and falls back to a scalar loop otherwise.
  * @par Thanks:
  * Thanks to Sandia National Laboratories for this compression technique
 */
@@ -73,6 +82,19 @@ public:
   vtkGetMacro(SquirtLevel, int);
   //@}
 
+  //@{
+  /**
+   * Set the number of pixels per tile used when compressing. Each tile is
+   * encoded independently, so smaller tiles expose more parallelism at the
+   * cost of slightly worse compression at tile boundaries. 0 encodes the
+   * whole image as a single tile. The decompressor reads the tile layout
+   * from the stream so this need not match on both ends.
+   * Default is 65536.
+   */
+  vtkSetClampMacro(TileSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(TileSize, int);
+  //@}
+
   //@{
   /**
    * Compress/Decompress data array on the objects input with results
@@ -100,6 +122,7 @@ protected:
   int DecompressRGBA();
 
   int SquirtLevel;
+  int TileSize;
 
 private:
   vtkSquirtCompressor(const vtkSquirtCompressor&) = delete;
@@ -28,7 +28,7 @@ namespace
 
 // ensure that the writer works when the columns are not in the same order on all ranks.
 // also ensures partial arrays don't mess things up.
-bool WriteCSV(const std::string& fname, int rank)
+bool WriteCSV(const std::string& fname, int rank, int mode)
 {
   vtkNew<vtkTable> table;
   vtkNew<vtkDoubleArray> col1;
@@ -65,6 +65,7 @@ bool WriteCSV(const std::string& fname, int rank)
 
   vtkNew<vtkCSVWriter> writer;
   writer->SetFileName(fname.c_str());
+  writer->SetParallelWriteMode(mode);
   writer->SetInputDataObject(table);
   writer->Update();
   return true;
@@ -78,13 +79,10 @@ bool WriteCSV(const std::string& fname, int rank)
     return false;                                                                                  \
   }
 
-bool ReadAndVerifyCSV(const std::string& fname, int rank, int numRanks)
+// verifies the rows of ranks [firstRank, firstRank + numRanks).
+bool ReadAndVerifyCSV(
+  const std::string& fname, int firstRank, int numRanks, vtkIdType numColumns = 2)
 {
-  if (rank != 0)
-  {
-    return true;
-  }
-
   vtkNew<vtkDelimitedTextReader> reader;
   reader->SetFileName(fname.c_str());
   reader->SetHaveHeaders(true);
@@ -93,15 +91,15 @@ bool ReadAndVerifyCSV(const std::string& fname, int rank, int numRanks)
 
   auto table = reader->GetOutput();
   VERITFY_EQ(table->GetNumberOfRows(), 10 * numRanks, "incorrect row count");
-  VERITFY_EQ(table->GetNumberOfColumns(), 2, "incorrect column count");
+  VERITFY_EQ(table->GetNumberOfColumns(), numColumns, "incorrect column count");
 
   for (int irank = 0; irank < numRanks; ++irank)
   {
     for (vtkIdType cc = 0; cc < 10; ++cc)
     {
-      const auto row = cc + irank * 10;
-      auto value1 = table->GetValueByName(row, "Column1");
-      auto value2 = table->GetValueByName(row, "Column2");
+      const auto row = cc + (firstRank + irank) * 10;
+      auto value1 = table->GetValueByName(row - firstRank * 10, "Column1");
+      auto value2 = table->GetValueByName(row - firstRank * 10, "Column2");
       VERITFY_EQ(value1.ToDouble(), row + 1.5,
         std::string("incorrect column1  values at row ") + std::to_string(row));
       VERITFY_EQ(value2.ToInt(), row * 100,
@@ -111,6 +109,26 @@ bool ReadAndVerifyCSV(const std::string& fname, int rank, int numRanks)
   return true;
 }
 
+bool TestParallelWriteMode(const std::string& tname, int mode, int rank, int numRanks)
+{
+  const std::string fname = tname + "/TestCSVWriter-" + std::to_string(mode) + ".csv";
+  if (!WriteCSV(fname, rank, mode))
+  {
+    return false;
+  }
+  if (mode == vtkCSVWriter::FILE_PER_RANK && numRanks > 1)
+  {
+    // each rank wrote all of its columns to its own file.
+    const std::string rankname =
+      tname + "/TestCSVWriter-" + std::to_string(mode) + "_" + std::to_string(rank) + ".csv";
+    return ReadAndVerifyCSV(rankname, rank, 1, rank == 0 ? 3 : 2);
+  }
+
+  // wait for all ranks to be done writing the shared file.
+  vtkMultiProcessController::GetGlobalController()->Barrier();
+  return rank != 0 || ReadAndVerifyCSV(fname, 0, numRanks);
+}
+
 } // end of namespace
 
 int TestCSVWriter(int argc, char* argv[])
@@ -133,10 +151,11 @@ int TestCSVWriter(int argc, char* argv[])
   }
 
   std::string tname{ testing->GetTempDirectory() };
-  int success = WriteCSV(tname + "/TestCSVWriter.csv", myRank) &&
-      ReadAndVerifyCSV(tname + "/TestCSVWriter.csv", myRank, numRanks)
-    ? 1
-    : 0;
+  int success = 1;
+  for (int mode = vtkCSVWriter::GATHER_TO_ROOT; mode <= vtkCSVWriter::SHARED_FILE; ++mode)
+  {
+    success = TestParallelWriteMode(tname, mode, myRank, numRanks) && success ? 1 : 0;
+  }
 
   int all_success;
   contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
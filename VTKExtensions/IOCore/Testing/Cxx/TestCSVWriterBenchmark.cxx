@@ -0,0 +1,148 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCSVWriterBenchmark.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a table with vtkCSVWriter, compares the file against the same table
+// formatted with std::ostream and reports the number of rows written per
+// second. Use `--rows=<N>` to time larger tables.
+
+#include "vtkCSVWriter.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+#include <vtksys/FStream.hxx>
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+std::string Format(vtkTable* table, bool scientific, int precision)
+{
+  std::ostringstream stream;
+  stream << "\"doubles\",\"floats\",\"ints\",\"ids:0\",\"ids:1\",\"ids:2\",\"strings\"\n";
+  if (scientific)
+  {
+    stream << std::scientific;
+  }
+  stream << std::setprecision(precision);
+  auto doubles = vtkDoubleArray::SafeDownCast(table->GetColumnByName("doubles"));
+  auto floats = vtkFloatArray::SafeDownCast(table->GetColumnByName("floats"));
+  auto ints = vtkIntArray::SafeDownCast(table->GetColumnByName("ints"));
+  auto ids = vtkIdTypeArray::SafeDownCast(table->GetColumnByName("ids"));
+  auto strings = vtkStringArray::SafeDownCast(table->GetColumnByName("strings"));
+  for (vtkIdType cc = 0; cc < table->GetNumberOfRows(); ++cc)
+  {
+    stream << doubles->GetValue(cc) << "," << floats->GetValue(cc) << "," << ints->GetValue(cc)
+           << "," << ids->GetTypedComponent(cc, 0) << "," << ids->GetTypedComponent(cc, 1) << ","
+           << ids->GetTypedComponent(cc, 2) << ",\"" << strings->GetValue(cc) << "\"\n";
+  }
+  return stream.str();
+}
+
+bool DoTest(vtkTable* table, const std::string& fname, bool scientific, int precision)
+{
+  vtkNew<vtkCSVWriter> writer;
+  writer->SetController(nullptr);
+  writer->SetFileName(fname.c_str());
+  writer->SetUseScientificNotation(scientific);
+  writer->SetPrecision(precision);
+  writer->SetInputDataObject(table);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  writer->Write();
+  timer->StopTimer();
+  const double elapsed = timer->GetElapsedTime();
+  cout << "scientific " << scientific << ", precision " << precision << ": "
+       << table->GetNumberOfRows() << " rows in " << elapsed << " s ("
+       << (elapsed > 0 ? table->GetNumberOfRows() / elapsed : 0) << " rows/s)" << endl;
+
+  vtksys::ifstream file(fname.c_str(), ios::in | ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  if (contents.str() != Format(table, scientific, precision))
+  {
+    cerr << "Mismatched file contents." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestCSVWriterBenchmark(int argc, char* argv[])
+{
+  int rows = 100000;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument("--rows", argT::EQUAL_ARGUMENT, &rows, "Number of rows to write.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse() || rows < 1)
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fname = std::string(tempDir) + "/TestCSVWriterBenchmark.csv";
+  delete[] tempDir;
+
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("doubles");
+  vtkNew<vtkFloatArray> floats;
+  floats->SetName("floats");
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("ints");
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfComponents(3);
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("strings");
+  vtkMath::RandomSeed(1234);
+  for (vtkIdType cc = 0; cc < rows; ++cc)
+  {
+    doubles->InsertNextValue(vtkMath::Gaussian(0.0, 1e6));
+    floats->InsertNextValue(static_cast<float>(vtkMath::Random(-1.0, 1.0)));
+    ints->InsertNextValue(static_cast<int>(vtkMath::Random(-1e9, 1e9)));
+    ids->InsertNextTuple3(cc, -cc, cc * 1000);
+    strings->InsertNextValue("row " + std::to_string(cc));
+  }
+
+  vtkNew<vtkTable> table;
+  table->AddColumn(doubles);
+  table->AddColumn(floats);
+  table->AddColumn(ints);
+  table->AddColumn(ids);
+  table->AddColumn(strings);
+
+  return DoTest(table, fname, true, 5) && DoTest(table, fname, false, 5) &&
+      DoTest(table, fname, true, 17)
+    ? TEST_SUCCESS
+    : TEST_FAILED;
+}
@@ -15,27 +15,37 @@
 #include "vtkCSVWriter.h"
 
 #include "vtkAlgorithm.h"
-#include "vtkArrayIteratorIncludes.h"
+#include "vtkArrayDispatch.h"
 #include "vtkAttributeDataToTableFilter.h"
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkErrorCode.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVMergeTables.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringArray.h"
 #include "vtkTable.h"
+#include "vtkVariant.h"
 
 #include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
+#include <cstdio>
+#include <memory>
 #include <numeric>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 vtkStandardNewMacro(vtkCSVWriter);
@@ -54,6 +64,7 @@ vtkCSVWriter::vtkCSVWriter()
   this->FieldAssociation = 0;
   this->AddMetaData = false;
   this->AddTime = false;
+  this->ParallelWriteMode = vtkCSVWriter::GATHER_TO_ROOT;
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
@@ -96,96 +107,225 @@ int vtkCSVWriter::ProcessRequest(
 
 namespace
 {
+struct FormatOptions
+{
+  std::string FieldDelimiter;
+  std::string StringDelimiter;
+  int Precision;
+  bool UseScientificNotation;
+};
+
 //-----------------------------------------------------------------------------
-template <class iterT>
-void vtkCSVWriterGetDataString(
-  iterT* iter, vtkIdType tupleIndex, ostream& stream, vtkCSVWriter* writer, bool* first)
+template <typename T>
+bool IsNegative(T value, std::true_type)
 {
-  int numComps = iter->GetNumberOfComponents();
-  vtkIdType index = tupleIndex * numComps;
-  for (int cc = 0; cc < numComps; cc++)
-  {
-    if (!(*first))
-    {
-      stream << writer->GetFieldDelimiter();
-    }
-    *first = false;
-    if ((index + cc) < iter->GetNumberOfValues())
-    {
-      stream << iter->GetValue(index + cc);
-    }
-  }
+  return value < 0;
+}
+
+template <typename T>
+bool IsNegative(T, std::false_type)
+{
+  return false;
 }
 
 //-----------------------------------------------------------------------------
-template <>
-void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<vtkStdString>* iter, vtkIdType tupleIndex,
-  ostream& stream, vtkCSVWriter* writer, bool* first)
+// Integers, including chars, are written as decimal numbers.
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value>::type AppendNumber(
+  T value, std::string& buffer, const FormatOptions&)
 {
-  int numComps = iter->GetNumberOfComponents();
-  vtkIdType index = tupleIndex * numComps;
-  for (int cc = 0; cc < numComps; cc++)
+  using UnsignedT = typename std::make_unsigned<T>::type;
+  const bool negative = IsNegative(value, std::is_signed<T>());
+  UnsignedT magnitude = negative ? static_cast<UnsignedT>(0) - static_cast<UnsignedT>(value)
+                                 : static_cast<UnsignedT>(value);
+  char digits[24];
+  char* end = digits + sizeof(digits);
+  char* first = end;
+  do
   {
-    if (!(*first))
-    {
-      stream << writer->GetFieldDelimiter();
-    }
-    (*first) = false;
-    if ((index + cc) < iter->GetNumberOfValues())
-    {
-      stream << writer->GetString(iter->GetValue(index + cc));
-    }
+    *--first = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (negative)
+  {
+    *--first = '-';
   }
+  buffer.append(first, end);
 }
 
 //-----------------------------------------------------------------------------
-template <>
-void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<char>* iter, vtkIdType tupleIndex,
-  ostream& stream, vtkCSVWriter* writer, bool* first)
+// Floating point values are written as `std::ostream` does with the
+// precision and notation of the writer.
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type AppendNumber(
+  T value, std::string& buffer, const FormatOptions& options)
 {
-  int numComps = iter->GetNumberOfComponents();
-  vtkIdType index = tupleIndex * numComps;
-  for (int cc = 0; cc < numComps; cc++)
+  const char* format = options.UseScientificNotation ? "%.*e" : "%.*g";
+  char digits[64];
+  const int length = snprintf(
+    digits, sizeof(digits), format, options.Precision, static_cast<double>(value));
+  if (length < static_cast<int>(sizeof(digits)))
   {
-    if (!(*first))
-    {
-      stream << writer->GetFieldDelimiter();
-    }
-    (*first) = false;
-    if ((index + cc) < iter->GetNumberOfValues())
-    {
-      stream << static_cast<int>(iter->GetValue(index + cc));
-    }
+    buffer.append(digits, length);
+  }
+  else
+  {
+    std::vector<char> large(length + 1);
+    snprintf(large.data(), large.size(), format, options.Precision, static_cast<double>(value));
+    buffer.append(large.data(), length);
   }
 }
 
 //-----------------------------------------------------------------------------
-template <>
-void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<unsigned char>* iter, vtkIdType tupleIndex,
-  ostream& stream, vtkCSVWriter* writer, bool* first)
+// Formats the values of a column.
+class ColumnFormatter
 {
-  int numComps = iter->GetNumberOfComponents();
-  vtkIdType index = tupleIndex * numComps;
-  for (int cc = 0; cc < numComps; cc++)
+public:
+  ColumnFormatter(vtkAbstractArray* array, const FormatOptions& options)
+    : NumberOfTuples(array->GetNumberOfTuples())
+    , NumberOfComponents(array->GetNumberOfComponents())
+    , Options(options)
   {
-    if ((index + cc) < iter->GetNumberOfValues())
+  }
+  virtual ~ColumnFormatter() = default;
+
+  // Whether rows can be formatted by concurrent threads.
+  virtual bool IsThreadSafe() const { return true; }
+
+  // Appends each component of the tuple, preceded by the field delimiter
+  // except for the very first column of the row.
+  void Append(vtkIdType tuple, std::string& buffer, bool& first) const
+  {
+    for (int comp = 0; comp < this->NumberOfComponents; ++comp)
     {
-      if (*first == false)
+      if (!first)
       {
-        stream << writer->GetFieldDelimiter();
+        buffer += this->Options.FieldDelimiter;
       }
-      *first = false;
-      stream << static_cast<int>(iter->GetValue(index + cc));
-    }
-    else
-    {
-      if (*first == false)
+      first = false;
+      if (tuple < this->NumberOfTuples)
       {
-        stream << writer->GetFieldDelimiter();
+        this->AppendValue(tuple, comp, buffer);
       }
-      *first = false;
     }
   }
+
+protected:
+  virtual void AppendValue(vtkIdType tuple, int comp, std::string& buffer) const = 0;
+
+  const vtkIdType NumberOfTuples;
+  const int NumberOfComponents;
+  const FormatOptions& Options;
+};
+
+//-----------------------------------------------------------------------------
+template <typename ArrayT>
+class NumericFormatter : public ColumnFormatter
+{
+public:
+  NumericFormatter(ArrayT* array, const FormatOptions& options)
+    : ColumnFormatter(array, options)
+    , Array(array)
+  {
+  }
+
+protected:
+  void AppendValue(vtkIdType tuple, int comp, std::string& buffer) const override
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(this->Array);
+    AppendNumber(accessor.Get(tuple, comp), buffer, this->Options);
+  }
+
+  ArrayT* Array;
+};
+
+//-----------------------------------------------------------------------------
+class StringFormatter : public ColumnFormatter
+{
+public:
+  StringFormatter(vtkStringArray* array, const FormatOptions& options)
+    : ColumnFormatter(array, options)
+    , Array(array)
+  {
+  }
+
+protected:
+  void AppendValue(vtkIdType tuple, int comp, std::string& buffer) const override
+  {
+    buffer += this->Options.StringDelimiter;
+    buffer += this->Array->GetValue(tuple * this->NumberOfComponents + comp);
+    buffer += this->Options.StringDelimiter;
+  }
+
+  vtkStringArray* Array;
+};
+
+//-----------------------------------------------------------------------------
+// Any other array, such as vtkVariantArray, vtkBitArray or data arrays not
+// covered by vtkArrayDispatch, is formatted through vtkVariant.
+class VariantFormatter : public ColumnFormatter
+{
+public:
+  VariantFormatter(vtkAbstractArray* array, const FormatOptions& options)
+    : ColumnFormatter(array, options)
+    , Array(array)
+  {
+  }
+
+  // vtkDataArray::GetVariantValue may go through a shared tuple buffer.
+  bool IsThreadSafe() const override { return vtkDataArray::SafeDownCast(this->Array) == nullptr; }
+
+protected:
+  void AppendValue(vtkIdType tuple, int comp, std::string& buffer) const override
+  {
+    buffer += this->Array->GetVariantValue(tuple * this->NumberOfComponents + comp).ToString();
+  }
+
+  vtkAbstractArray* Array;
+};
+
+//-----------------------------------------------------------------------------
+struct CreateNumericFormatter
+{
+  std::unique_ptr<ColumnFormatter> Formatter;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array, const FormatOptions& options)
+  {
+    this->Formatter.reset(new NumericFormatter<ArrayT>(array, options));
+  }
+};
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<ColumnFormatter> CreateFormatter(
+  vtkAbstractArray* array, const FormatOptions& options)
+{
+  if (auto strings = vtkStringArray::SafeDownCast(array))
+  {
+    return std::unique_ptr<ColumnFormatter>(new StringFormatter(strings, options));
+  }
+  CreateNumericFormatter worker;
+  auto dataArray = vtkDataArray::SafeDownCast(array);
+  if (dataArray && vtkArrayDispatch::Dispatch::Execute(dataArray, worker, options))
+  {
+    return std::move(worker.Formatter);
+  }
+  return std::unique_ptr<ColumnFormatter>(new VariantFormatter(array, options));
+}
+
+//-----------------------------------------------------------------------------
+// Inserts the rank before the extension, e.g. `table.csv` becomes `table_3.csv`.
+std::string GetRankFileName(const std::string& filename, int rank)
+{
+  const std::string path = vtksys::SystemTools::GetFilenamePath(filename);
+  std::ostringstream name;
+  if (!path.empty())
+  {
+    name << path << "/";
+  }
+  name << vtksys::SystemTools::GetFilenameWithoutLastExtension(filename) << "_" << rank
+       << vtksys::SystemTools::GetFilenameLastExtension(filename);
+  return name.str();
 }
 
 } // end anonymous namespace
@@ -202,21 +342,53 @@ public:
   {
   }
 
-  int Open(const char* filename)
+  int Open(const char* filename, ios::openmode mode = ios::out)
+  {
+    if (!filename)
+    {
+      return vtkErrorCode::NoFileNameError;
+    }
+
+    this->Stream.open(filename, mode);
+    if (this->Stream.fail())
+    {
+      return vtkErrorCode::CannotOpenFileError;
+    }
+    return vtkErrorCode::NoError;
+  }
+
+  // Opens an existing file, without truncating it, to write at `offset`.
+  int OpenAt(const char* filename, vtkIdType offset)
   {
     if (!filename)
     {
       return vtkErrorCode::NoFileNameError;
     }
 
-    this->Stream.open(filename, ios::out);
+    this->Stream.open(filename, ios::in | ios::out | ios::binary);
     if (this->Stream.fail())
     {
       return vtkErrorCode::CannotOpenFileError;
     }
+    this->Stream.seekp(offset);
+    return this->Stream.fail() ? vtkErrorCode::FileFormatError : vtkErrorCode::NoError;
+  }
+
+  int Close()
+  {
+    if (this->Stream.is_open())
+    {
+      this->Stream.close();
+      if (this->Stream.fail())
+      {
+        return vtkErrorCode::OutOfDiskSpaceError;
+      }
+    }
     return vtkErrorCode::NoError;
   }
 
+  void Write(const std::string& text) { this->Stream.write(text.data(), text.size()); }
+
   void WriteHeader(vtkTable* table, vtkCSVWriter* self)
   {
     this->WriteHeader(table->GetRowData(), self);
@@ -224,11 +396,18 @@ public:
 
   void WriteHeader(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
   {
+    this->Write(this->FormatHeader(dsa, self));
+  }
+
+  // Returns the header and saves the order of the columns to write.
+  std::string FormatHeader(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
+  {
+    std::ostringstream header;
     bool add_delimiter = false;
     if (!vtkMath::IsNan(this->Time))
     {
       // add a time column.
-      this->Stream << "Time";
+      header << "Time";
       add_delimiter = true;
     }
     for (int cc = 0, numArrays = dsa->GetNumberOfArrays(); cc < numArrays; ++cc)
@@ -244,7 +423,7 @@ public:
         if (add_delimiter)
         {
           // add separator for all but the very first column
-          this->Stream << self->GetFieldDelimiter();
+          header << self->GetFieldDelimiter();
         }
         add_delimiter = true;
 
@@ -254,18 +433,11 @@ public:
         {
           array_name << ":" << comp;
         }
-        this->Stream << self->GetString(array_name.str());
+        header << self->GetString(array_name.str());
       }
     }
-    this->Stream << "\n";
-
-    // push the floating point precision/notation type.
-    if (self->GetUseScientificNotation())
-    {
-      this->Stream << std::scientific;
-    }
-
-    this->Stream << std::setprecision(self->GetPrecision());
+    header << "\n";
+    return header.str();
   }
 
   void WriteData(vtkTable* table, vtkCSVWriter* self)
@@ -275,7 +447,25 @@ public:
 
   void WriteData(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
   {
-    std::vector<vtkSmartPointer<vtkArrayIterator> > columnsIters;
+    this->FormatData(dsa, self, [this](std::string& chunk) { this->Write(chunk); });
+  }
+
+  // Formats the rows in chunks, formatted concurrently, and passes the
+  // formatted chunks to `consumer` in order. The rows are processed in
+  // batches of chunks to bound the memory used by the formatted text.
+  template <typename ConsumerT>
+  void FormatData(vtkDataSetAttributes* dsa, vtkCSVWriter* self, ConsumerT&& consumer)
+  {
+    FormatOptions options;
+    options.FieldDelimiter = self->GetFieldDelimiter() ? self->GetFieldDelimiter() : "";
+    options.StringDelimiter = self->GetUseStringDelimiter() && self->GetStringDelimiter()
+      ? self->GetStringDelimiter()
+      : "";
+    options.Precision = self->GetPrecision();
+    options.UseScientificNotation = self->GetUseScientificNotation();
+
+    std::vector<std::unique_ptr<ColumnFormatter> > formatters;
+    bool threadSafe = true;
     for (const auto& cinfo : this->ColumnInfo)
     {
       auto array = dsa->GetAbstractArray(cinfo.first.c_str());
@@ -283,31 +473,58 @@ public:
       {
         vtkErrorWithObjectMacro(self, "Mismatched components for '" << array->GetName() << "'!");
       }
-      vtkArrayIterator* iter = array->NewIterator();
-      columnsIters.push_back(iter);
-      iter->FastDelete();
+      formatters.push_back(CreateFormatter(array, options));
+      threadSafe = threadSafe && formatters.back()->IsThreadSafe();
     }
 
+    const bool addTime = !vtkMath::IsNan(this->Time);
+    std::string time;
+    AppendNumber(this->Time, time, options);
+
+    const vtkIdType chunkSize = 4096;
+    const vtkIdType chunksPerBatch = 256;
     const auto num_tuples = dsa->GetNumberOfTuples();
-    for (vtkIdType cc = 0; cc < num_tuples; ++cc)
+    const vtkIdType numChunks = (num_tuples + chunkSize - 1) / chunkSize;
+    std::vector<std::string> chunks(std::min(chunksPerBatch, numChunks));
+    for (vtkIdType batch = 0; batch < numChunks; batch += chunksPerBatch)
     {
-      bool first_column = true;
-      if (!vtkMath::IsNan(this->Time))
+      const vtkIdType numBatchChunks = std::min(chunksPerBatch, numChunks - batch);
+      auto format = [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType chunk = begin; chunk < end; ++chunk)
+        {
+          std::string& buffer = chunks[chunk];
+          buffer.clear();
+          const vtkIdType firstRow = (batch + chunk) * chunkSize;
+          const vtkIdType lastRow = std::min(firstRow + chunkSize, num_tuples);
+          for (vtkIdType cc = firstRow; cc < lastRow; ++cc)
+          {
+            bool first_column = true;
+            if (addTime)
+            {
+              // add a time column.
+              buffer += time;
+              first_column = false;
+            }
+            for (const auto& formatter : formatters)
+            {
+              formatter->Append(cc, buffer, first_column);
+            }
+            buffer += "\n";
+          }
+        }
+      };
+      if (threadSafe)
       {
-        // add a time column.
-        this->Stream << this->Time;
-        first_column = false;
+        vtkSMPTools::For(0, numBatchChunks, 1, format);
       }
-
-      for (auto& iter : columnsIters)
+      else
       {
-        switch (iter->GetDataType())
-        {
-          vtkArrayIteratorTemplateMacro(vtkCSVWriterGetDataString(
-            static_cast<VTK_TT*>(iter.GetPointer()), cc, this->Stream, self, &first_column));
-        }
+        format(0, numBatchChunks);
+      }
+      for (vtkIdType chunk = 0; chunk < numBatchChunks; ++chunk)
+      {
+        consumer(chunks[chunk]);
       }
-      this->Stream << "\n";
     }
   }
 
@@ -375,6 +592,24 @@ void vtkCSVWriter::WriteData()
 
   const int myRank = controller->GetLocalProcessId();
   const int numRanks = controller->GetNumberOfProcesses();
+  if (this->ParallelWriteMode == vtkCSVWriter::FILE_PER_RANK)
+  {
+    vtkCSVWriter::CSVFile file(time);
+    int error_code = vtkErrorCode::NoFileNameError;
+    if (this->FileName)
+    {
+      error_code = file.Open(GetRankFileName(this->FileName, myRank).c_str());
+    }
+    if (error_code == vtkErrorCode::NoError)
+    {
+      file.WriteHeader(table, this);
+      file.WriteData(table, this);
+      error_code = file.Close();
+    }
+    this->SetErrorCode(error_code);
+    return;
+  }
+
   if (myRank > 0)
   {
     int error_code{ vtkErrorCode::NoError };
@@ -403,6 +638,15 @@ void vtkCSVWriter::WriteData()
     // BARRIER
     controller->Barrier();
 
+    if (this->ParallelWriteMode == vtkCSVWriter::SHARED_FILE)
+    {
+      vtkNew<vtkTable> header;
+      controller->Broadcast(header, 0);
+      vtkCSVWriter::CSVFile file(time);
+      this->SetErrorCode(this->WriteToSharedFile(file, header, table));
+      return;
+    }
+
     if (row_count > 0)
     {
       controller->Send(table, 0, 88021);
@@ -413,7 +657,10 @@ void vtkCSVWriter::WriteData()
   else
   {
     vtkCSVWriter::CSVFile file(time);
-    int error_code = file.Open(this->FileName);
+    // offsets in the shared file are counted in bytes, without newline
+    // translation.
+    int error_code = file.Open(this->FileName,
+      this->ParallelWriteMode == vtkCSVWriter::SHARED_FILE ? ios::out | ios::binary : ios::out);
     controller->Broadcast(&error_code, 1, 0);
     if (error_code != vtkErrorCode::NoError)
     {
@@ -448,10 +695,18 @@ void vtkCSVWriter::WriteData()
     controller->Barrier();
 
     // now write the real data.
-    vtkNew<vtkDataSetAttributes> tmp;
+    vtkNew<vtkTable> header;
+    auto tmp = header->GetRowData();
     tmp->CopyAllOn();
     columns.CopyAllocate(tmp, vtkDataSetAttributes::PASSDATA, /*sz=*/1, 0);
 
+    if (this->ParallelWriteMode == vtkCSVWriter::SHARED_FILE)
+    {
+      controller->Broadcast(header, 0);
+      this->SetErrorCode(this->WriteToSharedFile(file, header, table));
+      return;
+    }
+
     // first write headers.
     file.WriteHeader(tmp, this);
 
@@ -479,6 +734,54 @@ void vtkCSVWriter::WriteData()
   }
 }
 
+//-----------------------------------------------------------------------------
+int vtkCSVWriter::WriteToSharedFile(CSVFile& file, vtkTable* header, vtkTable* table)
+{
+  auto controller = this->Controller;
+  const int myRank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  // format the local rows first, to know where they go in the file.
+  const std::string headerText = file.FormatHeader(header->GetRowData(), this);
+  std::vector<std::string> chunks;
+  vtkIdType size = 0;
+  if (table->GetNumberOfRows() > 0)
+  {
+    file.FormatData(table->GetRowData(), this, [&](std::string& chunk) {
+      size += static_cast<vtkIdType>(chunk.size());
+      chunks.push_back(std::move(chunk));
+    });
+  }
+
+  std::vector<vtkIdType> sizes(numRanks, 0);
+  controller->AllGather(&size, &sizes[0], 1);
+  const vtkIdType offset = std::accumulate(
+    sizes.begin(), sizes.begin() + myRank, static_cast<vtkIdType>(headerText.size()));
+
+  // the root already has the file open at its beginning.
+  int error_code = vtkErrorCode::NoError;
+  if (myRank == 0)
+  {
+    file.Write(headerText);
+  }
+  else
+  {
+    error_code = file.OpenAt(this->FileName, offset);
+  }
+  if (error_code == vtkErrorCode::NoError)
+  {
+    for (const auto& chunk : chunks)
+    {
+      file.Write(chunk);
+    }
+    error_code = file.Close();
+  }
+
+  int global_error_code = vtkErrorCode::NoError;
+  controller->AllReduce(&error_code, &global_error_code, 1, vtkCommunicator::MAX_OP);
+  return global_error_code;
+}
+
 //-----------------------------------------------------------------------------
 void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -493,6 +796,7 @@ void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Precision: " << this->Precision << endl;
   os << indent << "FieldAssociation: " << this->FieldAssociation << endl;
   os << indent << "AddMetaData: " << this->AddMetaData << endl;
+  os << indent << "ParallelWriteMode: " << this->ParallelWriteMode << endl;
   if (this->Controller)
   {
     os << indent << "Controller: " << this->Controller << endl;
@@ -131,6 +131,28 @@ public:
   vtkBooleanMacro(AddTime, bool);
   //@}
 
+  enum ParallelWriteModes
+  {
+    GATHER_TO_ROOT = 0,
+    FILE_PER_RANK,
+    SHARED_FILE
+  };
+
+  //@{
+  /**
+   * Get/Set how the rows of multiple ranks are written. GATHER_TO_ROOT, the
+   * default, sends the rows to the root rank which writes them all to
+   * FileName. FILE_PER_RANK has each rank write its rows to its own file,
+   * named by inserting `_<rank>` before the extension of FileName, e.g.
+   * `table_3.csv`. SHARED_FILE has each rank write its rows at its own offset
+   * in FileName, which must then be accessible to all ranks. The last two
+   * modes do not move rows between ranks. This is ignored when running on a
+   * single rank.
+   */
+  vtkSetClampMacro(ParallelWriteMode, int, GATHER_TO_ROOT, SHARED_FILE);
+  vtkGetMacro(ParallelWriteMode, int);
+  //@}
+
   //@{
   /**
    * Internal method: decorates the "string" with the "StringDelimiter" if
@@ -162,6 +184,7 @@ protected:
   int FieldAssociation;
   bool AddMetaData;
   bool AddTime;
+  int ParallelWriteMode;
 
   vtkMultiProcessController* Controller;
 
@@ -170,6 +193,10 @@ private:
   void operator=(const vtkCSVWriter&) = delete;
 
   class CSVFile;
+
+  // Writes the rows of all ranks to FileName, each at its own offset, and
+  // returns the error code of all ranks.
+  int WriteToSharedFile(CSVFile& file, vtkTable* header, vtkTable* table);
 };
 
 #endif
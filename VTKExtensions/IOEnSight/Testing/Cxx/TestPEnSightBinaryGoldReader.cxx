@@ -1,15 +1,76 @@
 #include "vtkCellTypes.h"
+#include "vtkDataArray.h"
+#include "vtkMPIController.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
 #include "vtkPGenericEnSightReader.h"
+#include "vtkPointData.h"
 #include "vtkTestUtilities.h"
 #include "vtkUnstructuredGrid.h"
 
-int TestPEnSightBinaryGoldReader(int argc, char* argv[])
+namespace
 {
-  char* fname =
-    vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/EnSight/TEST_bin.case");
+// Checks that the memory-mapped read gives the same points, cells and point
+// data as the streamed one.
+bool Compare(vtkUnstructuredGrid* ug, vtkUnstructuredGrid* mappedUG)
+{
+  if (!ug || !mappedUG || mappedUG->GetNumberOfPoints() != ug->GetNumberOfPoints() ||
+    mappedUG->GetNumberOfCells() != ug->GetNumberOfCells() ||
+    mappedUG->GetPointData()->GetNumberOfArrays() != ug->GetPointData()->GetNumberOfArrays())
+  {
+    std::cerr << "Memory-mapped read does not match." << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < ug->GetNumberOfPoints(); i++)
+  {
+    double p1[3], p2[3];
+    ug->GetPoint(i, p1);
+    mappedUG->GetPoint(i, p2);
+    if (p1[0] != p2[0] || p1[1] != p2[1] || p1[2] != p2[2])
+    {
+      std::cerr << "Memory-mapped points do not match." << std::endl;
+      return false;
+    }
+  }
+  for (vtkIdType i = 0; i < ug->GetNumberOfCells(); i++)
+  {
+    if (ug->GetCellType(i) != mappedUG->GetCellType(i))
+    {
+      std::cerr << "Memory-mapped cells do not match." << std::endl;
+      return false;
+    }
+  }
+  for (int a = 0; a < ug->GetPointData()->GetNumberOfArrays(); a++)
+  {
+    vtkDataArray* array = ug->GetPointData()->GetArray(a);
+    if (!array || !array->GetName())
+    {
+      continue;
+    }
+    vtkDataArray* mappedArray = mappedUG->GetPointData()->GetArray(array->GetName());
+    if (!mappedArray || mappedArray->GetNumberOfComponents() != array->GetNumberOfComponents())
+    {
+      std::cerr << "Memory-mapped point data does not match." << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < array->GetNumberOfTuples(); i++)
+    {
+      for (int c = 0; c < array->GetNumberOfComponents(); c++)
+      {
+        if (array->GetComponent(i, c) != mappedArray->GetComponent(i, c))
+        {
+          std::cerr << "Memory-mapped point data does not match." << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
 
+// Checks the cell types read by a single process.
+bool CheckCellTypes(const char* fname)
+{
   vtkNew<vtkPGenericEnSightReader> reader;
   reader->SetCaseFileName(fname);
   reader->Update();
@@ -23,7 +84,7 @@ int TestPEnSightBinaryGoldReader(int argc, char* argv[])
   if (nbOfTypes != 2)
   {
     std::cerr << "Wrong number of cell types. Expects 2 ( has " << nbOfTypes << ")." << std::endl;
-    return EXIT_FAILURE;
+    return false;
   }
 
   for (vtkIdType i = 0; i < nbOfTypes; i++)
@@ -39,9 +100,51 @@ int TestPEnSightBinaryGoldReader(int argc, char* argv[])
       default:
         std::cerr << "Unexpected cell type (" << vtkCellTypes::GetClassNameFromTypeId(type) << ")."
                   << std::endl;
-        return EXIT_FAILURE;
+        return false;
     }
   }
+  return true;
+}
+
+// Checks that, with each rank reading its share of the file, memory-mapped
+// reads match streamed ones.
+bool CheckMemoryMapping(const char* fname, vtkMultiProcessController* controller)
+{
+  if (controller->GetNumberOfProcesses() < 2)
+  {
+    std::cerr << "The parallel reader needs at least 2 processes." << std::endl;
+    return false;
+  }
+  vtkNew<vtkPGenericEnSightReader> reader;
+  reader->SetCaseFileName(fname);
+  reader->Update();
+  vtkNew<vtkPGenericEnSightReader> mappedReader;
+  mappedReader->SetCaseFileName(fname);
+  mappedReader->UseMemoryMappingOn();
+  mappedReader->Update();
+  return Compare(vtkUnstructuredGrid::SafeDownCast(reader->GetOutput()->GetBlock(0)),
+    vtkUnstructuredGrid::SafeDownCast(mappedReader->GetOutput()->GetBlock(0)));
+}
+}
+
+int TestPEnSightBinaryGoldReader(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+
+  char* fname =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/EnSight/TEST_bin.case");
+
+  // without a global controller the reader takes the serial path.
+  int success = CheckCellTypes(fname) ? 1 : 0;
+  vtkMultiProcessController::SetGlobalController(controller);
+  success = CheckMemoryMapping(fname, controller) ? success : 0;
+  delete[] fname;
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::MIN_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
 
-  return EXIT_SUCCESS;
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -18,11 +18,150 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <ctype.h>
+#include <istream>
+#include <streambuf>
 #include <string>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 
+namespace
+{
+//----------------------------------------------------------------------------
+// A stream buffer over a read-only memory mapping of a whole file.
+// Seeking only moves the get pointer and reading copies straight from the
+// mapped pages.
+class vtkPEnSightMappedBuffer : public std::streambuf
+{
+public:
+  vtkPEnSightMappedBuffer(char* data, size_t size)
+    : Data(data)
+    , Size(size)
+  {
+    this->setg(data, data, data + size);
+  }
+
+  ~vtkPEnSightMappedBuffer() override
+  {
+#if !defined(_WIN32)
+    munmap(this->Data, this->Size);
+#endif
+  }
+
+  char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+  {
+    if ((which & std::ios_base::in) == 0)
+    {
+      return pos_type(off_type(-1));
+    }
+    off_type position = off;
+    if (dir == std::ios_base::cur)
+    {
+      position += this->gptr() - this->eback();
+    }
+    else if (dir == std::ios_base::end)
+    {
+      position += static_cast<off_type>(this->Size);
+    }
+    if (position < 0 || position > static_cast<off_type>(this->Size))
+    {
+      return pos_type(off_type(-1));
+    }
+    this->setg(this->eback(), this->eback() + position, this->egptr());
+    return pos_type(position);
+  }
+
+  pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+  {
+    return this->seekoff(off_type(position), std::ios_base::beg, which);
+  }
+
+  std::streamsize xsgetn(char* result, std::streamsize count) override
+  {
+    count = std::min(count, static_cast<std::streamsize>(this->egptr() - this->gptr()));
+    memcpy(result, this->gptr(), static_cast<size_t>(count));
+    this->setg(this->eback(), this->gptr() + count, this->egptr());
+    return count;
+  }
+
+private:
+  char* Data;
+  size_t Size;
+};
+
+//----------------------------------------------------------------------------
+class vtkPEnSightMappedStream : public std::istream
+{
+public:
+  // Returns nullptr if the file cannot be mapped.
+  static vtkPEnSightMappedStream* Open(const char* filename, size_t size)
+  {
+#if defined(_WIN32)
+    (void)filename;
+    (void)size;
+    return nullptr;
+#else
+    if (size == 0)
+    {
+      return nullptr;
+    }
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+      return nullptr;
+    }
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+      return nullptr;
+    }
+    return new vtkPEnSightMappedStream(static_cast<char*>(data), size);
+#endif
+  }
+
+  // Returns a pointer to `count` floats at `position` in the file, or nullptr
+  // if they are out of the file or not aligned.
+  float* GetFloats(vtkTypeInt64 position, vtkIdType count) const
+  {
+    if (position < 0 || count < 0 ||
+      static_cast<size_t>(position) + count * sizeof(float) > this->Buffer.GetSize())
+    {
+      return nullptr;
+    }
+    char* data = this->Buffer.GetData() + position;
+    if (reinterpret_cast<std::uintptr_t>(data) % alignof(float) != 0)
+    {
+      return nullptr;
+    }
+    return reinterpret_cast<float*>(data);
+  }
+
+private:
+  vtkPEnSightMappedStream(char* data, size_t size)
+    : std::istream(nullptr)
+    , Buffer(data, size)
+  {
+    this->rdbuf(&this->Buffer);
+  }
+
+  vtkPEnSightMappedBuffer Buffer;
+};
+}
+
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
@@ -77,11 +216,18 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
 
+    if (this->UseMemoryMapping)
+    {
+      this->IFile = vtkPEnSightMappedStream::Open(filename, static_cast<size_t>(fs.st_size));
+    }
+    if (!this->IFile)
+    {
 #ifdef _WIN32
-    this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
+      this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
 #else
-    this->IFile = new vtksys::ifstream(filename, ios::in);
+      this->IFile = new vtksys::ifstream(filename, ios::in);
 #endif
+    }
   }
   else
   {
@@ -1389,8 +1535,14 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       scalars = vtkFloatArray::New();
       scalars->SetNumberOfComponents(numberOfComponents);
       scalars->SetNumberOfTuples(this->GetPointIds(partId)->GetLocalNumberOfIds());
-      scalarsRead = new float[numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
+      float* scalarsBuffer = nullptr;
+      scalarsRead = this->ReadMappedFloatArray(numPts);
+      if (!scalarsRead)
+      {
+        scalarsBuffer = new float[numPts];
+        this->ReadFloatArray(scalarsBuffer, numPts);
+        scalarsRead = scalarsBuffer;
+      }
       // Why are we setting only one component here?
       // Only one component is set because scalars are single-component arrays.
       // For complex scalars, there is a file for the real part and another
@@ -1408,7 +1560,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
         output->GetPointData()->SetScalars(scalars);
       }
       scalars->Delete();
-      delete[] scalarsRead;
+      delete[] scalarsBuffer;
     }
 
     delete this->IFile;
@@ -1441,8 +1593,14 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
         scalars = (vtkFloatArray*)(output->GetPointData()->GetArray(description));
       }
 
-      scalarsRead = new float[numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
+      float* scalarsBuffer = nullptr;
+      scalarsRead = this->ReadMappedFloatArray(numPts);
+      if (!scalarsRead)
+      {
+        scalarsBuffer = new float[numPts];
+        this->ReadFloatArray(scalarsBuffer, numPts);
+        scalarsRead = scalarsBuffer;
+      }
 
       for (i = 0; i < numPts; i++)
       {
@@ -1463,7 +1621,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       {
         output->GetPointData()->AddArray(scalars);
       }
-      delete[] scalarsRead;
+      delete[] scalarsBuffer;
     }
 
     this->IFile->peek();
@@ -1647,12 +1805,21 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       this->ReadLine(line); // "coordinates" or "block"
       vectors->SetNumberOfComponents(3);
       vectors->SetNumberOfTuples(this->GetPointIds(realId)->GetLocalNumberOfIds());
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
+      float* comps[3];
+      float* compBuffers[3] = { nullptr, nullptr, nullptr };
+      for (int comp = 0; comp < 3; ++comp)
+      {
+        comps[comp] = this->ReadMappedFloatArray(numPts);
+        if (!comps[comp])
+        {
+          compBuffers[comp] = new float[numPts];
+          this->ReadFloatArray(compBuffers[comp], numPts);
+          comps[comp] = compBuffers[comp];
+        }
+      }
+      comp1 = comps[0];
+      comp2 = comps[1];
+      comp3 = comps[2];
       for (i = 0; i < numPts; i++)
       {
         tuple[0] = comp1[i];
@@ -1667,9 +1834,9 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
         output->GetPointData()->SetVectors(vectors);
       }
       vectors->Delete();
-      delete[] comp1;
-      delete[] comp2;
-      delete[] comp3;
+      delete[] compBuffers[0];
+      delete[] compBuffers[1];
+      delete[] compBuffers[2];
     }
 
     this->IFile->peek();
@@ -4295,6 +4462,43 @@ int vtkPEnSightGoldBinaryReader::ReadFloatArray(float* result, int numFloats)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+float* vtkPEnSightGoldBinaryReader::GetMappedFloatArray(vtkTypeInt64 position, vtkIdType numFloats)
+{
+  vtkPEnSightMappedStream* stream = dynamic_cast<vtkPEnSightMappedStream*>(this->IFile);
+  if (!stream || numFloats <= 0)
+  {
+    return nullptr;
+  }
+#ifdef VTK_WORDS_BIGENDIAN
+  if (this->ByteOrder == FILE_LITTLE_ENDIAN)
+#else
+  if (this->ByteOrder != FILE_LITTLE_ENDIAN)
+#endif
+  {
+    return nullptr;
+  }
+  return stream->GetFloats(position, numFloats);
+}
+
+//----------------------------------------------------------------------------
+float* vtkPEnSightGoldBinaryReader::ReadMappedFloatArray(int numFloats)
+{
+  const vtkTypeInt64 begin = static_cast<vtkTypeInt64>(this->IFile->tellg());
+  if (begin < 0)
+  {
+    return nullptr;
+  }
+  const vtkTypeInt64 position = begin + (this->Fortran ? 4 : 0);
+  float* result = this->GetMappedFloatArray(position, numFloats);
+  if (result)
+  {
+    this->IFile->seekg(position + numFloats * (vtkTypeInt64)sizeof(float) + (this->Fortran ? 4 : 0),
+      ios::beg);
+  }
+  return result;
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
   vtkPoints* points, long offset, int partId, bool skip)
@@ -4325,10 +4529,11 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
 
   long currentPositionInFile = this->IFile->tellg();
 
+  // The buffer is filled on first use by GetVectorFromFloatBuffer(), so
+  // nothing is read through it when the coordinates are memory-mapped.
   this->FloatBufferFilePosition = currentPositionInFile;
-  this->FloatBufferIndexBegin = 0;
+  this->FloatBufferIndexBegin = -1;
   this->FloatBufferNumberOfVectors = numPts;
-  this->UpdateFloatBuffer();
 
   // Position to reach at the end of this method
   long endFilePosition = currentPositionInFile + 3 * numPts * (long)sizeof(float);
@@ -4361,6 +4566,18 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
     }
     else
     {
+      // With memory mapping, coordinates are read in place.
+      float* mappedCoordinates[3];
+      bool mapped = true;
+      for (int comp = 0; comp < 3; ++comp)
+      {
+        vtkTypeInt64 position = this->Fortran
+          ? currentPositionInFile + 4 + comp * (numPts * (vtkTypeInt64)sizeof(float) + 8)
+          : currentPositionInFile + comp * numPts * (vtkTypeInt64)sizeof(float);
+        mappedCoordinates[comp] = this->GetMappedFloatArray(position, numPts);
+        mapped = mapped && mappedCoordinates[comp] != nullptr;
+      }
+
       // Inject really needed points
       vtkIdType i;
       int localNumberOfIds = this->GetPointIds(partId)->GetLocalNumberOfIds();
@@ -4378,7 +4595,16 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
             minId = id;
           if ((maxId == -1) || (maxId < id))
             maxId = id;
-          this->GetVectorFromFloatBuffer(i, vec);
+          if (mapped)
+          {
+            vec[0] = mappedCoordinates[0][i];
+            vec[1] = mappedCoordinates[1][i];
+            vec[2] = mappedCoordinates[2][i];
+          }
+          else
+          {
+            this->GetVectorFromFloatBuffer(i, vec);
+          }
           points->SetPoint(id, vec[0], vec[1], vec[2]);
         }
       }
@@ -170,6 +170,17 @@ protected:
    */
   int ReadFloatArray(float* result, int numFloats);
 
+  //@{
+  /**
+   * When the file is memory-mapped and its byte order is native, returns a
+   * pointer to the mapped floats, otherwise nullptr. GetMappedFloatArray()
+   * looks up `numFloats` floats at `position` in the file. ReadMappedFloatArray()
+   * is a replacement for ReadFloatArray() that moves past the floats read.
+   */
+  float* GetMappedFloatArray(vtkTypeInt64 position, vtkIdType numFloats);
+  float* ReadMappedFloatArray(int numFloats);
+  //@}
+
   /**
    * Read Coordinates, or just skip the part in the file.
    */
@@ -0,0 +1,236 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSpyPlotReaderBenchmark.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads a SpyPlot file with fresh readers, compares the decoded cell arrays
+// against a read that decodes on a single thread and reports the read time.
+// Also checks that volume fractions down converted to unsigned char match the
+// float ones. Use `--iterations=<N>` to average over more reads.
+
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDummyController.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpyPlotReader.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+#include <vtksys/RegularExpression.hxx>
+
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+vtkSmartPointer<vtkCompositeDataSet> Read(const std::string& fname, int downConvert)
+{
+  vtkNew<vtkSpyPlotReader> reader;
+  reader->SetFileName(fname.c_str());
+  reader->SetDownConvertVolumeFraction(downConvert);
+  reader->UpdateInformation();
+  for (int cc = 0; cc < reader->GetNumberOfCellArrays(); ++cc)
+  {
+    reader->SetCellArrayStatus(reader->GetCellArrayName(cc), 1);
+  }
+  reader->Update();
+  return vtkCompositeDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+}
+
+// Decodes the planes one after the other, on a single thread.
+vtkSmartPointer<vtkCompositeDataSet> ReadSerial(const std::string& fname, int downConvert)
+{
+  vtkSMPTools::Initialize(1);
+  auto output = Read(fname, downConvert);
+  vtkSMPTools::Initialize();
+  return output;
+}
+
+bool Compare(vtkCompositeDataSet* expected, vtkCompositeDataSet* actual, vtkIdType& numCells)
+{
+  numCells = 0;
+  vtkSmartPointer<vtkCompositeDataIterator> expectedIter;
+  vtkSmartPointer<vtkCompositeDataIterator> actualIter;
+  expectedIter.TakeReference(expected->NewIterator());
+  actualIter.TakeReference(actual->NewIterator());
+  for (expectedIter->InitTraversal(), actualIter->InitTraversal();
+       !expectedIter->IsDoneWithTraversal();
+       expectedIter->GoToNextItem(), actualIter->GoToNextItem())
+  {
+    if (actualIter->IsDoneWithTraversal())
+    {
+      cerr << "Mismatched number of blocks." << endl;
+      return false;
+    }
+    vtkDataSet* a = vtkDataSet::SafeDownCast(expectedIter->GetCurrentDataObject());
+    vtkDataSet* b = vtkDataSet::SafeDownCast(actualIter->GetCurrentDataObject());
+    if (a == nullptr || b == nullptr || a->GetNumberOfCells() != b->GetNumberOfCells() ||
+      a->GetCellData()->GetNumberOfArrays() != b->GetCellData()->GetNumberOfArrays())
+    {
+      cerr << "Mismatched block." << endl;
+      return false;
+    }
+    numCells += a->GetNumberOfCells();
+    for (int cc = 0; cc < a->GetCellData()->GetNumberOfArrays(); ++cc)
+    {
+      vtkDataArray* aa = a->GetCellData()->GetArray(cc);
+      vtkDataArray* ba = b->GetCellData()->GetArray(aa->GetName());
+      if (ba == nullptr || aa->GetNumberOfTuples() != a->GetNumberOfCells() ||
+        ba->GetNumberOfValues() != aa->GetNumberOfValues())
+      {
+        cerr << "Mismatched array: " << aa->GetName() << endl;
+        return false;
+      }
+      for (vtkIdType id = 0, max = aa->GetNumberOfValues(); id < max; ++id)
+      {
+        if (aa->GetVariantValue(id) != ba->GetVariantValue(id))
+        {
+          cerr << "Mismatched values in array: " << aa->GetName() << endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Volume fractions are down converted to unsigned char as fraction * 255.
+bool CompareVolumeFractions(vtkCompositeDataSet* floats, vtkCompositeDataSet* unsignedChars)
+{
+  vtksys::RegularExpression re("[vV]olume [fF]raction");
+  int numberOfVolumeFractions = 0;
+  vtkSmartPointer<vtkCompositeDataIterator> floatIter;
+  vtkSmartPointer<vtkCompositeDataIterator> unsignedCharIter;
+  floatIter.TakeReference(floats->NewIterator());
+  unsignedCharIter.TakeReference(unsignedChars->NewIterator());
+  for (floatIter->InitTraversal(), unsignedCharIter->InitTraversal();
+       !floatIter->IsDoneWithTraversal() && !unsignedCharIter->IsDoneWithTraversal();
+       floatIter->GoToNextItem(), unsignedCharIter->GoToNextItem())
+  {
+    vtkDataSet* floatBlock = vtkDataSet::SafeDownCast(floatIter->GetCurrentDataObject());
+    vtkDataSet* unsignedCharBlock =
+      vtkDataSet::SafeDownCast(unsignedCharIter->GetCurrentDataObject());
+    if (floatBlock == nullptr || unsignedCharBlock == nullptr)
+    {
+      cerr << "Mismatched block." << endl;
+      return false;
+    }
+    vtkCellData* a = floatBlock->GetCellData();
+    vtkCellData* b = unsignedCharBlock->GetCellData();
+    for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+    {
+      vtkDataArray* aa = a->GetArray(cc);
+      if (!re.find(aa->GetName()))
+      {
+        continue;
+      }
+      ++numberOfVolumeFractions;
+      vtkDataArray* ba = b->GetArray(aa->GetName());
+      if (aa->GetDataType() != VTK_FLOAT || ba == nullptr ||
+        ba->GetDataType() != VTK_UNSIGNED_CHAR ||
+        ba->GetNumberOfValues() != aa->GetNumberOfValues())
+      {
+        cerr << "Mismatched volume fraction array: " << aa->GetName() << endl;
+        return false;
+      }
+      for (vtkIdType id = 0, max = aa->GetNumberOfValues(); id < max; ++id)
+      {
+        const float fraction = static_cast<float>(aa->GetComponent(id, 0));
+        if (static_cast<unsigned char>(fraction * 255) != ba->GetComponent(id, 0))
+        {
+          cerr << "Mismatched volume fraction in array: " << aa->GetName() << endl;
+          return false;
+        }
+      }
+    }
+  }
+  if (numberOfVolumeFractions == 0)
+  {
+    cerr << "No volume fractions were read." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestSpyPlotReaderBenchmark(int argc, char* argv[])
+{
+  int iterations = 1;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument(
+    "--iterations", argT::EQUAL_ARGUMENT, &iterations, "Number of iterations to average over.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse() || iterations < 1)
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  char* fname =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/SPCTH/ball_and_box.spcth");
+  const std::string filename = fname;
+  delete[] fname;
+
+  bool success = true;
+  vtkSmartPointer<vtkCompositeDataSet> references[2];
+  for (int downConvert = 0; downConvert < 2 && success; ++downConvert)
+  {
+    auto reference = references[downConvert] = ReadSerial(filename, downConvert);
+    if (reference == nullptr)
+    {
+      cerr << "Missing output." << endl;
+      success = false;
+      break;
+    }
+
+    vtkNew<vtkTimerLog> timer;
+    double elapsed = 0.0;
+    vtkIdType numCells = 0;
+    for (int cc = 0; cc < iterations && success; ++cc)
+    {
+      timer->StartTimer();
+      auto output = Read(filename, downConvert);
+      timer->StopTimer();
+      elapsed += timer->GetElapsedTime();
+      success = output != nullptr && Compare(reference, output, numCells);
+    }
+    if (success && numCells == 0)
+    {
+      cerr << "No cells were read." << endl;
+      success = false;
+    }
+    if (success)
+    {
+      cout << "DownConvertVolumeFraction " << downConvert << ": " << numCells << " cells read in "
+           << (elapsed / iterations) << " s" << endl;
+    }
+  }
+  success = success && CompareVolumeFractions(references[0], references[1]);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? TEST_SUCCESS : TEST_FAILED;
+}
@@ -5,6 +5,7 @@
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
@@ -12,7 +13,13 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/RegularExpression.hxx"
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
 #include <sstream>
+#include <string>
+#include <system_error>
 #include <vector>
 
 //=============================================================================
@@ -41,6 +48,81 @@ inline ostream& operator<<(ostream& os, const vtkSpyPlotWriteString& c)
   return os;
 }
 
+// Returns 0 and describes the problem in error on failure. Doesn't report it
+// since it also runs on worker threads.
+template <class t>
+int vtkSpyPlotUniReaderRunLengthDataDecode(
+  const unsigned char* in, int inSize, t* out, int outSize, std::string& error, t scale = 1);
+
+namespace
+{
+// Compressed planes of a variable for all the allocated blocks, read from the
+// file in a single pass.
+struct vtkSpyPlotCompressedVariable
+{
+  std::vector<unsigned char> Bytes;
+  // Offsets of the planes in Bytes, followed by the number of bytes read.
+  std::vector<size_t> PlaneOffsets;
+  // Set when reading fails, reported by the thread that waits for the read.
+  std::string Error;
+};
+
+// Where a compressed plane is decoded to; nullptr for variables that are read
+// but not loaded.
+struct vtkSpyPlotDecodedPlane
+{
+  float* Float;
+  unsigned char* UnsignedChar;
+  int Size;
+};
+
+int vtkSpyPlotReadCompressedVariable(vtkSpyPlotIStream* spis, vtkTypeInt64 offset,
+  int numberOfPlanes, vtkSpyPlotCompressedVariable* variable)
+{
+  spis->Seek(offset);
+  variable->PlaneOffsets.resize(numberOfPlanes + 1);
+  size_t size = 0;
+  for (int plane = 0; plane < numberOfPlanes; ++plane)
+  {
+    int numBytes;
+    if (!spis->ReadInt32s(&numBytes, 1) || numBytes < 0)
+    {
+      variable->Error = "Problem reading the number of bytes";
+      return 0;
+    }
+    variable->PlaneOffsets[plane] = size;
+    if (variable->Bytes.size() < size + numBytes)
+    {
+      variable->Bytes.resize(std::max(size + numBytes, 2 * variable->Bytes.size()));
+    }
+    if (numBytes > 0 && !spis->ReadString(&variable->Bytes[size], numBytes))
+    {
+      variable->Error = "Problem reading the bytes";
+      return 0;
+    }
+    size += numBytes;
+  }
+  variable->PlaneOffsets[numberOfPlanes] = size;
+  return 1;
+}
+
+// Reads the compressed planes of a variable, on a separate thread if possible.
+std::future<int> vtkSpyPlotReadCompressedVariableAsync(vtkSpyPlotIStream* spis,
+  vtkTypeInt64 offset, int numberOfPlanes, vtkSpyPlotCompressedVariable* variable)
+{
+  try
+  {
+    return std::async(std::launch::async, vtkSpyPlotReadCompressedVariable, spis, offset,
+      numberOfPlanes, variable);
+  }
+  catch (const std::system_error&)
+  {
+    return std::async(std::launch::deferred, vtkSpyPlotReadCompressedVariable, spis, offset,
+      numberOfPlanes, variable);
+  }
+}
+}
+
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 {
@@ -328,6 +410,7 @@ int vtkSpyPlotUniReader::MakeCurrent()
   dump = this->CurrentTimeStep;
   dp = this->DataDumps + dump;
 
+  std::vector<int> variablesToRead;
   for (int fieldCnt = 0; fieldCnt < dp->NumVars; ++fieldCnt)
   {
     vtkSpyPlotUniReader::Variable* var = dp->Variables + fieldCnt;
@@ -386,89 +469,133 @@ int vtkSpyPlotUniReader::MakeCurrent()
       continue;
     }
 
-    // vtkDebugMacro( "  Field: " << fieldCnt << " / " << dp->NumVars
-    // << " [" << var->Name << "]" );
-    // vtkDebugMacro( "    Jump to: " << dp->SavedVariableOffsets[fieldCnt] );
-    spis.Seek(dp->SavedVariableOffsets[fieldCnt]);
-    int numBytes;
-    int block;
+    variablesToRead.push_back(fieldCnt);
+  }
+
+  // The compressed planes of all the blocks of a variable are read in a single
+  // pass, ahead of time on a separate thread, while the planes of the previous
+  // variable are decoded in parallel.
+  int numberOfPlanes = 0;
+  for (int block = 0; block < dp->NumberOfBlocks; ++block)
+  {
+    vtkSpyPlotBlock* bk = this->Blocks + block;
+    if (bk->IsAllocated())
+    {
+      numberOfPlanes += bk->GetDimension(2);
+    }
+  }
+
+  vtkSpyPlotCompressedVariable compressedVariables[2];
+  std::vector<vtkSpyPlotDecodedPlane> planes(numberOfPlanes);
+  std::future<int> readAhead;
+  if (!variablesToRead.empty())
+  {
+    readAhead = vtkSpyPlotReadCompressedVariableAsync(
+      &spis, dp->SavedVariableOffsets[variablesToRead[0]], numberOfPlanes, &compressedVariables[0]);
+  }
+  for (size_t cc = 0; cc < variablesToRead.size(); ++cc)
+  {
+    const vtkSpyPlotCompressedVariable& compressed = compressedVariables[cc % 2];
+    if (!readAhead.get())
+    {
+      vtkErrorMacro(<< compressed.Error);
+      return 0;
+    }
+    if (cc + 1 < variablesToRead.size())
+    {
+      readAhead = vtkSpyPlotReadCompressedVariableAsync(&spis,
+        dp->SavedVariableOffsets[variablesToRead[cc + 1]], numberOfPlanes,
+        &compressedVariables[(cc + 1) % 2]);
+    }
+
+    vtkSpyPlotUniReader::Variable* var = dp->Variables + variablesToRead[cc];
+    const bool loadVariable = this->CellArraySelection->ArrayIsEnabled(var->Name) != 0;
+    int plane = 0;
     int actualBlockId = 0;
-    for (block = 0; block < dp->NumberOfBlocks; ++block)
+    for (int block = 0; block < dp->NumberOfBlocks; ++block)
     {
       vtkSpyPlotBlock* bk = this->Blocks + block;
-      if (bk->IsAllocated())
+      if (!bk->IsAllocated())
       {
-        vtkFloatArray* floatArray = 0;
-        vtkUnsignedCharArray* unsignedCharArray = 0;
-        vtkDataArray* dataArray = 0;
-        if (this->CellArraySelection->ArrayIsEnabled(var->Name) && !var->DataBlocks[actualBlockId])
+        continue;
+      }
+      int bdims[3];
+      bk->GetDimensions(bdims);
+      const int planeSize = bdims[0] * bdims[1];
+      vtkFloatArray* floatArray = nullptr;
+      vtkUnsignedCharArray* unsignedCharArray = nullptr;
+      if (loadVariable)
+      {
+        vtkDataArray* dataArray;
+        if (this->DownConvertVolumeFraction && this->IsVolumeFraction(var))
         {
-          if (this->DownConvertVolumeFraction && this->IsVolumeFraction(var))
-          {
-            unsignedCharArray = vtkUnsignedCharArray::New();
-            dataArray = unsignedCharArray;
-          }
-          else
-          {
-            floatArray = vtkFloatArray::New();
-            dataArray = floatArray;
-          }
-          dataArray->SetNumberOfComponents(1);
-          dataArray->SetNumberOfTuples(
-            bk->GetDimension(0) * bk->GetDimension(1) * bk->GetDimension(2));
-          dataArray->SetName(var->Name);
-          // vtkDebugMacro( "*** Create data array: "
-          // << dataArray->GetNumberOfTuples() );
+          unsignedCharArray = vtkUnsignedCharArray::New();
+          dataArray = unsignedCharArray;
         }
-        int zax;
-        int bdims[3];
-        bk->GetDimensions(bdims);
-        for (zax = 0; zax < bdims[2]; ++zax)
+        else
         {
-          int planeSize = bdims[0] * bdims[1];
-          if (!spis.ReadInt32s(&numBytes, 1))
-          {
-            vtkErrorMacro("Problem reading the number of bytes");
-            return 0;
-          }
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
-          {
-            arrayBuffer.resize(numBytes);
-          }
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
-          {
-            vtkErrorMacro("Problem reading the bytes");
-            return 0;
-          }
-          if (floatArray)
-          {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding float data array");
-              return 0;
-            }
-          }
-          if (unsignedCharArray)
-          {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding unsigned char data array");
-              return 0;
-            }
-          }
+          floatArray = vtkFloatArray::New();
+          dataArray = floatArray;
         }
-        if (dataArray)
+        dataArray->SetNumberOfComponents(1);
+        dataArray->SetNumberOfTuples(bdims[0] * bdims[1] * bdims[2]);
+        dataArray->SetName(var->Name);
+        var->DataBlocks[actualBlockId] = dataArray;
+        var->GhostCellsFixed[actualBlockId] = 0;
+        vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
+        actualBlockId++;
+      }
+      for (int zax = 0; zax < bdims[2]; ++zax, ++plane)
+      {
+        planes[plane].Float = floatArray ? floatArray->GetPointer(zax * planeSize) : nullptr;
+        planes[plane].UnsignedChar =
+          unsignedCharArray ? unsignedCharArray->GetPointer(zax * planeSize) : nullptr;
+        planes[plane].Size = planeSize;
+      }
+    }
+
+    if (!loadVariable)
+    {
+      continue;
+    }
+
+    // errors are reported once all the workers are done, from this thread.
+    std::atomic<bool> failed(false);
+    std::mutex errorMutex;
+    std::string decodeError;
+    vtkSMPTools::For(0, numberOfPlanes, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cur = begin; cur < end && !failed; ++cur)
+      {
+        const unsigned char* in = compressed.Bytes.data() + compressed.PlaneOffsets[cur];
+        const int inSize =
+          static_cast<int>(compressed.PlaneOffsets[cur + 1] - compressed.PlaneOffsets[cur]);
+        const vtkSpyPlotDecodedPlane& out = planes[cur];
+        std::string error;
+        const int status = out.Float
+          ? ::vtkSpyPlotUniReaderRunLengthDataDecode(in, inSize, out.Float, out.Size, error)
+          : ::vtkSpyPlotUniReaderRunLengthDataDecode(
+              in, inSize, out.UnsignedChar, out.Size, error, static_cast<unsigned char>(255));
+        if (!status)
         {
-          var->DataBlocks[actualBlockId] = dataArray;
-          var->GhostCellsFixed[actualBlockId] = 0;
-          vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
-          actualBlockId++;
+          std::lock_guard<std::mutex> lock(errorMutex);
+          if (!failed)
+          {
+            decodeError = error;
+            failed = true;
+          }
         }
       }
+    });
+    if (failed)
+    {
+      vtkErrorMacro("Problem RLD decoding data array: " << var->Name << ". " << decodeError);
+      return 0;
     }
   }
+  if (readAhead.valid())
+  {
+    readAhead.wait();
+  }
 
   if (blocksUpdated && needMarkers)
   {
@@ -667,7 +794,7 @@ void vtkSpyPlotUniReader::PrintInformation()
 //-----------------------------------------------------------------------------
 template <class t>
 int vtkSpyPlotUniReaderRunLengthDataDecode(
-  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
+  const unsigned char* in, int inSize, t* out, int outSize, std::string& error, t scale)
 {
   int outIndex = 0, inIndex = 0;
 
@@ -686,18 +813,14 @@ int vtkSpyPlotUniReaderRunLengthDataDecode(
       vtkByteSwap::SwapBE(&val);
       ptmp += 4;
       // Now populate the out data
-      int k;
-      for (k = 0; k < runLength; ++k)
+      if (outIndex + runLength > outSize)
       {
-        if (outIndex >= outSize)
-        {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-              << "Too much data generated. Expected: " << outSize);
-          return 0;
-        }
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
+        error = "Problem doing RLD decode. Too much data generated. Expected: " +
+          std::to_string(outSize);
+        return 0;
       }
+      std::fill_n(out + outIndex, runLength, static_cast<t>(val * scale));
+      outIndex += runLength;
       inIndex += 5;
     }
     else // runLength >= 128
@@ -707,8 +830,8 @@ int vtkSpyPlotUniReaderRunLengthDataDecode(
       {
         if (outIndex >= outSize)
         {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-              << "Too much data generated. Expected: " << outSize);
+          error = "Problem doing RLD decode. Too much data generated. Expected: " +
+            std::to_string(outSize);
           return 0;
         }
         float val;
@@ -729,22 +852,40 @@ int vtkSpyPlotUniReaderRunLengthDataDecode(
 int vtkSpyPlotUniReader::RunLengthDataDecode(
   const unsigned char* in, int inSize, float* out, int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(this, in, inSize, out, outSize);
+  std::string error;
+  if (!::vtkSpyPlotUniReaderRunLengthDataDecode(in, inSize, out, outSize, error))
+  {
+    vtkErrorMacro(<< error);
+    return 0;
+  }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::RunLengthDataDecode(
   const unsigned char* in, int inSize, int* out, int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(this, in, inSize, out, outSize);
+  std::string error;
+  if (!::vtkSpyPlotUniReaderRunLengthDataDecode(in, inSize, out, outSize, error))
+  {
+    vtkErrorMacro(<< error);
+    return 0;
+  }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::RunLengthDataDecode(
   const unsigned char* in, int inSize, unsigned char* out, int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(
-    this, in, inSize, out, outSize, static_cast<unsigned char>(255));
+  std::string error;
+  if (!::vtkSpyPlotUniReaderRunLengthDataDecode(
+        in, inSize, out, outSize, error, static_cast<unsigned char>(255)))
+  {
+    vtkErrorMacro(<< error);
+    return 0;
+  }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,184 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestExtractHistogramKernel.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares the histogram computed by vtkExtractHistogram with a serial
+// reference and reports the throughput. Use `--size=<N>` to benchmark with
+// larger arrays.
+
+#include "vtkDoubleArray.h"
+#include "vtkExtractHistogram.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkTable.h"
+#include "vtkTimerLog.h"
+#include "vtkTypeInt64Array.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+const int BinCount = 37;
+
+// Serial reference for the histogram of `component` (magnitude if equal to
+// the number of components) and the totals of `other`.
+void ComputeReference(vtkDataArray* values, int component, vtkDataArray* other,
+  std::vector<vtkTypeInt64>& counts, std::vector<double>& totals)
+{
+  const int numComps = values->GetNumberOfComponents();
+  double range[2];
+  values->GetRange(range, component == numComps ? -1 : component);
+  const double delta = (range[1] - range[0]) / BinCount;
+
+  counts.assign(BinCount, 0);
+  totals.assign(BinCount * other->GetNumberOfComponents(), 0.0);
+  for (vtkIdType cc = 0; cc < values->GetNumberOfTuples(); ++cc)
+  {
+    double value = 0.0;
+    if (component == numComps)
+    {
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        value += values->GetComponent(cc, comp) * values->GetComponent(cc, comp);
+      }
+      value = std::sqrt(value);
+    }
+    else
+    {
+      value = values->GetComponent(cc, component);
+    }
+    int bin = static_cast<int>((value - range[0]) / delta);
+    bin = bin < 0 ? 0 : (bin > BinCount - 1 ? BinCount - 1 : bin);
+    counts[bin]++;
+    for (int comp = 0; comp < other->GetNumberOfComponents(); ++comp)
+    {
+      totals[bin * other->GetNumberOfComponents() + comp] += other->GetComponent(cc, comp);
+    }
+  }
+}
+
+bool DoTest(vtkTable* input, int component, const char* label)
+{
+  vtkNew<vtkExtractHistogram> histogram;
+  histogram->SetInputData(input);
+  histogram->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_ROWS, "values");
+  histogram->SetComponent(component);
+  histogram->SetBinCount(BinCount);
+  histogram->SetCalculateAverages(1);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  histogram->Update();
+  timer->StopTimer();
+
+  vtkTable* output = histogram->GetOutput();
+  vtkDataArray* values = input->GetRowData()->GetArray("values");
+  vtkDataArray* other = input->GetRowData()->GetArray("other");
+  std::vector<vtkTypeInt64> counts;
+  std::vector<double> totals;
+  ComputeReference(values, component, other, counts, totals);
+
+  auto binValues = vtkTypeInt64Array::SafeDownCast(output->GetRowData()->GetArray("bin_values"));
+  expect(binValues && binValues->GetNumberOfTuples() == BinCount, "invalid bin_values");
+  auto otherTotals = output->GetRowData()->GetArray("other_total");
+  auto otherAverages = output->GetRowData()->GetArray("other_average");
+  expect(otherTotals && otherTotals->GetNumberOfComponents() == 2, "invalid other_total");
+  expect(otherAverages && output->GetRowData()->GetArray("ints_average"), "missing averages");
+  expect(output->GetRowData()->GetArray("values_total") == nullptr, "binned array averaged");
+
+  vtkTypeInt64 total = 0;
+  for (int bin = 0; bin < BinCount; ++bin)
+  {
+    expect(binValues->GetValue(bin) == counts[bin], "mismatched count in bin " << bin);
+    total += binValues->GetValue(bin);
+    for (int comp = 0; comp < 2; ++comp)
+    {
+      const double expected = totals[bin * 2 + comp];
+      const double actual = otherTotals->GetComponent(bin, comp);
+      expect(std::abs(actual - expected) <= 1e-9 * (1.0 + std::abs(expected)),
+        "mismatched total in bin " << bin << ": " << actual << " (expected " << expected << ")");
+      if (counts[bin] > 0)
+      {
+        const double average = otherAverages->GetComponent(bin, comp);
+        expect(std::abs(average * counts[bin] - actual) <= 1e-9 * (1.0 + std::abs(actual)),
+          "mismatched average in bin " << bin);
+      }
+    }
+  }
+  expect(total == values->GetNumberOfTuples(), "counts do not add up");
+
+  cout << label << ": " << timer->GetElapsedTime() << " s ("
+       << values->GetNumberOfTuples() / timer->GetElapsedTime() << " values/s)" << endl;
+  return true;
+}
+}
+
+int TestExtractHistogramKernel(int argc, char* argv[])
+{
+  vtkIdType size = 100000;
+  for (int cc = 1; cc < argc; ++cc)
+  {
+    if (strncmp(argv[cc], "--size=", 7) == 0)
+    {
+      size = std::atoll(argv[cc] + 7);
+    }
+  }
+
+  vtkNew<vtkFloatArray> values;
+  values->SetName("values");
+  values->SetNumberOfComponents(3);
+  values->SetNumberOfTuples(size);
+  vtkNew<vtkDoubleArray> other;
+  other->SetName("other");
+  other->SetNumberOfComponents(2);
+  other->SetNumberOfTuples(size);
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("ints");
+  ints->SetNumberOfTuples(size);
+
+  unsigned int seed = 1;
+  for (vtkIdType cc = 0; cc < size; ++cc)
+  {
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      seed = seed * 1103515245u + 12345u;
+      values->SetTypedComponent(cc, comp, static_cast<float>((seed >> 8) % 10007) - 5000.0f);
+    }
+    other->SetTypedComponent(cc, 0, std::sin(0.001 * cc));
+    other->SetTypedComponent(cc, 1, static_cast<double>(cc % 97));
+    ints->SetValue(cc, static_cast<int>(cc % 13));
+  }
+
+  vtkNew<vtkTable> input;
+  input->GetRowData()->AddArray(values);
+  input->GetRowData()->AddArray(other);
+  input->GetRowData()->AddArray(ints);
+
+  if (!DoTest(input, 1, "Component") || !DoTest(input, 3, "Magnitude"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
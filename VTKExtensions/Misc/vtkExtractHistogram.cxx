@@ -14,23 +14,29 @@
 =========================================================================*/
 #include "vtkExtractHistogram.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkGraph.h"
 #include "vtkIOStream.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
-#include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
+#include "vtkTypeInt64Array.h"
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
 #include <vector>
@@ -276,16 +282,162 @@ void vtkExtractHistogram::FillBinExtents(vtkDoubleArray* bin_extents, double min
   }
 }
 
-inline int vtkExtractHistogramClamp(int value, int min, int max)
+namespace
 {
-  value = value < min ? min : value;
-  value = value > max ? max : value;
-  return value;
+// Maps values to bins.
+struct vtkEHBinning
+{
+  double Min;
+  double Delta;
+  double Offset;
+  int BinCount;
+  int Component;
+  bool Magnitude;
+
+  int GetBin(double value) const
+  {
+    // If the value is equal to max, include it in the last bin. NaNs go to the
+    // first bin.
+    const double bin = (value - this->Min + this->Offset) / this->Delta;
+    if (!(bin >= 0.0))
+    {
+      return 0;
+    }
+    return bin < this->BinCount - 1 ? static_cast<int>(bin) : this->BinCount - 1;
+  }
+};
+
+// Computes the bins of the tuples [Begin, End) of an array.
+struct vtkEHComputeBins
+{
+  const vtkEHBinning* Binning;
+  vtkIdType Begin;
+  vtkIdType End;
+  int* Bins;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array) const
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(array);
+    const int numComps = array->GetNumberOfComponents();
+    const vtkEHBinning& binning = *this->Binning;
+    int* bins = this->Bins - this->Begin;
+    if (binning.Magnitude)
+    {
+      for (vtkIdType tuple = this->Begin; tuple < this->End; ++tuple)
+      {
+        double value = 0.0;
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          const double compValue = static_cast<double>(accessor.Get(tuple, comp));
+          value += compValue * compValue;
+        }
+        bins[tuple] = binning.GetBin(std::sqrt(value));
+      }
+    }
+    else
+    {
+      for (vtkIdType tuple = this->Begin; tuple < this->End; ++tuple)
+      {
+        bins[tuple] = binning.GetBin(static_cast<double>(accessor.Get(tuple, binning.Component)));
+      }
+    }
+  }
+};
+
+// Adds the tuples [Begin, End) of an array to the totals of their bins.
+struct vtkEHAccumulateTotals
+{
+  const int* Bins;
+  vtkIdType Begin;
+  vtkIdType End;
+  double* Totals;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array) const
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(array);
+    const int numComps = array->GetNumberOfComponents();
+    const int* bins = this->Bins - this->Begin;
+    for (vtkIdType tuple = this->Begin; tuple < this->End; ++tuple)
+    {
+      double* totals = this->Totals + static_cast<vtkIdType>(bins[tuple]) * numComps;
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        totals[comp] += static_cast<double>(accessor.Get(tuple, comp));
+      }
+    }
+  }
+};
+
+// Bins a range of tuples into thread local counts and totals, merged by the
+// caller once all tuples have been processed.
+class vtkEHBinFunctor
+{
+public:
+  struct LocalBins
+  {
+    std::vector<vtkTypeInt64> Counts;
+    // Totals of each averaged array, BinCount x number of components.
+    std::vector<std::vector<double> > Totals;
+    std::vector<int> Bins;
+  };
+
+  vtkDataArray* Array;
+  std::vector<vtkDataArray*> AveragedArrays;
+  vtkEHBinning Binning;
+  vtkSMPThreadLocal<LocalBins> Locals;
+
+  // Not using Initialize() since the functor is used for several
+  // vtkSMPTools::For() calls.
+  LocalBins& GetLocal()
+  {
+    LocalBins& local = this->Locals.Local();
+    if (local.Counts.empty())
+    {
+      local.Counts.resize(this->Binning.BinCount, 0);
+      local.Totals.resize(this->AveragedArrays.size());
+      for (size_t cc = 0; cc < this->AveragedArrays.size(); ++cc)
+      {
+        local.Totals[cc].resize(static_cast<size_t>(this->Binning.BinCount) *
+          this->AveragedArrays[cc]->GetNumberOfComponents());
+      }
+    }
+    return local;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalBins& local = this->GetLocal();
+    local.Bins.resize(end - begin);
+
+    vtkEHComputeBins binner = { &this->Binning, begin, end, local.Bins.data() };
+    if (!vtkArrayDispatch::Dispatch::Execute(this->Array, binner))
+    {
+      binner(this->Array);
+    }
+    vtkTypeInt64* counts = local.Counts.data();
+    for (const int bin : local.Bins)
+    {
+      ++counts[bin];
+    }
+
+    for (size_t cc = 0; cc < this->AveragedArrays.size(); ++cc)
+    {
+      vtkEHAccumulateTotals accumulator = { local.Bins.data(), begin, end,
+        local.Totals[cc].data() };
+      if (!vtkArrayDispatch::Dispatch::Execute(this->AveragedArrays[cc], accumulator))
+      {
+        accumulator(this->AveragedArrays[cc]);
+      }
+    }
+  }
+};
 }
 
 //-----------------------------------------------------------------------------
-void vtkExtractHistogram::BinAnArray(
-  vtkDataArray* data_array, vtkIntArray* bin_values, double min, double max, vtkFieldData* field)
+void vtkExtractHistogram::BinAnArray(vtkDataArray* data_array, vtkTypeInt64Array* bin_values,
+  double min, double max, vtkFieldData* field)
 {
   // If the requested component is out-of-range for the input,
   // the bin_values will be 0, so no need to do any actual counting.
@@ -295,61 +447,74 @@ void vtkExtractHistogram::BinAnArray(
     return;
   }
 
-  int num_of_tuples = data_array->GetNumberOfTuples();
-  double bin_delta =
+  const vtkIdType num_of_tuples = data_array->GetNumberOfTuples();
+  const double bin_delta =
     (max - min) / (this->CenterBinsAroundMinAndMax ? (this->BinCount - 1) : this->BinCount);
-  double half_delta = bin_delta / 2.0;
 
-  for (int i = 0; i != num_of_tuples; ++i)
+  vtkEHBinFunctor functor;
+  functor.Array = data_array;
+  functor.Binning.Min = min;
+  functor.Binning.Delta = bin_delta;
+  functor.Binning.Offset = this->CenterBinsAroundMinAndMax ? bin_delta / 2.0 : 0.0;
+  functor.Binning.BinCount = this->BinCount;
+  functor.Binning.Component = this->Component;
+  // if component is equal to the number of components, then the magnitude was requested.
+  functor.Binning.Magnitude = this->Component == data_array->GetNumberOfComponents();
+
+  if (this->CalculateAverages)
   {
-    if (i % 1000 == 0)
-    {
-      this->UpdateProgress(0.10 + 0.90 * i / num_of_tuples);
-    }
-    double value;
-    // if component is equal to the number of components, then the magnitude was requested.
-    if (this->Component == data_array->GetNumberOfComponents())
+    // Get all other arrays, add their values to the bins. At the end, each
+    // total is divided by the number of values in the bin.
+    for (int idx = 0, num_arrays = field->GetNumberOfArrays(); idx < num_arrays; idx++)
     {
-      value = 0;
-      double comp;
-      for (int j = 0; j < data_array->GetNumberOfComponents(); ++j)
+      vtkDataArray* array = field->GetArray(idx);
+      if (array && array != data_array && array->GetName() &&
+        array->GetNumberOfTuples() >= num_of_tuples)
       {
-        comp = data_array->GetComponent(i, j);
-        value += comp * comp;
+        functor.AveragedArrays.push_back(array);
       }
-      value = sqrt(value);
     }
-    else
-    {
-      value = data_array->GetComponent(i, this->Component);
-    }
-    int index = static_cast<int>(
-      (value - min + (this->CenterBinsAroundMinAndMax ? half_delta : 0.)) / bin_delta);
+  }
 
-    // If the value is equal to max, include it in the last bin.
-    index = ::vtkExtractHistogramClamp(index, 0, this->BinCount - 1);
-    bin_values->SetValue(index, bin_values->GetValue(index) + 1);
+  // Process the tuples in large blocks to report progress.
+  const vtkIdType block_size = 16 * 1024 * 1024;
+  for (vtkIdType begin = 0; begin < num_of_tuples; begin += block_size)
+  {
+    this->UpdateProgress(0.10 + 0.90 * begin / num_of_tuples);
+    vtkSMPTools::For(begin, std::min(begin + block_size, num_of_tuples), functor);
+  }
 
-    if (this->CalculateAverages)
+  vtkTypeInt64* counts = bin_values->GetPointer(0);
+  for (auto iter = functor.Locals.begin(); iter != functor.Locals.end(); ++iter)
+  {
+    vtkEHBinFunctor::LocalBins& local = *iter;
+    if (local.Counts.empty())
+    {
+      continue;
+    }
+    for (int bin = 0; bin < this->BinCount; ++bin)
     {
-      // Get all other arrays, add their value to the bin
-      // For each bin, we will need 2 values per array ->
-      // total, num. elements
-      // at the end, divide each total by num. elements
-      int num_arrays = field->GetNumberOfArrays();
-      for (int idx = 0; idx < num_arrays; idx++)
+      counts[bin] += local.Counts[bin];
+    }
+    for (size_t cc = 0; cc < functor.AveragedArrays.size(); ++cc)
+    {
+      vtkDataArray* array = functor.AveragedArrays[cc];
+      const int numComps = array->GetNumberOfComponents();
+      vtkEHInternals::ArrayValuesType& arrayValues =
+        this->Internal->ArrayValues[array->GetName()];
+      arrayValues.TotalValues.resize(this->BinCount);
+      for (int bin = 0; bin < this->BinCount; ++bin)
       {
-        vtkDataArray* array = field->GetArray(idx);
-        if (array && array != data_array && array->GetName())
+        std::vector<double>& totals = arrayValues.TotalValues[bin];
+        if (totals.empty())
+        {
+          totals.resize(numComps, 0.0);
+        }
+        if (static_cast<int>(totals.size()) == numComps)
         {
-          vtkEHInternals::ArrayValuesType& arrayValues =
-            this->Internal->ArrayValues[array->GetName()];
-          arrayValues.TotalValues.resize(this->BinCount);
-          int numComps = array->GetNumberOfComponents();
-          arrayValues.TotalValues[index].resize(numComps);
           for (int comp = 0; comp < numComps; comp++)
           {
-            arrayValues.TotalValues[index][comp] += array->GetComponent(i, comp);
+            totals[comp] += local.Totals[cc][bin * numComps + comp];
           }
         }
       }
@@ -383,11 +548,11 @@ int vtkExtractHistogram::RequestData(vtkInformation* /*request*/,
   bin_extents->FillComponent(0, 0.0);
 
   // Insert values into bins ...
-  vtkSmartPointer<vtkIntArray> bin_values = vtkSmartPointer<vtkIntArray>::New();
+  vtkSmartPointer<vtkTypeInt64Array> bin_values = vtkSmartPointer<vtkTypeInt64Array>::New();
   bin_values->SetNumberOfComponents(1);
   bin_values->SetNumberOfTuples(this->BinCount);
   bin_values->SetName("bin_values");
-  bin_values->FillComponent(0, 0.0);
+  bin_values->FillValue(0);
 
   // Initializes the bin_extents array.
   double min, max;
@@ -20,8 +20,10 @@
  * vtkExtractHistogram accepts any vtkDataSet as input and produces a
  * vtkPolyData containing histogram data as output.  The output vtkPolyData
  * will have contain a vtkDoubleArray named "bin_extents" which contains
- * the boundaries between each histogram bin, and a vtkUnsignedLongArray
+ * the boundaries between each histogram bin, and a vtkTypeInt64Array
  * named "bin_values" which will contain the value for each bin.
+ *
+ * The values are binned in parallel using vtkSMPTools.
 */
 
 #ifndef vtkExtractHistogram_h
@@ -32,7 +34,7 @@
 
 class vtkDoubleArray;
 class vtkFieldData;
-class vtkIntArray;
+class vtkTypeInt64Array;
 struct vtkEHInternals;
 
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkExtractHistogram : public vtkTableAlgorithm
@@ -125,7 +127,7 @@ protected:
     vtkInformationVector** inputVector, vtkDoubleArray* bin_extents, double& min, double& max);
 
   void BinAnArray(
-    vtkDataArray* src, vtkIntArray* vals, double min, double max, vtkFieldData* field);
+    vtkDataArray* src, vtkTypeInt64Array* vals, double min, double max, vtkFieldData* field);
 
   void FillBinExtents(vtkDoubleArray* bin_extents, double min, double max);
 
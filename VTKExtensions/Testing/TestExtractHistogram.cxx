@@ -16,10 +16,10 @@
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkExtractHistogram.h"
-#include "vtkIntArray.h"
 #include "vtkSmartPointer.h"
 #include "vtkSphereSource.h"
 #include "vtkTable.h"
+#include "vtkTypeInt64Array.h"
 
 /// Test the output of the vtkExtractHistogram filter in a simple serial case
 int TestExtractHistogram(int, char* [])
@@ -59,8 +59,8 @@ int TestExtractHistogram(int, char* [])
     return 1;
   }
 
-  vtkIntArray* const bin_values =
-    vtkIntArray::SafeDownCast(histogram->GetRowData()->GetArray((int)1));
+  vtkTypeInt64Array* const bin_values =
+    vtkTypeInt64Array::SafeDownCast(histogram->GetRowData()->GetArray((int)1));
   if (!bin_values)
   {
     vtkGenericWarningMacro("cell data missing.");